@@ -0,0 +1,68 @@
+/**
+ * @file AdvertisementQueue.cpp
+ *
+ * Created: 2022
+ * License: GNU GENERAL PUBLIC LICENSE (see LICENSE)
+ *
+ * This library provides a BLE scanner to be used by other libraries to
+ * receive advertisements from BLE devices
+ *
+ */
+
+#include "AdvertisementQueue.h"
+
+namespace BleScanner {
+
+// one slot stays empty to tell a full buffer from an empty one
+static const size_t SLOTS = BLESCANNER_QUEUE_SIZE + 1;
+
+AdvertisementQueue::AdvertisementQueue()
+  : head(0),
+    tail(0),
+    maxSize(0),
+    droppedCount(0) {
+}
+
+bool AdvertisementQueue::push(const Advertisement& advertisement) {
+  size_t currentTail = tail.load(std::memory_order_relaxed);
+  size_t nextTail = (currentTail + 1) % SLOTS;
+  size_t currentHead = head.load(std::memory_order_acquire);
+  if (nextTail == currentHead) {
+    droppedCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  buffer[currentTail] = advertisement;
+  tail.store(nextTail, std::memory_order_release);
+
+  size_t currentSize = (nextTail + SLOTS - currentHead) % SLOTS;
+  if (currentSize > maxSize.load(std::memory_order_relaxed)) {
+    maxSize.store(currentSize, std::memory_order_relaxed);
+  }
+  return true;
+}
+
+bool AdvertisementQueue::pop(Advertisement& advertisement) {
+  size_t currentHead = head.load(std::memory_order_relaxed);
+  if (currentHead == tail.load(std::memory_order_acquire)) {
+    return false;
+  }
+
+  advertisement = buffer[currentHead];
+  head.store((currentHead + 1) % SLOTS, std::memory_order_release);
+  return true;
+}
+
+size_t AdvertisementQueue::size() const {
+  return (tail.load(std::memory_order_acquire) + SLOTS - head.load(std::memory_order_acquire)) % SLOTS;
+}
+
+size_t AdvertisementQueue::highWater() const {
+  return maxSize.load(std::memory_order_relaxed);
+}
+
+uint32_t AdvertisementQueue::dropped() const {
+  return droppedCount.load(std::memory_order_relaxed);
+}
+
+} // namespace BleScanner
@@ -0,0 +1,75 @@
+#pragma once
+
+/**
+ * @file AdvertisementQueue.h
+ *
+ * Created: 2022
+ * License: GNU GENERAL PUBLIC LICENSE (see LICENSE)
+ *
+ * This library provides a BLE scanner to be used by other libraries to
+ * receive advertisements from BLE devices
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+#ifndef BLESCANNER_QUEUE_SIZE
+#define BLESCANNER_QUEUE_SIZE 32
+#endif
+
+#ifndef BLESCANNER_MAX_MANUFACTURER_DATA
+#define BLESCANNER_MAX_MANUFACTURER_DATA 31
+#endif
+
+namespace BleScanner {
+
+/**
+ * @brief The fields of an advertisement that are kept after the NimBLE callback returned
+ */
+struct Advertisement {
+  uint64_t address;
+  uint32_t timestamp;  // millis() when received
+  int8_t rssi;
+  uint8_t manufacturerDataLength;
+  uint8_t manufacturerData[BLESCANNER_MAX_MANUFACTURER_DATA];
+};
+
+/**
+ * @brief Fixed size ring buffer handing advertisements from the BLE host task to a consumer task
+ *
+ * Lock-free for exactly one producer and one consumer, it does not allocate. When the buffer is
+ * full the new advertisement is dropped and counted, the consumer should drain it regularly.
+ */
+class AdvertisementQueue {
+  public:
+    AdvertisementQueue();
+
+    /**
+     * @brief Copies an advertisement into the buffer, called by the producer
+     *
+     * @return false if the buffer is full and the advertisement was dropped
+     */
+    bool push(const Advertisement& advertisement);
+
+    /**
+     * @brief Takes the oldest advertisement from the buffer, called by the consumer
+     *
+     * @return false if the buffer is empty
+     */
+    bool pop(Advertisement& advertisement);
+
+    size_t size() const;
+    size_t highWater() const;
+    uint32_t dropped() const;
+
+  private:
+    Advertisement buffer[BLESCANNER_QUEUE_SIZE + 1];
+    std::atomic<size_t> head;  // next to pop, owned by the consumer
+    std::atomic<size_t> tail;  // next to push, owned by the producer
+    std::atomic<size_t> maxSize;
+    std::atomic<uint32_t> droppedCount;
+};
+
+} // namespace BleScanner
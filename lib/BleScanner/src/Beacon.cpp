@@ -0,0 +1,39 @@
+/**
+ * @file Beacon.cpp
+ *
+ * Created: 2022
+ * License: GNU GENERAL PUBLIC LICENSE (see LICENSE)
+ *
+ * This library provides a BLE scanner to be used by other libraries to
+ * receive advertisements from BLE devices
+ *
+ */
+
+#include "Beacon.h"
+#include <string.h>
+
+namespace BleScanner {
+
+// company id (little endian) | type | length | uuid (16) | major | minor | tx power
+static const size_t BEACON_LENGTH = 25;
+static const uint16_t BEACON_COMPANY_ID = 0x004C;
+static const uint8_t BEACON_TYPE = 0x02;
+static const uint8_t BEACON_DATA_LENGTH = 0x15;
+
+bool decodeBeacon(const uint8_t* data, size_t length, Beacon& beacon) {
+  if (data == nullptr || length != BEACON_LENGTH) {
+    return false;
+  }
+  if ((data[0] | (data[1] << 8)) != BEACON_COMPANY_ID || data[2] != BEACON_TYPE || data[3] != BEACON_DATA_LENGTH) {
+    return false;
+  }
+
+  memcpy(beacon.uuid, &data[4], sizeof(beacon.uuid));
+  // major and minor are big endian
+  beacon.major = (data[20] << 8) | data[21];
+  beacon.minor = (data[22] << 8) | data[23];
+  beacon.txPower = (int8_t)data[24];
+  return true;
+}
+
+} // namespace BleScanner
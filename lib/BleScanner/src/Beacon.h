@@ -0,0 +1,38 @@
+#pragma once
+
+/**
+ * @file Beacon.h
+ *
+ * Created: 2022
+ * License: GNU GENERAL PUBLIC LICENSE (see LICENSE)
+ *
+ * This library provides a BLE scanner to be used by other libraries to
+ * receive advertisements from BLE devices
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace BleScanner {
+
+struct Beacon {
+  uint8_t uuid[16];
+  uint16_t major;
+  uint16_t minor;
+  int8_t txPower;
+};
+
+/**
+ * @brief Decodes an iBeacon from the manufacturer data of an advertisement
+ *
+ * @param data manufacturer data, starting with the company id
+ * @param length length of the manufacturer data
+ * @param beacon filled in if the data is an iBeacon
+ * @return true if the data is an iBeacon
+ *
+ * Does not depend on NimBLE, so it can be used from any context and tested on the host
+ */
+bool decodeBeacon(const uint8_t* data, size_t length, Beacon& beacon);
+
+} // namespace BleScanner
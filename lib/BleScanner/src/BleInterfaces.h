@@ -12,6 +12,7 @@
  */
 
 #include <NimBLEDevice.h>
+#include "AdvertisementQueue.h"
 
 namespace BleScanner {
 
@@ -21,6 +22,12 @@ class Subscriber {
     virtual void onResult(const NimBLEAdvertisedDevice* advertisedDevice) = 0;
 };
 
+// Receives a copy of the advertisement on the task calling Scanner::update() instead of the BLE host task
+class AdvertisementSubscriber {
+  public:
+    virtual void onAdvertisement(const Advertisement& advertisement) = 0;
+};
+
 class Publisher {
   public:
     virtual void subscribe(Subscriber* subscriber) = 0;
@@ -38,12 +38,42 @@ void Scanner::initialize(const std::string& deviceName, const bool wantDuplicate
   #else
   bleScan->setScanCallbacks(this, wantDuplicates);
   #endif
+  scanInterval = interval;
+  scanWindow = window;
   bleScan->setInterval(interval);
   bleScan->setWindow(window);
   bleScan->setActiveScan(false);
 }
 
 void Scanner::update() {
+  Advertisement advertisement;
+  AdvertisementSubscriber* matches[BLESCANNER_MAX_MATCHES];
+  while (queue.pop(advertisement)) {
+    size_t count;
+    {
+      std::lock_guard<std::mutex> lock(subscribersMutex);
+      count = advertisementSubscribers.match(advertisement.address, advertisement.manufacturerData, advertisement.manufacturerDataLength, matches);
+    }
+    for (size_t i = 0; i < count; ++i) {
+      matches[i]->onAdvertisement(advertisement);
+    }
+    dispatchedCount += count;
+    if (scanPolicy != nullptr) {
+      scanPolicy->received(advertisement.address, advertisement.timestamp);
+    }
+  }
+
+  if (scanPolicy != nullptr && scanPolicy->update(millis())) {
+    // the new interval takes effect when the scan is restarted below
+    scanInterval = scanPolicy->interval();
+    scanWindow = scanPolicy->window();
+    if (bleScan->isScanning()) {
+      bleScan->stop();
+    }
+    bleScan->setInterval(scanInterval);
+    bleScan->setWindow(scanWindow);
+  }
+
   if (!scanningEnabled || bleScan->isScanning()) {
     return;
   }
@@ -75,33 +105,168 @@ void Scanner::enableScanning(bool enable) {
   }
 }
 
+void Scanner::setScanPolicy(ScanPolicy* policy) {
+  scanPolicy = policy;
+}
+
+void Scanner::boostScanning() {
+  if (scanPolicy != nullptr) {
+    scanPolicy->boost(millis());
+  }
+}
+
+uint8_t Scanner::dutyCycle() const {
+  return (uint32_t)scanWindow * 100 / scanInterval;
+}
+
+uint32_t Scanner::detectionLatency() const {
+  return scanPolicy != nullptr ? scanPolicy->latency() : 0;
+}
+
 void Scanner::setScanDuration(const uint32_t value) {
   scanDuration = value;
 }
 
 void Scanner::subscribe(Subscriber* subscriber) {
-  if (std::find(subscribers.begin(), subscribers.end(), subscriber) != subscribers.end()) {
-    return;
-  }
-  subscribers.push_back(subscriber);
+  std::lock_guard<std::mutex> lock(subscribersMutex);
+  subscribers.add(subscriber);
 }
 
 void Scanner::unsubscribe(Subscriber* subscriber) {
-  auto it = std::find(subscribers.begin(), subscribers.end(), subscriber);
-  if (it != subscribers.end()) {
-    subscribers.erase(it);
-  }
+  std::lock_guard<std::mutex> lock(subscribersMutex);
+  subscribers.remove(subscriber);
+}
+
+void Scanner::subscribe(AdvertisementSubscriber* subscriber) {
+  std::lock_guard<std::mutex> lock(subscribersMutex);
+  advertisementSubscribers.add(subscriber);
+}
+
+void Scanner::unsubscribe(AdvertisementSubscriber* subscriber) {
+  std::lock_guard<std::mutex> lock(subscribersMutex);
+  advertisementSubscribers.remove(subscriber);
+}
+
+void Scanner::addAddressFilter(Subscriber* subscriber, const BLEAddress& bleAddress) {
+  std::lock_guard<std::mutex> lock(subscribersMutex);
+  subscribers.addAddress(subscriber, bleAddress);
+}
+
+void Scanner::addAddressFilter(AdvertisementSubscriber* subscriber, const BLEAddress& bleAddress) {
+  std::lock_guard<std::mutex> lock(subscribersMutex);
+  advertisementSubscribers.addAddress(subscriber, bleAddress);
+}
+
+void Scanner::addManufacturerFilter(Subscriber* subscriber, uint16_t manufacturerId) {
+  std::lock_guard<std::mutex> lock(subscribersMutex);
+  subscribers.addManufacturer(subscriber, manufacturerId);
+}
+
+void Scanner::addManufacturerFilter(AdvertisementSubscriber* subscriber, uint16_t manufacturerId) {
+  std::lock_guard<std::mutex> lock(subscribersMutex);
+  advertisementSubscribers.addManufacturer(subscriber, manufacturerId);
+}
+
+void Scanner::clearFilters(Subscriber* subscriber) {
+  std::lock_guard<std::mutex> lock(subscribersMutex);
+  subscribers.clearFilters(subscriber);
+}
+
+void Scanner::clearFilters(AdvertisementSubscriber* subscriber) {
+  std::lock_guard<std::mutex> lock(subscribersMutex);
+  advertisementSubscribers.clearFilters(subscriber);
 }
 
 void Scanner::onResult(const NimBLEAdvertisedDevice* advertisedDevice) {
-  for (const auto& subscriber : subscribers) {
-    subscriber->onResult(advertisedDevice);
+  ++seenCount;
+
+  // runs in the BLE host task: find out who is interested before copying anything
+  Advertisement advertisement;
+  advertisement.address = advertisedDevice->getAddress();
+  advertisement.manufacturerDataLength = 0;
+
+  Subscriber* matches[BLESCANNER_MAX_MATCHES];
+  AdvertisementSubscriber* advertisementMatches[BLESCANNER_MAX_MATCHES];
+  size_t count;
+  size_t advertisementCount;
+  bool byManufacturer;
+  {
+    std::lock_guard<std::mutex> lock(subscribersMutex);
+    count = subscribers.match(advertisement.address, nullptr, 0, matches);
+    advertisementCount = advertisementSubscribers.match(advertisement.address, nullptr, 0, advertisementMatches);
+    byManufacturer = subscribers.hasManufacturerFilters() || advertisementSubscribers.hasManufacturerFilters();
+  }
+
+  if (count == 0 && advertisementCount == 0 && !byManufacturer) {
+    ++filteredCount;
+    return;
+  }
+
+  if (advertisedDevice->haveManufacturerData()) {
+    std::string data = advertisedDevice->getManufacturerData();
+    size_t length = data.length() < sizeof(advertisement.manufacturerData) ? data.length() : sizeof(advertisement.manufacturerData);
+    memcpy(advertisement.manufacturerData, data.data(), length);
+    advertisement.manufacturerDataLength = length;
+  }
+
+  if (byManufacturer) {
+    std::lock_guard<std::mutex> lock(subscribersMutex);
+    count = subscribers.match(advertisement.address, advertisement.manufacturerData, advertisement.manufacturerDataLength, matches);
+    advertisementCount = advertisementSubscribers.match(advertisement.address, advertisement.manufacturerData, advertisement.manufacturerDataLength, advertisementMatches);
+  }
+
+  if (count == 0 && advertisementCount == 0) {
+    ++filteredCount;
+    return;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    matches[i]->onResult(advertisedDevice);
+  }
+  dispatchedCount += count;
+
+  if (advertisementCount > 0) {
+    // the subscribers get it from update()
+    advertisement.timestamp = millis();
+    advertisement.rssi = advertisedDevice->getRSSI();
+    queue.push(advertisement);
+    if (updateNotifier != nullptr) {
+      updateNotifier();
+    }
+  }
+}
+
+#ifdef BLESCANNER_USE_LATEST_NIMBLE
+void Scanner::onScanEnd(const NimBLEScanResults&, int) {
+  if (updateNotifier != nullptr) {
+    updateNotifier();
   }
 }
+#endif
+
+void Scanner::setUpdateNotifier(void (*notifier)()) {
+  updateNotifier = notifier;
+}
 
 void Scanner::whitelist(BLEAddress bleAddress) {
   BLEDevice::whiteListAdd(bleAddress);   
   bleScan->setFilterPolicy(BLE_HCI_SCAN_FILT_USE_WL);
 }
 
+uint32_t Scanner::droppedAdvertisements() const {
+  return queue.dropped();
+}
+
+size_t Scanner::queueHighWater() const {
+  return queue.highWater();
+}
+
+Scanner::Statistics Scanner::statistics() const {
+  Statistics statistics;
+  statistics.seen = seenCount;
+  statistics.filtered = filteredCount;
+  statistics.dispatched = dispatchedCount;
+  return statistics;
+}
+
 } // namespace BleScanner
\ No newline at end of file
@@ -13,8 +13,11 @@
 
 #include "Arduino.h"
 #include <string>
+#include <mutex>
 #include <NimBLEDevice.h>
 #include "BleInterfaces.h"
+#include "SubscriberIndex.h"
+#include "ScanPolicy.h"
 
 // Access to a globally available instance of BleScanner, created when first used
 // Note that BLESCANNER.initialize() has to be called somewhere
@@ -24,6 +27,12 @@ namespace BleScanner {
 
 class Scanner : public Publisher, BLEAdvertisedDeviceCallbacks {
   public:
+    struct Statistics {
+      uint32_t seen;        // advertisements received
+      uint32_t filtered;    // advertisements no subscriber was interested in
+      uint32_t dispatched;  // deliveries to subscribers
+    };
+
     Scanner(int reservedSubscribers = 10);
     ~Scanner() = default;
 
@@ -45,11 +54,33 @@ class Scanner : public Publisher, BLEAdvertisedDeviceCallbacks {
     void initialize(const std::string& deviceName = "blescanner", const bool wantDuplicates = true, const uint16_t interval = 23, const uint16_t window = 23);
 
     /**
-     * @brief starts the scan if not allready running, this should be called in loop() or a task;
+     * @brief dispatches the queued advertisements and starts the scan if not allready running, this should be called in loop() or a task;
      *
      */
     void update();
 
+    /**
+     * @brief Let the policy adapt the scan interval, the scan window of the policy replaces the one given to initialize()
+     *
+     * @param policy nullptr to keep the interval and window given to initialize()
+     */
+    void setScanPolicy(ScanPolicy* policy);
+
+    /**
+     * @brief Scan continuously for a while, e.g. after a command or when a device reported a change
+     */
+    void boostScanning();
+
+    /**
+     * @brief Share of the time spent scanning, in percent
+     */
+    uint8_t dutyCycle() const;
+
+    /**
+     * @brief Averaged gap in ms between two beacons of the slowest device tracked by the policy, 0 without policy
+     */
+    uint32_t detectionLatency() const;
+
     /**
      * @brief Set the Scan Duration
      *
@@ -79,11 +110,66 @@ class Scanner : public Publisher, BLEAdvertisedDeviceCallbacks {
     void unsubscribe(Subscriber* subscriber) override;
 
     /**
-     * @brief Forwards the scan result to the subcriber which has the onResult implemented
+     * @brief Subscribe to copies of the advertisements, delivered from update()
+     *
+     * @param subscriber
+     */
+    void subscribe(AdvertisementSubscriber* subscriber);
+
+    /**
+     * @brief Un-Subscribe from the copies of the advertisements
+     *
+     * @param subscriber
+     */
+    void unsubscribe(AdvertisementSubscriber* subscriber);
+
+    /**
+     * @brief Only forward the advertisements of this address (and of the other filters) to the subscriber
+     *
+     * @param subscriber
+     * @param bleAddress
+     */
+    void addAddressFilter(Subscriber* subscriber, const BLEAddress& bleAddress);
+    void addAddressFilter(AdvertisementSubscriber* subscriber, const BLEAddress& bleAddress);
+
+    /**
+     * @brief Only forward the advertisements with this manufacturer id (and of the other filters) to the subscriber
+     *
+     * @param subscriber
+     * @param manufacturerId company identifier, the first two bytes of the manufacturer data
+     */
+    void addManufacturerFilter(Subscriber* subscriber, uint16_t manufacturerId);
+    void addManufacturerFilter(AdvertisementSubscriber* subscriber, uint16_t manufacturerId);
+
+    /**
+     * @brief Removes the filters of the subscriber, it receives all advertisements again
+     *
+     * @param subscriber
+     */
+    void clearFilters(Subscriber* subscriber);
+    void clearFilters(AdvertisementSubscriber* subscriber);
+
+    /**
+     * @brief Forwards the scan result to the subcribers which have onResult implemented and queues a copy for
+     * the advertisement subscribers
      *
      * @param advertisedDevice
      */
     void onResult(const NimBLEAdvertisedDevice* advertisedDevice) override;
+
+    #ifdef BLESCANNER_USE_LATEST_NIMBLE
+    /**
+     * @brief Requests an update() so the scan is restarted
+     */
+    void onScanEnd(const NimBLEScanResults& scanResults, int reason) override;
+    #endif
+
+    /**
+     * @brief Called from the BLE host task when update() has work: an advertisement was queued or the scan ended
+     *
+     * @param notifier function waking the task that calls update(), nullptr to poll update()
+     */
+    void setUpdateNotifier(void (*notifier)());
     
     /**
      * @brief Whitelist a specific BLE Address
@@ -92,11 +178,37 @@ class Scanner : public Publisher, BLEAdvertisedDeviceCallbacks {
      */
     void whitelist(BLEAddress bleAddress);
 
+    /**
+     * @brief Number of advertisements dropped because the queue was full
+     */
+    uint32_t droppedAdvertisements() const;
+
+    /**
+     * @brief Highest number of advertisements waiting in the queue
+     */
+    size_t queueHighWater() const;
+
+    /**
+     * @brief Counters of the received, filtered and dispatched advertisements
+     */
+    Statistics statistics() const;
+
 
   private:
     uint32_t scanDuration = 0; //default indefinite scanning time
+    uint16_t scanInterval = 23;
+    uint16_t scanWindow = 23;
+    ScanPolicy* scanPolicy = nullptr;
+    void (*updateNotifier)() = nullptr;
     BLEScan* bleScan = nullptr;
-    std::vector<Subscriber*> subscribers;
+    // onResult runs in the BLE host task, subscriptions change from other tasks
+    mutable std::mutex subscribersMutex;
+    SubscriberIndex<Subscriber> subscribers;
+    SubscriberIndex<AdvertisementSubscriber> advertisementSubscribers;
+    AdvertisementQueue queue;
+    std::atomic<uint32_t> seenCount{0};
+    std::atomic<uint32_t> filteredCount{0};
+    std::atomic<uint32_t> dispatchedCount{0};
     uint16_t scanErrors = 0;
     bool scanningEnabled = true;
 };
@@ -0,0 +1,128 @@
+/**
+ * @file ScanPolicy.cpp
+ *
+ * Created: 2022
+ * License: GNU GENERAL PUBLIC LICENSE (see LICENSE)
+ *
+ * This library provides a BLE scanner to be used by other libraries to
+ * receive advertisements from BLE devices
+ *
+ */
+
+#include "ScanPolicy.h"
+
+namespace BleScanner {
+
+ScanPolicy::ScanPolicy(uint16_t window, uint16_t maxInterval, uint32_t boostDuration, uint32_t maxLatency)
+  : scanWindow(window),
+    maxInterval(maxInterval > window ? maxInterval : window),
+    boostDuration(boostDuration),
+    maxLatency(maxLatency),
+    currentInterval(window),
+    idleInterval(window) {
+}
+
+void ScanPolicy::track(uint64_t address) {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (size_t i = 0; i < trackedCount; ++i) {
+    if (tracked[i].address == address) {
+      return;
+    }
+  }
+  if (trackedCount == BLESCANNER_MAX_TRACKED) {
+    return;
+  }
+  tracked[trackedCount++] = {address, 0, 0, false};
+}
+
+void ScanPolicy::boost(uint32_t now) {
+  std::lock_guard<std::mutex> lock(mutex);
+  boostTs = now;
+  boostActive = true;
+}
+
+void ScanPolicy::received(uint64_t address, uint32_t now) {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (size_t i = 0; i < trackedCount; ++i) {
+    Tracked& device = tracked[i];
+    if (device.address != address) {
+      continue;
+    }
+
+    if (device.heard) {
+      uint32_t gap = now - device.lastTs;
+      device.latency = device.latency == 0 ? gap : (device.latency * 3 + gap) / 4;
+      if (!boosted(now)) {
+        if (gap > maxLatency) {
+          backOff(now);
+        } else if (device.latency * 2 < maxLatency && idleInterval < maxInterval) {
+          // heard well within the bound, give the radio back to Wi-Fi a step at a time
+          uint32_t next = idleInterval + scanWindow / 2;
+          idleInterval = next < maxInterval ? next : maxInterval;
+        }
+      }
+    }
+    device.lastTs = now;
+    device.heard = true;
+    return;
+  }
+}
+
+bool ScanPolicy::update(uint32_t now) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (boostActive && now - boostTs >= boostDuration) {
+    boostActive = false;
+  }
+
+  // a device silent for longer than the bound is missed, not gone quiet
+  for (size_t i = 0; i < trackedCount && !boostActive; ++i) {
+    const Tracked& device = tracked[i];
+    if (device.heard && now - device.lastTs > maxLatency && now - lastBackOffTs > maxLatency) {
+      backOff(now);
+    }
+  }
+
+  uint16_t interval = (trackedCount == 0 || boostActive) ? scanWindow : idleInterval;
+  if (interval == currentInterval) {
+    return false;
+  }
+  currentInterval = interval;
+  return true;
+}
+
+uint16_t ScanPolicy::window() const {
+  return scanWindow;
+}
+
+uint16_t ScanPolicy::interval() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return currentInterval;
+}
+
+uint8_t ScanPolicy::dutyCycle() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return (uint32_t)scanWindow * 100 / currentInterval;
+}
+
+uint32_t ScanPolicy::latency() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  uint32_t result = 0;
+  for (size_t i = 0; i < trackedCount; ++i) {
+    if (tracked[i].latency > result) {
+      result = tracked[i].latency;
+    }
+  }
+  return result;
+}
+
+void ScanPolicy::backOff(uint32_t now) {
+  uint16_t next = idleInterval / 2;
+  idleInterval = next > scanWindow ? next : scanWindow;
+  lastBackOffTs = now;
+}
+
+bool ScanPolicy::boosted(uint32_t now) const {
+  return boostActive && now - boostTs < boostDuration;
+}
+
+} // namespace BleScanner
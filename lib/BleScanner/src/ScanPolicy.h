@@ -0,0 +1,105 @@
+#pragma once
+
+/**
+ * @file ScanPolicy.h
+ *
+ * Created: 2022
+ * License: GNU GENERAL PUBLIC LICENSE (see LICENSE)
+ *
+ * This library provides a BLE scanner to be used by other libraries to
+ * receive advertisements from BLE devices
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <mutex>
+
+#ifndef BLESCANNER_MAX_TRACKED
+#define BLESCANNER_MAX_TRACKED 4
+#endif
+
+namespace BleScanner {
+
+/**
+ * @brief Adapts the scan interval to how fast the tracked devices have to be heard
+ *
+ * The scan window stays fixed, the interval between windows sets the duty cycle. After boost() (a command
+ * was sent or a beacon reported a change) the scanner scans continuously for the boost duration. When idle
+ * the interval is learned from the gaps between the beacons of the tracked devices: it grows while the
+ * devices are heard well within the latency bound and is halved as soon as a gap exceeds it or a device
+ * stays silent longer. Without tracked devices (e.g. while pairing) scanning is continuous.
+ *
+ * Time is passed in by the caller, thread safe.
+ */
+class ScanPolicy {
+  public:
+    /**
+     * @param window scan window in ms
+     * @param maxInterval longest interval in ms, bounds the lowest duty cycle
+     * @param boostDuration time in ms to scan continuously after boost()
+     * @param maxLatency longest accepted gap in ms between two beacons of a tracked device
+     */
+    ScanPolicy(uint16_t window, uint16_t maxInterval, uint32_t boostDuration, uint32_t maxLatency);
+
+    /**
+     * @brief Measure the beacon gaps of this device, at most BLESCANNER_MAX_TRACKED devices
+     */
+    void track(uint64_t address);
+
+    /**
+     * @brief Scan continuously for the boost duration
+     */
+    void boost(uint32_t now);
+
+    /**
+     * @brief An advertisement of address was received at now, ignored if the address is not tracked
+     */
+    void received(uint64_t address, uint32_t now);
+
+    /**
+     * @brief Re-evaluates the interval
+     *
+     * @return true if the interval changed and the scan has to be restarted
+     */
+    bool update(uint32_t now);
+
+    uint16_t window() const;
+    uint16_t interval() const;
+
+    /**
+     * @brief Share of the time spent scanning, in percent
+     */
+    uint8_t dutyCycle() const;
+
+    /**
+     * @brief Averaged gap in ms between two beacons of the slowest tracked device, 0 if not measured yet
+     */
+    uint32_t latency() const;
+
+  private:
+    struct Tracked {
+      uint64_t address;
+      uint32_t lastTs;
+      uint32_t latency;
+      bool heard;
+    };
+
+    void backOff(uint32_t now);
+    bool boosted(uint32_t now) const;
+
+    mutable std::mutex mutex;
+    const uint16_t scanWindow;
+    const uint16_t maxInterval;
+    const uint32_t boostDuration;
+    const uint32_t maxLatency;
+    Tracked tracked[BLESCANNER_MAX_TRACKED];
+    size_t trackedCount = 0;
+    uint16_t currentInterval;
+    uint16_t idleInterval;
+    uint32_t boostTs = 0;
+    bool boostActive = false;
+    uint32_t lastBackOffTs = 0;
+};
+
+} // namespace BleScanner
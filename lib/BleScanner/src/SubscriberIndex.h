@@ -0,0 +1,209 @@
+#pragma once
+
+/**
+ * @file SubscriberIndex.h
+ *
+ * Created: 2022
+ * License: GNU GENERAL PUBLIC LICENSE (see LICENSE)
+ *
+ * This library provides a BLE scanner to be used by other libraries to
+ * receive advertisements from BLE devices
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+
+#ifndef BLESCANNER_MAX_MATCHES
+#define BLESCANNER_MAX_MATCHES 16
+#endif
+
+namespace BleScanner {
+
+/**
+ * @brief Finds the subscribers interested in an advertisement by its address or manufacturer id
+ *
+ * A subscriber without filters receives every advertisement. Once it has filters, it only receives the
+ * advertisements from one of its addresses or with one of its manufacturer ids (the first two bytes of
+ * the manufacturer data). The filters are hashed into an open addressing table that is rebuilt when they
+ * change, a lookup costs a few probes however many devices are around.
+ *
+ * Not thread safe, the owner serializes access.
+ */
+template<typename T>
+class SubscriberIndex {
+  public:
+    /**
+     * @brief Registers a subscriber, it receives everything until it adds a filter
+     */
+    void add(T* subscriber) {
+      if (std::find(subscribers.begin(), subscribers.end(), subscriber) != subscribers.end()) {
+        return;
+      }
+      subscribers.push_back(subscriber);
+      rebuild();
+    }
+
+    /**
+     * @brief Unregisters a subscriber, its filters are kept for when it is added again
+     */
+    void remove(T* subscriber) {
+      auto it = std::find(subscribers.begin(), subscribers.end(), subscriber);
+      if (it != subscribers.end()) {
+        subscribers.erase(it);
+        rebuild();
+      }
+    }
+
+    void addAddress(T* subscriber, uint64_t address) {
+      addFilter(subscriber, address & ADDRESS_MASK);
+    }
+
+    void addManufacturer(T* subscriber, uint16_t manufacturerId) {
+      addFilter(subscriber, MANUFACTURER_KEY | manufacturerId);
+    }
+
+    /**
+     * @brief Removes the filters of a subscriber, it receives everything again
+     */
+    void clearFilters(T* subscriber) {
+      filters.erase(std::remove_if(filters.begin(), filters.end(), [subscriber](const Entry& entry) {
+        return entry.subscriber == subscriber;
+      }), filters.end());
+      rebuild();
+    }
+
+    bool empty() const {
+      return subscribers.empty();
+    }
+
+    /**
+     * @brief true if a match can depend on the manufacturer data, otherwise the address is enough
+     */
+    bool hasManufacturerFilters() const {
+      return manufacturerFilters > 0;
+    }
+
+    void reserve(size_t size) {
+      subscribers.reserve(size);
+    }
+
+    /**
+     * @brief Collects the subscribers interested in an advertisement, each one once
+     *
+     * @return the number of subscribers written to matches
+     */
+    size_t match(uint64_t address, const uint8_t* manufacturerData, size_t length, T** matches) const {
+      size_t count = 0;
+      for (size_t i = 0; i < unfiltered.size() && count < BLESCANNER_MAX_MATCHES; ++i) {
+        matches[count++] = unfiltered[i];
+      }
+      if (table.empty()) {
+        return count;
+      }
+
+      uint64_t addressKey = address & ADDRESS_MASK;
+      count = lookup(addressKey, nullptr, matches, count);
+      if (length >= 2) {
+        // a subscriber matching by address and manufacturer id is already in the list
+        uint64_t manufacturerKey = MANUFACTURER_KEY | manufacturerData[0] | (manufacturerData[1] << 8);
+        count = lookup(manufacturerKey, &addressKey, matches, count);
+      }
+      return count;
+    }
+
+  private:
+    struct Entry {
+      uint64_t key;
+      T* subscriber;
+    };
+
+    static const uint64_t ADDRESS_MASK = 0xFFFFFFFFFFFFULL;
+    static const uint64_t MANUFACTURER_KEY = 1ULL << 48;
+
+    void addFilter(T* subscriber, uint64_t key) {
+      for (const auto& entry : filters) {
+        if (entry.subscriber == subscriber && entry.key == key) {
+          return;
+        }
+      }
+      filters.push_back({key, subscriber});
+      rebuild();
+    }
+
+    bool registered(T* subscriber) const {
+      return std::find(subscribers.begin(), subscribers.end(), subscriber) != subscribers.end();
+    }
+
+    bool filtered(T* subscriber) const {
+      for (const auto& entry : filters) {
+        if (entry.subscriber == subscriber) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    size_t slot(uint64_t key) const {
+      return (key * 0x9E3779B97F4A7C15ULL) >> (64 - tableBits);
+    }
+
+    void rebuild() {
+      unfiltered.clear();
+      for (const auto& subscriber : subscribers) {
+        if (!filtered(subscriber)) {
+          unfiltered.push_back(subscriber);
+        }
+      }
+
+      // at most half full, probe sequences stay short
+      tableBits = 3;
+      while (((size_t)1 << tableBits) < filters.size() * 2) {
+        ++tableBits;
+      }
+      table.assign(filters.empty() ? 0 : (size_t)1 << tableBits, Entry{0, nullptr});
+      manufacturerFilters = 0;
+      for (const auto& entry : filters) {
+        if (!registered(entry.subscriber)) {
+          continue;
+        }
+        if (entry.key & MANUFACTURER_KEY) {
+          ++manufacturerFilters;
+        }
+        size_t i = slot(entry.key);
+        while (table[i].subscriber != nullptr) {
+          i = (i + 1) & (table.size() - 1);
+        }
+        table[i] = entry;
+      }
+    }
+
+    bool contains(uint64_t key, T* subscriber) const {
+      for (size_t i = slot(key); table[i].subscriber != nullptr; i = (i + 1) & (table.size() - 1)) {
+        if (table[i].key == key && table[i].subscriber == subscriber) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    size_t lookup(uint64_t key, const uint64_t* skipKey, T** matches, size_t count) const {
+      for (size_t i = slot(key); table[i].subscriber != nullptr && count < BLESCANNER_MAX_MATCHES; i = (i + 1) & (table.size() - 1)) {
+        if (table[i].key == key && (skipKey == nullptr || !contains(*skipKey, table[i].subscriber))) {
+          matches[count++] = table[i].subscriber;
+        }
+      }
+      return count;
+    }
+
+    std::vector<T*> subscribers;
+    std::vector<T*> unfiltered;
+    std::vector<Entry> filters;
+    std::vector<Entry> table;
+    int tableBits = 3;
+    size_t manufacturerFilters = 0;
+};
+
+} // namespace BleScanner
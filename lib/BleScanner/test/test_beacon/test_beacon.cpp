@@ -0,0 +1,83 @@
+#include <unity.h>
+
+#include <string.h>
+
+#include <Beacon.h>
+
+void setUp() {}
+void tearDown() {}
+
+// manufacturer data in the layout a Nuki Smart Lock advertises, bit 0 of the tx power is its "state changed" flag
+const uint8_t nukiBeacon[] = {
+  0x4C, 0x00, 0x02, 0x15,
+  0xA9, 0x2E, 0xE2, 0x00, 0x55, 0x01, 0x11, 0xE4, 0x91, 0x6C, 0x08, 0x00, 0x20, 0x0C, 0x9A, 0x66,
+  0x2A, 0x3B, 0x4C, 0x5D,
+  0xC4
+};
+
+const uint8_t nukiUuid[] = {
+  0xA9, 0x2E, 0xE2, 0x00, 0x55, 0x01, 0x11, 0xE4, 0x91, 0x6C, 0x08, 0x00, 0x20, 0x0C, 0x9A, 0x66
+};
+
+/*
+- uuid, major, minor and tx power are decoded
+- major and minor are big endian, tx power is signed
+*/
+void test_decode() {
+  BleScanner::Beacon beacon;
+  TEST_ASSERT_TRUE(BleScanner::decodeBeacon(nukiBeacon, sizeof(nukiBeacon), beacon));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(nukiUuid, beacon.uuid, sizeof(nukiUuid));
+  TEST_ASSERT_EQUAL_UINT16(0x2A3B, beacon.major);
+  TEST_ASSERT_EQUAL_UINT16(0x4C5D, beacon.minor);
+  TEST_ASSERT_EQUAL_INT8(-60, beacon.txPower);
+  TEST_ASSERT_EQUAL_INT8(0, beacon.txPower & 0x01);
+}
+
+/*
+- the flag in the lowest tx power bit is passed on unchanged
+*/
+void test_stateFlag() {
+  uint8_t data[sizeof(nukiBeacon)];
+  memcpy(data, nukiBeacon, sizeof(data));
+  data[24] = 0xC5;
+
+  BleScanner::Beacon beacon;
+  TEST_ASSERT_TRUE(BleScanner::decodeBeacon(data, sizeof(data), beacon));
+  TEST_ASSERT_EQUAL_INT8(-59, beacon.txPower);
+  TEST_ASSERT_EQUAL_INT8(1, beacon.txPower & 0x01);
+}
+
+/*
+- other manufacturers, beacon types and lengths are rejected
+*/
+void test_reject() {
+  BleScanner::Beacon beacon;
+  uint8_t data[sizeof(nukiBeacon) + 1];
+
+  TEST_ASSERT_FALSE(BleScanner::decodeBeacon(nullptr, 0, beacon));
+  TEST_ASSERT_FALSE(BleScanner::decodeBeacon(nukiBeacon, sizeof(nukiBeacon) - 1, beacon));
+
+  memcpy(data, nukiBeacon, sizeof(nukiBeacon));
+  data[sizeof(nukiBeacon)] = 0x00;
+  TEST_ASSERT_FALSE(BleScanner::decodeBeacon(data, sizeof(data), beacon));
+
+  memcpy(data, nukiBeacon, sizeof(nukiBeacon));
+  data[0] = 0x06;  // Microsoft
+  TEST_ASSERT_FALSE(BleScanner::decodeBeacon(data, sizeof(nukiBeacon), beacon));
+
+  memcpy(data, nukiBeacon, sizeof(nukiBeacon));
+  data[2] = 0x10;  // Apple "nearby" advertisement
+  TEST_ASSERT_FALSE(BleScanner::decodeBeacon(data, sizeof(nukiBeacon), beacon));
+
+  memcpy(data, nukiBeacon, sizeof(nukiBeacon));
+  data[3] = 0x14;
+  TEST_ASSERT_FALSE(BleScanner::decodeBeacon(data, sizeof(nukiBeacon), beacon));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_decode);
+  RUN_TEST(test_stateFlag);
+  RUN_TEST(test_reject);
+  return UNITY_END();
+}
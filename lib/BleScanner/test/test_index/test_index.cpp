@@ -0,0 +1,213 @@
+#include <unity.h>
+
+#include <stdio.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <SubscriberIndex.h>
+
+using BleScanner::SubscriberIndex;
+
+void setUp() {}
+void tearDown() {}
+
+// stand-in for a subscriber checking the address itself, like the beacon tracker does: it takes its lock
+// and gets a copy of the manufacturer data before it can tell the advertisement is not for it
+class Counter {
+ public:
+  Counter(uint64_t address = 0)
+  : address(address)
+  , received(0)
+  , accepted(0) {}
+  virtual ~Counter() = default;
+
+  virtual void onAdvertisement(uint64_t advertisementAddress, const uint8_t* data, size_t length) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string manufacturerData(reinterpret_cast<const char*>(data), length);
+    ++received;
+    if (advertisementAddress == address && !manufacturerData.empty()) {
+      ++accepted;
+    }
+  }
+
+  uint64_t address;
+  uint32_t received;
+  uint32_t accepted;
+
+ private:
+  std::mutex mutex;
+};
+
+const uint64_t lockAddress = 0x54D272AA0001ULL;
+const uint64_t openerAddress = 0x54D272AA0002ULL;
+const uint8_t appleData[] = {0x4C, 0x00, 0x02, 0x15};
+const uint8_t otherData[] = {0x59, 0x00, 0x01};
+
+size_t matchAddress(SubscriberIndex<Counter>& index, uint64_t address, Counter** matches) {
+  return index.match(address, otherData, sizeof(otherData), matches);
+}
+
+/*
+- a subscriber without filters receives everything
+- with an address filter, only the advertisements of that address
+*/
+void test_addressFilter() {
+  SubscriberIndex<Counter> index;
+  Counter lock(lockAddress);
+  Counter all;
+  Counter* matches[BLESCANNER_MAX_MATCHES];
+  index.add(&lock);
+  index.add(&all);
+
+  TEST_ASSERT_EQUAL_UINT32(2, matchAddress(index, 0x112233445566ULL, matches));
+
+  index.addAddress(&lock, lockAddress);
+  TEST_ASSERT_EQUAL_UINT32(1, matchAddress(index, 0x112233445566ULL, matches));
+  TEST_ASSERT_TRUE(matches[0] == &all);
+  TEST_ASSERT_EQUAL_UINT32(2, matchAddress(index, lockAddress, matches));
+
+  // the address type in the upper bits is ignored
+  TEST_ASSERT_EQUAL_UINT32(2, matchAddress(index, lockAddress | (1ULL << 48), matches));
+
+  index.remove(&all);
+  TEST_ASSERT_EQUAL_UINT32(0, matchAddress(index, openerAddress, matches));
+  TEST_ASSERT_EQUAL_UINT32(1, matchAddress(index, lockAddress, matches));
+  TEST_ASSERT_TRUE(matches[0] == &lock);
+
+  index.clearFilters(&lock);
+  TEST_ASSERT_EQUAL_UINT32(1, matchAddress(index, openerAddress, matches));
+}
+
+/*
+- manufacturer ids match on the first two bytes of the manufacturer data, little endian
+- a subscriber matching by address and manufacturer id is listed once
+- filters of a subscriber that is not registered are not matched
+*/
+void test_manufacturerFilter() {
+  SubscriberIndex<Counter> index;
+  Counter beacons;
+  Counter lock(lockAddress);
+  Counter opener(openerAddress);
+  Counter* matches[BLESCANNER_MAX_MATCHES];
+  index.add(&beacons);
+  index.add(&lock);
+  index.addManufacturer(&beacons, 0x004C);
+  index.addAddress(&lock, lockAddress);
+  index.addManufacturer(&lock, 0x004C);
+  index.addAddress(&opener, openerAddress);
+
+  TEST_ASSERT_EQUAL_UINT32(2, index.match(0x112233445566ULL, appleData, sizeof(appleData), matches));
+  TEST_ASSERT_TRUE(matches[0] != matches[1]);
+  TEST_ASSERT_EQUAL_UINT32(0, index.match(0x112233445566ULL, otherData, sizeof(otherData), matches));
+  TEST_ASSERT_EQUAL_UINT32(0, index.match(0x112233445566ULL, appleData, 1, matches));
+  TEST_ASSERT_TRUE(index.hasManufacturerFilters());
+
+  TEST_ASSERT_EQUAL_UINT32(2, index.match(lockAddress, appleData, sizeof(appleData), matches));
+  TEST_ASSERT_TRUE(matches[0] != matches[1]);
+
+  TEST_ASSERT_EQUAL_UINT32(0, index.match(openerAddress, otherData, sizeof(otherData), matches));
+  index.add(&opener);
+  TEST_ASSERT_EQUAL_UINT32(1, index.match(openerAddress, otherData, sizeof(otherData), matches));
+  TEST_ASSERT_TRUE(matches[0] == &opener);
+}
+
+/*
+- many filters grow the table, every address is still found
+*/
+void test_manyFilters() {
+  SubscriberIndex<Counter> index;
+  Counter counters[4];
+  Counter* matches[BLESCANNER_MAX_MATCHES];
+  for (int i = 0; i < 4; ++i) {
+    index.add(&counters[i]);
+    for (uint64_t address = 0; address < 100; ++address) {
+      index.addAddress(&counters[i], 0xC0FFEE000000ULL + address * 4 + i);
+    }
+  }
+  for (uint64_t address = 0; address < 400; ++address) {
+    TEST_ASSERT_EQUAL_UINT32(1, matchAddress(index, 0xC0FFEE000000ULL + address, matches));
+    TEST_ASSERT_TRUE(matches[0] == &counters[address % 4]);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, matchAddress(index, 0xC0FFEE000000ULL + 400, matches));
+}
+
+/*
+Benchmark: 1,000 distinct foreign addresses plus the lock and the opener, each advertising in turn.
+Fan-out calls both subscribers for every advertisement and lets them compare the address,
+the index only dispatches what they registered for.
+*/
+void test_dispatchBenchmark() {
+  const int rounds = 200;
+  std::vector<uint64_t> addresses;
+  for (uint64_t i = 0; i < 1000; ++i) {
+    addresses.push_back(0x7A0000000000ULL + i * 0x10001ULL);
+  }
+  addresses.push_back(lockAddress);
+  addresses.push_back(openerAddress);
+
+  // a full beacon, 25 bytes, the copy doesn't fit the small string buffer
+  uint8_t beaconData[25] = {0x4C, 0x00, 0x02, 0x15};
+
+  Counter fanOutLock(lockAddress);
+  Counter fanOutOpener(openerAddress);
+  std::vector<Counter*> subscribers = {&fanOutLock, &fanOutOpener};
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < rounds; ++round) {
+    for (uint64_t address : addresses) {
+      for (Counter* subscriber : subscribers) {
+        subscriber->onAdvertisement(address, beaconData, sizeof(beaconData));
+      }
+    }
+  }
+  double fanOutNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+  Counter indexedLock(lockAddress);
+  Counter indexedOpener(openerAddress);
+  SubscriberIndex<Counter> index;
+  index.add(&indexedLock);
+  index.add(&indexedOpener);
+  index.addAddress(&indexedLock, lockAddress);
+  index.addAddress(&indexedOpener, openerAddress);
+  Counter* matches[BLESCANNER_MAX_MATCHES];
+  uint32_t seen = 0;
+  uint32_t filtered = 0;
+  uint32_t dispatched = 0;
+  start = std::chrono::steady_clock::now();
+  for (int round = 0; round < rounds; ++round) {
+    for (uint64_t address : addresses) {
+      ++seen;
+      size_t count = index.match(address, beaconData, sizeof(beaconData), matches);
+      if (count == 0) {
+        ++filtered;
+      }
+      for (size_t i = 0; i < count; ++i) {
+        matches[i]->onAdvertisement(address, beaconData, sizeof(beaconData));
+      }
+      dispatched += count;
+    }
+  }
+  double indexedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+  printf("fan-out: %u calls, %.1f ns/advertisement\n", fanOutLock.received + fanOutOpener.received, fanOutNs / seen);
+  printf("indexed: %u seen, %u filtered, %u dispatched, %.1f ns/advertisement\n", seen, filtered, dispatched, indexedNs / seen);
+
+  TEST_ASSERT_EQUAL_UINT32(rounds * addresses.size(), seen);
+  TEST_ASSERT_EQUAL_UINT32(rounds * 1000, filtered);
+  TEST_ASSERT_EQUAL_UINT32(rounds * 2, dispatched);
+  TEST_ASSERT_EQUAL_UINT32(rounds, indexedLock.accepted);
+  TEST_ASSERT_EQUAL_UINT32(rounds, indexedLock.received);
+  TEST_ASSERT_EQUAL_UINT32(fanOutLock.accepted, indexedLock.accepted);
+  TEST_ASSERT_EQUAL_UINT32(fanOutOpener.accepted, indexedOpener.accepted);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_addressFilter);
+  RUN_TEST(test_manufacturerFilter);
+  RUN_TEST(test_manyFilters);
+  RUN_TEST(test_dispatchBenchmark);
+  return UNITY_END();
+}
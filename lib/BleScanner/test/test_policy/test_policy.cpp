@@ -0,0 +1,155 @@
+#include <unity.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <ScanPolicy.h>
+
+using BleScanner::ScanPolicy;
+
+void setUp() {}
+void tearDown() {}
+
+const uint64_t lockAddress = 0x54D272AA0001ULL;
+const uint16_t window = 40;
+const uint16_t maxInterval = 640;
+const uint32_t boostDuration = 30000;
+const uint32_t maxLatency = 3000;
+
+/*
+- continuous until a tracked device is heard
+- the interval grows while the beacons come in well within the bound
+- a boost scans continuously for the boost duration, then the learned interval is back
+*/
+void test_rampAndBoost() {
+  ScanPolicy policy(window, maxInterval, boostDuration, maxLatency);
+  TEST_ASSERT_FALSE(policy.update(0));
+  TEST_ASSERT_EQUAL_UINT8(100, policy.dutyCycle());
+
+  policy.track(lockAddress);
+  uint32_t now = 0;
+  for (int i = 0; i < 100; ++i) {
+    now += 500;
+    policy.received(lockAddress, now);
+    policy.received(0x112233445566ULL, now);  // not tracked
+  }
+  TEST_ASSERT_TRUE(policy.update(now));
+  TEST_ASSERT_EQUAL_UINT16(maxInterval, policy.interval());
+  TEST_ASSERT_EQUAL_UINT8(6, policy.dutyCycle());
+  TEST_ASSERT_EQUAL_UINT32(500, policy.latency());
+
+  policy.boost(now);
+  TEST_ASSERT_TRUE(policy.update(now));
+  TEST_ASSERT_EQUAL_UINT16(window, policy.interval());
+  uint32_t boostTs = now;
+  while (now < boostTs + boostDuration - 1) {
+    now += 500;
+    policy.received(lockAddress, now);
+  }
+  TEST_ASSERT_FALSE(policy.update(boostTs + boostDuration - 1));
+  TEST_ASSERT_TRUE(policy.update(boostTs + boostDuration));
+  TEST_ASSERT_EQUAL_UINT16(maxInterval, policy.interval());
+}
+
+/*
+- a gap over the bound halves the interval
+- so does a device that is not heard for longer than the bound, once per bound
+*/
+void test_backOff() {
+  ScanPolicy policy(window, maxInterval, boostDuration, maxLatency);
+  policy.track(lockAddress);
+  uint32_t now = 0;
+  for (int i = 0; i < 100; ++i) {
+    now += 500;
+    policy.received(lockAddress, now);
+  }
+  policy.update(now);
+  TEST_ASSERT_EQUAL_UINT16(maxInterval, policy.interval());
+
+  now += maxLatency + 1;
+  policy.received(lockAddress, now);
+  TEST_ASSERT_TRUE(policy.update(now));
+  TEST_ASSERT_EQUAL_UINT16(maxInterval / 2, policy.interval());
+
+  TEST_ASSERT_FALSE(policy.update(now + maxLatency));
+  TEST_ASSERT_TRUE(policy.update(now + maxLatency + 1));
+  TEST_ASSERT_EQUAL_UINT16(maxInterval / 4, policy.interval());
+  TEST_ASSERT_FALSE(policy.update(now + maxLatency + 2));
+  for (uint32_t t = now + maxLatency + 2; t < now + 20 * maxLatency; t += 20) {
+    policy.update(t);
+  }
+  TEST_ASSERT_EQUAL_UINT16(window, policy.interval());
+}
+
+/*
+Simulation of a lock advertising every 500 ms plus the random 0-10 ms delay of the BLE spec, over
+two hours with a state change every 10 minutes that is followed by a command. An advertisement is
+heard when it falls into a scan window, the task loop updates the policy every 20 ms.
+A window of 40 ms catches one advertisement in three at a duty cycle of about 33%, which is what
+keeps the gaps within the bound. Compared to continuous scanning the duty cycle drops by more than
+half and a state change is still detected within the bound.
+*/
+void test_simulation() {
+  ScanPolicy policy(window, maxInterval, boostDuration, maxLatency);
+  policy.track(lockAddress);
+  srand(1);
+
+  const uint32_t duration = 2 * 3600 * 1000;
+  const uint32_t changeInterval = 10 * 60 * 1000;
+  uint32_t nextAdvertisement = 137;
+  uint32_t scanStart = 0;
+  uint32_t scanTime = 0;
+  uint32_t pendingChange = 0;
+  bool changePending = false;
+  uint32_t changes = 0;
+  uint32_t worstDetection = 0;
+  uint32_t totalDetection = 0;
+
+  for (uint32_t now = 0; now < duration; ++now) {
+    bool scanning = (now - scanStart) % policy.interval() < policy.window();
+    if (scanning) {
+      ++scanTime;
+    }
+
+    if (now % changeInterval == changeInterval / 2) {
+      pendingChange = now;
+      changePending = true;
+    }
+
+    if (now == nextAdvertisement) {
+      nextAdvertisement += 500 + rand() % 11;
+      if (scanning) {
+        policy.received(lockAddress, now);
+        if (changePending) {
+          uint32_t detection = now - pendingChange;
+          worstDetection = detection > worstDetection ? detection : worstDetection;
+          totalDetection += detection;
+          ++changes;
+          changePending = false;
+          // the beacon reports a change, the lock state is queried
+          policy.boost(now);
+        }
+      }
+    }
+
+    if (now % 20 == 0 && policy.update(now)) {
+      scanStart = now;
+    }
+  }
+
+  uint32_t dutyCycle = (uint64_t)scanTime * 100 / duration;
+  printf("duty cycle %u%% (continuous 100%%), %u changes detected, average %u ms, worst %u ms, beacon gap %u ms\n",
+         dutyCycle, changes, totalDetection / changes, worstDetection, policy.latency());
+
+  TEST_ASSERT_EQUAL_UINT32(duration / changeInterval, changes);
+  TEST_ASSERT_LESS_OR_EQUAL(maxLatency, worstDetection);
+  TEST_ASSERT_LESS_THAN(50, dutyCycle);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_rampAndBoost);
+  RUN_TEST(test_backOff);
+  RUN_TEST(test_simulation);
+  return UNITY_END();
+}
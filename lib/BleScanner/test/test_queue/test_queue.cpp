@@ -0,0 +1,152 @@
+#include <unity.h>
+
+#include <string.h>
+
+#include <atomic>
+#include <thread>
+
+#include <AdvertisementQueue.h>
+
+using BleScanner::Advertisement;
+using BleScanner::AdvertisementQueue;
+
+void setUp() {}
+void tearDown() {}
+
+Advertisement makeAdvertisement(uint32_t sequence) {
+  Advertisement advertisement;
+  advertisement.address = 0x5479AB000000ULL + (sequence % 1000);
+  advertisement.timestamp = sequence;
+  advertisement.rssi = -40 - (sequence % 50);
+  advertisement.manufacturerDataLength = sequence % (BLESCANNER_MAX_MANUFACTURER_DATA + 1);
+  memset(advertisement.manufacturerData, sequence & 0xFF, sizeof(advertisement.manufacturerData));
+  return advertisement;
+}
+
+/*
+- advertisements come out in the order they were pushed, with all fields copied
+*/
+void test_fifo() {
+  AdvertisementQueue queue;
+  Advertisement advertisement;
+  TEST_ASSERT_FALSE(queue.pop(advertisement));
+
+  for (uint32_t i = 0; i < 10; ++i) {
+    TEST_ASSERT_TRUE(queue.push(makeAdvertisement(i)));
+  }
+  TEST_ASSERT_EQUAL_UINT32(10, queue.size());
+
+  for (uint32_t i = 0; i < 10; ++i) {
+    Advertisement expected = makeAdvertisement(i);
+    TEST_ASSERT_TRUE(queue.pop(advertisement));
+    TEST_ASSERT_TRUE(advertisement.address == expected.address);
+    TEST_ASSERT_EQUAL_UINT32(i, advertisement.timestamp);
+    TEST_ASSERT_EQUAL_INT8(expected.rssi, advertisement.rssi);
+    TEST_ASSERT_EQUAL_UINT8(expected.manufacturerDataLength, advertisement.manufacturerDataLength);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected.manufacturerData, advertisement.manufacturerData, sizeof(advertisement.manufacturerData));
+  }
+  TEST_ASSERT_FALSE(queue.pop(advertisement));
+  TEST_ASSERT_EQUAL_UINT32(0, queue.size());
+}
+
+/*
+- the indices wrap around the end of the buffer
+*/
+void test_wrap() {
+  AdvertisementQueue queue;
+  Advertisement advertisement;
+  uint32_t pushed = 0;
+  uint32_t popped = 0;
+
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < BLESCANNER_QUEUE_SIZE / 2 + 3; ++i) {
+      TEST_ASSERT_TRUE(queue.push(makeAdvertisement(pushed++)));
+    }
+    while (queue.pop(advertisement)) {
+      TEST_ASSERT_EQUAL_UINT32(popped++, advertisement.timestamp);
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT32(pushed, popped);
+  TEST_ASSERT_EQUAL_UINT32(0, queue.dropped());
+}
+
+/*
+- a full buffer drops the new advertisement and counts it
+- the high water mark tells how close the buffer got to full
+*/
+void test_overflow() {
+  AdvertisementQueue queue;
+  Advertisement advertisement;
+
+  for (uint32_t i = 0; i < 5; ++i) {
+    queue.push(makeAdvertisement(i));
+  }
+  queue.pop(advertisement);
+  TEST_ASSERT_EQUAL_UINT32(5, queue.highWater());
+
+  for (uint32_t i = 5; i < BLESCANNER_QUEUE_SIZE + 10; ++i) {
+    queue.push(makeAdvertisement(i));
+  }
+  TEST_ASSERT_EQUAL_UINT32(BLESCANNER_QUEUE_SIZE, queue.size());
+  TEST_ASSERT_EQUAL_UINT32(BLESCANNER_QUEUE_SIZE, queue.highWater());
+  TEST_ASSERT_EQUAL_UINT32(BLESCANNER_QUEUE_SIZE + 10 - 1 - BLESCANNER_QUEUE_SIZE, queue.dropped());
+
+  // the oldest are kept
+  TEST_ASSERT_TRUE(queue.pop(advertisement));
+  TEST_ASSERT_EQUAL_UINT32(1, advertisement.timestamp);
+}
+
+/*
+- a producer thread standing in for the BLE host task pushes at a high rate
+- the consumer sees every accepted advertisement once, in order and intact
+- accepted + dropped == injected
+*/
+void test_concurrent() {
+  static AdvertisementQueue queue;
+  const uint32_t injected = 200000;
+  std::atomic<bool> done(false);
+  uint32_t accepted = 0;
+
+  std::thread producer([&]() {
+    for (uint32_t i = 0; i < injected; ++i) {
+      if (queue.push(makeAdvertisement(i))) {
+        ++accepted;
+      }
+      if (i % 64 == 0) {
+        std::this_thread::yield();
+      }
+    }
+    done = true;
+  });
+
+  uint32_t received = 0;
+  int64_t last = -1;
+  bool intact = true;
+  Advertisement advertisement;
+  while (!done || queue.size() > 0) {
+    while (queue.pop(advertisement)) {
+      Advertisement expected = makeAdvertisement(advertisement.timestamp);
+      intact = intact && (int64_t)advertisement.timestamp > last &&
+               advertisement.address == expected.address &&
+               advertisement.manufacturerDataLength == expected.manufacturerDataLength &&
+               memcmp(advertisement.manufacturerData, expected.manufacturerData, sizeof(expected.manufacturerData)) == 0;
+      last = advertisement.timestamp;
+      ++received;
+    }
+  }
+  producer.join();
+
+  TEST_ASSERT_TRUE(intact);
+  TEST_ASSERT_EQUAL_UINT32(accepted, received);
+  TEST_ASSERT_EQUAL_UINT32(injected, received + queue.dropped());
+  TEST_ASSERT_LESS_OR_EQUAL(BLESCANNER_QUEUE_SIZE, queue.highWater());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_fifo);
+  RUN_TEST(test_wrap);
+  RUN_TEST(test_overflow);
+  RUN_TEST(test_concurrent);
+  return UNITY_END();
+}
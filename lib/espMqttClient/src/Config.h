@@ -73,3 +73,53 @@ the LICENSE file.
     #define EMC_SIZE_POOL_ELEMENTS 128
   #endif
 #endif
+
+// maximum number of queued packets per priority class, 0 is unlimited
+#ifndef EMC_QUEUE_LIMIT_CONTROL
+#define EMC_QUEUE_LIMIT_CONTROL 0
+#endif
+#ifndef EMC_QUEUE_LIMIT_STATE
+#define EMC_QUEUE_LIMIT_STATE 0
+#endif
+#ifndef EMC_QUEUE_LIMIT_BULK
+#define EMC_QUEUE_LIMIT_BULK 64
+#endif
+#ifndef EMC_QUEUE_LIMIT_LOG
+#define EMC_QUEUE_LIMIT_LOG 16
+#endif
+
+// MessageAssembler: number of messages that can be collected at once and the largest message
+#ifndef EMC_ASSEMBLER_BUFFERS
+#define EMC_ASSEMBLER_BUFFERS 2
+#endif
+#ifndef EMC_ASSEMBLER_MAX_SIZE
+#define EMC_ASSEMBLER_MAX_SIZE 4096
+#endif
+
+// PublishJournal: maximum size on storage, size of the RAM write buffer and the time (ms) after which it is written
+#ifndef EMC_JOURNAL_MAX_SIZE
+#define EMC_JOURNAL_MAX_SIZE 16384
+#endif
+#ifndef EMC_JOURNAL_BUFFER_SIZE
+#define EMC_JOURNAL_BUFFER_SIZE 512
+#endif
+#ifndef EMC_JOURNAL_FLUSH_INTERVAL
+#define EMC_JOURNAL_FLUSH_INTERVAL 5000
+#endif
+
+#ifndef EMC_USE_SLAB
+#define EMC_USE_SLAB 0
+#endif
+
+#if EMC_USE_SLAB && EMC_USE_MEMPOOL
+  #error "EMC_USE_SLAB and EMC_USE_MEMPOOL are mutually exclusive"
+#endif
+
+// block sizes in ascending order and the number of blocks per size
+// A Home Assistant discovery burst queues about 50 retained configs of 300-700 bytes at once
+#ifndef EMC_SLAB_BLOCK_SIZES
+#define EMC_SLAB_BLOCK_SIZES 32, 64, 128, 256, 512, 768, EMC_TX_BUFFER_SIZE + 96
+#endif
+#ifndef EMC_SLAB_BLOCK_COUNTS
+#define EMC_SLAB_BLOCK_COUNTS 32, 32, 48, 16, 48, 8, 2
+#endif
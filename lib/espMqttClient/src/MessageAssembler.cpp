@@ -0,0 +1,128 @@
+/*
+Copyright (c) 2022 Bert Melis. All rights reserved.
+
+This work is licensed under the terms of the MIT license.
+For a copy, see <https://opensource.org/licenses/MIT> or
+the LICENSE file.
+*/
+
+#include <stdlib.h>  // malloc, free
+#include <string.h>  // memcpy, strcmp, strncpy
+
+#include "MessageAssembler.h"
+#include "Logging.h"
+
+MessageAssembler::MessageAssembler(OnAssembledCallback callback, size_t maxSize)
+: _callback(callback)
+, _maxSize(maxSize)
+, _slots{}
+, _assembled(0)
+, _dropped(0) {
+  // empty
+}
+
+MessageAssembler::~MessageAssembler() {
+  for (size_t i = 0; i < EMC_ASSEMBLER_BUFFERS; ++i) {
+    free(_slots[i].data);
+  }
+}
+
+void MessageAssembler::feed(const espMqttClientTypes::MessageProperties& properties, const char* topic, const uint8_t* payload, size_t len, size_t index, size_t total) {
+  // single fragment: the client's receive buffer already holds a null-terminated payload
+  if (index == 0 && len == total) {
+    if (!_callback) return;
+    if (total == 0) {
+      _callback(properties, topic, "", 0);
+    } else {
+      _callback(properties, topic, reinterpret_cast<const char*>(payload), len);
+    }
+    return;
+  }
+
+  Slot* slot = nullptr;
+  if (index == 0) {
+    if (total > _maxSize) {
+      emc_log_w("Message too large to assemble: %zu > %zu", total, _maxSize);
+      _dropped++;
+      return;
+    }
+    slot = _find(topic, properties.packetId, total);  // retransmission of an incomplete message
+    if (!slot) slot = _acquire(total);
+    if (!slot) {
+      emc_log_w("No buffer to assemble message (l:%zu)", total);
+      _dropped++;
+      return;
+    }
+    strncpy(slot->topic, topic, EMC_MAX_TOPIC_LENGTH);
+    slot->topic[EMC_MAX_TOPIC_LENGTH] = '\0';
+    slot->packetId = properties.packetId;
+    slot->total = total;
+    slot->received = 0;
+    slot->inUse = true;
+  } else {
+    // no slot: the first fragment was already dropped
+    slot = _find(topic, properties.packetId, total);
+    if (!slot) return;
+    if (slot->received != index) {
+      emc_log_w("Missing fragment, expected index %zu, got %zu", slot->received, index);
+      slot->inUse = false;
+      _dropped++;
+      return;
+    }
+  }
+
+  memcpy(&slot->data[slot->received], payload, len);
+  slot->received += len;
+  if (slot->received == slot->total) {
+    slot->data[slot->total] = '\0';
+    slot->inUse = false;
+    _assembled++;
+    if (_callback) _callback(properties, slot->topic, slot->data, slot->total);
+  }
+}
+
+void MessageAssembler::reset() {
+  for (size_t i = 0; i < EMC_ASSEMBLER_BUFFERS; ++i) {
+    if (_slots[i].inUse) {
+      _slots[i].inUse = false;
+      _dropped++;
+    }
+  }
+}
+
+uint32_t MessageAssembler::assembled() const {
+  return _assembled;
+}
+
+uint32_t MessageAssembler::dropped() const {
+  return _dropped;
+}
+
+MessageAssembler::Slot* MessageAssembler::_find(const char* topic, uint16_t packetId, size_t total) {
+  for (size_t i = 0; i < EMC_ASSEMBLER_BUFFERS; ++i) {
+    Slot* slot = &_slots[i];
+    if (slot->inUse && slot->packetId == packetId && slot->total == total && strncmp(slot->topic, topic, EMC_MAX_TOPIC_LENGTH) == 0) {
+      return slot;
+    }
+  }
+  return nullptr;
+}
+
+MessageAssembler::Slot* MessageAssembler::_acquire(size_t total) {
+  // prefer a free slot that is already large enough, otherwise grow the smallest free one
+  Slot* candidate = nullptr;
+  for (size_t i = 0; i < EMC_ASSEMBLER_BUFFERS; ++i) {
+    Slot* slot = &_slots[i];
+    if (slot->inUse) continue;
+    if (slot->capacity > total) return slot;
+    if (!candidate || slot->capacity < candidate->capacity) candidate = slot;
+  }
+  if (!candidate) return nullptr;
+
+  char* data = reinterpret_cast<char*>(malloc(total + 1));
+  if (!data) return nullptr;
+  free(candidate->data);
+  candidate->data = data;
+  candidate->capacity = total + 1;
+  return candidate;
+}
@@ -0,0 +1,63 @@
+/*
+Copyright (c) 2022 Bert Melis. All rights reserved.
+
+This work is licensed under the terms of the MIT license.
+For a copy, see <https://opensource.org/licenses/MIT> or
+the LICENSE file.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+
+#include "Config.h"
+#include "TypeDefs.h"
+
+/**
+ * @brief Reassembles incoming PUBLISH payloads that the client hands out in fragments
+ *
+ * Feed it every call of the onMessage callback. Complete messages are passed on as one
+ * contiguous, null-terminated payload. Messages that arrive in a single fragment are passed
+ * on without copying: MqttClient places a null byte after every fragment it delivers.
+ * Fragmented messages are collected in a small pool of buffers that are kept for reuse.
+ */
+
+class MessageAssembler {
+ public:
+  typedef std::function<void(const espMqttClientTypes::MessageProperties& properties, const char* topic, const char* payload, size_t length)> OnAssembledCallback;
+
+  explicit MessageAssembler(OnAssembledCallback callback, size_t maxSize = EMC_ASSEMBLER_MAX_SIZE);
+  ~MessageAssembler();
+
+  // no copy nor move
+  MessageAssembler(const MessageAssembler&) = delete;
+  MessageAssembler& operator=(const MessageAssembler&) = delete;
+
+  void feed(const espMqttClientTypes::MessageProperties& properties, const char* topic, const uint8_t* payload, size_t len, size_t index, size_t total);
+  void reset();  // drop incomplete messages, eg. on disconnect
+
+  uint32_t assembled() const;  // fragmented messages that were delivered
+  uint32_t dropped() const;    // messages that were too large, had missing fragments or found no free buffer
+
+ private:
+  struct Slot {
+    char* data;
+    size_t capacity;
+    size_t received;
+    size_t total;
+    uint16_t packetId;
+    char topic[EMC_MAX_TOPIC_LENGTH + 1];
+    bool inUse;
+  };
+
+  Slot* _find(const char* topic, uint16_t packetId, size_t total);
+  Slot* _acquire(size_t total);
+
+  OnAssembledCallback _callback;
+  size_t _maxSize;
+  Slot _slots[EMC_ASSEMBLER_BUFFERS];
+  uint32_t _assembled;
+  uint32_t _dropped;
+};
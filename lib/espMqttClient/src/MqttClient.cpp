@@ -12,6 +12,7 @@ using espMqttClientInternals::Packet;
 using espMqttClientInternals::PacketType;
 using espMqttClientTypes::DisconnectReason;
 using espMqttClientTypes::Error;
+using espMqttClientTypes::Priority;
 
 MqttClient::MqttClient(espMqttClientTypes::UseInternalTask useInternalTask, uint8_t priority, uint8_t core)
 : _useInternalTask(useInternalTask)
@@ -38,6 +39,7 @@ MqttClient::MqttClient(espMqttClientTypes::UseInternalTask useInternalTask, uint
 , _willQos(0)
 , _willRetain(false)
 , _timeout(EMC_TX_TIMEOUT)
+, _queueLimits{EMC_QUEUE_LIMIT_CONTROL, EMC_QUEUE_LIMIT_STATE, EMC_QUEUE_LIMIT_BULK, EMC_QUEUE_LIMIT_LOG}
 , _state(State::disconnected)
 , _generatedClientId{0}
 , _packetId(0)
@@ -53,6 +55,7 @@ MqttClient::MqttClient(espMqttClientTypes::UseInternalTask useInternalTask, uint
 , _lastServerActivity(0)
 , _pingSent(false)
 , _disconnectReason(DisconnectReason::TCP_DISCONNECTED)
+, _droppedPackets{0}
 #if defined(ARDUINO_ARCH_ESP32) && ARDUHAL_LOG_LEVEL >= ARDUHAL_LOG_LEVEL_INFO
 , _highWaterMark(4294967295)
 #endif
@@ -140,7 +143,27 @@ bool MqttClient::disconnect(bool force) {
   return false;
 }
 
-uint16_t MqttClient::publish(const char* topic, uint8_t qos, bool retain, const uint8_t* payload, size_t length) {
+uint16_t MqttClient::subscribe(const char* const* topics, size_t numberTopics, uint8_t qos) {
+  uint16_t packetId = 0;
+  if (_state != State::connected) {
+    return packetId;
+  }
+  // the SUBACK carries one return code per topic and has to fit in the payload buffer
+  if (numberTopics == 0 || numberTopics > EMC_PAYLOAD_BUFFER_SIZE) {
+    emc_log_e("Invalid number of topics for SUBSCRIBE: %zu", numberTopics);
+    return packetId;
+  }
+  EMC_SEMAPHORE_TAKE();
+  packetId = _getNextPacketId();
+  if (!_addPacket(packetId, topics, numberTopics, qos)) {
+    emc_log_e("Could not create SUBSCRIBE packet");
+    packetId = 0;
+  }
+  EMC_SEMAPHORE_GIVE();
+  return packetId;
+}
+
+uint16_t MqttClient::publish(const char* topic, uint8_t qos, bool retain, const uint8_t* payload, size_t length, Priority priority) {
   #if !EMC_ALLOW_NOT_CONNECTED_PUBLISH
   if (_state != State::connected) {
   #else
@@ -149,8 +172,14 @@ uint16_t MqttClient::publish(const char* topic, uint8_t qos, bool retain, const
     return 0;
   }
   EMC_SEMAPHORE_TAKE();
+  if (_queueFull(priority)) {
+    emc_log_w("Queue limit reached, dropping PUBLISH (%s)", espMqttClientTypes::priorityToString(priority));
+    EMC_SEMAPHORE_GIVE();
+    _onError(0, Error::QUEUE_FULL);
+    return 0;
+  }
   uint16_t packetId = (qos > 0) ? _getNextPacketId() : 1;
-  if (!_addPacket(packetId, topic, payload, length, qos, retain)) {
+  if (!_insertPacket(priority, packetId, topic, payload, length, qos, retain)) {
     emc_log_e("Could not create PUBLISH packet");
     EMC_SEMAPHORE_GIVE();
     _onError(packetId, Error::OUT_OF_MEMORY);
@@ -161,12 +190,12 @@ uint16_t MqttClient::publish(const char* topic, uint8_t qos, bool retain, const
   return packetId;
 }
 
-uint16_t MqttClient::publish(const char* topic, uint8_t qos, bool retain, const char* payload) {
+uint16_t MqttClient::publish(const char* topic, uint8_t qos, bool retain, const char* payload, Priority priority) {
   size_t len = strlen(payload);
-  return publish(topic, qos, retain, reinterpret_cast<const uint8_t*>(payload), len);
+  return publish(topic, qos, retain, reinterpret_cast<const uint8_t*>(payload), len, priority);
 }
 
-uint16_t MqttClient::publish(const char* topic, uint8_t qos, bool retain, espMqttClientTypes::PayloadCallback callback, size_t length) {
+uint16_t MqttClient::publish(const char* topic, uint8_t qos, bool retain, espMqttClientTypes::PayloadCallback callback, size_t length, Priority priority) {
   #if !EMC_ALLOW_NOT_CONNECTED_PUBLISH
   if (_state != State::connected) {
   #else
@@ -175,8 +204,14 @@ uint16_t MqttClient::publish(const char* topic, uint8_t qos, bool retain, espMqt
     return 0;
   }
   EMC_SEMAPHORE_TAKE();
+  if (_queueFull(priority)) {
+    emc_log_w("Queue limit reached, dropping PUBLISH (%s)", espMqttClientTypes::priorityToString(priority));
+    EMC_SEMAPHORE_GIVE();
+    _onError(0, Error::QUEUE_FULL);
+    return 0;
+  }
   uint16_t packetId = (qos > 0) ? _getNextPacketId() : 1;
-  if (!_addPacket(packetId, topic, callback, length, qos, retain)) {
+  if (!_insertPacket(priority, packetId, topic, callback, length, qos, retain)) {
     emc_log_e("Could not create PUBLISH packet");
     EMC_SEMAPHORE_GIVE();
     _onError(packetId, Error::OUT_OF_MEMORY);
@@ -205,6 +240,22 @@ size_t MqttClient::queueSize() {
   return ret;
 }
 
+size_t MqttClient::queueSize(Priority priority) {
+  size_t ret = 0;
+  EMC_SEMAPHORE_TAKE();
+  espMqttClientInternals::Outbox<OutgoingPacket>::Iterator it = _outbox.front();
+  while (it) {
+    if (it.get()->priority == priority) ++ret;
+    ++it;
+  }
+  EMC_SEMAPHORE_GIVE();
+  return ret;
+}
+
+uint32_t MqttClient::droppedPackets(Priority priority) const {
+  return _droppedPackets[static_cast<uint8_t>(priority)];
+}
+
 void MqttClient::loop() {
   switch (_state) {
     case State::disconnected:
@@ -342,6 +393,21 @@ uint16_t MqttClient::_getNextPacketId() {
   return _packetId;
 }
 
+bool MqttClient::_queueFull(Priority priority) {
+  size_t limit = _queueLimits[static_cast<uint8_t>(priority)];
+  if (limit == 0) return false;
+  size_t count = 0;
+  espMqttClientInternals::Outbox<OutgoingPacket>::Iterator it = _outbox.front();
+  while (it) {
+    if (it.get()->priority == priority && ++count >= limit) {
+      ++_droppedPackets[static_cast<uint8_t>(priority)];
+      return true;
+    }
+    ++it;
+  }
+  return false;
+}
+
 void MqttClient::_checkOutbox() {
   while (_sendPacket() > 0) {
     if (!_advanceOutbox()) {
@@ -539,6 +605,15 @@ void MqttClient::_onPublish() {
     }
   }
   if (callback && _onMessageCallback) {
+    // null-terminate the fragment in the receive buffer so it can be used as a c-string without copying,
+    // the byte may already belong to the next packet so it is restored afterwards
+    uint8_t* end = nullptr;
+    uint8_t saved = 0;
+    if (p.payload.length > 0) {
+      end = const_cast<uint8_t*>(p.payload.data) + p.payload.length;  // points into _rxBuffer
+      saved = *end;
+      *end = 0x00;
+    }
     EMC_SEMAPHORE_GIVE();
     _onMessageCallback({qos, dup, retain, packetId},
                        p.variableHeader.topic,
@@ -547,6 +622,7 @@ void MqttClient::_onPublish() {
                        p.payload.index,
                        p.payload.total);
     EMC_SEMAPHORE_TAKE();
+    if (end) *end = saved;
   }
 }
 
@@ -718,6 +794,8 @@ void MqttClient::_clearQueue(int clearData) {
       if (type == PacketType.PUBREC ||
           type == PacketType.PUBREL ||
          (type == PacketType.PUBLISH && it.get()->packet.packetId() != 0)) {
+        // nothing has been sent on the next connection yet, so packets may be overtaken again
+        it.get()->timeSent = 0;
         ++it;
       } else {
         _outbox.remove(it);
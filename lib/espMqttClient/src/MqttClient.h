@@ -46,6 +46,7 @@ class MqttClient {
     }
     return packetId;
   }
+  uint16_t subscribe(const char* const* topics, size_t numberTopics, uint8_t qos);
   template <typename... Args>
   uint16_t unsubscribe(const char* topic, Args&&... args) {
     uint16_t packetId = 0;
@@ -62,12 +63,17 @@ class MqttClient {
     }
     return packetId;
   }
-  uint16_t publish(const char* topic, uint8_t qos, bool retain, const uint8_t* payload, size_t length);
-  uint16_t publish(const char* topic, uint8_t qos, bool retain, const char* payload);
-  uint16_t publish(const char* topic, uint8_t qos, bool retain, espMqttClientTypes::PayloadCallback callback, size_t length);
+  uint16_t publish(const char* topic, uint8_t qos, bool retain, const uint8_t* payload, size_t length,
+                   espMqttClientTypes::Priority priority = espMqttClientTypes::Priority::STATE);
+  uint16_t publish(const char* topic, uint8_t qos, bool retain, const char* payload,
+                   espMqttClientTypes::Priority priority = espMqttClientTypes::Priority::STATE);
+  uint16_t publish(const char* topic, uint8_t qos, bool retain, espMqttClientTypes::PayloadCallback callback, size_t length,
+                   espMqttClientTypes::Priority priority = espMqttClientTypes::Priority::STATE);
   void clearQueue(bool deleteSessionData = false);  // Not MQTT compliant and may cause unpredictable results when `deleteSessionData` = true!
   const char* getClientId() const;
   size_t queueSize();  // No const because of mutex
+  size_t queueSize(espMqttClientTypes::Priority priority);
+  uint32_t droppedPackets(espMqttClientTypes::Priority priority) const;  // publishes refused because the queue limit was reached
   void loop();
 
  protected:
@@ -98,6 +104,7 @@ class MqttClient {
   uint8_t _willQos;
   bool _willRetain;
   uint32_t _timeout;
+  size_t _queueLimits[4];  // per priority, 0 is unlimited
 
   // state is protected to allow state changes by the transport system, defined in child classes
   // eg. to allow AsyncTCP
@@ -129,13 +136,15 @@ class MqttClient {
   std::mutex mtx;
 #endif
 
-  uint8_t _rxBuffer[EMC_RX_BUFFER_SIZE];
+  uint8_t _rxBuffer[EMC_RX_BUFFER_SIZE + 1];  // + 1 for the null byte placed after a payload fragment
   struct OutgoingPacket {
     uint32_t timeSent;
+    espMqttClientTypes::Priority priority;
     espMqttClientInternals::Packet packet;
     template <typename... Args>
-    OutgoingPacket(uint32_t t, espMqttClientTypes::Error& error, Args&&... args) :  // NOLINT(runtime/references)
+    OutgoingPacket(uint32_t t, espMqttClientTypes::Priority p, espMqttClientTypes::Error& error, Args&&... args) :  // NOLINT(runtime/references)
       timeSent(t),
+      priority(p),
       packet(error, std::forward<Args>(args) ...) {}
   };
   espMqttClientInternals::Outbox<OutgoingPacket> _outbox;
@@ -145,13 +154,25 @@ class MqttClient {
   uint32_t _lastServerActivity;
   bool _pingSent;
   espMqttClientTypes::DisconnectReason _disconnectReason;
+  uint32_t _droppedPackets[4];
 
   uint16_t _getNextPacketId();
+  bool _queueFull(espMqttClientTypes::Priority priority);
 
+  // protocol packets are queued as control packets
   template <typename... Args>
   bool _addPacket(Args&&... args) {
+    return _insertPacket(espMqttClientTypes::Priority::CONTROL, std::forward<Args>(args) ...);
+  }
+
+  // queue in front of unsent packets with lower priority, packets that have been sent are never overtaken
+  // so they keep being acknowledged in order
+  template <typename... Args>
+  bool _insertPacket(espMqttClientTypes::Priority priority, Args&&... args) {
     espMqttClientTypes::Error error(espMqttClientTypes::Error::SUCCESS);
-    espMqttClientInternals::Outbox<OutgoingPacket>::Iterator it = _outbox.emplace(0, error, std::forward<Args>(args) ...);
+    espMqttClientInternals::Outbox<OutgoingPacket>::Iterator it = _outbox.emplaceBefore([priority](const OutgoingPacket& p) {
+      return p.timeSent == 0 && p.priority > priority;
+    }, 0, priority, error, std::forward<Args>(args) ...);
     if (it && error == espMqttClientTypes::Error::SUCCESS) {
       return true;
     } else {
@@ -163,7 +184,7 @@ class MqttClient {
   template <typename... Args>
   bool _addPacketFront(Args&&... args) {
     espMqttClientTypes::Error error(espMqttClientTypes::Error::SUCCESS);
-    espMqttClientInternals::Outbox<OutgoingPacket>::Iterator it = _outbox.emplaceFront(0, error, std::forward<Args>(args) ...);
+    espMqttClientInternals::Outbox<OutgoingPacket>::Iterator it = _outbox.emplaceFront(0, espMqttClientTypes::Priority::CONTROL, error, std::forward<Args>(args) ...);
     if (it && error == espMqttClientTypes::Error::SUCCESS) {
       return true;
     } else {
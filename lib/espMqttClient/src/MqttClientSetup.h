@@ -59,6 +59,12 @@ class MqttClientSetup : public MqttClient {
     return setWill(topic, qos, retain, reinterpret_cast<const uint8_t*>(payload), strlen(payload));
   }
 
+  // 0 means unlimited
+  T& setQueueLimit(espMqttClientTypes::Priority priority, size_t limit) {
+    _queueLimits[static_cast<uint8_t>(priority)] = limit;
+    return static_cast<T&>(*this);
+  }
+
   T& setServer(IPAddress ip, uint16_t port) {
     _ip = ip;
     _port = port;
@@ -12,6 +12,8 @@ the LICENSE file.
 #if EMC_USE_MEMPOOL
   #include "MemoryPool/src/MemoryPool.h"
   #include "Config.h"
+#elif EMC_USE_SLAB
+  #include "SlabAllocator.h"
 #else
   #include <new>  // new (std::nothrow)
 #endif
@@ -22,7 +24,8 @@ namespace espMqttClientInternals {
 /**
  * @brief Singly linked queue with builtin non-invalidating forward iterator
  * 
- * Queue items can only be emplaced, at front and back of the queue.
+ * Queue items can only be emplaced, at front and back of the queue
+ * or in front of a matching item that is not yet current.
  * Remove items using an iterator or the builtin iterator.
  */
 
@@ -44,6 +47,9 @@ class Outbox {
       #if EMC_USE_MEMPOOL
       _first->~Node();
       _memPool.free(_first);
+      #elif EMC_USE_SLAB
+      _first->~Node();
+      SlabAllocator::instance().free(_first);
       #else
       delete _first;
       #endif
@@ -93,15 +99,7 @@ class Outbox {
   template <class... Args>
   Iterator emplace(Args&&... args) {
     Iterator it;
-    #if EMC_USE_MEMPOOL
-    void* buf = _memPool.malloc();
-    Node* node = nullptr;
-    if (buf) {
-      node = new(buf) Node(std::forward<Args>(args) ...);
-    }
-    #else
-    Node* node = new(std::nothrow) Node(std::forward<Args>(args) ...);
-    #endif
+    Node* node = _createNode(std::forward<Args>(args) ...);
     if (node != nullptr) {
       if (!_first) {
         // queue is empty
@@ -125,15 +123,7 @@ class Outbox {
   template <class... Args>
   Iterator emplaceFront(Args&&... args) {
     Iterator it;
-    #if EMC_USE_MEMPOOL
-    void* buf = _memPool.malloc();
-    Node* node = nullptr;
-    if (buf) {
-      node = new(buf) Node(std::forward<Args>(args) ...);
-    }
-    #else
-    Node* node = new(std::nothrow) Node(std::forward<Args>(args) ...);
-    #endif
+    Node* node = _createNode(std::forward<Args>(args) ...);
     if (node != nullptr) {
       if (!_first) {
         // queue is empty
@@ -149,6 +139,37 @@ class Outbox {
     return it;
   }
 
+  // add node before the first node from current onwards for which pred returns true,
+  // add to back if there is none. Current points to newly created if inserted before current.
+  template <class Pred, class... Args>
+  Iterator emplaceBefore(Pred pred, Args&&... args) {
+    Node* prev = (_current == _first) ? nullptr : _prev;
+    Node* n = _current;
+    while (n && !pred(n->data)) {
+      prev = n;
+      n = n->next;
+    }
+    if (!n) {
+      return emplace(std::forward<Args>(args) ...);
+    }
+    Iterator it;
+    Node* node = _createNode(std::forward<Args>(args) ...);
+    if (node != nullptr) {
+      node->next = n;
+      if (prev) {
+        prev->next = node;
+      } else {
+        _first = node;
+      }
+      if (_current == n) {
+        _current = node;
+      }
+      it._node = node;
+      it._prev = prev;
+    }
+    return it;
+  }
+
   // remove node at iterator, iterator points to next
   void remove(Iterator& it) {  // NOLINT(runtime/references)
     if (!it) return;
@@ -171,6 +192,7 @@ class Outbox {
 
   void resetCurrent() {
     _current = _first;
+    _prev = nullptr;
   }
 
   Iterator front() const {
@@ -212,6 +234,26 @@ class Outbox {
   MemoryPool::Fixed<EMC_NUM_POOL_ELEMENTS, sizeof(Node)> _memPool;
   #endif
 
+  template <class... Args>
+  Node* _createNode(Args&&... args) {
+    #if EMC_USE_MEMPOOL
+    void* buf = _memPool.malloc();
+    Node* node = nullptr;
+    if (buf) {
+      node = new(buf) Node(std::forward<Args>(args) ...);
+    }
+    #elif EMC_USE_SLAB
+    void* buf = SlabAllocator::instance().malloc(sizeof(Node));
+    Node* node = nullptr;
+    if (buf) {
+      node = new(buf) Node(std::forward<Args>(args) ...);
+    }
+    #else
+    Node* node = new(std::nothrow) Node(std::forward<Args>(args) ...);
+    #endif
+    return node;
+  }
+
   void _remove(Node* prev, Node* node) {
     if (!node) return;
 
@@ -246,6 +288,9 @@ class Outbox {
       #if EMC_USE_MEMPOOL
       node->~Node();
       _memPool.free(node);
+      #elif EMC_USE_SLAB
+      node->~Node();
+      SlabAllocator::instance().free(node);
       #else
       delete node;
       #endif
@@ -17,6 +17,8 @@ MemoryPool::Variable<EMC_NUM_POOL_ELEMENTS, EMC_SIZE_POOL_ELEMENTS> Packet::_mem
 Packet::~Packet() {
   #if EMC_USE_MEMPOOL
   _memPool.free(_data);
+  #elif EMC_USE_SLAB
+  SlabAllocator::instance().free(_data);
   #else
   free(_data);
   #endif
@@ -223,7 +225,7 @@ Packet::Packet(espMqttClientTypes::Error& error,
     _packetId = 0;
   }
 
-  if (!_allocate(remainingLength - payloadLength + std::min(payloadLength, static_cast<size_t>(EMC_RX_BUFFER_SIZE)), true)) {
+  if (!_allocate(remainingLength - payloadLength + std::min(payloadLength, static_cast<size_t>(EMC_TX_BUFFER_SIZE)), true)) {
     error = espMqttClientTypes::Error::OUT_OF_MEMORY;
     return;
   }
@@ -251,6 +253,17 @@ Packet::Packet(espMqttClientTypes::Error& error, uint16_t packetId, const char*
   _createSubscribe(error, list, 1);
 }
 
+Packet::Packet(espMqttClientTypes::Error& error, uint16_t packetId, const char* const* topics, size_t numberTopics, uint8_t qos)
+: _packetId(packetId)
+, _data(nullptr)
+, _size(0)
+, _payloadIndex(0)
+, _payloadStartIndex(0)
+, _payloadEndIndex(0)
+, _getPayload(nullptr) {
+  _createSubscribe(error, topics, numberTopics, qos);
+}
+
 Packet::Packet(espMqttClientTypes::Error& error, MQTTPacketType type, uint16_t packetId)
 : _packetId(packetId)
 , _data(nullptr)
@@ -309,7 +322,8 @@ Packet::Packet(espMqttClientTypes::Error& error, MQTTPacketType type)
 
 
 bool Packet::_allocate(size_t remainingLength, bool check) {
-  #if EMC_USE_MEMPOOL
+  #if EMC_USE_MEMPOOL || EMC_USE_SLAB
+  // the slab applies the check to its heap fallback
   (void) check;
   #else
   if (check && EMC_GET_FREE_MEMORY() < EMC_MIN_FREE_MEMORY) {
@@ -320,6 +334,8 @@ bool Packet::_allocate(size_t remainingLength, bool check) {
   _size = 1 + remainingLengthLength(remainingLength) + remainingLength;
   #if EMC_USE_MEMPOOL
   _data = reinterpret_cast<uint8_t*>(_memPool.malloc(_size));
+  #elif EMC_USE_SLAB
+  _data = reinterpret_cast<uint8_t*>(SlabAllocator::instance().malloc(_size, check));
   #else
   _data = reinterpret_cast<uint8_t*>(malloc(_size));
   #endif
@@ -392,6 +408,42 @@ void Packet::_createSubscribe(espMqttClientTypes::Error& error,
   error = espMqttClientTypes::Error::SUCCESS;
 }
 
+void Packet::_createSubscribe(espMqttClientTypes::Error& error,
+                              const char* const* topics,
+                              size_t numberTopics,
+                              uint8_t qos) {
+  if (numberTopics == 0) {
+    error = espMqttClientTypes::Error::MALFORMED_PARAMETER;
+    return;
+  }
+
+  // Calculate size
+  size_t payload = 0;
+  for (size_t i = 0; i < numberTopics; ++i) {
+    payload += 2 + strlen(topics[i]) + 1;  // length bytes, string, qos
+  }
+  size_t remainingLength = 2 + payload;  // packetId + payload
+
+  // allocate memory
+  if (!_allocate(remainingLength, true)) {
+    error = espMqttClientTypes::Error::OUT_OF_MEMORY;
+    return;
+  }
+
+  // serialize
+  size_t pos = 0;
+  _data[pos++] = PacketType.SUBSCRIBE | HeaderFlag.SUBSCRIBE_RESERVED;
+  pos += encodeRemainingLength(remainingLength, &_data[pos]);
+  _data[pos++] = _packetId >> 8;
+  _data[pos++] = _packetId & 0xFF;
+  for (size_t i = 0; i < numberTopics; ++i) {
+    pos += encodeString(topics[i], &_data[pos]);
+    _data[pos++] = qos;
+  }
+
+  error = espMqttClientTypes::Error::SUCCESS;
+}
+
 void Packet::_createUnsubscribe(espMqttClientTypes::Error& error,
                                 const char** list,
                                 size_t numberTopics) {
@@ -425,17 +477,18 @@ size_t Packet::_chunkedAvailable(size_t index) {
   // index vs size check done in 'available(index)'
 
   // index points to header or first payload byte
+  // the callback is always given the offset within the payload, not within the packet
   if (index < _payloadIndex) {
     if (_size > _payloadIndex && _payloadEndIndex != 0) {
-      size_t copied = _getPayload(&_data[_payloadIndex], std::min(static_cast<size_t>(EMC_TX_BUFFER_SIZE), _size - _payloadStartIndex), index);
       _payloadStartIndex = _payloadIndex;
+      size_t copied = _getPayload(&_data[_payloadIndex], std::min(static_cast<size_t>(EMC_TX_BUFFER_SIZE), _size - _payloadStartIndex), 0);
       _payloadEndIndex = _payloadStartIndex + copied - 1;
     }
 
   // index points to payload unavailable
   } else if (index > _payloadEndIndex || _payloadStartIndex > index) {
     _payloadStartIndex = index;
-    size_t copied = _getPayload(&_data[_payloadIndex], std::min(static_cast<size_t>(EMC_TX_BUFFER_SIZE), _size - _payloadStartIndex), index);
+    size_t copied = _getPayload(&_data[_payloadIndex], std::min(static_cast<size_t>(EMC_TX_BUFFER_SIZE), _size - _payloadStartIndex), _payloadStartIndex - _payloadIndex);
     _payloadEndIndex = _payloadStartIndex + copied - 1;
   }
 
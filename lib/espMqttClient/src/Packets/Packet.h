@@ -21,6 +21,8 @@ the LICENSE file.
 
 #if EMC_USE_MEMPOOL
   #include "MemoryPool/src/MemoryPool.h"
+#elif EMC_USE_SLAB
+  #include "../SlabAllocator.h"
 #endif
 
 namespace espMqttClientInternals {
@@ -106,6 +108,12 @@ class Packet {
     SubscribeItem list[numberTopics] = {topic1, qos1, topic2, qos2, args...};
     _createSubscribe(error, list, numberTopics);
   }
+  // SUBSCRIBE with a runtime list of topics, all at the same QoS
+  Packet(espMqttClientTypes::Error& error,  // NOLINT(runtime/references)
+         uint16_t packetId,
+         const char* const* topics,
+         size_t numberTopics,
+         uint8_t qos);
   // UNSUBSCRIBE
   Packet(espMqttClientTypes::Error& error,  // NOLINT(runtime/references)
          uint16_t packetId,
@@ -148,6 +156,10 @@ class Packet {
   void _createSubscribe(espMqttClientTypes::Error& error,  // NOLINT(runtime/references)
                         SubscribeItem* list,
                         size_t numberTopics);
+  void _createSubscribe(espMqttClientTypes::Error& error,  // NOLINT(runtime/references)
+                        const char* const* topics,
+                        size_t numberTopics,
+                        uint8_t qos);
   void _createUnsubscribe(espMqttClientTypes::Error& error,  // NOLINT(runtime/references)
                           const char** list,
                           size_t numberTopics);
@@ -0,0 +1,359 @@
+/*
+Copyright (c) 2022 Bert Melis. All rights reserved.
+
+This work is licensed under the terms of the MIT license.
+For a copy, see <https://opensource.org/licenses/MIT> or
+the LICENSE file.
+*/
+
+#include <stdio.h>  // snprintf
+#include <stdlib.h>  // malloc, free
+#include <string.h>  // memcpy, strlen, strncpy
+
+#include "PublishJournal.h"
+#include "Logging.h"
+
+/*
+Record layout, multi-byte fields big endian:
+  magic (1) | flags (1): retain bit 0, qos bits 1-2 | topic length (2) | payload length (2) | crc32 (4) | topic | payload
+The CRC covers everything after itself plus the flags and length fields.
+*/
+
+namespace {
+
+const uint8_t JOURNAL_MAGIC = 0xE5;
+
+uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= data[i];
+    for (uint8_t bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return crc;
+}
+
+}  // end namespace
+
+PublishJournal::PublishJournal(Storage* storage, size_t maxSize, size_t bufferSize, uint32_t flushInterval)
+: _storage(storage)
+, _maxSize(maxSize)
+, _bufferSize(bufferSize < maxSize ? bufferSize : maxSize)
+, _flushInterval(flushInterval)
+, _buffer(nullptr)
+, _buffered(0)
+, _bufferedRecords(0)
+, _bufferedSince(0)
+, _bufferTimed(false)
+, _stored(0)
+, _storedRecords(0)
+, _dropped(0)
+, _writes(0)
+, _corrupt(0) {
+  // empty
+}
+
+PublishJournal::~PublishJournal() {
+  free(_buffer);
+}
+
+bool PublishJournal::begin() {
+  if (!_storage->begin()) return false;
+  if (!_buffer) {
+    _buffer = reinterpret_cast<uint8_t*>(malloc(_bufferSize));
+    if (!_buffer) return false;
+  }
+
+  // walk the records, everything after the last valid one is the remainder of an interrupted write
+  size_t size = _storage->size();
+  size_t offset = 0;
+  size_t records = 0;
+  Header header;
+  while (_readHeader(offset, &header)) {
+    size_t recordSize = HEADER_SIZE + header.topicLength + header.payloadLength;
+    if (offset + recordSize > size || !_validRecord(offset, header)) break;
+    offset += recordSize;
+    records++;
+  }
+  if (offset < size) {
+    emc_log_w("Journal: cutting %zu invalid bytes at %zu", size - offset, offset);
+    _corrupt++;
+    if (!_storage->keep(0, offset)) return false;
+  }
+  _stored = offset;
+  _storedRecords = records;
+  return true;
+}
+
+bool PublishJournal::append(const char* topic, const uint8_t* payload, size_t length, uint8_t qos, bool retain) {
+  size_t topicLength = strlen(topic);
+  size_t recordSize = HEADER_SIZE + topicLength + length;
+  if (!_buffer || topicLength > 0xFFFF || length > 0xFFFF || recordSize > _maxSize) return false;
+
+  uint8_t* record = nullptr;
+  if (recordSize > _bufferSize - _buffered) {
+    if (!flush()) return false;
+  }
+  if (recordSize > _bufferSize) {
+    // larger than the write buffer: written on its own
+    record = reinterpret_cast<uint8_t*>(malloc(recordSize));
+    if (!record) return false;
+  } else {
+    record = &_buffer[_buffered];
+  }
+
+  uint8_t flags = (retain ? 0x01 : 0x00) | ((qos & 0x03) << 1);
+  record[0] = JOURNAL_MAGIC;
+  record[1] = flags;
+  record[2] = topicLength >> 8;
+  record[3] = topicLength & 0xFF;
+  record[4] = length >> 8;
+  record[5] = length & 0xFF;
+  memcpy(&record[HEADER_SIZE], topic, topicLength);
+  if (length > 0) memcpy(&record[HEADER_SIZE + topicLength], payload, length);
+  uint32_t crc = crc32Update(0xFFFFFFFF, &record[1], 5);
+  crc = crc32Update(crc, &record[HEADER_SIZE], topicLength + length) ^ 0xFFFFFFFF;
+  record[6] = crc >> 24;
+  record[7] = (crc >> 16) & 0xFF;
+  record[8] = (crc >> 8) & 0xFF;
+  record[9] = crc & 0xFF;
+
+  if (record != &_buffer[_buffered]) {
+    bool result = _write(record, recordSize);
+    if (result) _storedRecords++;
+    free(record);
+    return result;
+  }
+  _buffered += recordSize;
+  _bufferedRecords++;
+  return true;
+}
+
+void PublishJournal::loop(uint32_t now) {
+  if (_buffered == 0) return;
+  if (!_bufferTimed) {
+    _bufferedSince = now;
+    _bufferTimed = true;
+  } else if (now - _bufferedSince >= _flushInterval) {
+    flush();
+  }
+}
+
+bool PublishJournal::flush() {
+  if (_buffered == 0) return true;
+  if (!_write(_buffer, _buffered)) return false;
+  _storedRecords += _bufferedRecords;
+  _buffered = 0;
+  _bufferedRecords = 0;
+  _bufferTimed = false;
+  return true;
+}
+
+size_t PublishJournal::replay(ReplayCallback callback) {
+  flush();
+
+  size_t offset = 0;
+  size_t replayed = 0;
+  bool invalid = false;
+  Header header;
+  while (offset < _stored) {
+    if (!_readHeader(offset, &header) || !_validRecord(offset, header)) {
+      emc_log_w("Journal: invalid record at %zu, dropping the remainder", offset);
+      _corrupt++;
+      _storedRecords = replayed;
+      _stored = offset;
+      invalid = true;
+      break;
+    }
+    size_t dataLength = header.topicLength + header.payloadLength;
+    uint8_t* data = reinterpret_cast<uint8_t*>(malloc(dataLength + 2));
+    if (!data) break;
+    _storage->read(offset + HEADER_SIZE, data, header.topicLength);
+    data[header.topicLength] = 0x00;  // topic and payload are null-terminated
+    uint8_t* payload = &data[header.topicLength + 1];
+    _storage->read(offset + HEADER_SIZE + header.topicLength, payload, header.payloadLength);
+    payload[header.payloadLength] = 0x00;
+    bool accepted = callback(reinterpret_cast<const char*>(data), payload, header.payloadLength, (header.flags >> 1) & 0x03, header.flags & 0x01);
+    free(data);
+    if (!accepted) break;
+    offset += HEADER_SIZE + dataLength;
+    replayed++;
+  }
+
+  if (offset > 0 || invalid) {
+    if (_storage->keep(offset, _stored - offset)) {
+      _stored -= offset;
+      _storedRecords -= replayed;
+    } else {
+      // the records stay and will be sent again, QoS 1 allows duplicates
+      emc_log_e("Journal: could not remove replayed records");
+    }
+  }
+  return replayed;
+}
+
+size_t PublishJournal::records() const {
+  return _storedRecords + _bufferedRecords;
+}
+
+bool PublishJournal::empty() const {
+  return _storedRecords == 0 && _bufferedRecords == 0;
+}
+
+uint32_t PublishJournal::dropped() const {
+  return _dropped;
+}
+
+uint32_t PublishJournal::writes() const {
+  return _writes;
+}
+
+uint32_t PublishJournal::corrupt() const {
+  return _corrupt;
+}
+
+bool PublishJournal::_readHeader(size_t offset, Header* header) {
+  uint8_t data[HEADER_SIZE];
+  if (_storage->read(offset, data, HEADER_SIZE) != HEADER_SIZE || data[0] != JOURNAL_MAGIC) return false;
+  header->flags = data[1];
+  header->topicLength = (data[2] << 8) | data[3];
+  header->payloadLength = (data[4] << 8) | data[5];
+  header->crc = (static_cast<uint32_t>(data[6]) << 24) | (static_cast<uint32_t>(data[7]) << 16) | (data[8] << 8) | data[9];
+  return true;
+}
+
+bool PublishJournal::_validRecord(size_t offset, const Header& header) {
+  uint8_t data[64];
+  data[0] = header.flags;
+  data[1] = header.topicLength >> 8;
+  data[2] = header.topicLength & 0xFF;
+  data[3] = header.payloadLength >> 8;
+  data[4] = header.payloadLength & 0xFF;
+  uint32_t crc = crc32Update(0xFFFFFFFF, data, 5);
+  size_t remaining = header.topicLength + header.payloadLength;
+  offset += HEADER_SIZE;
+  while (remaining > 0) {
+    size_t chunk = remaining < sizeof(data) ? remaining : sizeof(data);
+    if (_storage->read(offset, data, chunk) != chunk) return false;
+    crc = crc32Update(crc, data, chunk);
+    offset += chunk;
+    remaining -= chunk;
+  }
+  return (crc ^ 0xFFFFFFFF) == header.crc;
+}
+
+bool PublishJournal::_trim(size_t extra) {
+  if (_stored + extra <= _maxSize) return true;
+
+  // drop the oldest records until the new data fits
+  size_t offset = 0;
+  size_t records = 0;
+  Header header;
+  while (offset < _stored && _stored - offset + extra > _maxSize && _readHeader(offset, &header)) {
+    offset += HEADER_SIZE + header.topicLength + header.payloadLength;
+    records++;
+  }
+  if (offset > _stored) offset = _stored;
+  if (_stored - offset + extra > _maxSize) offset = _stored;  // unreadable header, start over
+  if (!_storage->keep(offset, _stored - offset)) return false;
+  emc_log_w("Journal full, dropped %zu records", records);
+  _dropped += records;
+  _stored -= offset;
+  _storedRecords = records > _storedRecords ? 0 : _storedRecords - records;
+  return true;
+}
+
+bool PublishJournal::_write(const uint8_t* data, size_t len) {
+  if (!_trim(len)) return false;
+  _writes++;
+  if (!_storage->append(data, len)) {
+    // part of the data may have been written, resync with what is on storage
+    emc_log_e("Journal: write failed");
+    _storage->keep(0, _stored);
+    return false;
+  }
+  _stored += len;
+  return true;
+}
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+FSJournalStorage::FSJournalStorage(fs::FS& fs, const char* path)
+: _fs(fs)
+, _path{0}
+, _tmpPath{0} {
+  strncpy(_path, path, sizeof(_path) - 1);
+  snprintf(_tmpPath, sizeof(_tmpPath), "%s.tmp", _path);
+}
+
+bool FSJournalStorage::begin() {
+  // keep() replaces the journal by a copy, finish an interrupted replacement
+  if (_fs.exists(_tmpPath)) {
+    if (_fs.exists(_path)) {
+      _fs.remove(_tmpPath);
+    } else {
+      return _fs.rename(_tmpPath, _path);
+    }
+  }
+  return true;
+}
+
+size_t FSJournalStorage::size() {
+  if (!_fs.exists(_path)) return 0;
+  File file = _fs.open(_path, FILE_READ);
+  if (!file) return 0;
+  size_t size = file.size();
+  file.close();
+  return size;
+}
+
+size_t FSJournalStorage::read(size_t offset, uint8_t* buf, size_t len) {
+  if (!_fs.exists(_path)) return 0;
+  File file = _fs.open(_path, FILE_READ);
+  if (!file) return 0;
+  size_t result = 0;
+  if (file.seek(offset)) {
+    result = file.read(buf, len);
+  }
+  file.close();
+  return result;
+}
+
+bool FSJournalStorage::append(const uint8_t* buf, size_t len) {
+  File file = _fs.open(_path, FILE_APPEND);
+  if (!file) return false;
+  size_t written = file.write(buf, len);
+  file.close();
+  return written == len;
+}
+
+bool FSJournalStorage::keep(size_t offset, size_t len) {
+  if (len == 0) {
+    return !_fs.exists(_path) || _fs.remove(_path);
+  }
+  File src = _fs.open(_path, FILE_READ);
+  File dst = _fs.open(_tmpPath, FILE_WRITE);
+  if (!src || !dst || !src.seek(offset)) {
+    src.close();
+    dst.close();
+    _fs.remove(_tmpPath);
+    return false;
+  }
+  uint8_t chunk[128];
+  size_t remaining = len;
+  while (remaining > 0) {
+    size_t n = src.read(chunk, remaining < sizeof(chunk) ? remaining : sizeof(chunk));
+    if (n == 0 || dst.write(chunk, n) != n) break;
+    remaining -= n;
+  }
+  src.close();
+  dst.close();
+  if (remaining > 0) {
+    _fs.remove(_tmpPath);
+    return false;
+  }
+  _fs.remove(_path);
+  return _fs.rename(_tmpPath, _path);
+}
+
+#endif
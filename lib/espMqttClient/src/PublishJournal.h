@@ -0,0 +1,115 @@
+/*
+Copyright (c) 2022 Bert Melis. All rights reserved.
+
+This work is licensed under the terms of the MIT license.
+For a copy, see <https://opensource.org/licenses/MIT> or
+the LICENSE file.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+
+#include "Config.h"
+
+/**
+ * @brief Append-only journal that keeps PUBLISH messages on flash until they can be sent
+ *
+ * Records are buffered in RAM and written to storage in batches to limit flash wear.
+ * Every record carries a CRC; on begin() a torn record at the end of the journal
+ * (power loss during a write) is cut off. When the journal exceeds its maximum size,
+ * the oldest records are dropped. replay() hands out the records in the order
+ * they were appended and removes the ones that were accepted.
+ *
+ * The journal is not thread safe.
+ */
+
+class PublishJournal {
+ public:
+  // backing store of the journal, a single file on ESP32 (see FSJournalStorage)
+  class Storage {
+   public:
+    virtual ~Storage() {}
+    virtual bool begin() { return true; }
+    virtual size_t size() = 0;
+    virtual size_t read(size_t offset, uint8_t* buf, size_t len) = 0;
+    virtual bool append(const uint8_t* buf, size_t len) = 0;
+    virtual bool keep(size_t offset, size_t len) = 0;  // discard everything outside [offset, offset + len)
+  };
+
+  // return false to stop replaying, the record and all following are kept
+  typedef std::function<bool(const char* topic, const uint8_t* payload, size_t length, uint8_t qos, bool retain)> ReplayCallback;
+
+  explicit PublishJournal(Storage* storage,
+                          size_t maxSize = EMC_JOURNAL_MAX_SIZE,
+                          size_t bufferSize = EMC_JOURNAL_BUFFER_SIZE,
+                          uint32_t flushInterval = EMC_JOURNAL_FLUSH_INTERVAL);
+  ~PublishJournal();
+
+  // no copy nor move
+  PublishJournal(const PublishJournal&) = delete;
+  PublishJournal& operator=(const PublishJournal&) = delete;
+
+  bool begin();
+  bool append(const char* topic, const uint8_t* payload, size_t length, uint8_t qos, bool retain);
+  void loop(uint32_t now);  // writes the buffer once it is older than flushInterval
+  bool flush();
+  size_t replay(ReplayCallback callback);
+
+  size_t records() const;
+  bool empty() const;
+  uint32_t dropped() const;  // records discarded to stay within the maximum size
+  uint32_t writes() const;   // batches written to storage
+  uint32_t corrupt() const;  // invalid or torn records that were cut off
+
+ private:
+  struct Header {
+    uint8_t flags;
+    uint16_t topicLength;
+    uint16_t payloadLength;
+    uint32_t crc;
+  };
+  static const size_t HEADER_SIZE = 10;
+
+  bool _readHeader(size_t offset, Header* header);
+  bool _validRecord(size_t offset, const Header& header);
+  bool _trim(size_t extra);
+  bool _write(const uint8_t* data, size_t len);
+
+  Storage* _storage;
+  size_t _maxSize;
+  size_t _bufferSize;
+  uint32_t _flushInterval;
+  uint8_t* _buffer;
+  size_t _buffered;
+  size_t _bufferedRecords;
+  uint32_t _bufferedSince;
+  bool _bufferTimed;
+  size_t _stored;
+  size_t _storedRecords;
+  uint32_t _dropped;
+  uint32_t _writes;
+  uint32_t _corrupt;
+};
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <FS.h>
+
+// journal in a single file on SPIFFS, LittleFS, ...
+class FSJournalStorage : public PublishJournal::Storage {
+ public:
+  FSJournalStorage(fs::FS& fs, const char* path);
+  bool begin() override;
+  size_t size() override;
+  size_t read(size_t offset, uint8_t* buf, size_t len) override;
+  bool append(const uint8_t* buf, size_t len) override;
+  bool keep(size_t offset, size_t len) override;
+
+ private:
+  fs::FS& _fs;
+  char _path[32];
+  char _tmpPath[36];
+};
+#endif
@@ -0,0 +1,187 @@
+/*
+Copyright (c) 2022 Bert Melis. All rights reserved.
+
+This work is licensed under the terms of the MIT license.
+For a copy, see <https://opensource.org/licenses/MIT> or
+the LICENSE file.
+*/
+
+#include <cstdlib>  // malloc, free
+#include <new>  // new (std::nothrow)
+
+#include "SlabAllocator.h"
+#include "Helpers.h"
+#include "Logging.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+  #include "esp_heap_caps.h"
+#endif
+
+namespace espMqttClientInternals {
+
+namespace {
+
+// blocks are aligned to the largest fundamental alignment so nodes can be placed in them
+constexpr size_t slabAlignment = alignof(std::max_align_t);
+
+size_t alignBlockSize(size_t size) {
+  if (size < sizeof(unsigned char*)) size = sizeof(unsigned char*);
+  return (size + slabAlignment - 1) & ~(slabAlignment - 1);
+}
+
+// The region is never freed. On ESP32 it is only placed in PSRAM: without PSRAM it would
+// permanently take its full size from the internal heap, the allocator then uses the heap only.
+void* allocateRegion(size_t size) {
+  #if defined(ARDUINO_ARCH_ESP32)
+    #if defined(CONFIG_SOC_SPIRAM_SUPPORTED)
+    return heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    #else
+    (void) size;
+    return nullptr;
+    #endif
+  #else
+  return std::malloc(size);
+  #endif
+}
+
+}  // end namespace
+
+SlabAllocator::SlabAllocator(const size_t* blockSizes, const size_t* blockCounts, size_t numClasses)
+: _classes(nullptr)
+, _numClasses(0)
+, _region(nullptr)
+, _regionEnd(nullptr)
+, _heapFallbacks(0)
+, _failures(0) {
+  _classes = new(std::nothrow) SizeClass[numClasses];
+  if (!_classes) {
+    emc_log_e("Slab classes not allocated");
+    return;
+  }
+
+  size_t regionSize = 0;
+  for (size_t i = 0; i < numClasses; ++i) {
+    regionSize += alignBlockSize(blockSizes[i]) * blockCounts[i];
+  }
+  _region = reinterpret_cast<unsigned char*>(allocateRegion(regionSize));
+  if (!_region) {
+    emc_log_w("Slab region not allocated (l:%zu), using the heap", regionSize);
+    delete[] _classes;
+    _classes = nullptr;
+    return;
+  }
+  _regionEnd = _region + regionSize;
+  _numClasses = numClasses;
+
+  // classes are laid out in configuration order, blocks of a class are chained into its free list
+  unsigned char* b = _region;
+  for (size_t i = 0; i < numClasses; ++i) {
+    SizeClass& sizeClass = _classes[i];
+    size_t blockSize = alignBlockSize(blockSizes[i]);
+    sizeClass.start = b;
+    sizeClass.head = blockCounts[i] > 0 ? b : nullptr;
+    sizeClass.stats = {blockSize, blockCounts[i], 0, 0, 0};
+    for (size_t j = 0; j < blockCounts[i]; ++j) {
+      *reinterpret_cast<unsigned char**>(b) = (j < blockCounts[i] - 1) ? b + blockSize : nullptr;
+      b += blockSize;
+    }
+  }
+  emc_log_i("Slab region allocated (l:%zu)", regionSize);
+}
+
+SlabAllocator::~SlabAllocator() {
+  std::free(_region);
+  delete[] _classes;
+}
+
+SlabAllocator& SlabAllocator::instance() {
+  static const size_t blockSizes[] = {EMC_SLAB_BLOCK_SIZES};
+  static const size_t blockCounts[] = {EMC_SLAB_BLOCK_COUNTS};
+  static_assert(sizeof(blockSizes) == sizeof(blockCounts), "EMC_SLAB_BLOCK_SIZES and EMC_SLAB_BLOCK_COUNTS differ in length");
+  static SlabAllocator allocator(blockSizes, blockCounts, sizeof(blockSizes) / sizeof(blockSizes[0]));
+  return allocator;
+}
+
+void* SlabAllocator::malloc(size_t size, bool check) {
+  if (size == 0) return nullptr;
+  {
+    #if _GLIBCXX_HAS_GTHREADS
+    const std::lock_guard<std::mutex> lockGuard(_mutex);
+    #endif
+    // classes are expected in ascending block size
+    bool spilled = false;
+    for (size_t i = 0; i < _numClasses; ++i) {
+      SizeClass& sizeClass = _classes[i];
+      if (sizeClass.stats.blockSize < size) continue;
+      if (sizeClass.head) {
+        void* retVal = sizeClass.head;
+        sizeClass.head = *reinterpret_cast<unsigned char**>(sizeClass.head);
+        if (++sizeClass.stats.inUse > sizeClass.stats.highWater) {
+          sizeClass.stats.highWater = sizeClass.stats.inUse;
+        }
+        return retVal;
+      }
+      if (!spilled) {
+        ++sizeClass.stats.exhausted;
+        spilled = true;
+      }
+    }
+  }
+
+  // same low memory check as allocations without the slab
+  void* retVal = nullptr;
+  if (!check || EMC_GET_FREE_MEMORY() >= EMC_MIN_FREE_MEMORY) {
+    retVal = std::malloc(size);
+  }
+  #if _GLIBCXX_HAS_GTHREADS
+  const std::lock_guard<std::mutex> lockGuard(_mutex);
+  #endif
+  if (retVal) {
+    ++_heapFallbacks;
+  } else {
+    ++_failures;
+  }
+  return retVal;
+}
+
+void SlabAllocator::free(void* ptr) {
+  if (!ptr) return;
+  unsigned char* b = reinterpret_cast<unsigned char*>(ptr);
+  if (b < _region || b >= _regionEnd) {
+    std::free(ptr);
+    return;
+  }
+
+  #if _GLIBCXX_HAS_GTHREADS
+  const std::lock_guard<std::mutex> lockGuard(_mutex);
+  #endif
+  // the owning class is the last one starting at or before the block
+  size_t i = _numClasses - 1;
+  while (i > 0 && _classes[i].start > b) --i;
+  SizeClass& sizeClass = _classes[i];
+  *reinterpret_cast<unsigned char**>(b) = sizeClass.head;
+  sizeClass.head = b;
+  --sizeClass.stats.inUse;
+}
+
+size_t SlabAllocator::numClasses() const {
+  return _numClasses;
+}
+
+SlabAllocator::Stats SlabAllocator::stats(size_t index) {
+  #if _GLIBCXX_HAS_GTHREADS
+  const std::lock_guard<std::mutex> lockGuard(_mutex);
+  #endif
+  if (index >= _numClasses) return {0, 0, 0, 0, 0};
+  return _classes[index].stats;
+}
+
+size_t SlabAllocator::heapFallbacks() const {
+  return _heapFallbacks;
+}
+
+size_t SlabAllocator::failures() const {
+  return _failures;
+}
+
+}  // end namespace espMqttClientInternals
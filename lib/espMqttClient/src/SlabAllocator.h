@@ -0,0 +1,77 @@
+/*
+Copyright (c) 2022 Bert Melis. All rights reserved.
+
+This work is licensed under the terms of the MIT license.
+For a copy, see <https://opensource.org/licenses/MIT> or
+the LICENSE file.
+*/
+
+#pragma once
+
+#include <cstddef>  // std::size_t
+#if _GLIBCXX_HAS_GTHREADS
+#include <mutex>  // NOLINT [build/c++11] std::mutex, std::lock_guard
+#endif
+
+#include "Config.h"
+
+namespace espMqttClientInternals {
+
+/**
+ * @brief Size-classed block allocator for outbox nodes and packet buffers
+ *
+ * Every size class is a free list of equally sized blocks, like MemoryPool::Fixed,
+ * but all classes share one region that is allocated once on construction.
+ * On ESP32 the region is only allocated in PSRAM, without PSRAM every request goes to the heap.
+ * Requests are served from the smallest class that has a free block,
+ * larger requests or requests when all fitting classes are exhausted fall back to the heap.
+ * Heap allocations with check set require EMC_MIN_FREE_MEMORY, like packets without the slab.
+ */
+
+class SlabAllocator {
+ public:
+  struct Stats {
+    size_t blockSize;
+    size_t blocks;
+    size_t inUse;
+    size_t highWater;
+    size_t exhausted;  // requests for this class that could not be served from it
+  };
+
+  SlabAllocator(const size_t* blockSizes, const size_t* blockCounts, size_t numClasses);
+  ~SlabAllocator();
+
+  // no copy nor move
+  SlabAllocator(const SlabAllocator&) = delete;
+  SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+  // allocator configured by EMC_SLAB_BLOCK_SIZES and EMC_SLAB_BLOCK_COUNTS
+  static SlabAllocator& instance();
+
+  void* malloc(size_t size, bool check = true);
+  void free(void* ptr);
+
+  size_t numClasses() const;
+  Stats stats(size_t index);
+  size_t heapFallbacks() const;  // allocations served from the heap
+  size_t failures() const;       // allocations that failed altogether
+
+ private:
+  struct SizeClass {
+    unsigned char* start;
+    unsigned char* head;
+    Stats stats;
+  };
+
+  SizeClass* _classes;
+  size_t _numClasses;
+  unsigned char* _region;
+  unsigned char* _regionEnd;
+  size_t _heapFallbacks;
+  size_t _failures;
+  #if _GLIBCXX_HAS_GTHREADS
+  std::mutex _mutex;
+  #endif
+};
+
+}  // end namespace espMqttClientInternals
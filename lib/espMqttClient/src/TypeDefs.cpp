@@ -44,8 +44,19 @@ const char* errorToString(Error error) {
     case Error::MAX_RETRIES:         return "Maximum retries exceeded";
     case Error::MALFORMED_PARAMETER: return "Malformed parameters";
     case Error::MISC_ERROR:          return "Misc error";
+    case Error::QUEUE_FULL:          return "Queue full";
     default:                         return "";
   }
 }
 
+const char* priorityToString(Priority priority) {
+  switch (priority) {
+    case Priority::CONTROL: return "Control";
+    case Priority::STATE:   return "State";
+    case Priority::BULK:    return "Bulk";
+    case Priority::LOG:     return "Log";
+    default:                return "";
+  }
+}
+
 }  // end namespace espMqttClientTypes
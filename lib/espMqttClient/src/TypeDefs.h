@@ -44,11 +44,22 @@ enum class Error : uint8_t {
   OUT_OF_MEMORY = 1,
   MAX_RETRIES = 2,
   MALFORMED_PARAMETER = 3,
-  MISC_ERROR = 4
+  MISC_ERROR = 4,
+  QUEUE_FULL = 5
 };
 
 const char* errorToString(Error error);
 
+// publishes are queued ahead of all unsent packets with a lower priority (higher value)
+enum class Priority : uint8_t {
+  CONTROL = 0,  // command results and acknowledgements
+  STATE = 1,
+  BULK = 2,     // eg. discovery messages
+  LOG = 3,
+};
+
+const char* priorityToString(Priority priority);
+
 struct MessageProperties {
   uint8_t qos;
   bool dup;
@@ -0,0 +1,223 @@
+#include <unity.h>
+
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include <MessageAssembler.h>
+#include <Packets/Parser.h>
+
+using espMqttClientInternals::Parser;
+using espMqttClientInternals::ParserResult;
+using espMqttClientInternals::IncomingPacket;
+using espMqttClientInternals::PacketType;
+
+void setUp() {}
+void tearDown() {}
+
+struct Message {
+  std::string topic;
+  std::string payload;
+  size_t length;
+  bool terminated;
+  bool inRxBuffer;
+};
+
+Parser parser;
+uint8_t rxBuffer[64 + 1];
+std::vector<Message> messages;
+
+void onAssembled(const espMqttClientTypes::MessageProperties& properties, const char* topic, const char* payload, size_t length) {
+  (void) properties;
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(payload);
+  messages.push_back({topic,
+                      std::string(payload, length),
+                      length,
+                      payload[length] == 0x00,
+                      p >= rxBuffer && p < rxBuffer + sizeof(rxBuffer)});
+}
+
+std::vector<uint8_t> publishPacket(const char* topic, const std::string& payload, uint8_t qos = 0, uint16_t packetId = 0) {
+  size_t topicLength = strlen(topic);
+  size_t remainingLength = 2 + topicLength + (qos ? 2 : 0) + payload.size();
+  std::vector<uint8_t> packet;
+  packet.push_back(PacketType.PUBLISH | (qos << 1));
+  packet.push_back(static_cast<uint8_t>(remainingLength));  // tests stay below 128 bytes
+  packet.push_back(0x00);
+  packet.push_back(static_cast<uint8_t>(topicLength));
+  packet.insert(packet.end(), topic, topic + topicLength);
+  if (qos) {
+    packet.push_back(packetId >> 8);
+    packet.push_back(packetId & 0xFF);
+  }
+  packet.insert(packet.end(), payload.begin(), payload.end());
+  return packet;
+}
+
+/*
+Feeds the stream to the parser in reads of at most chunkSize bytes and hands the payload
+fragments to the assembler, null-terminating them in the receive buffer like MqttClient does.
+*/
+void feedStream(MessageAssembler* assembler, const std::vector<uint8_t>& stream, size_t chunkSize) {
+  size_t pos = 0;
+  while (pos < stream.size()) {
+    size_t length = std::min(chunkSize, stream.size() - pos);
+    memcpy(rxBuffer, &stream[pos], length);
+    pos += length;
+    size_t index = 0;
+    while (index < length) {
+      size_t bytesParsed = 0;
+      ParserResult result = parser.parse(&rxBuffer[index], length - index, &bytesParsed);
+      TEST_ASSERT_NOT_EQUAL(ParserResult::protocolError, result);
+      index += bytesParsed;
+      if (result != ParserResult::packet) continue;
+      const IncomingPacket& p = parser.getPacket();
+      uint8_t* end = nullptr;
+      uint8_t saved = 0;
+      if (p.payload.length > 0) {
+        end = const_cast<uint8_t*>(p.payload.data) + p.payload.length;
+        saved = *end;
+        *end = 0x00;
+      }
+      assembler->feed({p.qos(), p.dup(), p.retain(), p.variableHeader.fixed.packetId},
+                      p.variableHeader.topic,
+                      p.payload.data,
+                      p.payload.length,
+                      p.payload.index,
+                      p.payload.total);
+      if (end) *end = saved;
+    }
+  }
+}
+
+void test_singleFragment() {
+  messages.clear();
+  MessageAssembler assembler(onAssembled);
+
+  feedStream(&assembler, publishPacket("a/b", "lock"), 64);
+
+  TEST_ASSERT_EQUAL_UINT32(1, messages.size());
+  TEST_ASSERT_EQUAL_STRING("a/b", messages[0].topic.c_str());
+  TEST_ASSERT_EQUAL_STRING("lock", messages[0].payload.c_str());
+  TEST_ASSERT_EQUAL_UINT32(4, messages[0].length);
+  TEST_ASSERT_TRUE(messages[0].terminated);
+  TEST_ASSERT_TRUE(messages[0].inRxBuffer);  // not copied
+  TEST_ASSERT_EQUAL_UINT32(0, assembler.assembled());
+}
+
+void test_emptyPayload() {
+  messages.clear();
+  MessageAssembler assembler(onAssembled);
+
+  feedStream(&assembler, publishPacket("a/b", ""), 64);
+
+  TEST_ASSERT_EQUAL_UINT32(1, messages.size());
+  TEST_ASSERT_EQUAL_UINT32(0, messages[0].length);
+  TEST_ASSERT_TRUE(messages[0].terminated);
+}
+
+void test_fragmented() {
+  messages.clear();
+  MessageAssembler assembler(onAssembled);
+  std::string payload = "{\"action\":\"add\",\"code\":123456,\"name\":\"front door\"}";
+
+  feedStream(&assembler, publishPacket("lock/keypad/json", payload, 1, 7), 16);
+
+  TEST_ASSERT_EQUAL_UINT32(1, messages.size());
+  TEST_ASSERT_EQUAL_STRING("lock/keypad/json", messages[0].topic.c_str());
+  TEST_ASSERT_EQUAL_STRING(payload.c_str(), messages[0].payload.c_str());
+  TEST_ASSERT_EQUAL_UINT32(payload.size(), messages[0].length);
+  TEST_ASSERT_TRUE(messages[0].terminated);
+  TEST_ASSERT_FALSE(messages[0].inRxBuffer);
+  TEST_ASSERT_EQUAL_UINT32(1, assembler.assembled());
+  TEST_ASSERT_EQUAL_UINT32(0, assembler.dropped());
+}
+
+/*
+- the null byte written after the first payload overlaps the header of the second packet,
+  which still has to parse
+- buffers are reused for the next fragmented message
+*/
+void test_consecutive() {
+  messages.clear();
+  MessageAssembler assembler(onAssembled);
+  std::vector<uint8_t> stream = publishPacket("a", "1");
+  std::vector<uint8_t> second = publishPacket("b", "2");
+  std::vector<uint8_t> third = publishPacket("c", std::string(40, 'x'));
+  std::vector<uint8_t> fourth = publishPacket("d", std::string(30, 'y'));
+  stream.insert(stream.end(), second.begin(), second.end());
+  feedStream(&assembler, stream, 64);
+  feedStream(&assembler, third, 20);
+  feedStream(&assembler, fourth, 20);
+
+  TEST_ASSERT_EQUAL_UINT32(4, messages.size());
+  TEST_ASSERT_EQUAL_STRING("1", messages[0].payload.c_str());
+  TEST_ASSERT_EQUAL_STRING("2", messages[1].payload.c_str());
+  TEST_ASSERT_EQUAL_STRING("b", messages[1].topic.c_str());
+  TEST_ASSERT_EQUAL_STRING(std::string(40, 'x').c_str(), messages[2].payload.c_str());
+  TEST_ASSERT_EQUAL_STRING(std::string(30, 'y').c_str(), messages[3].payload.c_str());
+  TEST_ASSERT_TRUE(messages[3].terminated);
+  TEST_ASSERT_EQUAL_UINT32(2, assembler.assembled());
+}
+
+void test_tooLarge() {
+  messages.clear();
+  MessageAssembler assembler(onAssembled, 32);
+
+  feedStream(&assembler, publishPacket("a/b", std::string(40, 'x')), 16);
+  feedStream(&assembler, publishPacket("a/b", std::string(20, 'z')), 16);
+
+  TEST_ASSERT_EQUAL_UINT32(1, messages.size());
+  TEST_ASSERT_EQUAL_STRING(std::string(20, 'z').c_str(), messages[0].payload.c_str());
+  TEST_ASSERT_EQUAL_UINT32(1, assembler.dropped());
+}
+
+void test_missingFragment() {
+  messages.clear();
+  MessageAssembler assembler(onAssembled);
+  const uint8_t payload[] = "0123456789";
+
+  assembler.feed({1, false, false, 5}, "a/b", payload, 4, 0, 10);
+  assembler.feed({1, false, false, 5}, "a/b", &payload[6], 4, 6, 10);
+
+  TEST_ASSERT_EQUAL_UINT32(0, messages.size());
+  TEST_ASSERT_EQUAL_UINT32(1, assembler.dropped());
+
+  // a retransmission is assembled from the start
+  assembler.feed({1, true, false, 5}, "a/b", payload, 4, 0, 10);
+  assembler.feed({1, true, false, 5}, "a/b", &payload[4], 6, 4, 10);
+
+  TEST_ASSERT_EQUAL_UINT32(1, messages.size());
+  TEST_ASSERT_EQUAL_STRING("0123456789", messages[0].payload.c_str());
+}
+
+void test_noFreeBuffer() {
+  messages.clear();
+  MessageAssembler assembler(onAssembled);
+  const uint8_t payload[] = "0123456789";
+
+  for (uint16_t i = 0; i < EMC_ASSEMBLER_BUFFERS + 1; ++i) {
+    assembler.feed({1, false, false, i}, "a/b", payload, 4, 0, 10);
+  }
+  TEST_ASSERT_EQUAL_UINT32(1, assembler.dropped());
+
+  // incomplete messages are released on reset
+  assembler.reset();
+  TEST_ASSERT_EQUAL_UINT32(1 + EMC_ASSEMBLER_BUFFERS, assembler.dropped());
+  assembler.feed({1, false, false, 9}, "a/b", payload, 4, 0, 10);
+  assembler.feed({1, false, false, 9}, "a/b", &payload[4], 6, 4, 10);
+  TEST_ASSERT_EQUAL_UINT32(1, messages.size());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_singleFragment);
+  RUN_TEST(test_emptyPayload);
+  RUN_TEST(test_fragmented);
+  RUN_TEST(test_consecutive);
+  RUN_TEST(test_tooLarge);
+  RUN_TEST(test_missingFragment);
+  RUN_TEST(test_noFreeBuffer);
+  return UNITY_END();
+}
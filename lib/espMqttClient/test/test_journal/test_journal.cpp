@@ -0,0 +1,299 @@
+#include <unity.h>
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include <PublishJournal.h>
+
+void setUp() {}
+void tearDown() {}
+
+/*
+File-backed stand-in for a SPIFFS file. keep() writes a temporary file and renames it,
+like FSJournalStorage. Power loss is simulated by writing only part of the data
+and failing every operation until the "device" restarts with a new storage object.
+*/
+class FileStorage : public PublishJournal::Storage {
+ public:
+  explicit FileStorage(const char* path)
+  : _path(path)
+  , _tmpPath(std::string(path) + ".tmp")
+  , _failAfter(-1)
+  , _powerLost(false)
+  , _appends(0) {}
+
+  bool begin() override {
+    if (access(_tmpPath.c_str(), F_OK) == 0) {
+      if (access(_path.c_str(), F_OK) == 0) {
+        remove(_tmpPath.c_str());
+      } else {
+        rename(_tmpPath.c_str(), _path.c_str());
+      }
+    }
+    return true;
+  }
+
+  size_t size() override {
+    FILE* f = fopen(_path.c_str(), "rb");
+    if (!f) return 0;
+    fseek(f, 0, SEEK_END);
+    size_t size = ftell(f);
+    fclose(f);
+    return size;
+  }
+
+  size_t read(size_t offset, uint8_t* buf, size_t len) override {
+    if (_powerLost) return 0;
+    FILE* f = fopen(_path.c_str(), "rb");
+    if (!f) return 0;
+    fseek(f, offset, SEEK_SET);
+    size_t n = fread(buf, 1, len, f);
+    fclose(f);
+    return n;
+  }
+
+  bool append(const uint8_t* buf, size_t len) override {
+    if (_powerLost) return false;
+    _appends++;
+    FILE* f = fopen(_path.c_str(), "ab");
+    if (!f) return false;
+    size_t n = len;
+    if (_failAfter >= 0 && static_cast<size_t>(_failAfter) < len) {
+      n = _failAfter;
+      _powerLost = true;
+    }
+    fwrite(buf, 1, n, f);
+    fclose(f);
+    return !_powerLost;
+  }
+
+  bool keep(size_t offset, size_t len) override {
+    if (_powerLost) return false;
+    if (len == 0) {
+      remove(_path.c_str());
+      return true;
+    }
+    std::vector<uint8_t> data(len);
+    if (read(offset, data.data(), len) != len) return false;
+    FILE* f = fopen(_tmpPath.c_str(), "wb");
+    fwrite(data.data(), 1, len, f);
+    fclose(f);
+    remove(_path.c_str());
+    return rename(_tmpPath.c_str(), _path.c_str()) == 0;
+  }
+
+  void loseDataAfter(int bytes) {
+    _failAfter = bytes;
+  }
+
+  size_t appends() const {
+    return _appends;
+  }
+
+ private:
+  std::string _path;
+  std::string _tmpPath;
+  int _failAfter;
+  bool _powerLost;
+  size_t _appends;
+};
+
+const char* journalPath = "/tmp/emc_test_journal.bin";
+
+struct Record {
+  std::string topic;
+  std::string payload;
+  uint8_t qos;
+  bool retain;
+};
+
+std::vector<Record> replayAll(PublishJournal* journal, size_t acceptMax = SIZE_MAX) {
+  std::vector<Record> records;
+  journal->replay([&](const char* topic, const uint8_t* payload, size_t length, uint8_t qos, bool retain) {
+    if (records.size() == acceptMax) return false;
+    TEST_ASSERT_EQUAL_UINT8(0, payload[length]);  // null-terminated
+    records.push_back({topic, std::string(reinterpret_cast<const char*>(payload), length), qos, retain});
+    return true;
+  });
+  return records;
+}
+
+bool appendString(PublishJournal* journal, const char* topic, const std::string& payload, uint8_t qos = 1, bool retain = false) {
+  return journal->append(topic, reinterpret_cast<const uint8_t*>(payload.data()), payload.size(), qos, retain);
+}
+
+/*
+- records are buffered in RAM and written in one batch
+- replay hands them out in order and empties the journal
+*/
+void test_appendReplay() {
+  remove(journalPath);
+  FileStorage storage(journalPath);
+  PublishJournal journal(&storage, 4096, 256, 1000);
+  TEST_ASSERT_TRUE(journal.begin());
+
+  TEST_ASSERT_TRUE(appendString(&journal, "lock/rollingLog", "{\"index\":1}", 1, true));
+  TEST_ASSERT_TRUE(appendString(&journal, "opener/ring", "ring"));
+  TEST_ASSERT_TRUE(appendString(&journal, "lock/commandResult", "success", 0));
+  TEST_ASSERT_EQUAL_UINT32(3, journal.records());
+  TEST_ASSERT_EQUAL_UINT32(0, storage.appends());
+
+  journal.loop(100);
+  journal.loop(600);
+  TEST_ASSERT_EQUAL_UINT32(0, storage.appends());
+  journal.loop(1100);
+  TEST_ASSERT_EQUAL_UINT32(1, storage.appends());
+  TEST_ASSERT_EQUAL_UINT32(1, journal.writes());
+
+  std::vector<Record> records = replayAll(&journal);
+  TEST_ASSERT_EQUAL_UINT32(3, records.size());
+  TEST_ASSERT_EQUAL_STRING("lock/rollingLog", records[0].topic.c_str());
+  TEST_ASSERT_EQUAL_STRING("{\"index\":1}", records[0].payload.c_str());
+  TEST_ASSERT_EQUAL_UINT8(1, records[0].qos);
+  TEST_ASSERT_TRUE(records[0].retain);
+  TEST_ASSERT_EQUAL_STRING("opener/ring", records[1].topic.c_str());
+  TEST_ASSERT_EQUAL_STRING("lock/commandResult", records[2].topic.c_str());
+  TEST_ASSERT_EQUAL_UINT8(0, records[2].qos);
+  TEST_ASSERT_FALSE(records[2].retain);
+  TEST_ASSERT_TRUE(journal.empty());
+  TEST_ASSERT_EQUAL_UINT32(0, storage.size());
+}
+
+/*
+- records survive a restart
+- a partially accepted replay keeps the remaining records in order
+*/
+void test_persistence() {
+  remove(journalPath);
+  {
+    FileStorage storage(journalPath);
+    PublishJournal journal(&storage, 4096, 256, 1000);
+    TEST_ASSERT_TRUE(journal.begin());
+    for (int i = 0; i < 5; ++i) {
+      appendString(&journal, "t", std::to_string(i));
+    }
+    TEST_ASSERT_TRUE(journal.flush());
+  }
+
+  FileStorage storage(journalPath);
+  PublishJournal journal(&storage, 4096, 256, 1000);
+  TEST_ASSERT_TRUE(journal.begin());
+  TEST_ASSERT_EQUAL_UINT32(5, journal.records());
+  TEST_ASSERT_EQUAL_UINT32(0, journal.corrupt());
+
+  std::vector<Record> records = replayAll(&journal, 2);
+  TEST_ASSERT_EQUAL_UINT32(2, records.size());
+  TEST_ASSERT_EQUAL_UINT32(3, journal.records());
+
+  appendString(&journal, "t", "5");
+  records = replayAll(&journal);
+  TEST_ASSERT_EQUAL_UINT32(4, records.size());
+  for (size_t i = 0; i < records.size(); ++i) {
+    TEST_ASSERT_EQUAL_STRING(std::to_string(i + 2).c_str(), records[i].payload.c_str());
+  }
+  TEST_ASSERT_TRUE(journal.empty());
+}
+
+/*
+- power is lost halfway through a batch write
+- after restart, the torn record is cut off and the earlier records are intact
+*/
+void test_powerLoss() {
+  remove(journalPath);
+  {
+    FileStorage storage(journalPath);
+    PublishJournal journal(&storage, 4096, 64, 1000);
+    TEST_ASSERT_TRUE(journal.begin());
+    appendString(&journal, "a", "first");
+    appendString(&journal, "b", "second");
+    TEST_ASSERT_TRUE(journal.flush());
+
+    storage.loseDataAfter(20);
+    appendString(&journal, "c", "third record, lost");
+    appendString(&journal, "d", "fourth record, lost");
+    TEST_ASSERT_FALSE(journal.flush());
+  }
+
+  FileStorage storage(journalPath);
+  PublishJournal journal(&storage, 4096, 64, 1000);
+  TEST_ASSERT_TRUE(journal.begin());
+  TEST_ASSERT_EQUAL_UINT32(1, journal.corrupt());
+  TEST_ASSERT_EQUAL_UINT32(2, journal.records());
+
+  // new records are appended after the last valid one
+  appendString(&journal, "e", "fifth");
+  std::vector<Record> records = replayAll(&journal);
+  TEST_ASSERT_EQUAL_UINT32(3, records.size());
+  TEST_ASSERT_EQUAL_STRING("first", records[0].payload.c_str());
+  TEST_ASSERT_EQUAL_STRING("second", records[1].payload.c_str());
+  TEST_ASSERT_EQUAL_STRING("fifth", records[2].payload.c_str());
+}
+
+/*
+- a flipped bit is caught by the CRC
+*/
+void test_corruptRecord() {
+  remove(journalPath);
+  {
+    FileStorage storage(journalPath);
+    PublishJournal journal(&storage, 4096, 256, 1000);
+    TEST_ASSERT_TRUE(journal.begin());
+    appendString(&journal, "a", "first");
+    appendString(&journal, "b", "second");
+    TEST_ASSERT_TRUE(journal.flush());
+  }
+  FILE* f = fopen(journalPath, "r+b");
+  fseek(f, -2, SEEK_END);
+  fputc('X', f);
+  fclose(f);
+
+  FileStorage storage(journalPath);
+  PublishJournal journal(&storage, 4096, 256, 1000);
+  TEST_ASSERT_TRUE(journal.begin());
+  TEST_ASSERT_EQUAL_UINT32(1, journal.corrupt());
+  std::vector<Record> records = replayAll(&journal);
+  TEST_ASSERT_EQUAL_UINT32(1, records.size());
+  TEST_ASSERT_EQUAL_STRING("first", records[0].payload.c_str());
+}
+
+/*
+- the journal stays within its maximum size by dropping the oldest records
+- records larger than the write buffer are written on their own
+*/
+void test_bounded() {
+  remove(journalPath);
+  FileStorage storage(journalPath);
+  PublishJournal journal(&storage, 100, 40, 1000);
+  TEST_ASSERT_TRUE(journal.begin());
+
+  // 10 byte header + 1 byte topic + 9 byte payload = 20 bytes per record
+  for (int i = 0; i < 8; ++i) {
+    TEST_ASSERT_TRUE(appendString(&journal, "t", "payload-" + std::to_string(i)));
+  }
+  TEST_ASSERT_TRUE(journal.flush());
+  TEST_ASSERT_LESS_OR_EQUAL(100, storage.size());
+  TEST_ASSERT_EQUAL_UINT32(4, journal.writes());
+  TEST_ASSERT_EQUAL_UINT32(3, journal.dropped());
+
+  TEST_ASSERT_TRUE(appendString(&journal, "t", std::string(50, 'x')));
+  TEST_ASSERT_FALSE(appendString(&journal, "t", std::string(100, 'x')));  // never fits
+
+  std::vector<Record> records = replayAll(&journal);
+  TEST_ASSERT_EQUAL_UINT32(journal.dropped() + records.size(), 9);
+  TEST_ASSERT_EQUAL_STRING("payload-7", records[records.size() - 2].payload.c_str());
+  TEST_ASSERT_EQUAL_STRING(std::string(50, 'x').c_str(), records.back().payload.c_str());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_appendReplay);
+  RUN_TEST(test_persistence);
+  RUN_TEST(test_powerLoss);
+  RUN_TEST(test_corruptRecord);
+  RUN_TEST(test_bounded);
+  remove(journalPath);
+  return UNITY_END();
+}
@@ -49,6 +49,44 @@ void test_outbox_emplaceFront() {
   TEST_ASSERT_EQUAL_UINT32(2, *(outbox.getCurrent()));
 }
 
+void test_outbox_emplaceBefore() {
+  Outbox<uint32_t> outbox;
+  auto greaterThan2 = [](const uint32_t& v) { return v > 2; };
+  outbox.emplace(1);
+  outbox.emplace(5);
+  outbox.next();
+  // 1 5, current points to 5
+
+  outbox.emplaceBefore(greaterThan2, 2);
+  // 1 2 5, current points to 2
+  TEST_ASSERT_NOT_NULL(outbox.getCurrent());
+  TEST_ASSERT_EQUAL_UINT32(2, *(outbox.getCurrent()));
+
+  outbox.emplaceBefore([](const uint32_t& v) { return v > 5; }, 6);
+  // 1 2 5 6, current points to 2
+  TEST_ASSERT_EQUAL_UINT32(2, *(outbox.getCurrent()));
+
+  // nodes before current are never matched
+  outbox.emplaceBefore([](const uint32_t& v) { return v == 1; }, 7);
+  // 1 2 5 6 7, current points to 2
+
+  uint32_t expected[] = {1, 2, 5, 6, 7};
+  size_t i = 0;
+  Outbox<uint32_t>::Iterator it = outbox.front();
+  while (it) {
+    TEST_ASSERT_EQUAL_UINT32(expected[i], *(it.get()));
+    ++it;
+    ++i;
+  }
+  TEST_ASSERT_EQUAL_UINT32(5, i);
+
+  // current is removable
+  outbox.removeCurrent();
+  // 1 5 6 7, current points to 5
+  TEST_ASSERT_EQUAL_UINT32(5, *(outbox.getCurrent()));
+  TEST_ASSERT_EQUAL_UINT32(4, outbox.size());
+}
+
 void test_outbox_remove1() {
   Outbox<uint32_t> outbox;
   Outbox<uint32_t>::Iterator it;
@@ -164,6 +202,7 @@ int main() {
   RUN_TEST(test_outbox_create);
   RUN_TEST(test_outbox_emplace);
   RUN_TEST(test_outbox_emplaceFront);
+  RUN_TEST(test_outbox_emplaceBefore);
   RUN_TEST(test_outbox_remove1);
   RUN_TEST(test_outbox_remove2);
   RUN_TEST(test_outbox_removeCurrent);
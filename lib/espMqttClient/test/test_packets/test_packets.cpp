@@ -479,6 +479,43 @@ void test_encodeMultiSubscribe3() {
   TEST_ASSERT_EQUAL_UINT16(packetId, packet.packetId());
 }
 
+void test_encodeSubscribeList() {
+  const uint8_t check[] = {
+    0b10000010,                 // header
+    0x14,                       // remaining length
+    0x00,0x17,                  // packet Id
+    0x00, 0x03, 'a', '/', 'b',  // topic1
+    0x01,                       // qos1
+    0x00, 0x03, 'c', '/', 'd',  // topic2
+    0x01,                       // qos2
+    0x00, 0x03, 'e', '/', 'f',  // topic3
+    0x01                        // qos3
+  };
+  const uint32_t length = 22;
+  const char* topics[] = {"a/b", "c/d", "e/f"};
+  uint8_t qos = 1;
+  uint16_t packetId = 23;
+  espMqttClientTypes::Error error = espMqttClientTypes::Error::MISC_ERROR;
+
+  Packet packet(error, packetId, topics, 3, qos);
+
+  TEST_ASSERT_EQUAL_UINT8(espMqttClientTypes::Error::SUCCESS, error);
+  TEST_ASSERT_EQUAL_UINT32(length, packet.size());
+  TEST_ASSERT_EQUAL_UINT8(PacketType.SUBSCRIBE, packet.packetType());
+  TEST_ASSERT_FALSE(packet.removable());
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(check, packet.data(0), length);
+  TEST_ASSERT_EQUAL_UINT16(packetId, packet.packetId());
+}
+
+void test_encodeSubscribeListEmpty() {
+  const char* topics[] = {"a/b"};
+  espMqttClientTypes::Error error = espMqttClientTypes::Error::SUCCESS;
+
+  Packet packet(error, 24, topics, 0, 1);
+
+  TEST_ASSERT_EQUAL_UINT8(espMqttClientTypes::Error::MALFORMED_PARAMETER, error);
+}
+
 void test_encodeUnsubscribe() {
   const uint8_t check[] = {
     0b10100010,                 // header
@@ -688,6 +725,59 @@ void test_encodeChunkedPublish() {
   TEST_ASSERT_EQUAL_UINT8_ARRAY(payloadChunk, packet.data(index), available);
 }
 
+
+size_t getIndexedData(uint8_t* dest, size_t len, size_t index) {
+  for (size_t i = 0; i < len; ++i) {
+    dest[i] = static_cast<uint8_t>(index + i);
+  }
+  return len;
+}
+
+void test_encodeChunkedPublishIndex() {
+  const char* topic = "top";
+  size_t headerLength = 9;  // header, remaining length (1 byte), topic, packet Id
+  size_t payloadLength = 2 * EMC_TX_BUFFER_SIZE + 5;
+  uint8_t payload[2 * EMC_TX_BUFFER_SIZE + 5];
+  for (size_t i = 0; i < payloadLength; ++i) {
+    payload[i] = static_cast<uint8_t>(i);
+  }
+  espMqttClientTypes::Error error = espMqttClientTypes::Error::MISC_ERROR;
+
+  Packet packet(error,
+                22,
+                topic,
+                getIndexedData,
+                payloadLength,
+                1,
+                false);
+
+  TEST_ASSERT_EQUAL_UINT8(espMqttClientTypes::Error::SUCCESS, error);
+  TEST_ASSERT_EQUAL_UINT32(headerLength + payloadLength, packet.size());
+
+  // callback receives payload offsets, independent of the header length
+  size_t index = 0;
+  size_t available = packet.available(index);
+  TEST_ASSERT_EQUAL_UINT32(headerLength + EMC_TX_BUFFER_SIZE, available);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(payload, packet.data(index) + headerLength, EMC_TX_BUFFER_SIZE);
+
+  index = headerLength + EMC_TX_BUFFER_SIZE;
+  available = packet.available(index);
+  TEST_ASSERT_EQUAL_UINT32(EMC_TX_BUFFER_SIZE, available);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(&payload[EMC_TX_BUFFER_SIZE], packet.data(index), available);
+
+  index = headerLength + 2 * EMC_TX_BUFFER_SIZE;
+  available = packet.available(index);
+  TEST_ASSERT_EQUAL_UINT32(5, available);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(&payload[2 * EMC_TX_BUFFER_SIZE], packet.data(index), available);
+
+  // resend restarts at payload offset 0
+  index = 0;
+  packet.setDup();
+  available = packet.available(index);
+  TEST_ASSERT_EQUAL_UINT32(headerLength + EMC_TX_BUFFER_SIZE, available);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(payload, packet.data(index) + headerLength, EMC_TX_BUFFER_SIZE);
+}
+
 int main() {
   UNITY_BEGIN();
   RUN_TEST(test_encodeConnect0);
@@ -704,11 +794,14 @@ int main() {
   RUN_TEST(test_encodeSubscribe);
   RUN_TEST(test_encodeMultiSubscribe2);
   RUN_TEST(test_encodeMultiSubscribe3);
+  RUN_TEST(test_encodeSubscribeList);
+  RUN_TEST(test_encodeSubscribeListEmpty);
   RUN_TEST(test_encodeUnsubscribe);
   RUN_TEST(test_encodeMultiUnsubscribe2);
   RUN_TEST(test_encodeMultiUnsubscribe3);
   RUN_TEST(test_encodePingReq);
   RUN_TEST(test_encodeDisconnect);
   RUN_TEST(test_encodeChunkedPublish);
+  RUN_TEST(test_encodeChunkedPublishIndex);
   return UNITY_END();
 }
@@ -0,0 +1,207 @@
+#include <unity.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <espMqttClient.h>  // espMqttClient for Linux also defines millis()
+
+using espMqttClientTypes::Priority;
+
+void setUp() {}
+void tearDown() {}
+
+/*
+
+Minimal broker stand-in: accepts a single connection, answers CONNECT with CONNACK,
+acknowledges QoS 1 publishes and records the topics in the order they arrive.
+
+*/
+class BrokerStandIn {
+ public:
+  BrokerStandIn()
+  : _listenFd(-1)
+  , _port(0)
+  , _stop(false) {
+    _listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    int flag = 1;
+    setsockopt(_listenFd, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(int));
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    ::bind(_listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    socklen_t len = sizeof(addr);
+    getsockname(_listenFd, reinterpret_cast<sockaddr*>(&addr), &len);
+    _port = ntohs(addr.sin_port);
+    ::listen(_listenFd, 1);
+    _thread = std::thread([this] { _run(); });
+  }
+
+  ~BrokerStandIn() {
+    _stop = true;
+    ::shutdown(_listenFd, SHUT_RDWR);
+    ::close(_listenFd);
+    _thread.join();
+  }
+
+  uint16_t port() const {
+    return _port;
+  }
+
+  std::vector<std::string> topics() {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _topics;
+  }
+
+ private:
+  void _run() {
+    int fd = ::accept(_listenFd, nullptr, nullptr);
+    if (fd < 0) return;
+    std::vector<uint8_t> buf;
+    uint8_t chunk[256];
+    while (!_stop) {
+      int n = ::recv(fd, chunk, sizeof(chunk), 0);
+      if (n <= 0) break;
+      buf.insert(buf.end(), chunk, chunk + n);
+      size_t consumed = 0;
+      while (_handlePacket(fd, buf.data() + consumed, buf.size() - consumed, &consumed)) {}
+      buf.erase(buf.begin(), buf.begin() + consumed);
+    }
+    ::close(fd);
+  }
+
+  // returns true when a complete packet was handled
+  bool _handlePacket(int fd, const uint8_t* data, size_t len, size_t* consumed) {
+    if (len < 2) return false;
+    size_t remainingLength = 0;
+    size_t multiplier = 1;
+    size_t index = 1;
+    do {
+      if (index >= len) return false;
+      remainingLength += (data[index] & 0x7F) * multiplier;
+      multiplier *= 128;
+    } while (data[index++] & 0x80);
+    if (len < index + remainingLength) return false;
+
+    uint8_t type = data[0] & 0xF0;
+    if (type == 0x10) {  // CONNECT
+      const uint8_t connack[] = {0x20, 0x02, 0x00, 0x00};
+      ::send(fd, connack, sizeof(connack), 0);
+    } else if (type == 0x30) {  // PUBLISH
+      uint16_t topicLength = (data[index] << 8) | data[index + 1];
+      std::string topic(reinterpret_cast<const char*>(&data[index + 2]), topicLength);
+      if (((data[0] >> 1) & 0x03) == 1) {
+        const uint8_t puback[] = {0x40, 0x02, data[index + 2 + topicLength], data[index + 3 + topicLength]};
+        ::send(fd, puback, sizeof(puback), 0);
+      }
+      std::lock_guard<std::mutex> lock(_mtx);
+      _topics.push_back(topic);
+    } else if (type == 0xC0) {  // PINGREQ
+      const uint8_t pingresp[] = {0xD0, 0x00};
+      ::send(fd, pingresp, sizeof(pingresp), 0);
+    }
+    *consumed += index + remainingLength;
+    return true;
+  }
+
+  int _listenFd;
+  uint16_t _port;
+  std::atomic<bool> _stop;
+  std::thread _thread;
+  std::mutex _mtx;
+  std::vector<std::string> _topics;
+};
+
+void runUntil(espMqttClient* client, std::function<bool()> condition, uint32_t timeout = 2000) {
+  uint32_t start = millis();
+  while (!condition() && millis() - start < timeout) {
+    client->loop();
+  }
+}
+
+/*
+
+- queue publishes of all priorities before connecting
+- on connect, they arrive in priority order and in order of queueing within a priority
+
+*/
+void test_priority_order() {
+  BrokerStandIn broker;
+  espMqttClient client;
+  client.setServer(IPAddress(127, 0, 0, 1), broker.port())
+        .setCleanSession(true);
+
+  TEST_ASSERT_GREATER_THAN_UINT16(0, client.publish("log/1", 0, false, "x", Priority::LOG));
+  TEST_ASSERT_GREATER_THAN_UINT16(0, client.publish("bulk/1", 1, false, "x", Priority::BULK));
+  TEST_ASSERT_GREATER_THAN_UINT16(0, client.publish("bulk/2", 0, false, "x", Priority::BULK));
+  TEST_ASSERT_GREATER_THAN_UINT16(0, client.publish("state/1", 1, false, "x"));
+  TEST_ASSERT_GREATER_THAN_UINT16(0, client.publish("control/1", 1, false, "x", Priority::CONTROL));
+  TEST_ASSERT_GREATER_THAN_UINT16(0, client.publish("state/2", 0, false, "x", Priority::STATE));
+  TEST_ASSERT_EQUAL_UINT32(2, client.queueSize(Priority::BULK));
+  TEST_ASSERT_EQUAL_UINT32(2, client.queueSize(Priority::STATE));
+
+  client.connect();
+  runUntil(&client, [&] { return broker.topics().size() == 6; });
+
+  std::vector<std::string> topics = broker.topics();
+  const char* expected[] = {"control/1", "state/1", "state/2", "bulk/1", "bulk/2", "log/1"};
+  TEST_ASSERT_EQUAL_UINT32(6, topics.size());
+  for (size_t i = 0; i < 6; ++i) {
+    TEST_ASSERT_EQUAL_STRING(expected[i], topics[i].c_str());
+  }
+
+  // QoS 1 packets are acknowledged
+  runUntil(&client, [&] { return client.queueSize() == 0; });
+  TEST_ASSERT_EQUAL_UINT32(0, client.queueSize());
+
+  client.disconnect(true);
+  runUntil(&client, [&] { return client.disconnected(); });
+}
+
+/*
+
+- bulk publishes beyond the queue limit are refused and counted
+- other priorities are not affected
+
+*/
+void test_priority_limit() {
+  BrokerStandIn broker;
+  espMqttClient client;
+  client.setServer(IPAddress(127, 0, 0, 1), broker.port())
+        .setCleanSession(true)
+        .setQueueLimit(Priority::BULK, 3);
+
+  for (size_t i = 0; i < 5; ++i) {
+    client.publish("bulk", 0, false, "x", Priority::BULK);
+  }
+  TEST_ASSERT_GREATER_THAN_UINT16(0, client.publish("control", 0, false, "x", Priority::CONTROL));
+
+  TEST_ASSERT_EQUAL_UINT32(3, client.queueSize(Priority::BULK));
+  TEST_ASSERT_EQUAL_UINT32(2, client.droppedPackets(Priority::BULK));
+  TEST_ASSERT_EQUAL_UINT32(0, client.droppedPackets(Priority::CONTROL));
+
+  client.connect();
+  runUntil(&client, [&] { return broker.topics().size() == 4; });
+  std::vector<std::string> topics = broker.topics();
+  TEST_ASSERT_EQUAL_UINT32(4, topics.size());
+  TEST_ASSERT_EQUAL_STRING("control", topics[0].c_str());
+
+  client.disconnect(true);
+  runUntil(&client, [&] { return client.disconnected(); });
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_priority_order);
+  RUN_TEST(test_priority_limit);
+  return UNITY_END();
+}
@@ -0,0 +1,159 @@
+#include <unity.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include <SlabAllocator.h>
+#include <MemoryPool/src/MemoryPool.h>
+
+using espMqttClientInternals::SlabAllocator;
+
+void setUp() {}
+void tearDown() {}
+
+const size_t blockSizes[] = {32, 64, 128};
+const size_t blockCounts[] = {2, 2, 1};
+
+void test_slab_sizeClass() {
+  SlabAllocator slab(blockSizes, blockCounts, 3);
+  TEST_ASSERT_EQUAL_UINT32(3, slab.numClasses());
+
+  void* a = slab.malloc(10);
+  void* b = slab.malloc(33);
+  TEST_ASSERT_NOT_NULL(a);
+  TEST_ASSERT_NOT_NULL(b);
+  TEST_ASSERT_EQUAL_UINT32(1, slab.stats(0).inUse);
+  TEST_ASSERT_EQUAL_UINT32(1, slab.stats(1).inUse);
+  TEST_ASSERT_EQUAL_UINT32(0, slab.stats(2).inUse);
+
+  slab.free(a);
+  slab.free(b);
+  TEST_ASSERT_EQUAL_UINT32(0, slab.stats(0).inUse);
+  TEST_ASSERT_EQUAL_UINT32(0, slab.stats(1).inUse);
+  TEST_ASSERT_EQUAL_UINT32(1, slab.stats(0).highWater);
+  TEST_ASSERT_EQUAL_UINT32(0, slab.heapFallbacks());
+}
+
+void test_slab_exhausted() {
+  SlabAllocator slab(blockSizes, blockCounts, 3);
+  void* p[6];
+
+  // 2 blocks of 32, then spill over to 64 and 128, then heap
+  for (size_t i = 0; i < 6; ++i) {
+    p[i] = slab.malloc(20);
+    TEST_ASSERT_NOT_NULL(p[i]);
+    memset(p[i], 0xAA, 20);
+  }
+  TEST_ASSERT_EQUAL_UINT32(2, slab.stats(0).inUse);
+  TEST_ASSERT_EQUAL_UINT32(2, slab.stats(1).inUse);
+  TEST_ASSERT_EQUAL_UINT32(1, slab.stats(2).inUse);
+  TEST_ASSERT_EQUAL_UINT32(4, slab.stats(0).exhausted);
+  TEST_ASSERT_EQUAL_UINT32(1, slab.heapFallbacks());
+
+  // larger than any class
+  void* large = slab.malloc(500);
+  TEST_ASSERT_NOT_NULL(large);
+  TEST_ASSERT_EQUAL_UINT32(2, slab.heapFallbacks());
+
+  for (size_t i = 0; i < 6; ++i) {
+    slab.free(p[i]);
+  }
+  slab.free(large);
+  for (size_t i = 0; i < 3; ++i) {
+    TEST_ASSERT_EQUAL_UINT32(0, slab.stats(i).inUse);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, slab.failures());
+
+  // freed blocks are reused
+  void* a = slab.malloc(20);
+  TEST_ASSERT_EQUAL_UINT32(1, slab.stats(0).inUse);
+  slab.free(a);
+}
+
+// simple deterministic generator, independent of the platform's rand()
+static uint32_t nextRandom() {
+  static uint32_t state = 2463534242;
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+// publish sizes: mostly small state updates, some discovery messages and an occasional large document
+static size_t publishSize() {
+  uint32_t r = nextRandom() % 100;
+  if (r < 70) return 16 + nextRandom() % 100;
+  if (r < 95) return 200 + nextRandom() % 300;
+  return 600 + nextRandom() % 800;
+}
+
+// the default configuration from Config.h
+constexpr size_t defaultSizes[] = {EMC_SLAB_BLOCK_SIZES};
+constexpr size_t defaultCounts[] = {EMC_SLAB_BLOCK_COUNTS};
+constexpr size_t numDefaultClasses = sizeof(defaultSizes) / sizeof(defaultSizes[0]);
+
+constexpr size_t defaultCapacity(size_t i = 0) {
+  return i == numDefaultClasses ? 0 : defaultSizes[i] * defaultCounts[i] + defaultCapacity(i + 1);
+}
+
+void test_slab_churn() {
+  const size_t maxLive = 24;
+  const size_t iterations = 1000000;
+  SlabAllocator slab(defaultSizes, defaultCounts, numDefaultClasses);
+  MemoryPool::Variable<defaultCapacity() / 340, 340> pool;  // comparable capacity to the slab above
+  void* slabLive[maxLive] = {nullptr};
+  void* poolLive[maxLive] = {nullptr};
+  size_t poolFailures = 0;
+  size_t worstPoolFragmentation = 0;  // in percent
+
+  for (size_t i = 0; i < iterations; ++i) {
+    size_t slot = nextRandom() % maxLive;
+    if (slabLive[slot]) {
+      slab.free(slabLive[slot]);
+      pool.free(poolLive[slot]);
+      slabLive[slot] = poolLive[slot] = nullptr;
+    } else {
+      size_t size = publishSize();
+      slabLive[slot] = slab.malloc(size);
+      TEST_ASSERT_NOT_NULL(slabLive[slot]);
+      poolLive[slot] = pool.malloc(size);
+      if (!poolLive[slot]) ++poolFailures;
+    }
+    if (i % 1000 == 0) {
+      size_t freeMemory = pool.freeMemory();
+      if (freeMemory > 0) {
+        size_t fragmentation = 100 - (pool.maxBlockSize() * 100 / freeMemory);
+        if (fragmentation > worstPoolFragmentation) worstPoolFragmentation = fragmentation;
+      }
+    }
+  }
+
+  for (size_t slot = 0; slot < maxLive; ++slot) {
+    slab.free(slabLive[slot]);
+    pool.free(poolLive[slot]);
+  }
+
+  char message[120];
+  for (size_t i = 0; i < slab.numClasses(); ++i) {
+    SlabAllocator::Stats stats = slab.stats(i);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.inUse);
+    TEST_ASSERT_LESS_OR_EQUAL(stats.blocks, stats.highWater);
+    snprintf(message, sizeof(message), "slab %zu: high water %zu/%zu, exhausted %zu",
+             stats.blockSize, stats.highWater, stats.blocks, stats.exhausted);
+    TEST_MESSAGE(message);
+  }
+  snprintf(message, sizeof(message), "slab: %zu heap fallbacks, %zu failures", slab.heapFallbacks(), slab.failures());
+  TEST_MESSAGE(message);
+  snprintf(message, sizeof(message), "variable pool: %zu failures, worst fragmentation %zu%%", poolFailures, worstPoolFragmentation);
+  TEST_MESSAGE(message);
+
+  TEST_ASSERT_EQUAL_UINT32(0, slab.failures());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_slab_sizeClass);
+  RUN_TEST(test_slab_exhausted);
+  RUN_TEST(test_slab_churn);
+  return UNITY_END();
+}
@@ -24,6 +24,8 @@ if content_new != file_content:
 
 recursive_purge("managed_components", ".component_hash")
 
+env.Execute("$PYTHONEXE resources/web_assets.py")
+
 board = env.get('BOARD_MCU')
 
 if os.path.exists("sdkconfig." + board):
@@ -0,0 +1,52 @@
+/*
+ * Live status of the landing page, served as /status.js
+ *
+ * Status changes are pushed over /events, browsers without EventSource or
+ * a refused stream fall back to polling /get?page=status.
+ */
+
+let intervalId;
+
+window.onload = function() {
+    if (window.EventSource) {
+        var source = new EventSource('/events');
+        source.addEventListener('status', function(e) {
+            showInfo(JSON.parse(e.data));
+        });
+        source.onerror = function() {
+            if (source.readyState == EventSource.CLOSED && !intervalId) {
+                startPolling();
+            }
+        };
+    } else {
+        startPolling();
+    }
+};
+
+function startPolling() {
+    updateInfo();
+    intervalId = setInterval(updateInfo, 3000);
+}
+
+function showInfo(obj) {
+    for (var key of Object.keys(obj)) {
+        if (key == 'ota' && document.getElementById(key) !== null) {
+            document.getElementById(key).innerText = "<a href='/ota'>" + obj[key] + "</a>";
+        } else if (document.getElementById(key) !== null) {
+            document.getElementById(key).innerText = obj[key];
+        }
+    }
+}
+
+function updateInfo() {
+    var request = new XMLHttpRequest();
+    request.open('GET', '/get?page=status', true);
+    request.onload = () => {
+        const obj = JSON.parse(request.responseText);
+        if (obj.stop == 1) {
+            clearInterval(intervalId);
+        }
+        showInfo(obj);
+    };
+    request.send();
+}
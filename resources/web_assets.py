@@ -0,0 +1,64 @@
+import re, gzip, hashlib, os
+
+# Generates src/WebCfgServerConstants.h from the static files of the web configuration.
+# Each file is minified, gzip-compressed when that makes it smaller and tagged with a hash
+# of the served bytes, used as strong ETag. Runs before every PlatformIO build (pio_package_pre.py),
+# the header is only rewritten when its content changes.
+
+root = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+output = os.path.join(root, "src", "WebCfgServerConstants.h")
+
+def minify_css(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags = re.S)
+    text = re.sub(r"\s+", " ", text)
+    text = re.sub(r"\s*([{};])\s*", r"\1", text)
+    return text.strip()
+
+def minify_js(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags = re.S)
+    lines = [line.strip() for line in text.splitlines()]
+    return "\n".join(line for line in lines if line)
+
+# name, source, content type, cache control, minifier
+assets = [
+    ("stylecss", "resources/style.css", "text/css", "public, max-age=3600", minify_css),
+    ("statusjs", "resources/status.js", "application/javascript", "public, max-age=3600", minify_js),
+    ("favicon", "icon/favicon-32x32.png", "image/png", "public, max-age=604800", None),
+]
+
+def c_array(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+content = "#pragma once\n\n"
+content += "// Generated by resources/web_assets.py, do not edit. Change the files in resources/ and icon/ instead.\n\n"
+content += "#include \"WebCfgAsset.h\"\n"
+
+for name, source, contentType, cacheControl, minify in assets:
+    with open(os.path.join(root, source), "rb") as file:
+        data = file.read()
+
+    if minify is not None:
+        data = minify(data.decode("utf-8")).encode("utf-8")
+
+    # mtime 0 keeps the output and with it the ETag stable between builds
+    compressed = gzip.compress(data, compresslevel = 9, mtime = 0)
+    useGzip = len(compressed) < len(data)
+    served = compressed if useGzip else data
+    etag = hashlib.sha256(served).hexdigest()[:16]
+
+    content += "\n// %s: %d bytes%s\n" % (source, len(data), (", %d gzipped" % len(compressed)) if useGzip else "")
+    content += "const uint8_t %s_data[] = {\n%s\n};\n" % (name, c_array(served))
+    content += "const WebCfgAsset %s = { \"%s\", \"%s\", %s_data, sizeof(%s_data), \"\\\"%s\\\"\", %s };\n" % (
+        name, contentType, cacheControl, name, name, etag, "true" if useGzip else "false")
+
+current = ""
+if os.path.exists(output):
+    with open(output, "r") as file:
+        current = file.read()
+
+if content != current:
+    with open(output, "w") as file:
+        file.write(content)
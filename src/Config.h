@@ -147,8 +147,28 @@
 #ifndef NUKI_HUB_UPDATER
 #define MQTT_QOS_LEVEL 1
 #define GPIO_DEBOUNCE_TIME 200
+#define MQTT_CONNECT_TIMEOUT 60000
+#define MQTT_RECONNECT_MIN_BACKOFF 1000
+#define MQTT_RECONNECT_MAX_BACKOFF 60000
 #define CHAR_BUFFER_SIZE 4096
 #define NUKI_TASK_SIZE 8192
+#define NUKI_TASK_MIN_SLEEP 20
+#define NUKI_TASK_MAX_SLEEP 1000
+#define NUKI_JOB_TICK 50
+#define NUKI_JOB_SPREAD 500
+#define NUKI_JOB_DEFER_DELAY 1000
+#define NUKI_JOB_OWNER_LOCK 0
+#define NUKI_JOB_OWNER_OPENER 1
+#define NUKI_GPIO_ACTION_QUEUE_LENGTH 4
+#define NUKI_BEACON_SAFETY_TIMEOUT (60 * 60 * 1000)
+#define NUKI_BEACON_TIMEOUT 20000
+#define NUKI_BEACON_SETTLE_TIME 3000
+#define BLE_SCAN_WINDOW 40
+#define BLE_SCAN_MAX_INTERVAL 640
+#define BLE_SCAN_BOOST_DURATION 30000
+#define BLE_SCAN_MAX_LATENCY 3000
+#define WEBCFG_STATUS_EVENT_INTERVAL 500
+#define SESSION_PERSIST_INTERVAL 5000
 #define MAX_AUTHLOG 5
 #define MAX_KEYPAD 10
 #define MAX_TIMECONTROL 10
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <list>
+#include <vector>
+
+/*
+ * Last published list of device entries (keypad codes, ...), to publish only what changed.
+ *
+ * The per-entry topics are numbered by position in the list, so update() compares the new list
+ * position by position with the previous one. Entries are compared bytewise, they are the packed
+ * structs received from the device. After invalidate() (e.g. on MQTT reconnect) the next update()
+ * reports a full publish.
+ */
+template<typename Entry>
+class EntrySnapshot
+{
+public:
+    struct Diff
+    {
+        bool full = false;            // nothing published yet, publish everything
+        std::vector<bool> changed;    // per position of the new list: added or different
+        size_t changedCount = 0;
+        size_t previousSize = 0;      // positions from the new size up to here were removed
+
+        bool any() const
+        {
+            return full || changedCount > 0 || previousSize > changed.size();
+        }
+    };
+
+    Diff update(const std::list<Entry>& entries)
+    {
+        Diff diff;
+        diff.full = !_valid || _invalidated.exchange(false);
+        diff.previousSize = diff.full ? 0 : _entries.size();
+        diff.changed.resize(entries.size());
+
+        size_t position = 0;
+        for(const auto& entry : entries)
+        {
+            bool changed = diff.full || position >= _entries.size() || memcmp(&_entries[position], &entry, sizeof(Entry)) != 0;
+            diff.changed[position] = changed;
+            if(changed)
+            {
+                ++diff.changedCount;
+            }
+            ++position;
+        }
+
+        if(diff.any())
+        {
+            _entries.assign(entries.begin(), entries.end());
+        }
+        _valid = true;
+        return diff;
+    }
+
+    // May be called from another task
+    void invalidate()
+    {
+        _invalidated = true;
+    }
+
+private:
+    std::vector<Entry> _entries;
+    bool _valid = false;
+    std::atomic<bool> _invalidated {false};
+};
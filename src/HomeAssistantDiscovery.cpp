@@ -161,7 +161,7 @@ void HomeAssistantDiscovery::publishHASSNukiHubConfig()
     path.concat(_nukiHubUidString);
     path.concat("/reset/config");
 
-    _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+    _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
 
 #ifndef CONFIG_IDF_TARGET_ESP32H2
     publishHassTopic("sensor",
@@ -551,7 +551,7 @@ void HomeAssistantDiscovery::publishHASSDeviceConfig(char* deviceType, const cha
     path.concat(uidString);
     path.concat("/smartlock/config");
 
-    _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+    _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
 
 
     // Firmware version
@@ -1210,7 +1210,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalLockEntities(char *devic
         json["options"][4] = "Intelligent";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "fob_action_1", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -1228,7 +1228,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalLockEntities(char *devic
         json["options"][4] = "Intelligent";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "fob_action_2", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -1246,7 +1246,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalLockEntities(char *devic
         json["options"][4] = "Intelligent";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "fob_action_3", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -1263,7 +1263,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalLockEntities(char *devic
         json["options"][3] = "Slowest";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "advertising_mode", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -1324,7 +1324,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalLockEntities(char *devic
 
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "timezone", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -1484,7 +1484,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalLockEntities(char *devic
         json["options"][6] = "Show Status";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "single_button_press_action", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -1504,7 +1504,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalLockEntities(char *devic
         json["options"][6] = "Show Status";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "double_button_press_action", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -1550,7 +1550,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalLockEntities(char *devic
         json["options"][2] = "Lithium";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "battery_type", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -1893,7 +1893,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalLockEntities(char *devic
         json["options"][2] = "Gentle";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "motor_speed", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -2091,7 +2091,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalOpenerEntities(char *dev
     json["event_types"][2] = "standby";
     serializeJson(json, _buffer, _bufferSize);
     String path = createHassTopicPath("event", "ring", uidString);
-    _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+    _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
 
     if((int)basicOpenerConfigAclPrefs[5] == 1)
     {
@@ -2287,7 +2287,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalOpenerEntities(char *dev
         json["options"][5] = "Ring";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "fob_action_1", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -2306,7 +2306,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalOpenerEntities(char *dev
         json["options"][5] = "Ring";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "fob_action_2", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -2325,7 +2325,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalOpenerEntities(char *dev
         json["options"][5] = "Ring";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "fob_action_3", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -2342,7 +2342,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalOpenerEntities(char *dev
         json["options"][3] = "Slowest";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "advertising_mode", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -2403,7 +2403,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalOpenerEntities(char *dev
 
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "timezone", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -2432,7 +2432,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalOpenerEntities(char *dev
         json["options"][15] = "Spare";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "operating_mode", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -2656,7 +2656,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalOpenerEntities(char *dev
         json["options"][7] = "CM & RTO & Ring";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "doorbell_suppression", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -2702,7 +2702,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalOpenerEntities(char *dev
         json["options"][3] = "Sound 3";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "sound_ring", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -2719,7 +2719,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalOpenerEntities(char *dev
         json["options"][3] = "Sound 3";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "sound_open", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -2736,7 +2736,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalOpenerEntities(char *dev
         json["options"][3] = "Sound 3";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "sound_rto", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -2753,7 +2753,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalOpenerEntities(char *dev
         json["options"][3] = "Sound 3";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "sound_cm", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -2804,7 +2804,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalOpenerEntities(char *dev
         json["options"][7] = "Open";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "single_button_press_action", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -2825,7 +2825,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalOpenerEntities(char *dev
         json["options"][7] = "Open";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "double_button_press_action", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -2841,7 +2841,7 @@ void HomeAssistantDiscovery::publishHASSConfigAdditionalOpenerEntities(char *dev
         json["options"][2] = "Lithium";
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath("select", "battery_type", uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
     else
     {
@@ -2994,7 +2994,7 @@ void HomeAssistantDiscovery::publishHassTopic(const String& mqttDeviceType,
         json = createHassJson(uidString, uidStringPostfix, displayName, name, baseTopic, stateTopic, deviceType, deviceClass, stateClass, entityCat, commandTopic, additionalEntries);
         serializeJson(json, _buffer, _bufferSize);
         String path = createHassTopicPath(mqttDeviceType, mqttDeviceName, uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer);
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, _buffer, espMqttClientTypes::Priority::BULK);
     }
 }
 
@@ -3017,7 +3017,7 @@ void HomeAssistantDiscovery::removeHassTopic(const String& mqttDeviceType, const
     if (_discoveryTopic != "")
     {
         String path = createHassTopicPath(mqttDeviceType, mqttDeviceName, uidString);
-        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, "");
+        _device->mqttPublish(path.c_str(), MQTT_QOS_LEVEL, true, "", espMqttClientTypes::Priority::BULK);
     }
 }
 
@@ -115,24 +115,6 @@ void ImportExport::setDuoCheckId(String duoCheckId)
     _duoCheckId = duoCheckId;
 }
 
-void ImportExport::saveSessions()
-{
-    if(_preferences->getBool(preference_update_time, false))
-    {
-        if (!SPIFFS.begin(true))
-        {
-            Log->println("SPIFFS Mount Failed");
-        }
-        else
-        {
-            File file;
-            file = SPIFFS.open("/duosessions.json", "w");
-            serializeJson(_duoSessions, file);
-            file.close();
-        }
-    }
-}
-
 int ImportExport::checkDuoAuth(PsychicRequest *request)
 {
     const char* duo_host = _duoHost.c_str();
@@ -187,8 +169,7 @@ int ImportExport::checkDuoAuth(PsychicRequest *request)
                         struct timeval time;
                         gettimeofday(&time, NULL);
                         int64_t time_us = (int64_t)time.tv_sec * 1000000L + (int64_t)time.tv_usec;
-                        _duoSessions[id] = time_us + (durationLength*1000000L);
-                        saveSessions();
+                        _duoSessions.add(id.c_str(), time_us + (durationLength*1000000L), time_us);
                         if (_preferences->getBool(preference_mfa_reconfigure, false))
                         {
                             _preferences->putBool(preference_mfa_reconfigure, false);
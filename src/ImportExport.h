@@ -3,6 +3,7 @@
 #include <Preferences.h>
 #include "ArduinoJson.h"
 #include <PsychicHttp.h>
+#include "SessionStore.h"
 
 class ImportExport
 {
@@ -26,16 +27,15 @@ public:
     void readSettings();
     void setDuoCheckIP(String duoCheckIP);
     void setDuoCheckId(String duoCheckId);
-    JsonDocument _duoSessions;
-    JsonDocument _totpSessions;
+    SessionStore _duoSessions;
+    SessionStore _totpSessions;
     JsonDocument _sessionsOpts;
-    JsonDocument _bypassSessions;
+    SessionStore _bypassSessions;
     int64_t _lastCodeCheck = 0;
     int64_t _lastCodeCheck2 = 0;
     int _invalidCount = 0;
     int _invalidCount2 = 0;
 private:
-    void saveSessions();
     Preferences* _preferences;
     struct tm timeinfo;
     bool _totpEnabled = false;
@@ -0,0 +1,300 @@
+#include "JobScheduler.h"
+
+JobScheduler::JobScheduler(uint32_t tickMs, uint32_t spreadMs)
+    : _tickMs(tickMs > 0 ? tickMs : 1),
+      _spreadMs(spreadMs)
+{
+    for(int i = 0; i <= READY_LIST; i++)
+    {
+        _heads[i] = NONE;
+    }
+}
+
+int JobScheduler::add(const char* name, uint8_t owner, uint8_t priority, Job job)
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    Entry entry;
+    entry.name = name;
+    entry.owner = owner;
+    entry.priority = priority;
+    entry.job = job;
+    entry.dueTs = INT64_MAX;
+    entry.list = NONE;
+    entry.prev = NONE;
+    entry.next = NONE;
+    _entries.push_back(entry);
+    return _entries.size() - 1;
+}
+
+void JobScheduler::schedule(int id, int64_t dueTs, bool spread)
+{
+    if(id < 0 || id >= (int)_entries.size())
+    {
+        return;
+    }
+
+    const std::lock_guard<std::mutex> lock(_mutex);
+    unlink(id);
+    _entries[id].dueTs = spread ? spreadDueTs(id, dueTs) : dueTs;
+    insert(id);
+}
+
+void JobScheduler::scheduleEarlier(int id, int64_t dueTs)
+{
+    if(id < 0 || id >= (int)_entries.size())
+    {
+        return;
+    }
+
+    const std::lock_guard<std::mutex> lock(_mutex);
+    if(_entries[id].list == NONE || dueTs < _entries[id].dueTs)
+    {
+        unlink(id);
+        _entries[id].dueTs = dueTs;
+        insert(id);
+    }
+}
+
+void JobScheduler::cancel(int id)
+{
+    if(id < 0 || id >= (int)_entries.size())
+    {
+        return;
+    }
+
+    const std::lock_guard<std::mutex> lock(_mutex);
+    unlink(id);
+    _entries[id].dueTs = INT64_MAX;
+}
+
+bool JobScheduler::scheduled(int id) const
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    return id >= 0 && id < (int)_entries.size() && _entries[id].list != NONE;
+}
+
+int64_t JobScheduler::dueTs(int id) const
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    return (id >= 0 && id < (int)_entries.size() && _entries[id].list != NONE) ? _entries[id].dueTs : INT64_MAX;
+}
+
+const char* JobScheduler::name(int id) const
+{
+    return (id >= 0 && id < (int)_entries.size()) ? _entries[id].name : "";
+}
+
+bool JobScheduler::runNext(int64_t now)
+{
+    Job* job = nullptr;
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        advance(now);
+
+        int best = NONE;
+        for(int id = _heads[READY_LIST]; id != NONE; id = _entries[id].next)
+        {
+            const Entry& entry = _entries[id];
+            if(entry.dueTs > now)
+            {
+                continue;
+            }
+            if(best == NONE || entry.priority < _entries[best].priority ||
+                    (entry.priority == _entries[best].priority && entry.dueTs < _entries[best].dueTs))
+            {
+                best = id;
+            }
+        }
+
+        if(best == NONE)
+        {
+            return false;
+        }
+
+        unlink(best);
+        _entries[best].dueTs = INT64_MAX;
+        ++_runs;
+        job = &_entries[best].job;
+    }
+
+    // outside the lock, the job re-arms itself
+    (*job)(now);
+    return true;
+}
+
+int64_t JobScheduler::nextDeadline() const
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+
+    // few jobs, a linear scan is cheaper than walking the slots
+    int64_t deadline = INT64_MAX;
+    for(const Entry& entry : _entries)
+    {
+        if(entry.list != NONE && entry.dueTs < deadline)
+        {
+            deadline = entry.dueTs;
+        }
+    }
+    return deadline;
+}
+
+uint32_t JobScheduler::runs() const
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    return _runs;
+}
+
+uint32_t JobScheduler::spread() const
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    return _spread;
+}
+
+void JobScheduler::insert(int id)
+{
+    int64_t tick = toTick(_entries[id].dueTs);
+    int64_t delta = tick - _currentTick;
+
+    if(delta <= 0)
+    {
+        link(id, READY_LIST);
+        return;
+    }
+
+    for(int level = 0; level < LEVELS; level++)
+    {
+        if(delta < ((int64_t)1 << (SLOT_BITS * (level + 1))))
+        {
+            int slot = (tick >> (SLOT_BITS * level)) & (SLOTS - 1);
+            link(id, level * SLOTS + slot);
+            return;
+        }
+    }
+    link(id, OVERFLOW_LIST);
+}
+
+void JobScheduler::link(int id, int list)
+{
+    Entry& entry = _entries[id];
+    entry.list = list;
+    entry.prev = NONE;
+    entry.next = _heads[list];
+    if(entry.next != NONE)
+    {
+        _entries[entry.next].prev = id;
+    }
+    _heads[list] = id;
+}
+
+void JobScheduler::unlink(int id)
+{
+    Entry& entry = _entries[id];
+    if(entry.list == NONE)
+    {
+        return;
+    }
+    if(entry.prev != NONE)
+    {
+        _entries[entry.prev].next = entry.next;
+    }
+    else
+    {
+        _heads[entry.list] = entry.next;
+    }
+    if(entry.next != NONE)
+    {
+        _entries[entry.next].prev = entry.prev;
+    }
+    entry.list = NONE;
+    entry.prev = NONE;
+    entry.next = NONE;
+}
+
+void JobScheduler::cascade(int list)
+{
+    int id = _heads[list];
+    _heads[list] = NONE;
+    while(id != NONE)
+    {
+        int next = _entries[id].next;
+        _entries[id].list = NONE;
+        insert(id);
+        id = next;
+    }
+}
+
+void JobScheduler::advance(int64_t now)
+{
+    int64_t target = toTick(now);
+    while(_currentTick < target)
+    {
+        ++_currentTick;
+
+        // refill the lower levels when a level wraps
+        for(int level = 1; level <= LEVELS; level++)
+        {
+            if((_currentTick & (((int64_t)1 << (SLOT_BITS * level)) - 1)) != 0)
+            {
+                break;
+            }
+            if(level == LEVELS)
+            {
+                cascade(OVERFLOW_LIST);
+            }
+            else
+            {
+                cascade(level * SLOTS + ((_currentTick >> (SLOT_BITS * level)) & (SLOTS - 1)));
+            }
+        }
+
+        cascade(_currentTick & (SLOTS - 1));
+
+        // nothing armed on the lower levels, skip ahead to the next level boundary
+        bool lowerEmpty = true;
+        for(int slot = 0; slot < SLOTS && lowerEmpty; slot++)
+        {
+            lowerEmpty = _heads[slot] == NONE;
+        }
+        if(lowerEmpty)
+        {
+            int64_t boundary = (_currentTick | (SLOTS - 1));
+            _currentTick = boundary < target ? boundary : _currentTick;
+        }
+    }
+}
+
+int64_t JobScheduler::spreadDueTs(int id, int64_t dueTs)
+{
+    if(_spreadMs == 0)
+    {
+        return dueTs;
+    }
+
+    // move back until no job of another owner is due within the spread time
+    bool moved = true;
+    for(int attempts = 0; moved && attempts < (int)_entries.size(); attempts++)
+    {
+        moved = false;
+        for(int other = 0; other < (int)_entries.size(); other++)
+        {
+            const Entry& entry = _entries[other];
+            if(other == id || entry.list == NONE || entry.owner == _entries[id].owner)
+            {
+                continue;
+            }
+            if(dueTs > entry.dueTs - (int64_t)_spreadMs && dueTs < entry.dueTs + (int64_t)_spreadMs)
+            {
+                dueTs = entry.dueTs + _spreadMs;
+                _spread++;
+                moved = true;
+            }
+        }
+    }
+    return dueTs;
+}
+
+int64_t JobScheduler::toTick(int64_t ts) const
+{
+    // rounded up, a job never runs before its due time
+    return (ts + _tickMs - 1) / _tickMs;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/*
+ * Hierarchical timer wheel for the periodic Nuki queries (lock state, battery, config, keypad, ...).
+ *
+ * Jobs are registered once and (re)armed with an absolute due time. Three levels of 64 slots
+ * cover 64, 4096 and 262144 ticks, later deadlines wait in an overflow list and are cascaded
+ * down as time advances. runNext() runs at most one due job per call, the one with the highest
+ * priority (lowest value), so BLE transactions are serialized and the caller's loop stays
+ * responsive. A periodic job can ask to be spread: when it is due close to a job of another owner
+ * (lock vs. opener), it is moved back by the spread time so their BLE transactions don't run back
+ * to back.
+ *
+ * A job is disarmed before it runs and re-arms itself if it is periodic. Jobs may be armed from
+ * any task, they only run from the task calling runNext(). Time is passed in by the caller, the
+ * scheduler has no platform dependencies.
+ */
+class JobScheduler
+{
+public:
+    typedef std::function<void(int64_t now)> Job;
+
+    JobScheduler(uint32_t tickMs = 50, uint32_t spreadMs = 500);
+
+    int add(const char* name, uint8_t owner, uint8_t priority, Job job); // during setup, before runNext()
+    void schedule(int id, int64_t dueTs, bool spread = false);
+    void scheduleEarlier(int id, int64_t dueTs); // only moves the deadline forward
+    void cancel(int id);
+
+    bool scheduled(int id) const;
+    int64_t dueTs(int id) const; // INT64_MAX if not scheduled
+    const char* name(int id) const;
+
+    bool runNext(int64_t now);
+    int64_t nextDeadline() const; // INT64_MAX if nothing is scheduled
+
+    uint32_t runs() const;
+    uint32_t spread() const;
+
+private:
+    static const int LEVELS = 3;
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const int OVERFLOW_LIST = LEVELS * SLOTS;
+    static const int READY_LIST = OVERFLOW_LIST + 1;
+    static const int NONE = -1;
+
+    struct Entry
+    {
+        const char* name;
+        uint8_t owner;
+        uint8_t priority;
+        Job job;
+        int64_t dueTs;
+        int list;
+        int prev;
+        int next;
+    };
+
+    void insert(int id);
+    void unlink(int id);
+    void link(int id, int list);
+    void cascade(int list);
+    void advance(int64_t now);
+    int64_t spreadDueTs(int id, int64_t dueTs);
+    int64_t toTick(int64_t ts) const;
+
+    mutable std::mutex _mutex;
+    const uint32_t _tickMs;
+    const uint32_t _spreadMs;
+    std::vector<Entry> _entries;
+    int _heads[READY_LIST + 1];
+    int64_t _currentTick = 0;
+    uint32_t _runs = 0;
+    uint32_t _spread = 0;
+};
@@ -0,0 +1,143 @@
+#include "JsonStreamWriter.h"
+#include <cstring>
+
+JsonStreamWriter::JsonStreamWriter(Print& out)
+    : _out(out)
+{
+}
+
+void JsonStreamWriter::beginObject(const char* key)
+{
+    writeKey(key);
+    _out.write('{');
+    if(_depth < JSON_STREAM_MAX_DEPTH)
+    {
+        _hasElements &= ~(1UL << _depth);
+        ++_depth;
+    }
+}
+
+void JsonStreamWriter::endObject()
+{
+    if(_depth > 0)
+    {
+        --_depth;
+    }
+    _out.write('}');
+}
+
+void JsonStreamWriter::beginArray(const char* key)
+{
+    writeKey(key);
+    _out.write('[');
+    if(_depth < JSON_STREAM_MAX_DEPTH)
+    {
+        _hasElements &= ~(1UL << _depth);
+        ++_depth;
+    }
+}
+
+void JsonStreamWriter::endArray()
+{
+    if(_depth > 0)
+    {
+        --_depth;
+    }
+    _out.write(']');
+}
+
+void JsonStreamWriter::addString(const char* key, const char* value)
+{
+    writeKey(key);
+    if(value == nullptr)
+    {
+        _out.print("null");
+        return;
+    }
+    writeString(value);
+}
+
+void JsonStreamWriter::addInt(const char* key, int32_t value)
+{
+    writeKey(key);
+    _out.print(value);
+}
+
+void JsonStreamWriter::addBool(const char* key, bool value)
+{
+    writeKey(key);
+    _out.print(value ? "true" : "false");
+}
+
+void JsonStreamWriter::addNull(const char* key)
+{
+    writeKey(key);
+    _out.print("null");
+}
+
+void JsonStreamWriter::writeKey(const char* key)
+{
+    if(_depth > 0)
+    {
+        uint32_t bit = 1UL << (_depth - 1);
+        if((_hasElements & bit) != 0)
+        {
+            _out.write(',');
+        }
+        _hasElements |= bit;
+    }
+
+    if(key != nullptr)
+    {
+        writeString(key);
+        _out.write(':');
+    }
+}
+
+void JsonStreamWriter::writeString(const char* value)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    _out.write('"');
+
+    // Runs of characters that need no escaping are written at once
+    const char* run = value;
+    for(const char* c = value; *c != 0x00; ++c)
+    {
+        uint8_t ch = (uint8_t)*c;
+        if(ch >= 0x20 && ch != '"' && ch != '\\')
+        {
+            continue;
+        }
+
+        _out.write((const uint8_t*)run, c - run);
+        run = c + 1;
+
+        switch(ch)
+        {
+        case '"':
+            _out.print("\\\"");
+            break;
+        case '\\':
+            _out.print("\\\\");
+            break;
+        case '\n':
+            _out.print("\\n");
+            break;
+        case '\r':
+            _out.print("\\r");
+            break;
+        case '\t':
+            _out.print("\\t");
+            break;
+        default:
+            _out.print("\\u00");
+            _out.write(hex[ch >> 4]);
+            _out.write(hex[ch & 0x0F]);
+            break;
+        }
+    }
+
+    _out.write((const uint8_t*)run, strlen(run));
+    _out.write('"');
+}
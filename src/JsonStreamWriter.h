@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Nesting is tracked in a bit mask
+#define JSON_STREAM_MAX_DEPTH 32
+
+/*
+ * Writes JSON directly to a Print, e.g. a PsychicStreamResponse, so a response is sent in chunks
+ * while it is generated instead of being built as JsonDocument and serialized as a whole.
+ * Keys and strings are escaped, the caller is responsible for closing what it opened.
+ * Array elements are written by passing nullptr as key.
+ */
+class JsonStreamWriter
+{
+public:
+    explicit JsonStreamWriter(Print& out);
+
+    void beginObject(const char* key = nullptr);
+    void endObject();
+    void beginArray(const char* key = nullptr);
+    void endArray();
+
+    void addString(const char* key, const char* value);
+    void addInt(const char* key, int32_t value);
+    void addBool(const char* key, bool value);
+    void addNull(const char* key);
+
+private:
+    void writeKey(const char* key);
+    void writeString(const char* value);
+
+    Print& _out;
+    uint32_t _hasElements = 0;
+    uint8_t _depth = 0;
+};
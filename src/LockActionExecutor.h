@@ -0,0 +1,241 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+/*
+ * Queues lock actions and runs them without blocking the nuki task.
+ *
+ * submit() may be called from any task (MQTT, web server, nuki task) but not from an interrupt, it
+ * takes a mutex; GPIO actions are handed to the nuki task first. The owner polls next() from its
+ * update loop; when an attempt is due it executes the returned command and reports the outcome
+ * with complete(). A failed attempt is retried after the retry delay instead of waiting in place.
+ * Commands run in the order they were submitted and carry an id that is echoed with the result.
+ *
+ * Coalescing: state changing actions (e.g. lock, unlock) only matter for the state they leave
+ * behind. A new one replaces those queued after the last momentary action (e.g. unlatch) and
+ * cancels the remaining retries of one that is failing, a duplicate of the last queued action is
+ * merged into it. Momentary actions are always kept.
+ */
+template<typename Action, size_t Capacity = 4>
+class LockActionExecutor
+{
+public:
+    struct Command
+    {
+        uint32_t id = 0;
+        Action action {};
+        int retryCount = 0;
+    };
+
+    enum class Step
+    {
+        Idle,
+        Success,
+        Retry,
+        Failed,
+        Superseded
+    };
+
+    explicit LockActionExecutor(bool (*coalescable)(Action))
+        : _coalescable(coalescable)
+    {}
+
+    void setRetries(int nrOfRetries, int retryDelay)
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        _nrOfRetries = nrOfRetries;
+        _retryDelay = retryDelay;
+    }
+
+    // Called outside the lock for every command that was replaced before it succeeded
+    void onSuperseded(std::function<void(const Command&)> callback)
+    {
+        _supersededCallback = callback;
+    }
+
+    // Returns the id of the queued command, 0 if the queue is full. Task context only.
+    uint32_t submit(Action action)
+    {
+        Command superseded[Capacity];
+        size_t nrSuperseded = 0;
+        uint32_t id = 0;
+        {
+            const std::lock_guard<std::mutex> lock(_mutex);
+
+            if(_coalescable(action) && _count > 0)
+            {
+                Entry& tail = _entries[index(_count - 1)];
+                if(tail.command.action == action && !tail.superseded)
+                {
+                    ++_coalesced;
+                    return tail.command.id;
+                }
+
+                while(_count > 0)
+                {
+                    Entry& last = _entries[index(_count - 1)];
+                    if(!_coalescable(last.command.action))
+                    {
+                        break;
+                    }
+                    if(last.running)
+                    {
+                        // decided when the attempt completes
+                        last.superseded = true;
+                        break;
+                    }
+                    superseded[nrSuperseded++] = last.command;
+                    --_count;
+                }
+            }
+
+            if(_count == Capacity)
+            {
+                ++_rejected;
+            }
+            else
+            {
+                id = _nextId++;
+                if(_nextId == 0)
+                {
+                    _nextId = 1;
+                }
+                Entry& entry = _entries[index(_count)];
+                entry = Entry();
+                entry.command.id = id;
+                entry.command.action = action;
+                ++_count;
+            }
+            _superseded += nrSuperseded;
+        }
+
+        if(_supersededCallback)
+        {
+            for(size_t i = 0; i < nrSuperseded; ++i)
+            {
+                _supersededCallback(superseded[i]);
+            }
+        }
+        return id;
+    }
+
+    // Returns true and the command to execute when an attempt is due at 'now'
+    bool next(int64_t now, Command& command)
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        if(_count == 0)
+        {
+            return false;
+        }
+        Entry& head = _entries[_head];
+        if(head.running || now < head.nextAttemptTs)
+        {
+            return false;
+        }
+        head.running = true;
+        command = head.command;
+        return true;
+    }
+
+    // Reports the outcome of the attempt handed out by next(), command.retryCount is updated
+    Step complete(bool success, int64_t now, Command& command)
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        if(_count == 0 || !_entries[_head].running)
+        {
+            return Step::Idle;
+        }
+        Entry& head = _entries[_head];
+        head.running = false;
+
+        Step step = Step::Failed;
+        if(success)
+        {
+            step = Step::Success;
+        }
+        else if(head.superseded)
+        {
+            ++_superseded;
+            step = Step::Superseded;
+        }
+        else if(head.command.retryCount < _nrOfRetries)
+        {
+            ++head.command.retryCount;
+            head.nextAttemptTs = now + _retryDelay;
+            step = Step::Retry;
+        }
+
+        command = head.command;
+        if(step != Step::Retry)
+        {
+            _head = (_head + 1) % Capacity;
+            --_count;
+        }
+        return step;
+    }
+
+    // Time the next attempt is due, INT64_MAX if there is nothing to run
+    int64_t nextAttemptTs()
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        if(_count == 0 || _entries[_head].running)
+        {
+            return INT64_MAX;
+        }
+        return _entries[_head].nextAttemptTs;
+    }
+
+    size_t size()
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        return _count;
+    }
+
+    uint32_t coalesced()
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        return _coalesced;
+    }
+
+    uint32_t superseded()
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        return _superseded;
+    }
+
+    uint32_t rejected()
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        return _rejected;
+    }
+
+private:
+    struct Entry
+    {
+        Command command;
+        int64_t nextAttemptTs = 0;
+        bool running = false;
+        bool superseded = false;
+    };
+
+    size_t index(size_t position) const
+    {
+        return (_head + position) % Capacity;
+    }
+
+    bool (*_coalescable)(Action);
+    std::function<void(const Command&)> _supersededCallback;
+    std::mutex _mutex;
+    Entry _entries[Capacity];
+    size_t _head = 0;
+    size_t _count = 0;
+    uint32_t _nextId = 1;
+    int _nrOfRetries = 0;
+    int _retryDelay = 0;
+    uint32_t _coalesced = 0;
+    uint32_t _superseded = 0;
+    uint32_t _rejected = 0;
+};
@@ -1,7 +0,0 @@
-#pragma once
-
-class MqttReceiver
-{
-public:
-    virtual void onMqttDataReceived(const char* topic, byte* payload, const unsigned int length) = 0;
-};
\ No newline at end of file
@@ -0,0 +1,202 @@
+#include "MqttTopicRegistry.h"
+#include <cstring>
+#include <cstdlib>
+#include "esp_heap_caps.h"
+
+#define MQTT_TOPIC_REGISTRY_ARENA_STEP 1024
+
+MqttTopicRegistry::MqttTopicRegistry()
+{
+    memset(_slots, 0xFF, sizeof(_slots));
+}
+
+MqttTopicRegistry::~MqttTopicRegistry()
+{
+    free(_arena);
+}
+
+MqttTopicRegistry::Key::Key(const char* prefix, const char* path)
+    : prefix(prefix),
+      prefixLen(strlen(prefix)),
+      path(path[0] == '/' ? path + 1 : path),
+      pathLen(strlen(this->path))
+{
+}
+
+uint16_t MqttTopicRegistry::add(const char* prefix, const char* path)
+{
+    Key key(prefix, path);
+    uint32_t h = hash(key);
+    uint16_t id = find(key, h);
+    if(id != InvalidId)
+    {
+        return id;
+    }
+
+    // keep the table at most 75% full so probe sequences stay short
+    if(_entries.size() >= (MQTT_TOPIC_REGISTRY_SLOTS / 4) * 3)
+    {
+        return InvalidId;
+    }
+
+    size_t len = key.prefixLen + 1 + key.pathLen + 1;
+
+    if(_arenaSize + len > UINT16_MAX || !reserve(_arenaSize + len))
+    {
+        return InvalidId;
+    }
+
+    char* out = _arena + _arenaSize;
+    memcpy(out, key.prefix, key.prefixLen);
+    out[key.prefixLen] = '/';
+    memcpy(out + key.prefixLen + 1, key.path, key.pathLen + 1);
+
+    id = _entries.size();
+    _entries.push_back({h, (uint16_t)_arenaSize, (uint16_t)(len - 1)});
+    _arenaSize += len;
+
+    uint32_t slot = h & (MQTT_TOPIC_REGISTRY_SLOTS - 1);
+    while(_slots[slot] != InvalidId)
+    {
+        slot = (slot + 1) & (MQTT_TOPIC_REGISTRY_SLOTS - 1);
+    }
+    _slots[slot] = id;
+
+    return id;
+}
+
+void MqttTopicRegistry::add(const char* prefix, const std::vector<char*>& paths)
+{
+    for(const char* path : paths)
+    {
+        add(prefix, path);
+    }
+}
+
+uint16_t MqttTopicRegistry::find(const char* prefix, const char* path) const
+{
+    Key key(prefix, path);
+    return find(key, hash(key));
+}
+
+uint16_t MqttTopicRegistry::find(const Key& key, const uint32_t h) const
+{
+    const size_t length = key.prefixLen + 1 + key.pathLen;
+    uint32_t slot = h & (MQTT_TOPIC_REGISTRY_SLOTS - 1);
+
+    while(_slots[slot] != InvalidId)
+    {
+        const Entry& entry = _entries[_slots[slot]];
+        const char* topic = _arena + entry.offset;
+        if(entry.hash == h && entry.length == length &&
+                memcmp(topic, key.prefix, key.prefixLen) == 0 &&
+                memcmp(topic + key.prefixLen + 1, key.path, key.pathLen) == 0)
+        {
+            return _slots[slot];
+        }
+        slot = (slot + 1) & (MQTT_TOPIC_REGISTRY_SLOTS - 1);
+    }
+
+    return InvalidId;
+}
+
+const char* MqttTopicRegistry::topic(const uint16_t id) const
+{
+    if(id >= _entries.size())
+    {
+        return nullptr;
+    }
+    return _arena + _entries[id].offset;
+}
+
+bool MqttTopicRegistry::equals(const char* prefix, const char* path, const char* fullPath) const
+{
+    // compare prefix and path in place, a lookup would have to compare them as well
+    size_t prefixLen = strlen(prefix);
+    if(strncmp(fullPath, prefix, prefixLen) != 0)
+    {
+        return false;
+    }
+    fullPath += prefixLen;
+
+    if(path[0] != '/')
+    {
+        if(fullPath[0] != '/')
+        {
+            return false;
+        }
+        ++fullPath;
+    }
+
+    return strcmp(fullPath, path) == 0;
+}
+
+size_t MqttTopicRegistry::count() const
+{
+    return _entries.size();
+}
+
+size_t MqttTopicRegistry::arenaSize() const
+{
+    return _arenaSize;
+}
+
+static uint32_t tailWord(const char* str, const size_t len, const size_t skip)
+{
+    uint32_t word = 0;
+    if(len >= skip + 4)
+    {
+        memcpy(&word, str + len - skip - 4, 4);
+    }
+    else
+    {
+        for(size_t i = skip; i < len; i++)
+        {
+            word = (word << 8) | (uint8_t)str[len - 1 - i];
+        }
+    }
+    return word;
+}
+
+static uint32_t mix(uint32_t h, const uint32_t word)
+{
+    h ^= word;
+    h *= 2654435761UL;
+    return h ^ (h >> 15);
+}
+
+uint32_t MqttTopicRegistry::hash(const Key& key)
+{
+    uint32_t h = ((uint32_t)key.prefixLen << 16) | (uint32_t)key.pathLen;
+    h = mix(h, tailWord(key.prefix, key.prefixLen, 0));
+    h = mix(h, tailWord(key.path, key.pathLen, 0));
+    h = mix(h, tailWord(key.path, key.pathLen, 4));
+    return h ^ (h >> 16);
+}
+
+bool MqttTopicRegistry::reserve(const size_t size)
+{
+    if(size <= _arenaCapacity)
+    {
+        return true;
+    }
+
+    size_t capacity = ((size / MQTT_TOPIC_REGISTRY_ARENA_STEP) + 1) * MQTT_TOPIC_REGISTRY_ARENA_STEP;
+    char* arena = nullptr;
+
+#ifdef CONFIG_SOC_SPIRAM_SUPPORTED
+    arena = (char*)heap_caps_realloc(_arena, capacity, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+#endif
+    if(arena == nullptr)
+    {
+        arena = (char*)realloc(_arena, capacity);
+    }
+    if(arena == nullptr)
+    {
+        return false;
+    }
+
+    _arena = arena;
+    _arenaCapacity = capacity;
+    return true;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#define MQTT_TOPIC_REGISTRY_SLOTS 512
+
+// Interns full MQTT topic paths (prefix + topic) into a single arena so that
+// publishing registered topics doesn't require rebuilding the path every
+// time. Entries are found by content, not by the address of the strings, so
+// any copy of a prefix or topic resolves to the same entry. All registration
+// has to be finished before the tasks are started, after that the registry
+// is read only.
+class MqttTopicRegistry
+{
+public:
+    static const uint16_t InvalidId = 0xFFFF;
+
+    MqttTopicRegistry();
+    ~MqttTopicRegistry();
+
+    uint16_t add(const char* prefix, const char* path);
+    void add(const char* prefix, const std::vector<char*>& paths);
+
+    uint16_t find(const char* prefix, const char* path) const;
+    const char* topic(const uint16_t id) const;
+    bool equals(const char* prefix, const char* path, const char* fullPath) const;
+
+    size_t count() const;
+    size_t arenaSize() const;
+
+private:
+    struct Entry
+    {
+        uint32_t hash;
+        uint16_t offset;
+        uint16_t length;
+    };
+
+    // Prefix and path with their lengths, the path without its leading "/"
+    struct Key
+    {
+        Key(const char* prefix, const char* path);
+
+        const char* prefix;
+        size_t prefixLen;
+        const char* path;
+        size_t pathLen;
+    };
+
+    uint16_t find(const Key& key, const uint32_t h) const;
+    // Mixes the lengths and the last bytes of prefix and path instead of
+    // hashing every character, the topics differ at their end anyway
+    static uint32_t hash(const Key& key);
+    bool reserve(const size_t size);
+
+    std::vector<Entry> _entries;
+    uint16_t _slots[MQTT_TOPIC_REGISTRY_SLOTS];
+    char* _arena = nullptr;
+    size_t _arenaSize = 0;
+    size_t _arenaCapacity = 0;
+};
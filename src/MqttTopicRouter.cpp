@@ -0,0 +1,89 @@
+#include "MqttTopicRouter.h"
+#include <cstring>
+
+#define MQTT_TOPIC_ROUTER_EMPTY 0xFF
+
+MqttTopicRouter::MqttTopicRouter(const MqttTopicRegistry* registry)
+    : _registry(registry)
+{
+    memset(_slots, MQTT_TOPIC_ROUTER_EMPTY, sizeof(_slots));
+}
+
+bool MqttTopicRouter::add(const uint16_t topicId, MqttTopicHandler handler)
+{
+    const char* topic = _registry->topic(topicId);
+
+    if(topic == nullptr || _routes.size() >= (MQTT_TOPIC_ROUTER_SLOTS / 4) * 3)
+    {
+        return false;
+    }
+
+    uint32_t h = hash(topic);
+    uint32_t slot = h & (MQTT_TOPIC_ROUTER_SLOTS - 1);
+    while(_slots[slot] != MQTT_TOPIC_ROUTER_EMPTY)
+    {
+        slot = (slot + 1) & (MQTT_TOPIC_ROUTER_SLOTS - 1);
+    }
+
+    _slots[slot] = _routes.size();
+    _routes.push_back({h, topicId, handler});
+    return true;
+}
+
+void MqttTopicRouter::addFallback(const char* topic, MqttTopicHandler handler)
+{
+    _fallbackRoutes.push_back({topic, handler});
+}
+
+bool MqttTopicRouter::dispatch(const char* topic, const char* data, const unsigned int length) const
+{
+    bool dispatched = false;
+    uint32_t h = hash(topic);
+    uint32_t slot = h & (MQTT_TOPIC_ROUTER_SLOTS - 1);
+
+    while(_slots[slot] != MQTT_TOPIC_ROUTER_EMPTY)
+    {
+        const Route& route = _routes[_slots[slot]];
+        if(route.hash == h && strcmp(_registry->topic(route.topicId), topic) == 0)
+        {
+            route.handler(topic, data, length);
+            dispatched = true;
+        }
+        slot = (slot + 1) & (MQTT_TOPIC_ROUTER_SLOTS - 1);
+    }
+
+    for(const FallbackRoute& route : _fallbackRoutes)
+    {
+        if(route.topic == topic)
+        {
+            route.handler(topic, data, length);
+            dispatched = true;
+        }
+    }
+
+    return dispatched;
+}
+
+size_t MqttTopicRouter::count() const
+{
+    return _routes.size();
+}
+
+size_t MqttTopicRouter::fallbackCount() const
+{
+    return _fallbackRoutes.size();
+}
+
+uint32_t MqttTopicRouter::hash(const char* topic)
+{
+    uint32_t h = 2166136261UL;
+
+    while(*topic != 0x00)
+    {
+        h ^= (uint8_t)*topic;
+        h *= 16777619UL;
+        ++topic;
+    }
+
+    return h;
+}
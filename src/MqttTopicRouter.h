@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "MqttTopicRegistry.h"
+
+#define MQTT_TOPIC_ROUTER_SLOTS 128
+
+typedef std::function<void(const char* topic, const char* data, const unsigned int length)> MqttTopicHandler;
+
+// Dispatches incoming MQTT messages to the handler registered for the exact
+// topic. Routes are kept in an open addressing table indexed by the hash of
+// the full topic, so the cost of a dispatch doesn't depend on the number of
+// subscribed topics. Multiple handlers for the same topic are called in the
+// order they were added. Topics that don't fit into the table (or the
+// registry) are kept in a fallback list that is compared one by one. Like
+// the registry, routes have to be added before the tasks are started.
+class MqttTopicRouter
+{
+public:
+    explicit MqttTopicRouter(const MqttTopicRegistry* registry);
+
+    bool add(const uint16_t topicId, MqttTopicHandler handler);
+    void addFallback(const char* topic, MqttTopicHandler handler);
+    bool dispatch(const char* topic, const char* data, const unsigned int length) const;
+
+    size_t count() const;
+    size_t fallbackCount() const;
+
+private:
+    struct Route
+    {
+        uint32_t hash;
+        uint16_t topicId;
+        MqttTopicHandler handler;
+    };
+
+    struct FallbackRoute
+    {
+        std::string topic;
+        MqttTopicHandler handler;
+    };
+
+    static uint32_t hash(const char* topic);
+
+    const MqttTopicRegistry* _registry;
+    std::vector<Route> _routes;
+    std::vector<FallbackRoute> _fallbackRoutes;
+    uint8_t _slots[MQTT_TOPIC_ROUTER_SLOTS];
+};
@@ -21,6 +21,7 @@
 #define mqtt_topic_lock_auth_name (char*)"/authorizationName"
 #define mqtt_topic_lock_completionStatus (char*)"/completionStatus"
 #define mqtt_topic_lock_action_command_result (char*)"/commandResult"
+#define mqtt_topic_lock_action_command_result_json (char*)"/commandResultJson"
 #define mqtt_topic_lock_door_sensor_state (char*)"/doorSensorState"
 #define mqtt_topic_lock_rssi (char*)"/rssi"
 #define mqtt_topic_lock_address (char*)"/address"
@@ -57,6 +58,8 @@
 #define mqtt_topic_query_keypad (char*)"/query/keypad"
 #define mqtt_topic_query_battery (char*)"/query/battery"
 #define mqtt_topic_query_lockstate_command_result (char*)"/query/lockstateCommandResult"
+#define mqtt_topic_query_lockstate_performed (char*)"/query/lockstatePerformed"
+#define mqtt_topic_query_lockstate_avoided (char*)"/query/lockstateAvoided"
 
 #define mqtt_topic_battery_level (char*)"/battery/level"
 #define mqtt_topic_battery_critical (char*)"/battery/critical"
@@ -113,6 +116,11 @@
 #define mqtt_topic_restart_reason_esp (char*)"/maintenance/restartReasonNukiEsp"
 #define mqtt_topic_mqtt_connection_state (char*)"/maintenance/mqttConnectionState"
 #define mqtt_topic_network_device (char*)"/maintenance/networkDevice"
+#define mqtt_topic_publish_cache_hits (char*)"/maintenance/publishCacheHits"
+#define mqtt_topic_publish_cache_misses (char*)"/maintenance/publishCacheMisses"
+#define mqtt_topic_mqtt_queue (char*)"/maintenance/mqttQueue"
+#define mqtt_topic_mqtt_reconnect (char*)"/maintenance/mqttReconnect"
+#define mqtt_topic_ble_scan (char*)"/maintenance/bleScan"
 
 #define mqtt_topic_nuki_hub_config_action (char*)"/configuration/action"
 #define mqtt_topic_nuki_hub_config_action_command_result (char*)"/configuration/commandResult"
@@ -133,10 +141,11 @@ private:
         mqtt_topic_lock_action, mqtt_topic_lock_status_updated, mqtt_topic_lock_state, mqtt_topic_lock_ha_state, mqtt_topic_lock_json, mqtt_topic_lock_binary_state,
         mqtt_topic_lock_continuous_mode, mqtt_topic_lock_ring, mqtt_topic_lock_binary_ring, mqtt_topic_lock_trigger, mqtt_topic_lock_last_lock_action, mqtt_topic_lock_log,
         mqtt_topic_lock_log_latest, mqtt_topic_lock_log_rolling, mqtt_topic_lock_log_rolling_last, mqtt_topic_lock_auth_id, mqtt_topic_lock_auth_name, mqtt_topic_lock_completionStatus,
-        mqtt_topic_lock_action_command_result, mqtt_topic_lock_door_sensor_state, mqtt_topic_lock_rssi, mqtt_topic_lock_address, mqtt_topic_lock_retry, mqtt_topic_config_action,
+        mqtt_topic_lock_action_command_result, mqtt_topic_lock_action_command_result_json, mqtt_topic_lock_door_sensor_state, mqtt_topic_lock_rssi, mqtt_topic_lock_address, mqtt_topic_lock_retry, mqtt_topic_config_action,
         mqtt_topic_config_action_command_result, mqtt_topic_config_basic_json, mqtt_topic_config_advanced_json, mqtt_topic_config_button_enabled, mqtt_topic_config_led_enabled,
         mqtt_topic_config_led_brightness, mqtt_topic_config_auto_unlock, mqtt_topic_config_auto_lock, mqtt_topic_config_single_lock, mqtt_topic_config_sound_level,
         mqtt_topic_query_config, mqtt_topic_query_lockstate, mqtt_topic_query_keypad, mqtt_topic_query_battery, mqtt_topic_query_lockstate_command_result,
+        mqtt_topic_query_lockstate_performed, mqtt_topic_query_lockstate_avoided,
         mqtt_topic_battery_level, mqtt_topic_battery_critical, mqtt_topic_battery_charging, mqtt_topic_battery_voltage, mqtt_topic_battery_drain,
         mqtt_topic_battery_max_turn_current, mqtt_topic_battery_lock_distance, mqtt_topic_battery_keypad_critical, mqtt_topic_battery_doorsensor_critical,
         mqtt_topic_battery_basic_json,mqtt_topic_battery_advanced_json, mqtt_topic_keypad, mqtt_topic_keypad_codes, mqtt_topic_keypad_command_action, 
@@ -146,7 +155,8 @@ private:
         mqtt_topic_auth_json, mqtt_topic_auth_action, mqtt_topic_auth_command_result, mqtt_topic_info_hardware_version, mqtt_topic_info_firmware_version, 
         mqtt_topic_info_nuki_hub_version, mqtt_topic_info_nuki_hub_build, mqtt_topic_info_nuki_hub_latest, mqtt_topic_info_nuki_hub_ip, mqtt_topic_reset, 
         mqtt_topic_update, mqtt_topic_webserver_state, mqtt_topic_webserver_action, mqtt_topic_uptime, mqtt_topic_wifi_rssi, mqtt_topic_log, mqtt_topic_freeheap, 
-        mqtt_topic_restart_reason_fw, mqtt_topic_restart_reason_esp, mqtt_topic_mqtt_connection_state, mqtt_topic_network_device, mqtt_topic_hybrid_state
+        mqtt_topic_restart_reason_fw, mqtt_topic_restart_reason_esp, mqtt_topic_mqtt_connection_state, mqtt_topic_network_device, mqtt_topic_hybrid_state,
+        mqtt_topic_publish_cache_hits, mqtt_topic_publish_cache_misses, mqtt_topic_mqtt_queue, mqtt_topic_mqtt_reconnect, mqtt_topic_ble_scan
     };
 public:
     const std::vector<char*> getMqttTopics()
@@ -0,0 +1,91 @@
+#include "NukiBeaconTracker.h"
+#include "Beacon.h"
+#include "EspMillis.h"
+
+NukiBeaconTracker::NukiBeaconTracker(uint32_t safetyTimeout, uint32_t beaconTimeout, uint32_t settleTime)
+    : _safetyTimeout(safetyTimeout),
+      _beaconTimeout(beaconTimeout),
+      _settleTime(settleTime)
+{
+}
+
+void NukiBeaconTracker::setAddress(const BLEAddress& address)
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    _address = address;
+    _hasAddress = true;
+    _lastBeaconTs = 0;
+    _lastQueryTs = 0;
+}
+
+void NukiBeaconTracker::onAdvertisement(const BleScanner::Advertisement& advertisement)
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    if(!_hasAddress || advertisement.address != _address)
+    {
+        return;
+    }
+
+    BleScanner::Beacon beacon;
+    if(!BleScanner::decodeBeacon(advertisement.manufacturerData, advertisement.manufacturerDataLength, beacon))
+    {
+        return;
+    }
+
+    _lastBeaconTs = espMillis();
+    bool changed = (beacon.txPower & 0x01) != 0;
+    if(!changed || _lastQueryTs == 0 || _lastBeaconTs - _lastQueryTs >= _settleTime)
+    {
+        _changed = changed;
+    }
+}
+
+bool NukiBeaconTracker::skipPeriodicQuery(int64_t now)
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    if(_lastQueryTs == 0 ||
+            _changed ||
+            _lastBeaconTs == 0 ||
+            now - _lastBeaconTs > _beaconTimeout ||
+            now - _lastQueryTs >= _safetyTimeout)
+    {
+        return false;
+    }
+    ++_avoided;
+    return true;
+}
+
+bool NukiBeaconTracker::skipFlaggedQuery(int64_t now)
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    if(_lastQueryTs == 0 || now - _lastQueryTs >= _settleTime)
+    {
+        return false;
+    }
+    ++_avoided;
+    return true;
+}
+
+void NukiBeaconTracker::queried(bool success, int64_t now)
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    ++_performed;
+    // a failed query is never a reason to skip the next one
+    _lastQueryTs = success ? now : 0;
+    if(success)
+    {
+        _changed = false;
+    }
+}
+
+uint32_t NukiBeaconTracker::avoided()
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    return _avoided;
+}
+
+uint32_t NukiBeaconTracker::performed()
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    return _performed;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include "BleScanner.h"
+
+/*
+ * Follows the beacons of a paired device to skip state queries that can't return anything new.
+ *
+ * Nuki devices set bit 0 of the beacon's tx power while there is a state change that hasn't been
+ * read. The tracker remembers when the device was last heard and whether its last beacon had the
+ * bit set. A periodic query is skipped while the device is heard, reports no change and was read
+ * successfully within the safety timeout. Right after a successful query, flagged beacons still
+ * in flight carry the change that was just read, they don't need another query.
+ *
+ * Advertisements are delivered from the scanner's queue on the nuki task, not from the BLE host task.
+ */
+class NukiBeaconTracker : public BleScanner::AdvertisementSubscriber
+{
+public:
+    NukiBeaconTracker(uint32_t safetyTimeout, uint32_t beaconTimeout, uint32_t settleTime);
+
+    void setAddress(const BLEAddress& address);
+    void onAdvertisement(const BleScanner::Advertisement& advertisement) override;
+
+    // Decide whether a query is needed, skipped queries are counted as avoided
+    bool skipPeriodicQuery(int64_t now);
+    bool skipFlaggedQuery(int64_t now);
+    void queried(bool success, int64_t now);
+
+    uint32_t avoided();
+    uint32_t performed();
+
+private:
+    std::mutex _mutex;
+    const uint32_t _safetyTimeout;
+    const uint32_t _beaconTimeout;
+    const uint32_t _settleTime;
+    uint64_t _address = 0;
+    bool _hasAddress = false;
+    bool _changed = false;
+    int64_t _lastBeaconTs = 0;
+    int64_t _lastQueryTs = 0;
+    uint32_t _avoided = 0;
+    uint32_t _performed = 0;
+};
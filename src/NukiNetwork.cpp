@@ -11,6 +11,7 @@
 #endif
 #include "networkDevices/EthernetDevice.h"
 #include "hal/wdt_hal.h"
+#include "esp_random.h"
 
 NukiNetwork* NukiNetwork::_inst = nullptr;
 
@@ -21,6 +22,122 @@ extern bool forceEnableWebServer;
 extern const uint8_t x509_crt_imported_bundle_bin_start[] asm("_binary_x509_crt_bundle_start");
 extern const uint8_t x509_crt_imported_bundle_bin_end[]   asm("_binary_x509_crt_bundle_end");
 
+#ifndef NUKI_HUB_UPDATER
+static uint32_t fnv1aHash(const char* str)
+{
+    uint32_t hash = 2166136261UL;
+
+    while(*str != 0x00)
+    {
+        hash ^= (uint8_t)*str;
+        hash *= 16777619UL;
+        ++str;
+    }
+
+    return hash;
+}
+
+// command results are what a user is waiting for after an action, logs and lists can wait
+static espMqttClientTypes::Priority topicPriority(const char* topic)
+{
+    static const char* const controlTopics[] =
+    {
+        mqtt_topic_lock_action_command_result, mqtt_topic_lock_action_command_result_json, mqtt_topic_lock_completionStatus, mqtt_topic_config_action_command_result,
+        mqtt_topic_query_lockstate_command_result, mqtt_topic_keypad_command_result, mqtt_topic_keypad_json_command_result,
+        mqtt_topic_timecontrol_command_result, mqtt_topic_auth_command_result
+    };
+    static const char* const bulkTopics[] =
+    {
+        mqtt_topic_keypad_json, mqtt_topic_timecontrol_json, mqtt_topic_auth_json, mqtt_topic_config_basic_json,
+        mqtt_topic_config_advanced_json, mqtt_topic_battery_basic_json, mqtt_topic_battery_advanced_json, mqtt_topic_nuki_hub_config_json
+    };
+    static const char* const logTopics[] =
+    {
+        mqtt_topic_lock_log, mqtt_topic_lock_log_latest, mqtt_topic_lock_log_rolling, mqtt_topic_lock_log_rolling_last, mqtt_topic_log
+    };
+
+    for(const char* t : controlTopics)
+    {
+        if(strcmp(topic, t) == 0)
+        {
+            return espMqttClientTypes::Priority::CONTROL;
+        }
+    }
+    for(const char* t : bulkTopics)
+    {
+        if(strcmp(topic, t) == 0)
+        {
+            return espMqttClientTypes::Priority::BULK;
+        }
+    }
+    for(const char* t : logTopics)
+    {
+        if(strcmp(topic, t) == 0)
+        {
+            return espMqttClientTypes::Priority::LOG;
+        }
+    }
+    return espMqttClientTypes::Priority::STATE;
+}
+
+// events that must not get lost while the broker is unreachable, they are kept on flash until sent
+static bool journaledTopic(const char* topic)
+{
+    static const char* const journaledTopics[] =
+    {
+        mqtt_topic_lock_log_rolling, mqtt_topic_lock_ring, mqtt_topic_lock_binary_ring, mqtt_topic_lock_action_command_result,
+        mqtt_topic_lock_action_command_result_json,
+        mqtt_topic_config_action_command_result, mqtt_topic_query_lockstate_command_result, mqtt_topic_keypad_command_result,
+        mqtt_topic_keypad_json_command_result, mqtt_topic_timecontrol_command_result, mqtt_topic_auth_command_result
+    };
+
+    for(const char* t : journaledTopics)
+    {
+        if(strcmp(topic, t) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ArduinoJson writer hashing and measuring the serialized document without materializing it
+class JsonHashWriter
+{
+public:
+    size_t write(uint8_t c)
+    {
+        _hash ^= c;
+        _hash *= 16777619UL;
+        ++_length;
+        return 1;
+    }
+
+    size_t write(const uint8_t* s, size_t n)
+    {
+        for(size_t i = 0; i < n; i++)
+        {
+            write(s[i]);
+        }
+        return n;
+    }
+
+    uint32_t hash() const
+    {
+        return _hash;
+    }
+
+    size_t length() const
+    {
+        return _length;
+    }
+
+private:
+    uint32_t _hash = 2166136261UL;
+    size_t _length = 0;
+};
+#endif
+
 #ifndef NUKI_HUB_UPDATER
 NukiNetwork::NukiNetwork(Preferences *preferences, Gpio* gpio, const String& maintenancePathPrefix, char* buffer, size_t bufferSize, ImportExport* importExport)
     : _preferences(preferences),
@@ -138,6 +255,10 @@ void NukiNetwork::setupDevice()
     {
         onMqttDisconnect(reason);
     });
+    _device->mqttOnSubscribe([&](uint16_t packetId, const espMqttClientTypes::SubscribeReturncode* returncodes, size_t len)
+    {
+        onMqttSubscribe(packetId, returncodes, len);
+    });
 
     _hadiscovery = new HomeAssistantDiscovery(_device, _preferences, _buffer, _bufferSize);
 #endif
@@ -348,7 +469,28 @@ void NukiNetwork::initialize()
             }
         }
 
+        MqttTopics mqttTopics;
+        registerTopics(_maintenancePathPrefix, mqttTopics.getMqttTopics());
+
+        addTopicRoute(_maintenancePathPrefix, mqtt_topic_reset, [this](const char* topic, const char* data, const unsigned int length)
+        {
+            onResetReceived(data);
+        });
+        addTopicRoute(_maintenancePathPrefix, mqtt_topic_update, [this](const char* topic, const char* data, const unsigned int length)
+        {
+            onUpdateReceived(data);
+        });
+        addTopicRoute(_maintenancePathPrefix, mqtt_topic_webserver_action, [this](const char* topic, const char* data, const unsigned int length)
+        {
+            onWebserverActionReceived(data);
+        });
+        addTopicRoute(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action, [this](const char* topic, const char* data, const unsigned int length)
+        {
+            onConfigActionReceived(data);
+        });
+
         readSettings();
+        initializeJournal();
     }
 }
 
@@ -412,10 +554,12 @@ bool NukiNetwork::update()
 
         if(_restartOnDisconnect && espMillis() > 60000)
         {
+            flushJournal();
             restartEsp(RestartReason::RestartOnDisconnectWatchdog);
         }
         else if(_disableNetworkIfNotConnected && espMillis() > 60000)
         {
+            flushJournal();
             disableNetwork = true;
             restartEsp(RestartReason::DisableNetworkIfNotConnected);
         }
@@ -429,43 +573,32 @@ bool NukiNetwork::update()
         _firstDisconnected = true;
     }
 
-    if(!_device->mqttConnected() && _device->isConnected())
+    bool mqttReady = false;
+
+    if(_device->isConnected())
     {
-        bool success = reconnect();
-        if(!success)
-        {
-            delay(2000);
-            _mqttConnectCounter++;
-            return false;
-        }
+        mqttReady = reconnect();
+    }
 
-        _mqttConnectCounter = 0;
-        if(forceEnableWebServer && !_webEnabled)
-        {
-            forceEnableWebServer = false;
-            delay(200);
-            restartEsp(RestartReason::ReconfigureWebServer);
-        }
-        else if(!_webEnabled)
+    // Also while the network is up but the broker can't be reached
+    if(!mqttReady && _networkTimeout > 0 && (ts - _lastConnectedTs > _networkTimeout * 1000) && ts > 60000)
+    {
+        if(!_webEnabled)
         {
-            forceEnableWebServer = false;
+            forceEnableWebServer = true;
         }
-        delay(2000);
+        Log->println("Network timeout has been reached, restarting ...");
+        flushJournal();
+        delay(200);
+        restartEsp(RestartReason::NetworkTimeoutWatchdog);
     }
 
-    if(!_device->mqttConnected() || !_device->isConnected())
+    // input changes are queued while the broker is unreachable and sent once connected
+    publishGpioStates();
+    updateJournal(mqttReady);
+
+    if(!mqttReady)
     {
-        if(_networkTimeout > 0 && (ts - _lastConnectedTs > _networkTimeout * 1000) && ts > 60000)
-        {
-            if(!_webEnabled)
-            {
-                forceEnableWebServer = true;
-            }
-            Log->println("Network timeout has been reached, restarting ...");
-            delay(200);
-            restartEsp(RestartReason::NetworkTimeoutWatchdog);
-        }
-        delay(2000);
         return false;
     }
 
@@ -509,6 +642,11 @@ bool NukiNetwork::update()
         if(_publishDebugInfo)
         {
             publishUInt(_maintenancePathPrefix, mqtt_topic_freeheap, esp_get_free_heap_size(), true);
+            publishUInt(_maintenancePathPrefix, mqtt_topic_publish_cache_hits, _publishCacheHits, true);
+            publishUInt(_maintenancePathPrefix, mqtt_topic_publish_cache_misses, _publishCacheMisses, true);
+            publishMqttQueueInfo();
+            publishMqttReconnectInfo();
+            publishBleScanInfo();
         }
         _lastMaintenanceTs = ts;
     }
@@ -580,6 +718,11 @@ bool NukiNetwork::update()
         }
     }
 
+    return true;
+}
+
+void NukiNetwork::publishGpioStates()
+{
     for(const auto& gpioTs : _gpioTs)
     {
         uint8_t pin = gpioTs.first;
@@ -599,18 +742,54 @@ bool NukiNetwork::update()
             Log->println(pinState);
         }
     }
-
-    return true;
 }
 
 void NukiNetwork::onMqttConnect(const bool &sessionPresent)
 {
     _connectReplyReceived = true;
+    _mqttConnAckTs = espMillis();
+    clearPublishCache();
+}
+
+void NukiNetwork::onMqttSubscribe(uint16_t packetId, const espMqttClientTypes::SubscribeReturncode* returncodes, size_t len)
+{
+    for(size_t i = 0; i < len; i++)
+    {
+        if(returncodes[i] == espMqttClientTypes::SubscribeReturncode::FAIL)
+        {
+            Log->print("MQTT subscription refused by broker, packet ");
+            Log->print(packetId);
+            Log->print(" topic index ");
+            Log->println(i);
+        }
+    }
+
+    auto it = std::find(_pendingSubscribeAcks.begin(), _pendingSubscribeAcks.end(), packetId);
+    if(it == _pendingSubscribeAcks.end())
+    {
+        return;
+    }
+    _pendingSubscribeAcks.erase(it);
+
+    if(_pendingSubscribeAcks.empty())
+    {
+        _mqttTimeToReady = espMillis() - _mqttConnAckTs;
+        Log->print("MQTT ready ");
+        Log->print((long)_mqttTimeToReady);
+        Log->println(" ms after CONNACK");
+    }
 }
 
 void NukiNetwork::onMqttDisconnect(const espMqttClientTypes::DisconnectReason &reason)
 {
     _connectReplyReceived = false;
+    _pendingSubscribeAcks.clear();
+    _messageAssembler.reset();
+    if(_mqttReconnectState == MqttReconnectState::Connecting)
+    {
+        // don't wait for the connect timeout, the attempt has already failed
+        _mqttConnectTimeoutTs = 0;
+    }
     Log->print("MQTT disconnected. Reason: ");
     switch(reason)
     {
@@ -646,22 +825,43 @@ void NukiNetwork::onMqttDisconnect(const espMqttClientTypes::DisconnectReason &r
 
 bool NukiNetwork::reconnect()
 {
-    _mqttConnectionState = 0;
+    const int64_t ts = espMillis();
 
-    while (!_device->mqttConnected() && espMillis() > _nextReconnect)
+    switch(_mqttReconnectState)
     {
+    case MqttReconnectState::Connected:
+        if(_device->mqttConnected())
+        {
+            return true;
+        }
+
+        Log->println("MQTT connection lost");
+        _mqttConnectionState = 0;
+        _mqttReconnectState = MqttReconnectState::Waiting;
+        _mqttDisconnectedTs = ts;
+        _mqttReconnectAttempts = 0;
+        _nextReconnect = ts;
+        return false;
+
+    case MqttReconnectState::Waiting:
+        if(ts < _nextReconnect)
+        {
+            return false;
+        }
+
         if(strcmp(_mqttBrokerAddr, "") == 0)
         {
             Log->println("MQTT Broker not configured, aborting connection attempt.");
-            _nextReconnect = espMillis() + 5000;
-
-            if(_device->isConnected())
-            {
-                _lastConnectedTs = espMillis();
-            }
+            _nextReconnect = ts + 5000;
+            _lastConnectedTs = ts;
             return false;
         }
 
+        if(_mqttDisconnectedTs == -1)
+        {
+            _mqttDisconnectedTs = ts;
+        }
+
         Log->println("Attempting MQTT connection");
 
         _connectReplyReceived = false;
@@ -681,154 +881,258 @@ bool NukiNetwork::reconnect()
         _device->mqttSetServer(_mqttBrokerAddr, _mqttPort);
         _device->mqttConnect();
 
-        int64_t timeout = espMillis() + 60000;
+        _mqttConnectTimeoutTs = ts + MQTT_CONNECT_TIMEOUT;
+        _mqttReconnectState = MqttReconnectState::Connecting;
+        return false;
 
-        while(!_connectReplyReceived && espMillis() < timeout)
+    case MqttReconnectState::Connecting:
+        if(!_connectReplyReceived && ts < _mqttConnectTimeoutTs)
         {
-            delay(50);
-            _device->update();
-            if(_keepAliveCallback != nullptr)
-            {
-                _keepAliveCallback();
-            }
+            return false;
         }
 
-        if (_device->mqttConnected())
+        if(!_device->mqttConnected())
         {
-            Log->println("MQTT connected");
-            _mqttConnectedTs = millis();
-            _mqttConnectionState = 1;
-            delay(100);
-            _device->mqttOnMessage(onMqttDataReceivedCallback);
-
-            if(_firstConnect)
-            {
-                _firstConnect = false;
+            Log->println("MQTT connect failed");
+            scheduleReconnect(ts);
+            return false;
+        }
 
-                if(_preferences->getBool(preference_reset_mqtt_topics, false))
-                {
-                    char mqttLockPath[181] = {0};
-                    char mqttOpenerPath[181] = {0};
-                    char mqttOldOpenerPath[181] = {0};
-                    char mqttOldOpenerPath2[181] = {0};
-                    String mqttPath = _preferences->getString(preference_mqtt_lock_path, "");
-                    mqttPath.concat("/lock");
-
-                    size_t len = mqttPath.length();
-                    for(int i=0; i < len; i++)
-                    {
-                        mqttLockPath[i] = mqttPath.charAt(i);
-                    }
+        _mqttLastReconnectLatency = ts - _mqttDisconnectedTs;
+        if(_mqttLastReconnectLatency > _mqttMaxReconnectLatency)
+        {
+            _mqttMaxReconnectLatency = _mqttLastReconnectLatency;
+        }
+        _mqttReconnectCount++;
+        _mqttDisconnectedTs = -1;
 
-                    mqttPath = _preferences->getString(preference_mqtt_lock_path, "");
-                    mqttPath.concat("/opener");
+        Log->print("MQTT connected after ");
+        Log->print((long)_mqttLastReconnectLatency);
+        Log->print(" ms, attempts: ");
+        Log->println(_mqttReconnectAttempts + 1);
 
-                    len = mqttPath.length();
-                    for(int i=0; i < len; i++)
-                    {
-                        mqttOpenerPath[i] = mqttPath.charAt(i);
-                    }
+        _mqttReconnectState = MqttReconnectState::Connected;
+        _mqttReconnectAttempts = 0;
+        _mqttConnectCounter = 0;
+        initializeMqttSession();
 
-                    mqttPath = _preferences->getString(preference_mqtt_opener_path, "");
+        if(forceEnableWebServer && !_webEnabled)
+        {
+            forceEnableWebServer = false;
+            delay(200);
+            restartEsp(RestartReason::ReconfigureWebServer);
+        }
+        else if(!_webEnabled)
+        {
+            forceEnableWebServer = false;
+        }
+        return true;
+    }
 
-                    len = mqttPath.length();
-                    for(int i=0; i < len; i++)
-                    {
-                        mqttOldOpenerPath[i] = mqttPath.charAt(i);
-                    }
+    return false;
+}
 
-                    mqttPath = _preferences->getString(preference_mqtt_opener_path, "");
-                    mqttPath.concat("/lock");
+void NukiNetwork::scheduleReconnect(const int64_t ts)
+{
+    // exponential backoff with up to 25% jitter, so several hubs don't hit a recovering broker at the same time
+    uint32_t backoff = MQTT_RECONNECT_MAX_BACKOFF;
+    if(_mqttReconnectAttempts < 16)
+    {
+        backoff = std::min((uint32_t)MQTT_RECONNECT_MIN_BACKOFF << _mqttReconnectAttempts, (uint32_t)MQTT_RECONNECT_MAX_BACKOFF);
+    }
+    backoff += esp_random() % (backoff / 4 + 1);
 
-                    len = mqttPath.length();
-                    for(int i=0; i < len; i++)
-                    {
-                        mqttOldOpenerPath2[i] = mqttPath.charAt(i);
-                    }
+    _nextReconnect = ts + backoff;
+    _mqttReconnectAttempts++;
+    _mqttConnectCounter++;
+    _mqttReconnectState = MqttReconnectState::Waiting;
+}
 
-                    MqttTopics mqttTopics;
+void NukiNetwork::initializeMqttSession()
+{
+    _mqttConnectedTs = millis();
+    _mqttConnectionState = 1;
+    _device->mqttOnMessage(onMqttDataReceivedCallback);
 
-                    const std::vector<char*> mqttTopicsKeys = mqttTopics.getMqttTopics();
+    if(_firstConnect)
+    {
+        _firstConnect = false;
 
-                    for(const auto& topic : mqttTopicsKeys)
-                    {
-                        removeTopic(_maintenancePathPrefix, topic);
-                        removeTopic(mqttLockPath, topic);
-                        removeTopic(mqttOpenerPath, topic);
-                        if (len > 5)
-                        {
-                            removeTopic(mqttOldOpenerPath, topic);
-                            removeTopic(mqttOldOpenerPath2, topic);
-                        }
-                    }
+        if(_preferences->getBool(preference_reset_mqtt_topics, false))
+        {
+            char mqttLockPath[181] = {0};
+            char mqttOpenerPath[181] = {0};
+            char mqttOldOpenerPath[181] = {0};
+            char mqttOldOpenerPath2[181] = {0};
+            String mqttPath = _preferences->getString(preference_mqtt_lock_path, "");
+            mqttPath.concat("/lock");
+
+            size_t len = mqttPath.length();
+            for(int i=0; i < len; i++)
+            {
+                mqttLockPath[i] = mqttPath.charAt(i);
+            }
 
-                    _preferences->putBool(preference_reset_mqtt_topics, false);
-                }
+            mqttPath = _preferences->getString(preference_mqtt_lock_path, "");
+            mqttPath.concat("/opener");
 
-                publishString(_maintenancePathPrefix, mqtt_topic_network_device, _device->deviceName().c_str(), true);
+            len = mqttPath.length();
+            for(int i=0; i < len; i++)
+            {
+                mqttOpenerPath[i] = mqttPath.charAt(i);
+            }
 
-                if(_preferences->getBool(preference_mqtt_hass_enabled, false))
-                {
-                    setupHASS(0, 0, {0}, {0}, {0}, false, false);
-                }
+            mqttPath = _preferences->getString(preference_mqtt_opener_path, "");
 
-                initTopic(_maintenancePathPrefix, mqtt_topic_reset, "0");
-                subscribe(_maintenancePathPrefix, mqtt_topic_reset);
-                initTopic(_maintenancePathPrefix, mqtt_topic_freeheap, "");
-                initTopic(_maintenancePathPrefix, mqtt_topic_log, "");
-                initTopic(_maintenancePathPrefix, mqtt_topic_wifi_rssi, "");
+            len = mqttPath.length();
+            for(int i=0; i < len; i++)
+            {
+                mqttOldOpenerPath[i] = mqttPath.charAt(i);
+            }
 
-                if(_preferences->getBool(preference_update_from_mqtt, false))
-                {
-                    initTopic(_maintenancePathPrefix, mqtt_topic_update, "0");
-                    subscribe(_maintenancePathPrefix, mqtt_topic_update);
-                }
+            mqttPath = _preferences->getString(preference_mqtt_opener_path, "");
+            mqttPath.concat("/lock");
 
-                if(_preferences->getBool(preference_publish_config, false))
-                {
-                    initTopic(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_json, "--");
-                }
+            len = mqttPath.length();
+            for(int i=0; i < len; i++)
+            {
+                mqttOldOpenerPath2[i] = mqttPath.charAt(i);
+            }
 
-                if(_preferences->getBool(preference_config_from_mqtt, false) || _preferences->getBool(preference_publish_config, false))
-                {
-                    initTopic(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action, "--");
-                    subscribe(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action);
-                    initTopic(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "--");
-                }
+            MqttTopics mqttTopics;
 
-                initTopic(_maintenancePathPrefix, mqtt_topic_webserver_action, "--");
-                subscribe(_maintenancePathPrefix, mqtt_topic_webserver_action);
-                initTopic(_maintenancePathPrefix, mqtt_topic_webserver_state, (_preferences->getBool(preference_webserver_enabled, true) || forceEnableWebServer ? "1" : "0"));
+            const std::vector<char*> mqttTopicsKeys = mqttTopics.getMqttTopics();
 
-                for(const auto& it : _initTopics)
+            for(const auto& topic : mqttTopicsKeys)
+            {
+                removeTopic(_maintenancePathPrefix, topic);
+                removeTopic(mqttLockPath, topic);
+                removeTopic(mqttOpenerPath, topic);
+                if (len > 5)
                 {
-                    publish(it.first.c_str(), it.second.c_str(), true);
+                    removeTopic(mqttOldOpenerPath, topic);
+                    removeTopic(mqttOldOpenerPath2, topic);
                 }
             }
 
-            for(const String& topic : _subscribedTopics)
-            {
-                subscribe(topic.c_str(), MQTT_QOS_LEVEL);
-            }
+            _preferences->putBool(preference_reset_mqtt_topics, false);
+        }
 
-            publishString(_maintenancePathPrefix, mqtt_topic_mqtt_connection_state, "online", true);
-            publishString(_maintenancePathPrefix, mqtt_topic_info_nuki_hub_ip, _device->localIP().c_str(), true);
+        publishString(_maintenancePathPrefix, mqtt_topic_network_device, _device->deviceName().c_str(), true);
 
-            _mqttConnectionState = 2;
-            for(const auto& callback : _reconnectedCallbacks)
-            {
-                callback();
-            }
+        if(_preferences->getBool(preference_mqtt_hass_enabled, false))
+        {
+            setupHASS(0, 0, {0}, {0}, {0}, false, false);
+        }
+
+        initTopic(_maintenancePathPrefix, mqtt_topic_reset, "0");
+        subscribe(_maintenancePathPrefix, mqtt_topic_reset);
+        initTopic(_maintenancePathPrefix, mqtt_topic_freeheap, "");
+        initTopic(_maintenancePathPrefix, mqtt_topic_log, "");
+        initTopic(_maintenancePathPrefix, mqtt_topic_wifi_rssi, "");
+
+        if(_preferences->getBool(preference_update_from_mqtt, false))
+        {
+            initTopic(_maintenancePathPrefix, mqtt_topic_update, "0");
+            subscribe(_maintenancePathPrefix, mqtt_topic_update);
+        }
+
+        if(_preferences->getBool(preference_publish_config, false))
+        {
+            initTopic(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_json, "--");
+        }
+
+        if(_preferences->getBool(preference_config_from_mqtt, false) || _preferences->getBool(preference_publish_config, false))
+        {
+            initTopic(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action, "--");
+            subscribe(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action);
+            initTopic(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "--");
+        }
+
+        initTopic(_maintenancePathPrefix, mqtt_topic_webserver_action, "--");
+        subscribe(_maintenancePathPrefix, mqtt_topic_webserver_action);
+        initTopic(_maintenancePathPrefix, mqtt_topic_webserver_state, (_preferences->getBool(preference_webserver_enabled, true) || forceEnableWebServer ? "1" : "0"));
+
+        for(const auto& it : _initTopics)
+        {
+            publish(it.first.c_str(), it.second.first.c_str(), true, it.second.second);
+        }
+    }
+
+    subscribeTopics();
+
+    publishString(_maintenancePathPrefix, mqtt_topic_mqtt_connection_state, "online", true);
+    publishString(_maintenancePathPrefix, mqtt_topic_info_nuki_hub_ip, _device->localIP().c_str(), true);
+
+    _mqttConnectionState = 2;
+    for(const auto& callback : _reconnectedCallbacks)
+    {
+        callback();
+    }
+}
+
+void NukiNetwork::subscribeTopics()
+{
+    // Group the subscriptions into as few SUBSCRIBE packets as possible instead of one round trip per topic.
+    // A packet is closed when the next topic would exceed the TX buffer (minus fixed header) or the
+    // number of return codes the client can take in a single SUBACK.
+    const size_t maxPacketSize = EMC_TX_BUFFER_SIZE - 5;
+    const char* batch[EMC_PAYLOAD_BUFFER_SIZE];
+    size_t batchCount = 0;
+    size_t batchSize = 2;
+    size_t packets = 0;
+
+    _pendingSubscribeAcks.clear();
+
+    auto flush = [&]()
+    {
+        if(batchCount == 0)
+        {
+            return;
+        }
+        uint16_t packetId = _device->mqttSubscribe(batch, batchCount, MQTT_QOS_LEVEL);
+        if(packetId != 0)
+        {
+            _pendingSubscribeAcks.push_back(packetId);
+            packets++;
         }
         else
         {
-            Log->print("MQTT connect failed");
-            _mqttConnectionState = 0;
-            _nextReconnect = espMillis() + 5000;
-            //_device->mqttDisconnect(true);
+            Log->print("Failed to queue MQTT subscription for ");
+            Log->print(batchCount);
+            Log->println(" topics");
         }
+        batchCount = 0;
+        batchSize = 2;
+    };
+
+    for(const String& topic : _subscribedTopics)
+    {
+        size_t topicSize = 2 + topic.length() + 1;
+        if(batchCount == EMC_PAYLOAD_BUFFER_SIZE || (batchCount > 0 && batchSize + topicSize > maxPacketSize))
+        {
+            flush();
+        }
+        batch[batchCount++] = topic.c_str();
+        batchSize += topicSize;
+    }
+    flush();
+
+    Log->print("Subscribing to ");
+    Log->print(_subscribedTopics.size());
+    Log->print(" MQTT topics in ");
+    Log->print(packets);
+    Log->println(" packets");
+
+    if(_pendingSubscribeAcks.empty())
+    {
+        _mqttTimeToReady = espMillis() - _mqttConnAckTs;
     }
-    return _mqttConnectionState > 0;
+}
+
+void NukiNetwork::registerTopics(const char* prefix, const std::vector<char*>& paths)
+{
+    _topicRegistry.add(prefix, paths);
 }
 
 void NukiNetwork::subscribe(const char* prefix, const char *path)
@@ -838,39 +1142,32 @@ void NukiNetwork::subscribe(const char* prefix, const char *path)
     _subscribedTopics.push_back(prefixedPath);
 }
 
-void NukiNetwork::initTopic(const char *prefix, const char *path, const char *value)
+void NukiNetwork::subscribe(const char* prefix, const char* path, MqttTopicHandler handler)
 {
-    char prefixedPath[500];
-    buildMqttPath(prefixedPath, { prefix, path });
-    String pathStr = prefixedPath;
-    String valueStr = value;
-    _initTopics[pathStr] = valueStr;
+    addTopicRoute(prefix, path, handler);
+    subscribe(prefix, path);
 }
 
-void NukiNetwork::buildMqttPath(const char *path, char *outPath)
+void NukiNetwork::addTopicRoute(const char* prefix, const char* path, MqttTopicHandler handler)
 {
-    int offset = 0;
-    char inPath[181] = {0};
-
-    memcpy(inPath, _nukiHubPath, sizeof(_nukiHubPath));
-
-    for(const char& c : inPath)
-    {
-        if(c == 0x00)
-        {
-            break;
-        }
-        outPath[offset] = c;
-        ++offset;
-    }
-    int i=0;
-    while(outPath[i] != 0x00)
+    if(!_topicRouter.add(_topicRegistry.add(prefix, path), handler))
     {
-        outPath[offset] = path[i];
-        ++i;
-        ++offset;
+        char prefixedPath[500];
+        buildMqttPath(prefixedPath, { prefix, path });
+        _topicRouter.addFallback(prefixedPath, handler);
+
+        Log->print("MQTT topic route table full, dispatching linearly: ");
+        Log->println(prefixedPath);
     }
-    outPath[i+1] = 0x00;
+}
+
+void NukiNetwork::initTopic(const char *prefix, const char *path, const char *value)
+{
+    char prefixedPath[500];
+    buildMqttPath(prefixedPath, { prefix, path });
+    String pathStr = prefixedPath;
+    String valueStr = value;
+    _initTopics[pathStr] = std::make_pair(valueStr, topicPriority(path));
 }
 
 void NukiNetwork::buildMqttPath(char* outPath, std::initializer_list<const char*> paths)
@@ -899,369 +1196,380 @@ void NukiNetwork::buildMqttPath(char* outPath, std::initializer_list<const char*
     outPath[offset] = 0x00;
 }
 
-void NukiNetwork::registerMqttReceiver(MqttReceiver* receiver)
-{
-    _mqttReceivers.push_back(receiver);
-}
-
 void NukiNetwork::onMqttDataReceivedCallback(const espMqttClientTypes::MessageProperties& properties, const char* topic, const uint8_t* payload, size_t len, size_t index, size_t total)
 {
-    uint8_t value[800] = {0};
+    uint32_t dropped = _inst->_messageAssembler.dropped();
+    _inst->_messageAssembler.feed(properties, topic, payload, len, index, total);
 
-    size_t l = min(len, sizeof(value)-1);
-
-    for(int i=0; i<l; i++)
+    if(_inst->_messageAssembler.dropped() != dropped)
     {
-        value[i] = payload[i];
+        Log->print("Incoming MQTT message dropped, topic: ");
+        Log->print(topic);
+        Log->print(", size: ");
+        Log->println(total);
     }
-
-    _inst->onMqttDataReceived(properties, topic, value, len, index, total);
 }
 
-void NukiNetwork::onMqttDataReceived(const espMqttClientTypes::MessageProperties& properties, const char* topic, const uint8_t* payload, size_t& len, size_t& index, size_t& total)
+void NukiNetwork::onMqttDataReceived(const espMqttClientTypes::MessageProperties& properties, const char* topic, const char* payload, size_t length)
 {
+    // Retained echoes right after connect can still differ from what we last published
+    invalidatePublishCache(topic);
+
     if(_mqttConnectedTs == -1 || (millis() - _mqttConnectedTs < 2000))
     {
         return;
     }
 
-    parseGpioTopics(properties, topic, payload, len, index, total);
+    parseGpioTopics(properties, topic, payload);
 
-    onMqttDataReceived(topic, (byte*)payload, index);
+    _topicRouter.dispatch(topic, payload, length);
+}
 
-    for(auto receiver : _mqttReceivers)
+void NukiNetwork::onResetReceived(const char* data)
+{
+    if(strcmp(data, "1") != 0 || mqttRecentlyConnected())
     {
-        receiver->onMqttDataReceived(topic, (byte*)payload, index);
+        return;
     }
+
+    Log->println("Restart requested via MQTT.");
+    clearWifiFallback();
+    delay(200);
+    restartEsp(RestartReason::RequestedViaMqtt);
 }
 
-void NukiNetwork::onMqttDataReceived(const char* topic, byte* payload, const unsigned int length)
+void NukiNetwork::onUpdateReceived(const char* data)
 {
-    char* data = (char*)payload;
-
-    if(comparePrefixedPath(topic, mqtt_topic_reset) && strcmp(data, "1") == 0 && !mqttRecentlyConnected())
+    if(strcmp(data, "1") != 0 || !_preferences->getBool(preference_update_from_mqtt, false) || mqttRecentlyConnected())
     {
-        Log->println("Restart requested via MQTT.");
-        clearWifiFallback();
-        delay(200);
-        restartEsp(RestartReason::RequestedViaMqtt);
+        return;
     }
-    else if(comparePrefixedPath(topic, mqtt_topic_update) && strcmp(data, "1") == 0 && _preferences->getBool(preference_update_from_mqtt, false) && !mqttRecentlyConnected())
-    {
-        Log->println("Update requested via MQTT.");
 
-        bool otaManifestSuccess = false;
-        JsonDocument doc;
+    Log->println("Update requested via MQTT.");
 
-        NetworkClientSecure *client = new NetworkClientSecure;
-        if (client)
+    bool otaManifestSuccess = false;
+    JsonDocument doc;
+
+    NetworkClientSecure *client = new NetworkClientSecure;
+    if (client)
+    {
+        client->setCACertBundle(x509_crt_imported_bundle_bin_start, x509_crt_imported_bundle_bin_end - x509_crt_imported_bundle_bin_start);
         {
-            client->setCACertBundle(x509_crt_imported_bundle_bin_start, x509_crt_imported_bundle_bin_end - x509_crt_imported_bundle_bin_start);
+            HTTPClient https;
+            https.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
+            https.useHTTP10(true);
+
+            if (https.begin(*client, GITHUB_OTA_MANIFEST_URL))
             {
-                HTTPClient https;
-                https.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-                https.useHTTP10(true);
+                int httpResponseCode = https.GET();
 
-                if (https.begin(*client, GITHUB_OTA_MANIFEST_URL))
+                if (httpResponseCode == HTTP_CODE_OK || httpResponseCode == HTTP_CODE_MOVED_PERMANENTLY)
                 {
-                    int httpResponseCode = https.GET();
+                    DeserializationError jsonError = deserializeJson(doc, https.getStream());
 
-                    if (httpResponseCode == HTTP_CODE_OK || httpResponseCode == HTTP_CODE_MOVED_PERMANENTLY)
+                    if (!jsonError)
                     {
-                        DeserializationError jsonError = deserializeJson(doc, https.getStream());
-
-                        if (!jsonError)
-                        {
-                            otaManifestSuccess = true;
-                        }
+                        otaManifestSuccess = true;
                     }
                 }
-                https.end();
             }
-            delete client;
+            https.end();
         }
+        delete client;
+    }
 
-        if (otaManifestSuccess)
-        {
-            String currentVersion = NUKI_HUB_VERSION;
+    if (otaManifestSuccess)
+    {
+        String currentVersion = NUKI_HUB_VERSION;
 
-            if(atof(doc["release"]["version"]) >= atof(currentVersion.c_str()))
+        if(atof(doc["release"]["version"]) >= atof(currentVersion.c_str()))
+        {
+            if(strcmp(NUKI_HUB_VERSION, doc["release"]["fullversion"].as<const char*>()) == 0 && strcmp(NUKI_HUB_BUILD, doc["release"]["build"].as<const char*>()) == 0 && strcmp(NUKI_HUB_DATE, doc["release"]["time"].as<const char*>()) == 0)
             {
-                if(strcmp(NUKI_HUB_VERSION, doc["release"]["fullversion"].as<const char*>()) == 0 && strcmp(NUKI_HUB_BUILD, doc["release"]["build"].as<const char*>()) == 0 && strcmp(NUKI_HUB_DATE, doc["release"]["time"].as<const char*>()) == 0)
-                {
-                    Log->println("Nuki Hub is already on the latest release version, OTA update aborted.");
-                }
-                else
-                {
-                    _preferences->putString(preference_ota_updater_url, GITHUB_LATEST_UPDATER_BINARY_URL);
-                    _preferences->putString(preference_ota_main_url, GITHUB_LATEST_RELEASE_BINARY_URL);
-                    Log->println("Updating to latest release version.");
-                    delay(200);
-                    restartEsp(RestartReason::OTAReboot);
-                }
+                Log->println("Nuki Hub is already on the latest release version, OTA update aborted.");
             }
-            else if(currentVersion.indexOf("beta") > 0)
+            else
             {
-                if(strcmp(NUKI_HUB_VERSION, doc["beta"]["fullversion"].as<const char*>()) == 0 && strcmp(NUKI_HUB_BUILD, doc["beta"]["build"].as<const char*>()) == 0 && strcmp(NUKI_HUB_DATE, doc["beta"]["time"].as<const char*>()) == 0)
-                {
-                    Log->println("Nuki Hub is already on the latest beta version, OTA update aborted.");
-                }
-                else
-                {
-                    _preferences->putString(preference_ota_updater_url, GITHUB_BETA_UPDATER_BINARY_URL);
-                    _preferences->putString(preference_ota_main_url, GITHUB_BETA_RELEASE_BINARY_URL);
-                    Log->println("Updating to latest beta version.");
-                    delay(200);
-                    restartEsp(RestartReason::OTAReboot);
-                }
+                _preferences->putString(preference_ota_updater_url, GITHUB_LATEST_UPDATER_BINARY_URL);
+                _preferences->putString(preference_ota_main_url, GITHUB_LATEST_RELEASE_BINARY_URL);
+                Log->println("Updating to latest release version.");
+                delay(200);
+                restartEsp(RestartReason::OTAReboot);
             }
-            else if(currentVersion.indexOf("master") > 0)
+        }
+        else if(currentVersion.indexOf("beta") > 0)
+        {
+            if(strcmp(NUKI_HUB_VERSION, doc["beta"]["fullversion"].as<const char*>()) == 0 && strcmp(NUKI_HUB_BUILD, doc["beta"]["build"].as<const char*>()) == 0 && strcmp(NUKI_HUB_DATE, doc["beta"]["time"].as<const char*>()) == 0)
             {
-                if(strcmp(NUKI_HUB_VERSION, doc["master"]["fullversion"].as<const char*>()) == 0 && strcmp(NUKI_HUB_BUILD, doc["master"]["build"].as<const char*>()) == 0 && strcmp(NUKI_HUB_DATE, doc["master"]["time"].as<const char*>()) == 0)
-                {
-                    Log->println("Nuki Hub is already on the latest development version, OTA update aborted.");
-                }
-                else
-                {
-                    _preferences->putString(preference_ota_updater_url, GITHUB_MASTER_UPDATER_BINARY_URL);
-                    _preferences->putString(preference_ota_main_url, GITHUB_MASTER_RELEASE_BINARY_URL);
-                    Log->println("Updating to latest developmemt version.");
-                    delay(200);
-                    restartEsp(RestartReason::OTAReboot);
-                }
+                Log->println("Nuki Hub is already on the latest beta version, OTA update aborted.");
             }
             else
             {
-                if(strcmp(NUKI_HUB_VERSION, doc["release"]["fullversion"].as<const char*>()) == 0 && strcmp(NUKI_HUB_BUILD, doc["release"]["build"].as<const char*>()) == 0 && strcmp(NUKI_HUB_DATE, doc["release"]["time"].as<const char*>()) == 0)
-                {
-                    Log->println("Nuki Hub is already on the latest release version, OTA update aborted.");
-                }
-                else
-                {
-                    _preferences->putString(preference_ota_updater_url, GITHUB_LATEST_UPDATER_BINARY_URL);
-                    _preferences->putString(preference_ota_main_url, GITHUB_LATEST_RELEASE_BINARY_URL);
-                    Log->println("Updating to latest release version.");
-                    delay(200);
-                    restartEsp(RestartReason::OTAReboot);
-                }
+                _preferences->putString(preference_ota_updater_url, GITHUB_BETA_UPDATER_BINARY_URL);
+                _preferences->putString(preference_ota_main_url, GITHUB_BETA_RELEASE_BINARY_URL);
+                Log->println("Updating to latest beta version.");
+                delay(200);
+                restartEsp(RestartReason::OTAReboot);
+            }
+        }
+        else if(currentVersion.indexOf("master") > 0)
+        {
+            if(strcmp(NUKI_HUB_VERSION, doc["master"]["fullversion"].as<const char*>()) == 0 && strcmp(NUKI_HUB_BUILD, doc["master"]["build"].as<const char*>()) == 0 && strcmp(NUKI_HUB_DATE, doc["master"]["time"].as<const char*>()) == 0)
+            {
+                Log->println("Nuki Hub is already on the latest development version, OTA update aborted.");
+            }
+            else
+            {
+                _preferences->putString(preference_ota_updater_url, GITHUB_MASTER_UPDATER_BINARY_URL);
+                _preferences->putString(preference_ota_main_url, GITHUB_MASTER_RELEASE_BINARY_URL);
+                Log->println("Updating to latest developmemt version.");
+                delay(200);
+                restartEsp(RestartReason::OTAReboot);
             }
         }
         else
         {
-            Log->println("Failed to retrieve OTA manifest, OTA update aborted.");
+            if(strcmp(NUKI_HUB_VERSION, doc["release"]["fullversion"].as<const char*>()) == 0 && strcmp(NUKI_HUB_BUILD, doc["release"]["build"].as<const char*>()) == 0 && strcmp(NUKI_HUB_DATE, doc["release"]["time"].as<const char*>()) == 0)
+            {
+                Log->println("Nuki Hub is already on the latest release version, OTA update aborted.");
+            }
+            else
+            {
+                _preferences->putString(preference_ota_updater_url, GITHUB_LATEST_UPDATER_BINARY_URL);
+                _preferences->putString(preference_ota_main_url, GITHUB_LATEST_RELEASE_BINARY_URL);
+                Log->println("Updating to latest release version.");
+                delay(200);
+                restartEsp(RestartReason::OTAReboot);
+            }
         }
     }
-    else if(comparePrefixedPath(topic, mqtt_topic_webserver_action) && !mqttRecentlyConnected())
+    else
     {
-        if(strcmp(data, "") == 0 ||
-                strcmp(data, "--") == 0)
-        {
-            return;
-        }
+        Log->println("Failed to retrieve OTA manifest, OTA update aborted.");
+    }
+}
+
+void NukiNetwork::onWebserverActionReceived(const char* data)
+{
+    if(mqttRecentlyConnected())
+    {
+        return;
+    }
 
-        if(strcmp(data, "1") == 0)
+    if(strcmp(data, "") == 0 ||
+            strcmp(data, "--") == 0)
+    {
+        return;
+    }
+
+    if(strcmp(data, "1") == 0)
+    {
+        if(_preferences->getBool(preference_webserver_enabled, true) || forceEnableWebServer)
         {
-            if(_preferences->getBool(preference_webserver_enabled, true) || forceEnableWebServer)
-            {
-                return;
-            }
-            Log->println("Webserver enabled, restarting.");
-            _preferences->putBool(preference_webserver_enabled, true);
+            return;
         }
-        else if (strcmp(data, "0") == 0)
+        Log->println("Webserver enabled, restarting.");
+        _preferences->putBool(preference_webserver_enabled, true);
+    }
+    else if (strcmp(data, "0") == 0)
+    {
+        if(!_preferences->getBool(preference_webserver_enabled, true) && !forceEnableWebServer)
         {
-            if(!_preferences->getBool(preference_webserver_enabled, true) && !forceEnableWebServer)
-            {
-                return;
-            }
-            Log->println("Webserver disabled, restarting.");
-            _preferences->putBool(preference_webserver_enabled, false);
+            return;
         }
-        clearWifiFallback();
-        delay(200);
-        restartEsp(RestartReason::ReconfigureWebServer);
+        Log->println("Webserver disabled, restarting.");
+        _preferences->putBool(preference_webserver_enabled, false);
+    }
+    clearWifiFallback();
+    delay(200);
+    restartEsp(RestartReason::ReconfigureWebServer);
+}
+
+void NukiNetwork::onConfigActionReceived(const char* data)
+{
+    if(mqttRecentlyConnected())
+    {
+        return;
+    }
+
+    if(strcmp(data, "") == 0 || strcmp(data, "--") == 0)
+    {
+        return;
     }
-    else if(comparePrefixedPath(topic, mqtt_topic_nuki_hub_config_action) && !mqttRecentlyConnected())
+    else
     {
-        if(strcmp(data, "") == 0 || strcmp(data, "--") == 0)
+        Log->println("JSON config update received");
+        JsonDocument doc;
+
+        DeserializationError error = deserializeJson(doc, data);
+        if (error)
         {
-            return;
+            Log->println("Invalid JSON for import/export");
+            publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"jsonInvalid\"}", false);
+            publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action, "--", true);
         }
         else
         {
-            Log->println("JSON config update received");
-            JsonDocument doc;
-
-            DeserializationError error = deserializeJson(doc, data);
-            if (error)
-            {
-                Log->println("Invalid JSON for import/export");
-                publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"jsonInvalid\"}", false);
-                publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action, "--", true);
-            }
-            else
+            if(_preferences->getBool(preference_cred_duo_approval, false) && (_importExport->getTOTPEnabled() || _importExport->getDuoEnabled()))
             {
-                if(_preferences->getBool(preference_cred_duo_approval, false) && (_importExport->getTOTPEnabled() || _importExport->getDuoEnabled()))
+                if(timeSynced && _importExport->getTOTPEnabled() && !doc["totp"].isNull())
                 {
-                    if(timeSynced && _importExport->getTOTPEnabled() && !doc["totp"].isNull())
-                    {
-                        String jsonTotp = doc["totp"];
+                    String jsonTotp = doc["totp"];
 
-                        if (!_importExport->checkTOTP(&jsonTotp)) {
-                            publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"totpIncorrect\"}", false);
-                            publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action, "--", true);
-                            return;
-                        }
-                    }
-                    else if (!timeSynced)
-                    {
-                        publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"duoTimeNotSynced\"}", false);
+                    if (!_importExport->checkTOTP(&jsonTotp)) {
+                        publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"totpIncorrect\"}", false);
                         publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action, "--", true);
                         return;
                     }
-                    else
-                    {
-                        bool duoRes = _importExport->startDuoAuth((char*)"Approve Nuki Hub setting change");
-                        int duoResult = 2;
+                }
+                else if (!timeSynced)
+                {
+                    publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"duoTimeNotSynced\"}", false);
+                    publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action, "--", true);
+                    return;
+                }
+                else
+                {
+                    bool duoRes = _importExport->startDuoAuth((char*)"Approve Nuki Hub setting change");
+                    int duoResult = 2;
 
-                        if (duoRes)
+                    if (duoRes)
+                    {
+                        while (duoResult == 2)
                         {
-                            while (duoResult == 2)
-                            {
-                                duoResult = _importExport->checkDuoApprove();
-                                delay(2000);
-                                esp_task_wdt_reset();
-                            }
+                            duoResult = _importExport->checkDuoApprove();
+                            delay(2000);
+                            esp_task_wdt_reset();
                         }
+                    }
 
-                        if (duoResult != 1)
-                        {
-                            publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"duoApprovalFailed\"}", false);
-                            publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action, "--", true);
-                            return;
-                        }
+                    if (duoResult != 1)
+                    {
+                        publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"duoApprovalFailed\"}", false);
+                        publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action, "--", true);
+                        return;
                     }
                 }
+            }
 
-                if(!doc["exportHTTPS"].isNull() && _device->isEncrypted())
+            if(!doc["exportHTTPS"].isNull() && _device->isEncrypted())
+            {
+                if(_preferences->getBool(preference_publish_config, false))
                 {
-                    if(_preferences->getBool(preference_publish_config, false))
+                    if(_device->isEncrypted())
                     {
-                        if(_device->isEncrypted())
-                        {
-                            JsonDocument json;
-                            _importExport->exportHttpsJson(json);
-                            serializeJson(json, _buffer, _bufferSize);
-                            publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_json, _buffer, false);
+                        JsonDocument json;
+                        _importExport->exportHttpsJson(json);
+                        serializeJson(json, _buffer, _bufferSize);
+                        publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_json, _buffer, false);
 
-                            if (doc["exportHTTPS"].as<int>() > 0)
-                            {
-                                _overwriteNukiHubConfigTS = espMillis() + (doc["exportHTTPS"].as<int>() * 1000);
-                            }
-                        }
-                        else
+                        if (doc["exportHTTPS"].as<int>() > 0)
                         {
-                            publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"mqttExportNotEncrypted\"}", false);
+                            _overwriteNukiHubConfigTS = espMillis() + (doc["exportHTTPS"].as<int>() * 1000);
                         }
                     }
                     else
                     {
-                        publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"mqttExportNotEnabled\"}", false);
+                        publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"mqttExportNotEncrypted\"}", false);
                     }
                 }
-                else if(!doc["exportMQTTS"].isNull())
+                else
+                {
+                    publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"mqttExportNotEnabled\"}", false);
+                }
+            }
+            else if(!doc["exportMQTTS"].isNull())
+            {
+                if(_preferences->getBool(preference_publish_config, false))
                 {
-                    if(_preferences->getBool(preference_publish_config, false))
+                    if(_device->isEncrypted())
                     {
-                        if(_device->isEncrypted())
-                        {
-                            JsonDocument json;
-                            _importExport->exportMqttsJson(json);
-                            serializeJson(json, _buffer, _bufferSize);
-                            publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_json, _buffer, false);
+                        JsonDocument json;
+                        _importExport->exportMqttsJson(json);
+                        serializeJson(json, _buffer, _bufferSize);
+                        publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_json, _buffer, false);
 
-                            if (doc["exportMQTTS"].as<int>() > 0)
-                            {
-                                _overwriteNukiHubConfigTS = espMillis() + (doc["exportMQTTS"].as<int>() * 1000);
-                            }
-                        }
-                        else
+                        if (doc["exportMQTTS"].as<int>() > 0)
                         {
-                            publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"mqttExportNotEncrypted\"}", false);
+                            _overwriteNukiHubConfigTS = espMillis() + (doc["exportMQTTS"].as<int>() * 1000);
                         }
                     }
                     else
                     {
-                        publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"mqttExportNotEnabled\"}", false);
+                        publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"mqttExportNotEncrypted\"}", false);
                     }
                 }
-                else if(!doc["exportNH"].isNull())
+                else
+                {
+                    publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"mqttExportNotEnabled\"}", false);
+                }
+            }
+            else if(!doc["exportNH"].isNull())
+            {
+                if(_preferences->getBool(preference_publish_config, false))
                 {
-                    if(_preferences->getBool(preference_publish_config, false))
+                    bool redacted = false;
+                    if(!doc["redacted"].isNull())
                     {
-                        bool redacted = false;
-                        if(!doc["redacted"].isNull())
+                        if(_device->isEncrypted())
                         {
-                            if(_device->isEncrypted())
-                            {
-                                redacted = true;
-                            }
-                            else
-                            {
-                                publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"mqttExportNotEncrypted\"}", false);
-                            }
+                            redacted = true;
                         }
-                        bool pairing = false;
-                        if(!doc["pairing"].isNull())
+                        else
                         {
-                            if(_device->isEncrypted())
-                            {
-                                pairing = true;
-                            }
-                            else
-                            {
-                                publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"mqttExportNotEncrypted\"}", false);
-                            }
+                            publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"mqttExportNotEncrypted\"}", false);
                         }
-                        JsonDocument json;
-                        _importExport->exportNukiHubJson(json, redacted, pairing, _preferences->getBool(preference_lock_enabled, true), _preferences->getBool(preference_opener_enabled, false));
-                        serializeJson(json, _buffer, _bufferSize);
-                        publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_json, _buffer, false);
-
-                        if (doc["exportNH"].as<int>() > 0)
+                    }
+                    bool pairing = false;
+                    if(!doc["pairing"].isNull())
+                    {
+                        if(_device->isEncrypted())
                         {
-                            _overwriteNukiHubConfigTS = espMillis() + (doc["exportNH"].as<int>() * 1000);
+                            pairing = true;
+                        }
+                        else
+                        {
+                            publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"mqttExportNotEncrypted\"}", false);
                         }
                     }
-                    else
+                    JsonDocument json;
+                    _importExport->exportNukiHubJson(json, redacted, pairing, _preferences->getBool(preference_lock_enabled, true), _preferences->getBool(preference_opener_enabled, false));
+                    serializeJson(json, _buffer, _bufferSize);
+                    publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_json, _buffer, false);
+
+                    if (doc["exportNH"].as<int>() > 0)
                     {
-                        publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"mqttExportNotEnabled\"}", false);
+                        _overwriteNukiHubConfigTS = espMillis() + (doc["exportNH"].as<int>() * 1000);
                     }
                 }
                 else
                 {
-                    if(_preferences->getBool(preference_config_from_mqtt, false))
-                    {
-                        JsonDocument json;
-                        json = _importExport->importJson(doc);
-                        serializeJson(json, _buffer, _bufferSize);
-                        publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_json, _buffer, false);
-                        publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action, "--", true);
-                        delay(200);
-                        restartEsp(RestartReason::ConfigurationUpdated);
-                    }
-                    else
-                    {
-                        publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"mqttImportNotEnabled\"}", false);
-                    }
+                    publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"mqttExportNotEnabled\"}", false);
                 }
-                publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action, "--", true);
             }
+            else
+            {
+                if(_preferences->getBool(preference_config_from_mqtt, false))
+                {
+                    JsonDocument json;
+                    json = _importExport->importJson(doc);
+                    serializeJson(json, _buffer, _bufferSize);
+                    publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_json, _buffer, false);
+                    publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action, "--", true);
+                    delay(200);
+                    restartEsp(RestartReason::ConfigurationUpdated);
+                }
+                else
+                {
+                    publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action_command_result, "{\"error\": \"mqttImportNotEnabled\"}", false);
+                }
+            }
+            publishString(_maintenancePathPrefix, mqtt_topic_nuki_hub_config_action, "--", true);
         }
     }
 }
 
-void NukiNetwork::parseGpioTopics(const espMqttClientTypes::MessageProperties &properties, const char *topic, const uint8_t *payload, size_t& len, size_t& index, size_t& total)
+void NukiNetwork::parseGpioTopics(const espMqttClientTypes::MessageProperties &properties, const char *topic, const char *payload)
 {
     char gpioPath[250];
     buildMqttPath(gpioPath, {_lockPath.c_str(), mqtt_topic_gpio_prefix, mqtt_topic_gpio_pin});
@@ -1280,7 +1588,7 @@ void NukiNetwork::parseGpioTopics(const espMqttClientTypes::MessageProperties &p
 
         if(_gpio->getPinRole(pin) == PinRole::GeneralOutput)
         {
-            const uint8_t pinState = strcmp((const char*)payload, "1") == 0 ? HIGH : LOW;
+            const uint8_t pinState = strcmp(payload, "1") == 0 ? HIGH : LOW;
             Log->print("GPIO ");
             Log->print(pin);
             Log->print(" (Output) --> ");
@@ -1314,9 +1622,7 @@ bool NukiNetwork::mqttRecentlyConnected()
 
 bool NukiNetwork::pathEquals(const char* prefix, const char* path, const char* referencePath)
 {
-    char prefixedPath[500];
-    buildMqttPath(prefixedPath, { prefix, path });
-    return strcmp(prefixedPath, referencePath) == 0;
+    return _topicRegistry.equals(prefix, path, referencePath);
 }
 
 void NukiNetwork::publishFloat(const char* prefix, const char* topic, const float value, bool retain, const uint8_t precision)
@@ -1368,21 +1674,317 @@ void NukiNetwork::publishString(const char* prefix, const char *topic, const cha
 
 void NukiNetwork::publish(const char* prefix, const char *topic, const char *value, bool retain)
 {
-    char path[200] = {0};
-    buildMqttPath(path, { prefix, topic });
-    _device->mqttPublish(path, MQTT_QOS_LEVEL, retain, value);
+    char pathBuffer[200] = {0};
+    const char* path = resolveMqttPath(pathBuffer, prefix, topic);
+
+    if(journalPublish(topic, path, value, strlen(value), retain))
+    {
+        return;
+    }
+
+    publish(path, value, retain, topicPriority(topic));
+}
+
+void NukiNetwork::publish(const char* path, const char *value, bool retain, espMqttClientTypes::Priority priority)
+{
+    const uint32_t valueHash = fnv1aHash(value);
+
+    if(retain && publishCacheHit(path, valueHash))
+    {
+        return;
+    }
+
+    if(_device->mqttPublish(path, MQTT_QOS_LEVEL, retain, value, priority) != 0)
+    {
+        updatePublishCache(path, valueHash, retain);
+    }
+    else
+    {
+        invalidatePublishCache(path);
+    }
+}
+
+void NukiNetwork::publishJson(const char* prefix, const char* topic, JsonDocument&& json, bool retain)
+{
+    char pathBuffer[200] = {0};
+    const char* path = resolveMqttPath(pathBuffer, prefix, topic);
+
+    // Hash and length in one pass without a buffer, so a cache hit doesn't allocate
+    JsonHashWriter hashWriter;
+    serializeJson(json, hashWriter);
+    const uint32_t valueHash = hashWriter.hash();
+    const size_t length = hashWriter.length();
+
+    // Serialized once into a buffer of the exact size, which the callback keeps alive until the
+    // packet is removed from the outbox. Each chunk of the outgoing packet and the journal record
+    // are copied from there, the document itself is released when the caller's copy goes out of scope.
+    std::shared_ptr<uint8_t> payload;
+    auto serializePayload = [&]() -> bool
+    {
+        payload.reset(new (std::nothrow) uint8_t[length + 1], std::default_delete<uint8_t[]>());
+        if(!payload)
+        {
+            Log->print("Out of memory publishing ");
+            Log->println(path);
+            invalidatePublishCache(path);
+            return false;
+        }
+        serializeJson(json, (char*)payload.get(), length + 1);
+        return true;
+    };
+
+    if(_journal != nullptr && journaledTopic(topic))
+    {
+        if(!serializePayload())
+        {
+            return;
+        }
+        if(journalPublish(topic, path, (const char*)payload.get(), length, retain))
+        {
+            return;
+        }
+    }
+
+    if(retain && publishCacheHit(path, valueHash))
+    {
+        return;
+    }
+
+    if(!payload && !serializePayload())
+    {
+        return;
+    }
+
+    uint16_t result = _device->mqttPublish(path, MQTT_QOS_LEVEL, retain, [payload, length](uint8_t* data, size_t maxSize, size_t index) -> size_t
+    {
+        const size_t chunk = std::min(maxSize, length - index);
+        memcpy(data, payload.get() + index, chunk);
+        return chunk;
+    }, length, topicPriority(topic));
+
+    if(result != 0)
+    {
+        updatePublishCache(path, valueHash, retain);
+    }
+    else
+    {
+        invalidatePublishCache(path);
+    }
 }
 
-void NukiNetwork::publish(const char* path, const char *value, bool retain)
+void NukiNetwork::initializeJournal()
 {
-    _device->mqttPublish(path, MQTT_QOS_LEVEL, retain, value);
+    if(!_preferences->getBool(preference_mqtt_journal_enabled, false))
+    {
+        return;
+    }
+
+    if(!SPIFFS.begin(true))
+    {
+        Log->println("SPIFFS Mount Failed, MQTT journal disabled");
+        return;
+    }
+
+    _journalStorage = new FSJournalStorage(SPIFFS, "/mqttjournal.bin");
+    _journal = new PublishJournal(_journalStorage);
+
+    if(!_journal->begin())
+    {
+        Log->println("Failed to open MQTT journal");
+        delete _journal;
+        delete _journalStorage;
+        _journal = nullptr;
+        _journalStorage = nullptr;
+        return;
+    }
+
+    Log->print("MQTT journal opened, pending messages: ");
+    Log->println(_journal->records());
+}
+
+bool NukiNetwork::journalPublish(const char* topic, const char* path, const char* value, size_t length, bool retain)
+{
+    if(_journal == nullptr || !journaledTopic(topic))
+    {
+        return false;
+    }
+
+    const std::lock_guard<std::mutex> lock(_journalMutex);
+
+    // keep appending until the journal has been replayed, so the messages are sent in order
+    if(_device->mqttConnected() && _journal->empty())
+    {
+        return false;
+    }
+
+    if(!_journal->append(path, (const uint8_t*)value, length, MQTT_QOS_LEVEL, retain))
+    {
+        return false;
+    }
+
+    invalidatePublishCache(path);
+    return true;
+}
+
+void NukiNetwork::updateJournal(bool mqttReady)
+{
+    if(_journal == nullptr)
+    {
+        return;
+    }
+
+    const std::lock_guard<std::mutex> lock(_journalMutex);
+
+    if(mqttReady && !_journal->empty())
+    {
+        size_t replayed = _journal->replay([this](const char* topic, const uint8_t* payload, size_t length, uint8_t qos, bool retain)
+        {
+            return _device->mqttPublish(topic, qos, retain, payload, length) != 0;
+        });
+
+        if(replayed > 0)
+        {
+            Log->print("Replayed MQTT messages from journal: ");
+            Log->println(replayed);
+        }
+    }
+
+    _journal->loop((uint32_t)espMillis());
+}
+
+void NukiNetwork::flushJournal()
+{
+    if(_journal == nullptr)
+    {
+        return;
+    }
+
+    const std::lock_guard<std::mutex> lock(_journalMutex);
+    _journal->flush();
+}
+
+void NukiNetwork::publishMqttReconnectInfo()
+{
+    JsonDocument json;
+    json["reconnects"] = _mqttReconnectCount;
+    json["lastLatency"] = (uint32_t)_mqttLastReconnectLatency;
+    json["maxLatency"] = (uint32_t)_mqttMaxReconnectLatency;
+    json["timeToReady"] = (uint32_t)_mqttTimeToReady;
+
+    serializeJson(json, _buffer, _bufferSize);
+    publishString(_maintenancePathPrefix, mqtt_topic_mqtt_reconnect, _buffer, true);
+}
+
+void NukiNetwork::publishBleScanInfo()
+{
+    if(_bleScanner == nullptr)
+    {
+        return;
+    }
+
+    JsonDocument json;
+    const BleScanner::Scanner::Statistics statistics = _bleScanner->statistics();
+    json["dutyCycle"] = _bleScanner->dutyCycle();
+    json["detectionLatency"] = _bleScanner->detectionLatency();
+    json["seen"] = statistics.seen;
+    json["filtered"] = statistics.filtered;
+    json["dispatched"] = statistics.dispatched;
+    json["queueDropped"] = _bleScanner->droppedAdvertisements();
+    json["queueHighWater"] = _bleScanner->queueHighWater();
+
+    serializeJson(json, _buffer, _bufferSize);
+    publishString(_maintenancePathPrefix, mqtt_topic_ble_scan, _buffer, true);
+}
+
+void NukiNetwork::publishMqttQueueInfo()
+{
+    JsonDocument json;
+    const espMqttClientTypes::Priority priorities[] =
+    {
+        espMqttClientTypes::Priority::CONTROL, espMqttClientTypes::Priority::STATE, espMqttClientTypes::Priority::BULK, espMqttClientTypes::Priority::LOG
+    };
+
+    for(const espMqttClientTypes::Priority priority : priorities)
+    {
+        JsonObject entry = json[espMqttClientTypes::priorityToString(priority)].to<JsonObject>();
+        entry["queued"] = _device->mqttQueueSize(priority);
+        entry["dropped"] = _device->mqttDroppedPackets(priority);
+    }
+
+    if(_journal != nullptr)
+    {
+        const std::lock_guard<std::mutex> lock(_journalMutex);
+        JsonObject journal = json["Journal"].to<JsonObject>();
+        journal["pending"] = _journal->records();
+        journal["dropped"] = _journal->dropped();
+        journal["writes"] = _journal->writes();
+        journal["corrupt"] = _journal->corrupt();
+    }
+
+    serializeJson(json, _buffer, _bufferSize);
+    publishString(_maintenancePathPrefix, mqtt_topic_mqtt_queue, _buffer, true);
+}
+
+const char* NukiNetwork::resolveMqttPath(char* outPath, const char* prefix, const char* topic)
+{
+    const uint16_t topicId = _topicRegistry.find(prefix, topic);
+    if(topicId != MqttTopicRegistry::InvalidId)
+    {
+        return _topicRegistry.topic(topicId);
+    }
+
+    buildMqttPath(outPath, { prefix, topic });
+    return outPath;
+}
+
+bool NukiNetwork::publishCacheHit(const char* path, uint32_t valueHash)
+{
+    const std::lock_guard<std::mutex> lock(_publishCacheMutex);
+
+    auto it = _publishCache.find(fnv1aHash(path));
+    if(it != _publishCache.end() && it->second == valueHash)
+    {
+        _publishCacheHits++;
+        return true;
+    }
+
+    _publishCacheMisses++;
+    return false;
+}
+
+void NukiNetwork::updatePublishCache(const char* path, uint32_t valueHash, bool retain)
+{
+    const std::lock_guard<std::mutex> lock(_publishCacheMutex);
+
+    if(retain)
+    {
+        _publishCache[fnv1aHash(path)] = valueHash;
+    }
+    else
+    {
+        // a non-retained publish changes what subscribers last saw on this topic
+        _publishCache.erase(fnv1aHash(path));
+    }
+}
+
+void NukiNetwork::invalidatePublishCache(const char* path)
+{
+    const std::lock_guard<std::mutex> lock(_publishCacheMutex);
+    _publishCache.erase(fnv1aHash(path));
+}
+
+void NukiNetwork::clearPublishCache()
+{
+    const std::lock_guard<std::mutex> lock(_publishCacheMutex);
+    _publishCache.clear();
 }
 
 void NukiNetwork::removeTopic(const String& mqttPath, const String& mqttTopic)
 {
     String path = mqttPath;
     path.concat(mqttTopic);
-    publish(path.c_str(), "", true);
+    // Same class as the publishes to the topic, a queued removal must not overtake a newer value or be overtaken by one
+    publish(path.c_str(), "", true, topicPriority(mqttTopic.c_str()));
 
 #ifdef DEBUG_NUKIHUB
     Log->print("Removing MQTT topic: ");
@@ -1623,17 +2225,14 @@ uint16_t NukiNetwork::subscribe(const char *topic, uint8_t qos)
     return _device->mqttSubscribe(topic, qos);
 }
 
-bool NukiNetwork::comparePrefixedPath(const char *fullPath, const char *subPath)
+void NukiNetwork::addReconnectedCallback(std::function<void()> reconnectedCallback)
 {
-    char prefixedPath[500];
-    buildMqttPath(subPath, prefixedPath);
-
-    return strcmp(fullPath, prefixedPath) == 0;
+    _reconnectedCallbacks.push_back(reconnectedCallback);
 }
 
-void NukiNetwork::addReconnectedCallback(std::function<void()> reconnectedCallback)
+void NukiNetwork::setBleScanner(BleScanner::Scanner* bleScanner)
 {
-    _reconnectedCallbacks.push_back(reconnectedCallback);
+    _bleScanner = bleScanner;
 }
 
 void NukiNetwork::disableMqtt()
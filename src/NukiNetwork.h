@@ -3,6 +3,8 @@
 #include <Preferences.h>
 #include <vector>
 #include <map>
+#include <mutex>
+#include <memory>
 #include "networkDevices/NetworkDevice.h"
 #include "networkDevices/IPConfiguration.h"
 #include "enums/NetworkDeviceType.h"
@@ -10,13 +12,17 @@
 #include "EspMillis.h"
 
 #ifndef NUKI_HUB_UPDATER
-#include "MqttReceiver.h"
 #include "MqttTopics.h"
+#include "MqttTopicRegistry.h"
+#include "MqttTopicRouter.h"
+#include "MessageAssembler.h"
+#include "PublishJournal.h"
 #include "Gpio.h"
 #include <ArduinoJson.h>
 #include "NukiConstants.h"
 #include "HomeAssistantDiscovery.h"
 #include "ImportExport.h"
+#include "BleScanner.h"
 #endif
 
 class NukiNetwork
@@ -45,12 +51,13 @@ public:
     #else
     explicit NukiNetwork(Preferences* preferences, Gpio* gpio, const String& maintenancePathPrefix, char* buffer, size_t bufferSize, ImportExport* importExport);
 
-    void registerMqttReceiver(MqttReceiver* receiver);
     void disableAutoRestarts(); // disable on OTA start
     void disableMqtt();
     String localIP();
 
+    void registerTopics(const char* prefix, const std::vector<char*>& paths);
     void subscribe(const char* prefix, const char* path);
+    void subscribe(const char* prefix, const char* path, MqttTopicHandler handler);
     void initTopic(const char* prefix, const char* path, const char* value);
     void publishFloat(const char* prefix, const char* topic, const float value, bool retain, const uint8_t precision = 2);
     void publishInt(const char* prefix, const char* topic, const int value, bool retain);
@@ -60,7 +67,8 @@ public:
     void publishBool(const char* prefix, const char* topic, const bool value, bool retain);
     void publishString(const char* prefix, const char* topic, const char* value, bool retain);
     void publish(const char* prefix, const char *topic, const char *value, bool retain);
-    void publish(const char* path, const char *value, bool retain);
+    void publish(const char* path, const char *value, bool retain, espMqttClientTypes::Priority priority = espMqttClientTypes::Priority::STATE);
+    void publishJson(const char* prefix, const char* topic, JsonDocument&& json, bool retain);
     void removeTopic(const String& mqttPath, const String& mqttTopic);
     void batteryTypeToString(const Nuki::BatteryType battype, char* str);
     void advertisingModeToString(const Nuki::AdvertisingMode advmode, char* str);
@@ -90,6 +98,7 @@ public:
     bool pathEquals(const char* prefix, const char* path, const char* referencePath);
     uint16_t subscribe(const char* topic, uint8_t qos);
     void addReconnectedCallback(std::function<void()> reconnectedCallback);
+    void setBleScanner(BleScanner::Scanner* bleScanner);
     #endif
 private:
     void setupDevice();
@@ -114,15 +123,34 @@ private:
 
     #ifndef NUKI_HUB_UPDATER
     static void onMqttDataReceivedCallback(const espMqttClientTypes::MessageProperties& properties, const char* topic, const uint8_t* payload, size_t len, size_t index, size_t total);
-    void onMqttDataReceived(const espMqttClientTypes::MessageProperties& properties, const char* topic, const uint8_t* payload, size_t& len, size_t& index, size_t& total);
-    void onMqttDataReceived(const char* topic, byte* payload, const unsigned int length);
+    void onMqttDataReceived(const espMqttClientTypes::MessageProperties& properties, const char* topic, const char* payload, size_t length);
+    void onResetReceived(const char* data);
+    void onUpdateReceived(const char* data);
+    void onWebserverActionReceived(const char* data);
+    void onConfigActionReceived(const char* data);
+    void addTopicRoute(const char* prefix, const char* path, MqttTopicHandler handler);
     void onMqttConnect(const bool& sessionPresent);
     void onMqttDisconnect(const espMqttClientTypes::DisconnectReason& reason);
-    void parseGpioTopics(const espMqttClientTypes::MessageProperties& properties, const char* topic, const uint8_t* payload, size_t& len, size_t& index, size_t& total);
+    void parseGpioTopics(const espMqttClientTypes::MessageProperties& properties, const char* topic, const char* payload);
     void gpioActionCallback(const GpioAction& action, const int& pin);
-    bool comparePrefixedPath(const char* fullPath, const char* subPath);
-    void buildMqttPath(const char *path, char *outPath);
     void buildMqttPath(char* outPath, std::initializer_list<const char*> paths);
+    const char* resolveMqttPath(char* outPath, const char* prefix, const char* topic);
+    bool publishCacheHit(const char* path, uint32_t valueHash);
+    void updatePublishCache(const char* path, uint32_t valueHash, bool retain);
+    void invalidatePublishCache(const char* path);
+    void clearPublishCache();
+    void publishMqttQueueInfo();
+    void publishMqttReconnectInfo();
+    void publishBleScanInfo();
+    void onMqttSubscribe(uint16_t packetId, const espMqttClientTypes::SubscribeReturncode* returncodes, size_t len);
+    void scheduleReconnect(const int64_t ts);
+    void initializeMqttSession();
+    void subscribeTopics();
+    void initializeJournal();
+    bool journalPublish(const char* topic, const char* path, const char* value, size_t length, bool retain);
+    void updateJournal(bool mqttReady);
+    void flushJournal();
+    void publishGpioStates();
 
     const char* _lastWillPayload = "offline";
     char _mqttConnectionStateTopic[211] = {0};
@@ -132,6 +160,14 @@ private:
     ImportExport* _importExport;
     Gpio* _gpio;
 
+    enum class MqttReconnectState
+    {
+        Waiting,
+        Connecting,
+        Connected
+    };
+
+    MqttReconnectState _mqttReconnectState = MqttReconnectState::Waiting;
     int _mqttConnectionState = 0;
     int _mqttConnectCounter = 0;
     int _mqttPort = 1883;
@@ -142,12 +178,20 @@ private:
 
     int64_t _publishedUpTime = 0;
     int64_t _nextReconnect = 0;
+    int64_t _mqttConnectTimeoutTs = 0;
+    int64_t _mqttDisconnectedTs = -1;
+    int64_t _mqttLastReconnectLatency = 0;
+    int64_t _mqttMaxReconnectLatency = 0;
+    uint32_t _mqttReconnectCount = 0;
+    uint8_t _mqttReconnectAttempts = 0;
+    int64_t _mqttConnAckTs = 0;
+    int64_t _mqttTimeToReady = 0;
+    std::vector<uint16_t> _pendingSubscribeAcks;
     char _mqttBrokerAddr[101] = {0};
     char _mqttUser[31] = {0};
     char _mqttPass[31] = {0};
     char _maintenancePathPrefix[181] = {0};
     int _networkTimeout = 0;
-    std::vector<MqttReceiver*> _mqttReceivers;
     bool _restartOnDisconnect = false;
     bool _disableNetworkIfNotConnected = false;
     bool _checkUpdates = false;
@@ -156,7 +200,8 @@ private:
     bool _logIp = true;
     bool _retainGpio = false;
     std::vector<String> _subscribedTopics;
-    std::map<String, String> _initTopics;
+    // path -> value and priority class of the topic, so later publishes can't overtake the init value
+    std::map<String, std::pair<String, espMqttClientTypes::Priority>> _initTopics;
     int64_t _lastConnectedTs = 0;
     int64_t _lastMaintenanceTs = 0;
     int64_t _lastUpdateCheckTs = 0;
@@ -164,6 +209,20 @@ private:
     bool _mqttEnabled = true;
     int _rssiPublishInterval = 0;
     std::map<uint8_t, int64_t> _gpioTs;
+    MqttTopicRegistry _topicRegistry;
+    MqttTopicRouter _topicRouter{&_topicRegistry};
+    MessageAssembler _messageAssembler{[this](const espMqttClientTypes::MessageProperties& properties, const char* topic, const char* payload, size_t length)
+    {
+        onMqttDataReceived(properties, topic, payload, length);
+    }};
+    std::map<uint32_t, uint32_t> _publishCache;
+    std::mutex _publishCacheMutex;
+    PublishJournal::Storage* _journalStorage = nullptr;
+    PublishJournal* _journal = nullptr;
+    std::mutex _journalMutex;
+    BleScanner::Scanner* _bleScanner = nullptr;
+    uint32_t _publishCacheHits = 0;
+    uint32_t _publishCacheMisses = 0;
 
     char* _buffer;
     const size_t _bufferSize;
@@ -5,6 +5,7 @@
 #include "PreferencesKeys.h"
 #include "Logger.h"
 #include "RestartReason.h"
+#include "NukiTaskWakeup.h"
 #include <ArduinoJson.h>
 #include <ctype.h>
 
@@ -24,8 +25,6 @@ NukiNetworkLock::NukiNetworkLock(NukiNetwork* network, NukiOfficial* nukiOfficia
 
     memset(_authName, 0, sizeof(_authName));
     _authName[0] = '\0';
-
-    _network->registerMqttReceiver(this);
 }
 
 NukiNetworkLock::~NukiNetworkLock()
@@ -44,22 +43,41 @@ void NukiNetworkLock::initialize()
     }
 
     _haEnabled = _preferences->getString(preference_mqtt_hass_discovery, "") != "";
+    _lastRollingLog = _preferences->getUInt(preference_lock_auth_log_cursor, 0);
     _disableNonJSON = _preferences->getBool(preference_disable_non_json, false);
     _hybridRebootOnDisconnect = _preferences->getBool(preference_hybrid_reboot_on_disconnect, false);
     _isUltra = _preferences->getBool(preference_lock_gemini_enabled, false);
 
+    MqttTopics mqttTopics;
+    _network->registerTopics(_mqttPath, mqttTopics.getMqttTopics());
+
     _network->initTopic(_mqttPath, mqtt_topic_lock_action, "--");
-    _network->subscribe(_mqttPath, mqtt_topic_lock_action);
+    _network->subscribe(_mqttPath, mqtt_topic_lock_action, [this](const char* topic, const char* data, const unsigned int length)
+    {
+        onLockActionReceived(data);
+    });
     _network->initTopic(_mqttPath, mqtt_topic_config_action, "--");
-    _network->subscribe(_mqttPath, mqtt_topic_config_action);
+    _network->subscribe(_mqttPath, mqtt_topic_config_action, [this](const char* topic, const char* data, const unsigned int length)
+    {
+        onJsonActionReceived(mqtt_topic_config_action, data, _configUpdateReceivedCallback);
+    });
 
     _network->initTopic(_mqttPath, mqtt_topic_query_keypad, "0");
     _network->initTopic(_mqttPath, mqtt_topic_query_config, "0");
     _network->initTopic(_mqttPath, mqtt_topic_query_lockstate, "0");
     _network->initTopic(_mqttPath, mqtt_topic_query_battery, "0");
-    _network->subscribe(_mqttPath, mqtt_topic_query_config);
-    _network->subscribe(_mqttPath, mqtt_topic_query_lockstate);
-    _network->subscribe(_mqttPath, mqtt_topic_query_battery);
+    _network->subscribe(_mqttPath, mqtt_topic_query_config, [this](const char* topic, const char* data, const unsigned int length)
+    {
+        onQueryReceived(mqtt_topic_query_config, data, QUERY_COMMAND_CONFIG);
+    });
+    _network->subscribe(_mqttPath, mqtt_topic_query_lockstate, [this](const char* topic, const char* data, const unsigned int length)
+    {
+        onQueryReceived(mqtt_topic_query_lockstate, data, QUERY_COMMAND_LOCKSTATE);
+    });
+    _network->subscribe(_mqttPath, mqtt_topic_query_battery, [this](const char* topic, const char* data, const unsigned int length)
+    {
+        onQueryReceived(mqtt_topic_query_battery, data, QUERY_COMMAND_BATTERY);
+    });
 
     _network->initTopic(_mqttPath, mqtt_topic_auth_action, "--");
     _network->initTopic(_mqttPath, mqtt_topic_timecontrol_action, "--");
@@ -121,41 +139,85 @@ void NukiNetworkLock::initialize()
             _network->initTopic(_mqttPath, mqtt_topic_keypad_command_name, "--");
             _network->initTopic(_mqttPath, mqtt_topic_keypad_command_code, "000000");
             _network->initTopic(_mqttPath, mqtt_topic_keypad_command_enabled, "1");
-            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_action);
-            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_id);
-            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_name);
-            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_code);
-            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_enabled);
+            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_action, [this](const char* topic, const char* data, const unsigned int length)
+            {
+                onKeypadCommandActionReceived(data);
+            });
+            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_id, [this](const char* topic, const char* data, const unsigned int length)
+            {
+                _keypadCommandId = atoi(data);
+            });
+            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_name, [this](const char* topic, const char* data, const unsigned int length)
+            {
+                _keypadCommandName = data;
+            });
+            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_code, [this](const char* topic, const char* data, const unsigned int length)
+            {
+                _keypadCommandCode = data;
+            });
+            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_enabled, [this](const char* topic, const char* data, const unsigned int length)
+            {
+                _keypadCommandEnabled = atoi(data);
+            });
         }
 
-        _network->subscribe(_mqttPath, mqtt_topic_query_keypad);
-        _network->subscribe(_mqttPath, mqtt_topic_keypad_json_action);
+        _network->subscribe(_mqttPath, mqtt_topic_query_keypad, [this](const char* topic, const char* data, const unsigned int length)
+        {
+            onQueryReceived(mqtt_topic_query_keypad, data, QUERY_COMMAND_KEYPAD);
+        });
+        _network->subscribe(_mqttPath, mqtt_topic_keypad_json_action, [this](const char* topic, const char* data, const unsigned int length)
+        {
+            onJsonActionReceived(mqtt_topic_keypad_json_action, data, _keypadJsonCommandReceivedReceivedCallback);
+        });
     }
 
     if(_preferences->getBool(preference_timecontrol_control_enabled))
     {
-        _network->subscribe(_mqttPath, mqtt_topic_timecontrol_action);
+        _network->subscribe(_mqttPath, mqtt_topic_timecontrol_action, [this](const char* topic, const char* data, const unsigned int length)
+        {
+            onJsonActionReceived(mqtt_topic_timecontrol_action, data, _timeControlCommandReceivedReceivedCallback);
+        });
     }
 
     if(_preferences->getBool(preference_auth_control_enabled))
     {
-        _network->subscribe(_mqttPath, mqtt_topic_auth_action);
+        _network->subscribe(_mqttPath, mqtt_topic_auth_action, [this](const char* topic, const char* data, const unsigned int length)
+        {
+            onJsonActionReceived(mqtt_topic_auth_action, data, _authCommandReceivedReceivedCallback);
+        });
     }
 
     if(_nukiOfficial->getOffEnabled())
     {
         _nukiOfficial->setUid(_preferences->getUInt(preference_nuki_id_lock, 0));
+        _network->registerTopics(_nukiOfficial->getMqttPath(), _nukiOfficial->getOffTopics());
+        _network->registerTopics(_nukiOfficial->getMqttPath(), { mqtt_topic_official_lock_action });
 
         for(const auto& offTopic : _nukiOfficial->getOffTopics())
         {
-            _network->subscribe(_nukiOfficial->getMqttPath(), offTopic);
+            _network->subscribe(_nukiOfficial->getMqttPath(), offTopic, [this, offTopic](const char* topic, const char* data, const unsigned int length)
+            {
+                if(_officialUpdateReceivedCallback != nullptr)
+                {
+                    _officialUpdateReceivedCallback(offTopic, data);
+                }
+            });
         }
     }
 
     if(_preferences->getBool(preference_publish_authdata, false))
     {
-        _network->subscribe(_mqttPath, mqtt_topic_lock_log_rolling_last);
+        _network->subscribe(_mqttPath, mqtt_topic_lock_log_rolling_last, [this](const char* topic, const char* data, const unsigned int length)
+        {
+            onRollingLogReceived(data);
+        });
     }
+
+    // retained topics may be lost with the broker session, publish the keypad in full again
+    _network->addReconnectedCallback([this]()
+    {
+        _keypadSnapshot.invalidate();
+    });
 }
 
 bool NukiNetworkLock::update()
@@ -187,207 +249,109 @@ bool NukiNetworkLock::update()
     return ret;
 }
 
-void NukiNetworkLock::onMqttDataReceived(const char* topic, byte* payload, const unsigned int length)
+void NukiNetworkLock::onLockActionReceived(const char* data)
 {
-    char* data = (char*)payload;
-
-    if(_network->mqttRecentlyConnected() && _network->pathEquals(_mqttPath, mqtt_topic_lock_action, topic))
+    if(_network->mqttRecentlyConnected())
     {
         Log->println("MQTT recently connected, ignoring lock action.");
         return;
     }
 
-    if(comparePrefixedPath(topic, mqtt_topic_lock_log_rolling_last))
+    if(strcmp(data, "") == 0 ||
+            strcmp(data, "--") == 0 ||
+            strcmp(data, "ack") == 0 ||
+            strcmp(data, "unknown_action") == 0 ||
+            strcmp(data, "denied") == 0 ||
+            strcmp(data, "error") == 0)
     {
-        if(strcmp(data, "") == 0 ||
-                strcmp(data, "--") == 0)
-        {
-            return;
-        }
-
-        if(atoi(data) > 0 && atoi(data) > _lastRollingLog)
-        {
-            _lastRollingLog = atoi(data);
-        }
+        return;
     }
 
-    if(_nukiOfficial->getOffEnabled())
+    Log->print("Lock action received: ");
+    Log->println(data);
+    LockActionResult lockActionResult = LockActionResult::Failed;
+    if(_lockActionReceivedCallback != NULL)
     {
-        for(auto offTopic : _nukiOfficial->getOffTopics())
-        {
-            if(_nukiOfficial->comparePrefixedPath(topic, offTopic))
-            {
-                if(_officialUpdateReceivedCallback != nullptr)
-                {
-                    _officialUpdateReceivedCallback(offTopic, data);
-                }
-            }
-        }
+        lockActionResult = _lockActionReceivedCallback(data);
     }
 
-    if(comparePrefixedPath(topic, mqtt_topic_lock_action))
+    switch(lockActionResult)
     {
-        if(strcmp(data, "") == 0 ||
-                strcmp(data, "--") == 0 ||
-                strcmp(data, "ack") == 0 ||
-                strcmp(data, "unknown_action") == 0 ||
-                strcmp(data, "denied") == 0 ||
-                strcmp(data, "error") == 0)
-        {
-            return;
-        }
-
-        Log->print("Lock action received: ");
-        Log->println(data);
-        LockActionResult lockActionResult = LockActionResult::Failed;
-        if(_lockActionReceivedCallback != NULL)
-        {
-            lockActionResult = _lockActionReceivedCallback(data);
-        }
-
-        switch(lockActionResult)
-        {
-        case LockActionResult::Success:
-            _nukiPublisher->publishString(mqtt_topic_lock_action, "ack", false);
-            break;
-        case LockActionResult::UnknownAction:
-            _nukiPublisher->publishString(mqtt_topic_lock_action, "unknown_action", false);
-            break;
-        case LockActionResult::AccessDenied:
-            _nukiPublisher->publishString(mqtt_topic_lock_action, "denied", false);
-            break;
-        case LockActionResult::Failed:
-            _nukiPublisher->publishString(mqtt_topic_lock_action, "error", false);
-            break;
-        }
+    case LockActionResult::Success:
+        _nukiPublisher->publishString(mqtt_topic_lock_action, "ack", false);
+        break;
+    case LockActionResult::UnknownAction:
+        _nukiPublisher->publishString(mqtt_topic_lock_action, "unknown_action", false);
+        break;
+    case LockActionResult::AccessDenied:
+        _nukiPublisher->publishString(mqtt_topic_lock_action, "denied", false);
+        break;
+    case LockActionResult::Failed:
+        _nukiPublisher->publishString(mqtt_topic_lock_action, "error", false);
+        break;
     }
+}
 
-    if(!_disableNonJSON)
+void NukiNetworkLock::onRollingLogReceived(const char* data)
+{
+    if(strcmp(data, "") == 0 ||
+            strcmp(data, "--") == 0)
     {
-        if(comparePrefixedPath(topic, mqtt_topic_keypad_command_action))
-        {
-            if(_keypadCommandReceivedReceivedCallback != nullptr)
-            {
-                if(strcmp(data, "--") == 0)
-                {
-                    return;
-                }
-
-                _keypadCommandReceivedReceivedCallback(data, _keypadCommandId, _keypadCommandName, _keypadCommandCode, _keypadCommandEnabled);
-
-                _keypadCommandId = 0;
-                _keypadCommandName = "--";
-                _keypadCommandCode = "000000";
-                _keypadCommandEnabled = 1;
-
-                if(strcmp(data, "--") != 0)
-                {
-                    _nukiPublisher->publishString(mqtt_topic_keypad_command_action, "--", true);
-                }
-                _nukiPublisher->publishInt(mqtt_topic_keypad_command_id, _keypadCommandId, true);
-                _nukiPublisher->publishString(mqtt_topic_keypad_command_name, _keypadCommandName, true);
-                _nukiPublisher->publishString(mqtt_topic_keypad_command_code, _keypadCommandCode, true);
-                _nukiPublisher->publishInt(mqtt_topic_keypad_command_enabled, _keypadCommandEnabled, true);
-            }
-        }
-        else if(comparePrefixedPath(topic, mqtt_topic_keypad_command_id))
-        {
-            _keypadCommandId = atoi(data);
-        }
-        else if(comparePrefixedPath(topic, mqtt_topic_keypad_command_name))
-        {
-            _keypadCommandName = data;
-        }
-        else if(comparePrefixedPath(topic, mqtt_topic_keypad_command_code))
-        {
-            _keypadCommandCode = data;
-        }
-        else if(comparePrefixedPath(topic, mqtt_topic_keypad_command_enabled))
-        {
-            _keypadCommandEnabled = atoi(data);
-        }
+        return;
     }
 
-    if(comparePrefixedPath(topic, mqtt_topic_query_config) && strcmp(data, "1") == 0)
-    {
-        _queryCommands = _queryCommands | QUERY_COMMAND_CONFIG;
-        _nukiPublisher->publishInt(mqtt_topic_query_config, 0, true);
-    }
-    else if(comparePrefixedPath(topic, mqtt_topic_query_lockstate) && strcmp(data, "1") == 0)
-    {
-        _queryCommands = _queryCommands | QUERY_COMMAND_LOCKSTATE;
-        _nukiPublisher->publishInt(mqtt_topic_query_lockstate, 0, true);
-    }
-    else if(comparePrefixedPath(topic, mqtt_topic_query_keypad) && strcmp(data, "1") == 0)
+    if(atoi(data) > 0 && atoi(data) > _lastRollingLog)
     {
-        _queryCommands = _queryCommands | QUERY_COMMAND_KEYPAD;
-        _nukiPublisher->publishInt(mqtt_topic_query_keypad, 0, true);
-    }
-    else if(comparePrefixedPath(topic, mqtt_topic_query_battery) && strcmp(data, "1") == 0)
-    {
-        _queryCommands = _queryCommands | QUERY_COMMAND_BATTERY;
-        _nukiPublisher->publishInt(mqtt_topic_query_battery, 0, true);
+        setLastRollingLog(atoi(data));
     }
+}
 
-    if(comparePrefixedPath(topic, mqtt_topic_config_action))
+void NukiNetworkLock::onKeypadCommandActionReceived(const char* data)
+{
+    if(_keypadCommandReceivedReceivedCallback == nullptr || strcmp(data, "--") == 0)
     {
-        if(strcmp(data, "") == 0 || strcmp(data, "--") == 0)
-        {
-            return;
-        }
-
-        if(_configUpdateReceivedCallback != NULL)
-        {
-            _configUpdateReceivedCallback(data);
-        }
-
-        _nukiPublisher->publishString(mqtt_topic_config_action, "--", true);
+        return;
     }
 
-    if(comparePrefixedPath(topic, mqtt_topic_keypad_json_action))
-    {
-        if(strcmp(data, "") == 0 || strcmp(data, "--") == 0)
-        {
-            return;
-        }
+    _keypadCommandReceivedReceivedCallback(data, _keypadCommandId, _keypadCommandName, _keypadCommandCode, _keypadCommandEnabled);
 
-        if(_keypadJsonCommandReceivedReceivedCallback != NULL)
-        {
-            _keypadJsonCommandReceivedReceivedCallback(data);
-        }
+    _keypadCommandId = 0;
+    _keypadCommandName = "--";
+    _keypadCommandCode = "000000";
+    _keypadCommandEnabled = 1;
 
-        _nukiPublisher->publishString(mqtt_topic_keypad_json_action, "--", true);
-    }
+    _nukiPublisher->publishString(mqtt_topic_keypad_command_action, "--", true);
+    _nukiPublisher->publishInt(mqtt_topic_keypad_command_id, _keypadCommandId, true);
+    _nukiPublisher->publishString(mqtt_topic_keypad_command_name, _keypadCommandName, true);
+    _nukiPublisher->publishString(mqtt_topic_keypad_command_code, _keypadCommandCode, true);
+    _nukiPublisher->publishInt(mqtt_topic_keypad_command_enabled, _keypadCommandEnabled, true);
+}
 
-    if(comparePrefixedPath(topic, mqtt_topic_timecontrol_action))
+void NukiNetworkLock::onQueryReceived(const char* topic, const char* data, const uint8_t queryCommand)
+{
+    if(strcmp(data, "1") != 0)
     {
-        if(strcmp(data, "") == 0 || strcmp(data, "--") == 0)
-        {
-            return;
-        }
+        return;
+    }
 
-        if(_timeControlCommandReceivedReceivedCallback != NULL)
-        {
-            _timeControlCommandReceivedReceivedCallback(data);
-        }
+    _queryCommands = _queryCommands | queryCommand;
+    NukiTaskWakeup::notify(NukiTaskWakeupReason::Query);
+    _nukiPublisher->publishInt(topic, 0, true);
+}
 
-        _nukiPublisher->publishString(mqtt_topic_timecontrol_action, "--", true);
+void NukiNetworkLock::onJsonActionReceived(const char* topic, const char* data, void (*callback)(const char* value))
+{
+    if(strcmp(data, "") == 0 || strcmp(data, "--") == 0)
+    {
+        return;
     }
 
-    if(comparePrefixedPath(topic, mqtt_topic_auth_action))
+    if(callback != NULL)
     {
-        if(strcmp(data, "") == 0 || strcmp(data, "--") == 0)
-        {
-            return;
-        }
-
-        if(_authCommandReceivedReceivedCallback != NULL)
-        {
-            _authCommandReceivedReceivedCallback(data);
-        }
-
-        _nukiPublisher->publishString(mqtt_topic_auth_action, "--", true);
+        callback(data);
     }
+
+    _nukiPublisher->publishString(topic, "--", true);
 }
 
 void NukiNetworkLock::publishKeyTurnerState(const NukiLock::KeyTurnerState& keyTurnerState, const NukiLock::KeyTurnerState& lastKeyTurnerState)
@@ -630,7 +594,6 @@ void NukiNetworkLock::publishState(NukiLock::LockState lockState)
 
 void NukiNetworkLock::publishAuthorizationInfo(const std::list<NukiLock::LogEntry>& logEntries, bool latest)
 {
-    char str[50];
     char authName[33];
     uint32_t authIndex = 0;
 
@@ -666,125 +629,145 @@ void NukiNetworkLock::publishAuthorizationInfo(const std::list<NukiLock::LogEntr
             }
         }
 
-        auto entry = json.add<JsonVariant>();
+        authLogEntryToJson(log, json.add<JsonObject>());
+    }
+
+    _nukiPublisher->publishJson(latest ? mqtt_topic_lock_log_latest : mqtt_topic_lock_log, std::move(json), true);
+
+    if(authIndex > 0 || (_nukiOfficial->getOffConnected() && _nukiOfficial->hasAuthId()))
+    {
+        _nukiPublisher->publishUInt(mqtt_topic_lock_auth_id, getAuthId(), true);
+        _nukiPublisher->publishString(mqtt_topic_lock_auth_name, getAuthName(), true);
+    }
+}
 
-        entry["index"] = log.index;
-        entry["authorizationId"] = log.authId;
-        entry["authorizationName"] = authName;
+void NukiNetworkLock::publishRollingLog(const std::list<NukiLock::LogEntry>& logEntries)
+{
+    const uint32_t lastRollingLog = _lastRollingLog;
 
-        if(entry["authorizationName"].as<String>().length() == 0 && _authEntries.count(log.authId) > 0)
+    for(const auto& log : logEntries)
+    {
+        if(log.index <= _lastRollingLog)
         {
-            entry["authorizationName"] = _authEntries[log.authId];
+            continue;
         }
 
-        entry["timeYear"] = log.timeStampYear;
-        entry["timeMonth"] = log.timeStampMonth;
-        entry["timeDay"] = log.timeStampDay;
-        entry["timeHour"] = log.timeStampHour;
-        entry["timeMinute"] = log.timeStampMinute;
-        entry["timeSecond"] = log.timeStampSecond;
+        JsonDocument json;
+        authLogEntryToJson(log, json.to<JsonObject>());
+        _lastRollingLog = log.index;
+        serializeJson(json, _buffer, _bufferSize);
+        _nukiPublisher->publishString(mqtt_topic_lock_log_rolling, _buffer, true);
+        _nukiPublisher->publishInt(mqtt_topic_lock_log_rolling_last, log.index, true);
+    }
 
-        memset(str, 0, sizeof(str));
-        loggingTypeToString(log.loggingType, str);
-        entry["type"] = str;
+    if(_lastRollingLog != lastRollingLog)
+    {
+        _preferences->putUInt(preference_lock_auth_log_cursor, _lastRollingLog);
+    }
+}
 
-        switch(log.loggingType)
-        {
-        case NukiLock::LoggingType::LockAction:
-            memset(str, 0, sizeof(str));
-            NukiLock::lockactionToString((NukiLock::LockAction)log.data[0], str);
-            entry["action"] = str;
+void NukiNetworkLock::authLogEntryToJson(const NukiLock::LogEntry& log, JsonObject entry)
+{
+    char str[50];
+    char authName[33];
 
-            memset(str, 0, sizeof(str));
-            NukiLock::triggerToString((NukiLock::Trigger)log.data[1], str);
-            entry["trigger"] = str;
+    memset(authName, 0, sizeof(authName));
+    if(log.loggingType == NukiLock::LoggingType::LockAction || log.loggingType == NukiLock::LoggingType::KeypadAction)
+    {
+        memcpy(authName, log.name, sizeof(log.name));
+    }
 
-            memset(str, 0, sizeof(str));
-            NukiLock::completionStatusToString((NukiLock::CompletionStatus)log.data[3], str);
-            entry["completionStatus"] = str;
-            break;
-        case NukiLock::LoggingType::KeypadAction:
-            memset(str, 0, sizeof(str));
-            NukiLock::lockactionToString((NukiLock::LockAction)log.data[0], str);
-            entry["action"] = str;
+    entry["index"] = log.index;
+    entry["authorizationId"] = log.authId;
+    entry["authorizationName"] = authName;
 
-            switch(log.data[1])
-            {
-            case 0:
-                entry["trigger"] = "arrowkey";
-                break;
-            case 1:
-                entry["trigger"] = "code";
-                break;
-            case 2:
-                entry["trigger"] = "fingerprint";
-                break;
-            default:
-                entry["trigger"] = "Unknown";
-                break;
-            }
+    if(entry["authorizationName"].as<String>().length() == 0 && _authEntries.count(log.authId) > 0)
+    {
+        entry["authorizationName"] = _authEntries[log.authId];
+    }
 
-            memset(str, 0, sizeof(str));
+    entry["timeYear"] = log.timeStampYear;
+    entry["timeMonth"] = log.timeStampMonth;
+    entry["timeDay"] = log.timeStampDay;
+    entry["timeHour"] = log.timeStampHour;
+    entry["timeMinute"] = log.timeStampMinute;
+    entry["timeSecond"] = log.timeStampSecond;
 
-            if(log.data[2] == 9)
-            {
-                entry["completionStatus"] = "notAuthorized";
-            }
-            else if (log.data[2] == 224)
-            {
-                entry["completionStatus"] = "invalidCode";
-            }
-            else
-            {
-                NukiLock::completionStatusToString((NukiLock::CompletionStatus)log.data[2], str);
-                entry["completionStatus"] = str;
-            }
+    memset(str, 0, sizeof(str));
+    loggingTypeToString(log.loggingType, str);
+    entry["type"] = str;
 
-            entry["codeId"] = 256U*log.data[4]+log.data[3];
+    switch(log.loggingType)
+    {
+    case NukiLock::LoggingType::LockAction:
+        memset(str, 0, sizeof(str));
+        NukiLock::lockactionToString((NukiLock::LockAction)log.data[0], str);
+        entry["action"] = str;
+
+        memset(str, 0, sizeof(str));
+        NukiLock::triggerToString((NukiLock::Trigger)log.data[1], str);
+        entry["trigger"] = str;
+
+        memset(str, 0, sizeof(str));
+        NukiLock::completionStatusToString((NukiLock::CompletionStatus)log.data[3], str);
+        entry["completionStatus"] = str;
+        break;
+    case NukiLock::LoggingType::KeypadAction:
+        memset(str, 0, sizeof(str));
+        NukiLock::lockactionToString((NukiLock::LockAction)log.data[0], str);
+        entry["action"] = str;
+
+        switch(log.data[1])
+        {
+        case 0:
+            entry["trigger"] = "arrowkey";
             break;
-        case NukiLock::LoggingType::DoorSensor:
-            switch(log.data[0])
-            {
-            case 0:
-                entry["action"] = "DoorOpened";
-                break;
-            case 1:
-                entry["action"] = "DoorClosed";
-                break;
-            case 2:
-                entry["action"] = "SensorJammed";
-                break;
-            default:
-                entry["action"] = "Unknown";
-                break;
-            }
+        case 1:
+            entry["trigger"] = "code";
+            break;
+        case 2:
+            entry["trigger"] = "fingerprint";
+            break;
+        default:
+            entry["trigger"] = "Unknown";
             break;
         }
 
-        if(log.index > _lastRollingLog)
+        memset(str, 0, sizeof(str));
+
+        if(log.data[2] == 9)
         {
-            _lastRollingLog = log.index;
-            serializeJson(entry, _buffer, _bufferSize);
-            _nukiPublisher->publishString(mqtt_topic_lock_log_rolling, _buffer, true);
-            _nukiPublisher->publishInt(mqtt_topic_lock_log_rolling_last, log.index, true);
+            entry["completionStatus"] = "notAuthorized";
+        }
+        else if (log.data[2] == 224)
+        {
+            entry["completionStatus"] = "invalidCode";
+        }
+        else
+        {
+            NukiLock::completionStatusToString((NukiLock::CompletionStatus)log.data[2], str);
+            entry["completionStatus"] = str;
         }
-    }
-
-    serializeJson(json, _buffer, _bufferSize);
-
-    if(latest)
-    {
-        _nukiPublisher->publishString(mqtt_topic_lock_log_latest, _buffer, true);
-    }
-    else
-    {
-        _nukiPublisher->publishString(mqtt_topic_lock_log, _buffer, true);
-    }
 
-    if(authIndex > 0 || (_nukiOfficial->getOffConnected() && _nukiOfficial->hasAuthId()))
-    {
-        _nukiPublisher->publishUInt(mqtt_topic_lock_auth_id, getAuthId(), true);
-        _nukiPublisher->publishString(mqtt_topic_lock_auth_name, getAuthName(), true);
+        entry["codeId"] = 256U*log.data[4]+log.data[3];
+        break;
+    case NukiLock::LoggingType::DoorSensor:
+        switch(log.data[0])
+        {
+        case 0:
+            entry["action"] = "DoorOpened";
+            break;
+        case 1:
+            entry["action"] = "DoorClosed";
+            break;
+        case 2:
+            entry["action"] = "SensorJammed";
+            break;
+        default:
+            entry["action"] = "Unknown";
+            break;
+        }
+        break;
     }
 }
 
@@ -800,6 +783,24 @@ void NukiNetworkLock::publishCommandResult(const char *resultStr)
     _nukiPublisher->publishString(mqtt_topic_lock_action_command_result, resultStr, true);
 }
 
+void NukiNetworkLock::publishCommandResultJson(uint32_t commandId, const NukiLock::LockAction action, const char* resultStr, int retryCount)
+{
+    // called from the network and the nuki task, don't use the shared buffer
+    JsonDocument json;
+    char str[50];
+    char jsonStr[128];
+
+    json["id"] = commandId;
+    memset(str, 0, sizeof(str));
+    NukiLock::lockactionToString(action, str);
+    json["action"] = str;
+    json["result"] = resultStr;
+    json["retry"] = retryCount;
+
+    serializeJson(json, jsonStr, sizeof(jsonStr));
+    _nukiPublisher->publishString(mqtt_topic_lock_action_command_result_json, jsonStr, false);
+}
+
 void NukiNetworkLock::publishLockstateCommandResult(const char *resultStr)
 {
     _nukiPublisher->publishString(mqtt_topic_query_lockstate_command_result, resultStr, true);
@@ -985,6 +986,12 @@ void NukiNetworkLock::publishBleAddress(const std::string &address)
 
 void NukiNetworkLock::publishKeypad(const std::list<NukiLock::KeypadEntry>& entries, uint maxKeypadCodeCount)
 {
+    const EntrySnapshot<NukiLock::KeypadEntry>::Diff diff = _keypadSnapshot.update(entries);
+    if(!diff.any())
+    {
+        return;
+    }
+
     bool publishCode = _preferences->getBool(preference_keypad_publish_code, false);
     bool topicPerEntry = _preferences->getBool(preference_keypad_topic_per_entry, false);
     uint index = 0;
@@ -999,7 +1006,10 @@ void NukiNetworkLock::publishKeypad(const std::list<NukiLock::KeypadEntry>& entr
         String basePath = mqtt_topic_keypad;
         basePath.concat("/code_");
         basePath.concat(std::to_string(index).c_str());
-        publishKeypadEntry(basePath, entry);
+        if(diff.changed[index])
+        {
+            publishKeypadEntry(basePath, entry);
+        }
 
         auto jsonEntry = json.add<JsonVariant>();
 
@@ -1011,7 +1021,10 @@ void NukiNetworkLock::publishKeypad(const std::list<NukiLock::KeypadEntry>& entr
         }
         jsonEntry["enabled"] = entry.enabled;
         jsonEntry["name"] = entry.name;
-        _authEntries[jsonEntry["codeId"]] = jsonEntry["name"].as<String>();
+        if(diff.changed[index])
+        {
+            _authEntries[jsonEntry["codeId"]] = jsonEntry["name"].as<String>();
+        }
         char createdDT[20];
         sprintf(createdDT, "%04d-%02d-%02d %02d:%02d:%02d", entry.dateCreatedYear, entry.dateCreatedMonth, entry.dateCreatedDay, entry.dateCreatedHour, entry.dateCreatedMin, entry.dateCreatedSec);
         jsonEntry["dateCreated"] = createdDT;
@@ -1084,12 +1097,16 @@ void NukiNetworkLock::publishKeypad(const std::list<NukiLock::KeypadEntry>& entr
         jsonEntry["allowedUntilTime"] = allowedUntilTimeT;
 
         if(topicPerEntry)
+        {
+            jsonEntry["name_ha"] = entry.name;
+            jsonEntry["index"] = index;
+        }
+
+        if(topicPerEntry && diff.changed[index])
         {
             basePath = mqtt_topic_keypad;
             basePath.concat("/codes/");
             basePath.concat(std::to_string(index).c_str());
-            jsonEntry["name_ha"] = entry.name;
-            jsonEntry["index"] = index;
             serializeJson(jsonEntry, _buffer, _bufferSize);
             _nukiPublisher->publishString(basePath.c_str(), _buffer, true);
 
@@ -1133,12 +1150,14 @@ void NukiNetworkLock::publishKeypad(const std::list<NukiLock::KeypadEntry>& entr
         ++index;
     }
 
-    serializeJson(json, _buffer, _bufferSize);
-    _nukiPublisher->publishString(mqtt_topic_keypad_json, _buffer, true);
+    _nukiPublisher->publishJson(mqtt_topic_keypad_json, std::move(json), true);
+
+    // positions no longer used since the last publish, all unused ones on a full publish
+    const uint unusedUntil = diff.full ? maxKeypadCodeCount : diff.previousSize;
 
     if(!_disableNonJSON)
     {
-        while(index < maxKeypadCodeCount)
+        while(index < unusedUntil)
         {
             NukiLock::KeypadEntry entry;
             memset(&entry, 0, sizeof(entry));
@@ -1150,7 +1169,7 @@ void NukiNetworkLock::publishKeypad(const std::list<NukiLock::KeypadEntry>& entr
             ++index;
         }
 
-        if(!publishCode)
+        if(!publishCode && diff.full)
         {
             for(int i=0; i<maxKeypadCodeCount; i++)
             {
@@ -1189,7 +1208,7 @@ void NukiNetworkLock::publishKeypad(const std::list<NukiLock::KeypadEntry>& entr
             }
         }
 
-        for(int j=entries.size(); j<maxKeypadCodeCount; j++)
+        for(int j=entries.size(); j<unusedUntil; j++)
         {
             String codesTopic = _mqttPath;
             codesTopic.concat(mqtt_topic_keypad_codes);
@@ -1352,8 +1371,7 @@ void NukiNetworkLock::publishTimeControl(const std::list<NukiLock::TimeControlEn
         ++index;
     }
 
-    serializeJson(json, _buffer, _bufferSize);
-    _nukiPublisher->publishString(mqtt_topic_timecontrol_json, _buffer, true);
+    _nukiPublisher->publishJson(mqtt_topic_timecontrol_json, std::move(json), true);
 
     for(int j=timeControlEntries.size(); j<maxTimeControlEntryCount; j++)
     {
@@ -1503,8 +1521,7 @@ void NukiNetworkLock::publishAuth(const std::list<NukiLock::AuthorizationEntry>&
         ++index;
     }
 
-    serializeJson(json, _buffer, _bufferSize);
-    _nukiPublisher->publishString(mqtt_topic_auth_json, _buffer, true);
+    _nukiPublisher->publishJson(mqtt_topic_auth_json, std::move(json), true);
 
     for(int j=authEntries.size(); j<maxAuthEntryCount; j++)
     {
@@ -1551,6 +1568,12 @@ void NukiNetworkLock::publishStatusUpdated(const bool statusUpdated)
     _nukiPublisher->publishBool(mqtt_topic_lock_status_updated, statusUpdated, true);
 }
 
+void NukiNetworkLock::publishLockstateQueries(const uint32_t performed, const uint32_t avoided)
+{
+    _nukiPublisher->publishUInt(mqtt_topic_query_lockstate_performed, performed, true);
+    _nukiPublisher->publishUInt(mqtt_topic_query_lockstate_avoided, avoided, true);
+}
+
 void NukiNetworkLock::setLockActionReceivedCallback(LockActionResult (*lockActionReceivedCallback)(const char *))
 {
     _lockActionReceivedCallback = lockActionReceivedCallback;
@@ -1590,39 +1613,6 @@ void NukiNetworkLock::setAuthCommandReceivedCallback(void (*authCommandReceivedR
     _authCommandReceivedReceivedCallback = authCommandReceivedReceivedCallback;
 }
 
-void NukiNetworkLock::buildMqttPath(const char* path, char* outPath)
-{
-    int offset = 0;
-    char inPath[181] = {0};
-
-    memcpy(inPath, _mqttPath, sizeof(_mqttPath));
-
-    for(const char& c : inPath)
-    {
-        if(c == 0x00)
-        {
-            break;
-        }
-        outPath[offset] = c;
-        ++offset;
-    }
-    int i=0;
-    while(outPath[i] != 0x00)
-    {
-        outPath[offset] = path[i];
-        ++i;
-        ++offset;
-    }
-    outPath[i+1] = 0x00;
-}
-
-bool NukiNetworkLock::comparePrefixedPath(const char *fullPath, const char *subPath)
-{
-    char prefixedPath[500];
-    buildMqttPath(subPath, prefixedPath);
-    return strcmp(fullPath, prefixedPath) == 0;
-}
-
 void NukiNetworkLock::publishOffAction(const int value)
 {
     _network->publishInt(_nukiOfficial->getMqttPath(), mqtt_topic_official_lock_action, value, false);
@@ -1647,6 +1637,21 @@ uint8_t NukiNetworkLock::queryCommands()
     return qc;
 }
 
+const uint32_t NukiNetworkLock::getLastRollingLog() const
+{
+    return _lastRollingLog;
+}
+
+void NukiNetworkLock::setLastRollingLog(const uint32_t index)
+{
+    // the cursor is kept across reboots, only written when it changes
+    if(index != _lastRollingLog)
+    {
+        _lastRollingLog = index;
+        _preferences->putUInt(preference_lock_auth_log_cursor, _lastRollingLog);
+    }
+}
+
 void NukiNetworkLock::setupHASS(int type, uint32_t nukiId, char* nukiName, const char* firmwareVersion, const char* hardwareVersion, bool hasDoorSensor, bool hasKeypad)
 {
     _network->setupHASS(type, nukiId, nukiName, firmwareVersion, hardwareVersion, hasDoorSensor, hasKeypad);
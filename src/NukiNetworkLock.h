@@ -15,8 +15,9 @@
 #include "NukiOfficial.h"
 #include "NukiPublisher.h"
 #include "EspMillis.h"
+#include "EntrySnapshot.h"
 
-class NukiNetworkLock : public MqttReceiver
+class NukiNetworkLock
 {
 public:
     explicit NukiNetworkLock(NukiNetwork* network, NukiOfficial* nukiOfficial, Preferences* preferences, char* buffer, size_t bufferSize);
@@ -28,8 +29,10 @@ public:
     void publishKeyTurnerState(const NukiLock::KeyTurnerState& keyTurnerState, const NukiLock::KeyTurnerState& lastKeyTurnerState);
     void publishState(NukiLock::LockState lockState);
     void publishAuthorizationInfo(const std::list<NukiLock::LogEntry>& logEntries, bool latest);
+    void publishRollingLog(const std::list<NukiLock::LogEntry>& logEntries);
     void clearAuthorizationInfo();
     void publishCommandResult(const char* resultStr);
+    void publishCommandResultJson(uint32_t commandId, const NukiLock::LockAction action, const char* resultStr, int retryCount);
     void publishLockstateCommandResult(const char* resultStr);
     void publishBatteryReport(const NukiLock::BatteryReport& batteryReport);
     void publishConfig(const NukiLock::Config& config);
@@ -41,6 +44,7 @@ public:
     void publishTimeControl(const std::list<NukiLock::TimeControlEntry>& timeControlEntries, uint maxTimeControlEntryCount);
     void publishAuth(const std::list<NukiLock::AuthorizationEntry>& authEntries, uint maxAuthEntryCount);
     void publishStatusUpdated(const bool statusUpdated);
+    void publishLockstateQueries(const uint32_t performed, const uint32_t avoided);
     void publishConfigCommandResult(const char* result);
     void publishKeypadCommandResult(const char* result);
     void publishKeypadJsonCommandResult(const char* result);
@@ -55,18 +59,24 @@ public:
     void setKeypadJsonCommandReceivedCallback(void (*keypadJsonCommandReceivedReceivedCallback)(const char* value));
     void setTimeControlCommandReceivedCallback(void (*timeControlCommandReceivedReceivedCallback)(const char* value));
     void setAuthCommandReceivedCallback(void (*authCommandReceivedReceivedCallback)(const char* value));
-    void onMqttDataReceived(const char* topic, byte* payload, const unsigned int length) override;
     void setupHASS(int type, uint32_t nukiId, char* nukiName, const char* firmwareVersion, const char* hardwareVersion, bool hasDoorSensor, bool hasKeypad);
 
     const uint32_t getAuthId() const;
     const char* getAuthName();
     int mqttConnectionState();
     uint8_t queryCommands();
+    const uint32_t getLastRollingLog() const;
+    void setLastRollingLog(const uint32_t index);
 
 private:
-    bool comparePrefixedPath(const char* fullPath, const char* subPath);
+    void onLockActionReceived(const char* data);
+    void onRollingLogReceived(const char* data);
+    void onKeypadCommandActionReceived(const char* data);
+    void onQueryReceived(const char* topic, const char* data, const uint8_t queryCommand);
+    void onJsonActionReceived(const char* topic, const char* data, void (*callback)(const char* value));
 
     void publishKeypadEntry(const String topic, NukiLock::KeypadEntry entry);
+    void authLogEntryToJson(const NukiLock::LogEntry& log, JsonObject entry);
     void buttonPressActionToString(const NukiLock::ButtonPressAction btnPressAction, char* str);
     void motorSpeedToString(const NukiLock::MotorSpeed speed, char* str);
     void homeKitStatusToString(const int hkstatus, char* str);
@@ -76,14 +86,13 @@ private:
 
     String concat(String a, String b);
 
-    void buildMqttPath(const char* path, char* outPath);
-
     NukiNetwork* _network = nullptr;
     NukiPublisher* _nukiPublisher = nullptr;
     NukiOfficial* _nukiOfficial = nullptr;
     Preferences* _preferences = nullptr;
 
     std::map<uint32_t, String> _authEntries;
+    EntrySnapshot<NukiLock::KeypadEntry> _keypadSnapshot;
     char _mqttPath[181] = {0};
 
     bool _firstTunerStatePublish = true;
@@ -4,6 +4,7 @@
 #include "PreferencesKeys.h"
 #include "Logger.h"
 #include "Config.h"
+#include "NukiTaskWakeup.h"
 #include <ArduinoJson.h>
 
 NukiNetworkOpener::NukiNetworkOpener(NukiNetwork* network, Preferences* preferences, char* buffer, size_t bufferSize)
@@ -16,8 +17,6 @@ NukiNetworkOpener::NukiNetworkOpener(NukiNetwork* network, Preferences* preferen
 
     memset(_authName, 0, sizeof(_authName));
     _authName[0] = '\0';
-
-    _network->registerMqttReceiver(this);
 }
 
 void NukiNetworkOpener::initialize()
@@ -32,12 +31,22 @@ void NukiNetworkOpener::initialize()
     }
 
     _haEnabled = _preferences->getString(preference_mqtt_hass_discovery, "") != "";
+    _lastRollingLog = _preferences->getUInt(preference_opener_auth_log_cursor, 0);
     _disableNonJSON = _preferences->getBool(preference_disable_non_json, false);
 
+    MqttTopics mqttTopics;
+    _network->registerTopics(_mqttPath, mqttTopics.getMqttTopics());
+
     _network->initTopic(_mqttPath, mqtt_topic_lock_action, "--");
-    _network->subscribe(_mqttPath, mqtt_topic_lock_action);
+    _network->subscribe(_mqttPath, mqtt_topic_lock_action, [this](const char* topic, const char* data, const unsigned int length)
+    {
+        onLockActionReceived(data);
+    });
     _network->initTopic(_mqttPath, mqtt_topic_config_action, "--");
-    _network->subscribe(_mqttPath, mqtt_topic_config_action);
+    _network->subscribe(_mqttPath, mqtt_topic_config_action, [this](const char* topic, const char* data, const unsigned int length)
+    {
+        onJsonActionReceived(mqtt_topic_config_action, data, _configUpdateReceivedCallback);
+    });
 
     _network->initTopic(_mqttPath, mqtt_topic_query_keypad, "0");
     _network->initTopic(_mqttPath, mqtt_topic_query_config, "0");
@@ -45,9 +54,18 @@ void NukiNetworkOpener::initialize()
     _network->initTopic(_mqttPath, mqtt_topic_query_battery, "0");
     _network->initTopic(_mqttPath, mqtt_topic_lock_binary_ring, "standby");
     _network->initTopic(_mqttPath, mqtt_topic_lock_ring, "standby");
-    _network->subscribe(_mqttPath, mqtt_topic_query_config);
-    _network->subscribe(_mqttPath, mqtt_topic_query_lockstate);
-    _network->subscribe(_mqttPath, mqtt_topic_query_battery);
+    _network->subscribe(_mqttPath, mqtt_topic_query_config, [this](const char* topic, const char* data, const unsigned int length)
+    {
+        onQueryReceived(mqtt_topic_query_config, data, QUERY_COMMAND_CONFIG);
+    });
+    _network->subscribe(_mqttPath, mqtt_topic_query_lockstate, [this](const char* topic, const char* data, const unsigned int length)
+    {
+        onQueryReceived(mqtt_topic_query_lockstate, data, QUERY_COMMAND_LOCKSTATE);
+    });
+    _network->subscribe(_mqttPath, mqtt_topic_query_battery, [this](const char* topic, const char* data, const unsigned int length)
+    {
+        onQueryReceived(mqtt_topic_query_battery, data, QUERY_COMMAND_BATTERY);
+    });
 
     _network->initTopic(_mqttPath, mqtt_topic_keypad_json_action, "--");
     _network->initTopic(_mqttPath, mqtt_topic_timecontrol_action, "--");
@@ -102,31 +120,67 @@ void NukiNetworkOpener::initialize()
             _network->initTopic(_mqttPath, mqtt_topic_keypad_command_name, "--");
             _network->initTopic(_mqttPath, mqtt_topic_keypad_command_code, "000000");
             _network->initTopic(_mqttPath, mqtt_topic_keypad_command_enabled, "1");
-            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_action);
-            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_id);
-            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_name);
-            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_code);
-            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_enabled);
+            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_action, [this](const char* topic, const char* data, const unsigned int length)
+            {
+                onKeypadCommandActionReceived(data);
+            });
+            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_id, [this](const char* topic, const char* data, const unsigned int length)
+            {
+                _keypadCommandId = atoi(data);
+            });
+            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_name, [this](const char* topic, const char* data, const unsigned int length)
+            {
+                _keypadCommandName = data;
+            });
+            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_code, [this](const char* topic, const char* data, const unsigned int length)
+            {
+                _keypadCommandCode = data;
+            });
+            _network->subscribe(_mqttPath, mqtt_topic_keypad_command_enabled, [this](const char* topic, const char* data, const unsigned int length)
+            {
+                _keypadCommandEnabled = atoi(data);
+            });
         }
 
-        _network->subscribe(_mqttPath, mqtt_topic_query_keypad);
-        _network->subscribe(_mqttPath, mqtt_topic_keypad_json_action);
+        _network->subscribe(_mqttPath, mqtt_topic_query_keypad, [this](const char* topic, const char* data, const unsigned int length)
+        {
+            onQueryReceived(mqtt_topic_query_keypad, data, QUERY_COMMAND_KEYPAD);
+        });
+        _network->subscribe(_mqttPath, mqtt_topic_keypad_json_action, [this](const char* topic, const char* data, const unsigned int length)
+        {
+            onJsonActionReceived(mqtt_topic_keypad_json_action, data, _keypadJsonCommandReceivedReceivedCallback);
+        });
     }
 
     if(_preferences->getBool(preference_timecontrol_control_enabled, false))
     {
-        _network->subscribe(_mqttPath, mqtt_topic_timecontrol_action);
+        _network->subscribe(_mqttPath, mqtt_topic_timecontrol_action, [this](const char* topic, const char* data, const unsigned int length)
+        {
+            onJsonActionReceived(mqtt_topic_timecontrol_action, data, _timeControlCommandReceivedReceivedCallback);
+        });
     }
 
     if(_preferences->getBool(preference_auth_control_enabled))
     {
-        _network->subscribe(_mqttPath, mqtt_topic_auth_action);
+        _network->subscribe(_mqttPath, mqtt_topic_auth_action, [this](const char* topic, const char* data, const unsigned int length)
+        {
+            onJsonActionReceived(mqtt_topic_auth_action, data, _authCommandReceivedReceivedCallback);
+        });
     }
 
     if(_preferences->getBool(preference_publish_authdata, false))
     {
-        _network->subscribe(_mqttPath, mqtt_topic_lock_log_rolling_last);
+        _network->subscribe(_mqttPath, mqtt_topic_lock_log_rolling_last, [this](const char* topic, const char* data, const unsigned int length)
+        {
+            onRollingLogReceived(data);
+        });
     }
+
+    // retained topics may be lost with the broker session, publish the keypad in full again
+    _network->addReconnectedCallback([this]()
+    {
+        _keypadSnapshot.invalidate();
+    });
 }
 
 void NukiNetworkOpener::update()
@@ -139,193 +193,109 @@ void NukiNetworkOpener::update()
     }
 }
 
-void NukiNetworkOpener::onMqttDataReceived(const char* topic, byte* payload, const unsigned int length)
+void NukiNetworkOpener::onLockActionReceived(const char* data)
 {
-    char* data = (char*)payload;
-
-    if(_network->mqttRecentlyConnected() && _network->pathEquals(_mqttPath, mqtt_topic_lock_action, topic))
+    if(_network->mqttRecentlyConnected())
     {
         Log->println("MQTT recently connected, ignoring opener action.");
         return;
     }
 
-    if(comparePrefixedPath(topic, mqtt_topic_lock_log_rolling_last))
+    if(strcmp(data, "") == 0 ||
+            strcmp(data, "--") == 0 ||
+            strcmp(data, "ack") == 0 ||
+            strcmp(data, "unknown_action") == 0 ||
+            strcmp(data, "denied") == 0 ||
+            strcmp(data, "error") == 0)
     {
-        if(strcmp(data, "") == 0 ||
-                strcmp(data, "--") == 0)
-        {
-            return;
-        }
-
-        if(atoi(data) > 0 && atoi(data) > _lastRollingLog)
-        {
-            _lastRollingLog = atoi(data);
-        }
+        return;
     }
 
-    if(comparePrefixedPath(topic, mqtt_topic_lock_action))
+    Log->print("Opener action received: ");
+    Log->println(data);
+    LockActionResult lockActionResult = LockActionResult::Failed;
+    if(_lockActionReceivedCallback != NULL)
     {
-        if(strcmp(data, "") == 0 ||
-                strcmp(data, "--") == 0 ||
-                strcmp(data, "ack") == 0 ||
-                strcmp(data, "unknown_action") == 0 ||
-                strcmp(data, "denied") == 0 ||
-                strcmp(data, "error") == 0)
-        {
-            return;
-        }
-
-        Log->print("Opener action received: ");
-        Log->println(data);
-        LockActionResult lockActionResult = LockActionResult::Failed;
-        if(_lockActionReceivedCallback != NULL)
-        {
-            lockActionResult = _lockActionReceivedCallback(data);
-        }
-
-        switch(lockActionResult)
-        {
-        case LockActionResult::Success:
-            _nukiPublisher->publishString(mqtt_topic_lock_action, "ack", false);
-            break;
-        case LockActionResult::UnknownAction:
-            _nukiPublisher->publishString(mqtt_topic_lock_action, "unknown_action", false);
-            break;
-        case LockActionResult::AccessDenied:
-            _nukiPublisher->publishString(mqtt_topic_lock_action, "denied", false);
-            break;
-        case LockActionResult::Failed:
-            _nukiPublisher->publishString(mqtt_topic_lock_action, "error", false);
-            break;
-        }
+        lockActionResult = _lockActionReceivedCallback(data);
     }
 
-    if(!_disableNonJSON)
+    switch(lockActionResult)
     {
-        if(comparePrefixedPath(topic, mqtt_topic_keypad_command_action))
-        {
-            if(_keypadCommandReceivedReceivedCallback != nullptr)
-            {
-                if(strcmp(data, "--") == 0)
-                {
-                    return;
-                }
-
-                _keypadCommandReceivedReceivedCallback(data, _keypadCommandId, _keypadCommandName, _keypadCommandCode, _keypadCommandEnabled);
-
-                _keypadCommandId = 0;
-                _keypadCommandName = "--";
-                _keypadCommandCode = "000000";
-                _keypadCommandEnabled = 1;
-
-                if(strcmp(data, "--") != 0)
-                {
-                    _nukiPublisher->publishString(mqtt_topic_keypad_command_action, "--", true);
-                }
-                _nukiPublisher->publishInt(mqtt_topic_keypad_command_id, _keypadCommandId, true);
-                _nukiPublisher->publishString(mqtt_topic_keypad_command_name, _keypadCommandName, true);
-                _nukiPublisher->publishString(mqtt_topic_keypad_command_code, _keypadCommandCode, true);
-                _nukiPublisher->publishInt(mqtt_topic_keypad_command_enabled, _keypadCommandEnabled, true);
-            }
-        }
-        else if(comparePrefixedPath(topic, mqtt_topic_keypad_command_id))
-        {
-            _keypadCommandId = atoi(data);
-        }
-        else if(comparePrefixedPath(topic, mqtt_topic_keypad_command_name))
-        {
-            _keypadCommandName = data;
-        }
-        else if(comparePrefixedPath(topic, mqtt_topic_keypad_command_code))
-        {
-            _keypadCommandCode = data;
-        }
-        else if(comparePrefixedPath(topic, mqtt_topic_keypad_command_enabled))
-        {
-            _keypadCommandEnabled = atoi(data);
-        }
+    case LockActionResult::Success:
+        _nukiPublisher->publishString(mqtt_topic_lock_action, "ack", false);
+        break;
+    case LockActionResult::UnknownAction:
+        _nukiPublisher->publishString(mqtt_topic_lock_action, "unknown_action", false);
+        break;
+    case LockActionResult::AccessDenied:
+        _nukiPublisher->publishString(mqtt_topic_lock_action, "denied", false);
+        break;
+    case LockActionResult::Failed:
+        _nukiPublisher->publishString(mqtt_topic_lock_action, "error", false);
+        break;
     }
+}
 
-    if(comparePrefixedPath(topic, mqtt_topic_query_config) && strcmp(data, "1") == 0)
-    {
-        _queryCommands = _queryCommands | QUERY_COMMAND_CONFIG;
-        _nukiPublisher->publishInt(mqtt_topic_query_config, 0, true);
-    }
-    else if(comparePrefixedPath(topic, mqtt_topic_query_lockstate) && strcmp(data, "1") == 0)
-    {
-        _queryCommands = _queryCommands | QUERY_COMMAND_LOCKSTATE;
-        _nukiPublisher->publishInt(mqtt_topic_query_lockstate, 0, true);
-    }
-    else if(comparePrefixedPath(topic, mqtt_topic_query_keypad) && strcmp(data, "1") == 0)
+void NukiNetworkOpener::onRollingLogReceived(const char* data)
+{
+    if(strcmp(data, "") == 0 ||
+            strcmp(data, "--") == 0)
     {
-        _queryCommands = _queryCommands | QUERY_COMMAND_KEYPAD;
-        _nukiPublisher->publishInt(mqtt_topic_query_keypad, 0, true);
+        return;
     }
-    else if(comparePrefixedPath(topic, mqtt_topic_query_battery) && strcmp(data, "1") == 0)
+
+    if(atoi(data) > 0 && atoi(data) > _lastRollingLog)
     {
-        _queryCommands = _queryCommands | QUERY_COMMAND_BATTERY;
-        _nukiPublisher->publishInt(mqtt_topic_query_battery, 0, true);
+        setLastRollingLog(atoi(data));
     }
+}
 
-    if(comparePrefixedPath(topic, mqtt_topic_config_action))
+void NukiNetworkOpener::onKeypadCommandActionReceived(const char* data)
+{
+    if(_keypadCommandReceivedReceivedCallback == nullptr || strcmp(data, "--") == 0)
     {
-        if(strcmp(data, "") == 0 || strcmp(data, "--") == 0)
-        {
-            return;
-        }
-
-        if(_configUpdateReceivedCallback != NULL)
-        {
-            _configUpdateReceivedCallback(data);
-        }
-
-        _nukiPublisher->publishString(mqtt_topic_config_action, "--", true);
+        return;
     }
 
-    if(comparePrefixedPath(topic, mqtt_topic_keypad_json_action))
-    {
-        if(strcmp(data, "") == 0 || strcmp(data, "--") == 0)
-        {
-            return;
-        }
+    _keypadCommandReceivedReceivedCallback(data, _keypadCommandId, _keypadCommandName, _keypadCommandCode, _keypadCommandEnabled);
 
-        if(_keypadJsonCommandReceivedReceivedCallback != NULL)
-        {
-            _keypadJsonCommandReceivedReceivedCallback(data);
-        }
+    _keypadCommandId = 0;
+    _keypadCommandName = "--";
+    _keypadCommandCode = "000000";
+    _keypadCommandEnabled = 1;
 
-        _nukiPublisher->publishString(mqtt_topic_keypad_json_action, "--", true);
-    }
+    _nukiPublisher->publishString(mqtt_topic_keypad_command_action, "--", true);
+    _nukiPublisher->publishInt(mqtt_topic_keypad_command_id, _keypadCommandId, true);
+    _nukiPublisher->publishString(mqtt_topic_keypad_command_name, _keypadCommandName, true);
+    _nukiPublisher->publishString(mqtt_topic_keypad_command_code, _keypadCommandCode, true);
+    _nukiPublisher->publishInt(mqtt_topic_keypad_command_enabled, _keypadCommandEnabled, true);
+}
 
-    if(comparePrefixedPath(topic, mqtt_topic_timecontrol_action))
+void NukiNetworkOpener::onQueryReceived(const char* topic, const char* data, const uint8_t queryCommand)
+{
+    if(strcmp(data, "1") != 0)
     {
-        if(strcmp(data, "") == 0 || strcmp(data, "--") == 0)
-        {
-            return;
-        }
+        return;
+    }
 
-        if(_timeControlCommandReceivedReceivedCallback != NULL)
-        {
-            _timeControlCommandReceivedReceivedCallback(data);
-        }
+    _queryCommands = _queryCommands | queryCommand;
+    NukiTaskWakeup::notify(NukiTaskWakeupReason::Query);
+    _nukiPublisher->publishInt(topic, 0, true);
+}
 
-        _nukiPublisher->publishString(mqtt_topic_timecontrol_action, "--", true);
+void NukiNetworkOpener::onJsonActionReceived(const char* topic, const char* data, void (*callback)(const char* value))
+{
+    if(strcmp(data, "") == 0 || strcmp(data, "--") == 0)
+    {
+        return;
     }
 
-    if(comparePrefixedPath(topic, mqtt_topic_auth_action))
+    if(callback != NULL)
     {
-        if(strcmp(data, "") == 0 || strcmp(data, "--") == 0)
-        {
-            return;
-        }
-
-        if(_authCommandReceivedReceivedCallback != NULL)
-        {
-            _authCommandReceivedReceivedCallback(data);
-        }
-
-        _nukiPublisher->publishString(mqtt_topic_auth_action, "--", true);
+        callback(data);
     }
+
+    _nukiPublisher->publishString(topic, "--", true);
 }
 
 void NukiNetworkOpener::publishKeyTurnerState(const NukiOpener::OpenerState& keyTurnerState, const NukiOpener::OpenerState& lastKeyTurnerState)
@@ -491,7 +461,6 @@ void NukiNetworkOpener::publishState(NukiOpener::OpenerState lockState)
 
 void NukiNetworkOpener::publishAuthorizationInfo(const std::list<NukiOpener::LogEntry>& logEntries, bool latest)
 {
-    char str[50];
     char authName[33];
     uint32_t authIndex = 0;
 
@@ -526,176 +495,189 @@ void NukiNetworkOpener::publishAuthorizationInfo(const std::list<NukiOpener::Log
             }
         }
 
-        auto entry = json.add<JsonVariant>();
-
-        entry["index"] = log.index;
-        entry["authorizationId"] = log.authId;
-        entry["authorizationName"] = _authName;
+        authLogEntryToJson(log, json.add<JsonObject>());
+    }
 
-        if(entry["authorizationName"].as<String>().length() == 0 && _authEntries.count(log.authId) > 0)
-        {
-            entry["authorizationName"] = _authEntries[log.authId];
-        }
+    _nukiPublisher->publishJson(latest ? mqtt_topic_lock_log_latest : mqtt_topic_lock_log, std::move(json), true);
 
-        entry["timeYear"] = log.timeStampYear;
-        entry["timeMonth"] = log.timeStampMonth;
-        entry["timeDay"] = log.timeStampDay;
-        entry["timeHour"] = log.timeStampHour;
-        entry["timeMinute"] = log.timeStampMinute;
-        entry["timeSecond"] = log.timeStampSecond;
+    if(authIndex > 0)
+    {
+        _nukiPublisher->publishUInt(mqtt_topic_lock_auth_id, _authId, true);
+        _nukiPublisher->publishString(mqtt_topic_lock_auth_name, _authName, true);
+    }
+}
 
-        memset(str, 0, sizeof(str));
-        loggingTypeToString(log.loggingType, str);
-        entry["type"] = str;
+void NukiNetworkOpener::publishRollingLog(const std::list<NukiOpener::LogEntry>& logEntries)
+{
+    const uint32_t lastRollingLog = _lastRollingLog;
 
-        switch(log.loggingType)
+    for(const auto& log : logEntries)
+    {
+        if(log.index <= _lastRollingLog)
         {
-        case NukiOpener::LoggingType::LockAction:
-            memset(str, 0, sizeof(str));
-            NukiOpener::lockactionToString((NukiOpener::LockAction)log.data[0], str);
-            entry["action"] = str;
-
-            memset(str, 0, sizeof(str));
-            NukiOpener::triggerToString((NukiOpener::Trigger)log.data[1], str);
-            entry["trigger"] = str;
-
-            memset(str, 0, sizeof(str));
-            NukiOpener::completionStatusToString((NukiOpener::CompletionStatus)log.data[3], str);
-            entry["completionStatus"] = str;
-            break;
-        case NukiOpener::LoggingType::KeypadAction:
-            memset(str, 0, sizeof(str));
-            NukiOpener::lockactionToString((NukiOpener::LockAction)log.data[0], str);
-            entry["action"] = str;
-
-            switch(log.data[1])
-            {
-            case 0:
-                entry["trigger"] = "arrowkey";
-                break;
-            case 1:
-                entry["trigger"] = "code";
-                break;
-            case 2:
-                entry["trigger"] = "fingerprint";
-                break;
-            default:
-                entry["trigger"] = "Unknown";
-                break;
-            }
+            continue;
+        }
 
-            memset(str, 0, sizeof(str));
+        JsonDocument json;
+        authLogEntryToJson(log, json.to<JsonObject>());
+        serializeJson(json, _buffer, _bufferSize);
+        _nukiPublisher->publishString(mqtt_topic_lock_log_rolling, _buffer, true);
+        _nukiPublisher->publishInt(mqtt_topic_lock_log_rolling_last, log.index, true);
 
-            if(log.data[2] == 9)
-            {
-                entry["completionStatus"] = "notAuthorized";
-            }
-            else if (log.data[2] == 224)
+        if(log.loggingType == NukiOpener::LoggingType::DoorbellRecognition && _lastRollingLog > 0)
+        {
+            if((log.data[0] & 3) == 0)
             {
-                entry["completionStatus"] = "invalidCode";
+                Log->println("Nuki opener: Ring detected (Locked)");
+                publishRing(true);
             }
             else
             {
-                NukiOpener::completionStatusToString((NukiOpener::CompletionStatus)log.data[2], str);
-                entry["completionStatus"] = str;
+                Log->println("Nuki opener: Ring detected (Open)");
+                publishRing(false);
             }
+        }
 
-            entry["codeId"] = 256U*log.data[4]+log.data[3];
-            break;
-        case NukiOpener::LoggingType::DoorbellRecognition:
-            switch(log.data[0] & 3)
-            {
-            case 0:
-                entry["mode"] = "None";
-                break;
-            case 1:
-                entry["mode"] = "RTO";
-                break;
-            case 2:
-                entry["mode"] = "CM";
-                break;
-            default:
-                entry["mode"] = "Unknown";
-                break;
-            }
+        _lastRollingLog = log.index;
+    }
 
-            switch(log.data[1])
-            {
-            case 0:
-                entry["source"] = "Doorbell";
-                break;
-            case 1:
-                entry["source"] = "Timecontrol";
-                break;
-            case 2:
-                entry["source"] = "App";
-                break;
-            case 3:
-                entry["source"] = "Button";
-                break;
-            case 4:
-                entry["source"] = "Fob";
-                break;
-            case 5:
-                entry["source"] = "Bridge";
-                break;
-            case 6:
-                entry["source"] = "Keypad";
-                break;
-            default:
-                entry["source"] = "Unknown";
-                break;
-            }
+    if(_lastRollingLog != lastRollingLog)
+    {
+        _preferences->putUInt(preference_opener_auth_log_cursor, _lastRollingLog);
+    }
+}
 
-            entry["geofence"] = log.data[2] == 1 ? "active" : "inactive";
-            entry["doorbellSuppression"] = log.data[3] == 1 ? "active" : "inactive";
-            entry["soundId"] = log.data[4];
-            memset(str, 0, sizeof(str));
-            NukiOpener::completionStatusToString((NukiOpener::CompletionStatus)log.data[5], str);
-            entry["completionStatus"] = str;
-            entry["codeId"] = 256U*log.data[7]+log.data[6];
-            break;
-        }
+void NukiNetworkOpener::authLogEntryToJson(const NukiOpener::LogEntry& log, JsonObject entry)
+{
+    char str[50];
+
+    entry["index"] = log.index;
+    entry["authorizationId"] = log.authId;
+    entry["authorizationName"] = _authName;
+
+    if(entry["authorizationName"].as<String>().length() == 0 && _authEntries.count(log.authId) > 0)
+    {
+        entry["authorizationName"] = _authEntries[log.authId];
+    }
+
+    entry["timeYear"] = log.timeStampYear;
+    entry["timeMonth"] = log.timeStampMonth;
+    entry["timeDay"] = log.timeStampDay;
+    entry["timeHour"] = log.timeStampHour;
+    entry["timeMinute"] = log.timeStampMinute;
+    entry["timeSecond"] = log.timeStampSecond;
+
+    memset(str, 0, sizeof(str));
+    loggingTypeToString(log.loggingType, str);
+    entry["type"] = str;
+
+    switch(log.loggingType)
+    {
+    case NukiOpener::LoggingType::LockAction:
+        memset(str, 0, sizeof(str));
+        NukiOpener::lockactionToString((NukiOpener::LockAction)log.data[0], str);
+        entry["action"] = str;
 
-        if(log.index > _lastRollingLog)
+        memset(str, 0, sizeof(str));
+        NukiOpener::triggerToString((NukiOpener::Trigger)log.data[1], str);
+        entry["trigger"] = str;
+
+        memset(str, 0, sizeof(str));
+        NukiOpener::completionStatusToString((NukiOpener::CompletionStatus)log.data[3], str);
+        entry["completionStatus"] = str;
+        break;
+    case NukiOpener::LoggingType::KeypadAction:
+        memset(str, 0, sizeof(str));
+        NukiOpener::lockactionToString((NukiOpener::LockAction)log.data[0], str);
+        entry["action"] = str;
+
+        switch(log.data[1])
         {
-            serializeJson(entry, _buffer, _bufferSize);
-            _nukiPublisher->publishString(mqtt_topic_lock_log_rolling, _buffer, true);
-            _nukiPublisher->publishInt(mqtt_topic_lock_log_rolling_last, log.index, true);
+        case 0:
+            entry["trigger"] = "arrowkey";
+            break;
+        case 1:
+            entry["trigger"] = "code";
+            break;
+        case 2:
+            entry["trigger"] = "fingerprint";
+            break;
+        default:
+            entry["trigger"] = "Unknown";
+            break;
+        }
 
-            if(log.loggingType == NukiOpener::LoggingType::DoorbellRecognition && _lastRollingLog > 0)
-            {
-                if((log.data[0] & 3) == 0)
-                {
-                    Log->println("Nuki opener: Ring detected (Locked)");
-                    publishRing(true);
-                }
-                else
-                {
-                    Log->println("Nuki opener: Ring detected (Open)");
-                    publishRing(false);
-                }
-            }
+        memset(str, 0, sizeof(str));
 
-            _lastRollingLog = log.index;
+        if(log.data[2] == 9)
+        {
+            entry["completionStatus"] = "notAuthorized";
+        }
+        else if (log.data[2] == 224)
+        {
+            entry["completionStatus"] = "invalidCode";
+        }
+        else
+        {
+            NukiOpener::completionStatusToString((NukiOpener::CompletionStatus)log.data[2], str);
+            entry["completionStatus"] = str;
         }
-    }
 
-    serializeJson(json, _buffer, _bufferSize);
+        entry["codeId"] = 256U*log.data[4]+log.data[3];
+        break;
+    case NukiOpener::LoggingType::DoorbellRecognition:
+        switch(log.data[0] & 3)
+        {
+        case 0:
+            entry["mode"] = "None";
+            break;
+        case 1:
+            entry["mode"] = "RTO";
+            break;
+        case 2:
+            entry["mode"] = "CM";
+            break;
+        default:
+            entry["mode"] = "Unknown";
+            break;
+        }
 
-    if(latest)
-    {
-        _nukiPublisher->publishString(mqtt_topic_lock_log_latest, _buffer, true);
-    }
-    else
-    {
-        _nukiPublisher->publishString(mqtt_topic_lock_log, _buffer, true);
-    }
+        switch(log.data[1])
+        {
+        case 0:
+            entry["source"] = "Doorbell";
+            break;
+        case 1:
+            entry["source"] = "Timecontrol";
+            break;
+        case 2:
+            entry["source"] = "App";
+            break;
+        case 3:
+            entry["source"] = "Button";
+            break;
+        case 4:
+            entry["source"] = "Fob";
+            break;
+        case 5:
+            entry["source"] = "Bridge";
+            break;
+        case 6:
+            entry["source"] = "Keypad";
+            break;
+        default:
+            entry["source"] = "Unknown";
+            break;
+        }
 
-    if(authIndex > 0)
-    {
-        _nukiPublisher->publishUInt(mqtt_topic_lock_auth_id, _authId, true);
-        _nukiPublisher->publishString(mqtt_topic_lock_auth_name, _authName, true);
+        entry["geofence"] = log.data[2] == 1 ? "active" : "inactive";
+        entry["doorbellSuppression"] = log.data[3] == 1 ? "active" : "inactive";
+        entry["soundId"] = log.data[4];
+        memset(str, 0, sizeof(str));
+        NukiOpener::completionStatusToString((NukiOpener::CompletionStatus)log.data[5], str);
+        entry["completionStatus"] = str;
+        entry["codeId"] = 256U*log.data[7]+log.data[6];
+        break;
     }
 }
 
@@ -711,6 +693,24 @@ void NukiNetworkOpener::publishCommandResult(const char *resultStr)
     _nukiPublisher->publishString(mqtt_topic_lock_action_command_result, resultStr, true);
 }
 
+void NukiNetworkOpener::publishCommandResultJson(uint32_t commandId, const NukiOpener::LockAction action, const char* resultStr, int retryCount)
+{
+    // called from the network and the nuki task, don't use the shared buffer
+    JsonDocument json;
+    char str[50];
+    char jsonStr[128];
+
+    json["id"] = commandId;
+    memset(str, 0, sizeof(str));
+    NukiOpener::lockactionToString(action, str);
+    json["action"] = str;
+    json["result"] = resultStr;
+    json["retry"] = retryCount;
+
+    serializeJson(json, jsonStr, sizeof(jsonStr));
+    _nukiPublisher->publishString(mqtt_topic_lock_action_command_result_json, jsonStr, false);
+}
+
 void NukiNetworkOpener::publishLockstateCommandResult(const char *resultStr)
 {
     _nukiPublisher->publishString(mqtt_topic_query_lockstate_command_result, resultStr, true);
@@ -872,6 +872,12 @@ void NukiNetworkOpener::publishBleAddress(const std::string &address)
 
 void NukiNetworkOpener::publishKeypad(const std::list<NukiLock::KeypadEntry>& entries, uint maxKeypadCodeCount)
 {
+    const EntrySnapshot<NukiLock::KeypadEntry>::Diff diff = _keypadSnapshot.update(entries);
+    if(!diff.any())
+    {
+        return;
+    }
+
     bool publishCode = _preferences->getBool(preference_keypad_publish_code, false);
     bool topicPerEntry = _preferences->getBool(preference_keypad_topic_per_entry, false);
     uint index = 0;
@@ -886,7 +892,10 @@ void NukiNetworkOpener::publishKeypad(const std::list<NukiLock::KeypadEntry>& en
         String basePath = mqtt_topic_keypad;
         basePath.concat("/code_");
         basePath.concat(std::to_string(index).c_str());
-        publishKeypadEntry(basePath, entry);
+        if(diff.changed[index])
+        {
+            publishKeypadEntry(basePath, entry);
+        }
 
         auto jsonEntry = json.add<JsonVariant>();
 
@@ -898,7 +907,10 @@ void NukiNetworkOpener::publishKeypad(const std::list<NukiLock::KeypadEntry>& en
         }
         jsonEntry["enabled"] = entry.enabled;
         jsonEntry["name"] = entry.name;
-        _authEntries[jsonEntry["codeId"]] = jsonEntry["name"].as<String>();
+        if(diff.changed[index])
+        {
+            _authEntries[jsonEntry["codeId"]] = jsonEntry["name"].as<String>();
+        }
         char createdDT[20];
         sprintf(createdDT, "%04d-%02d-%02d %02d:%02d:%02d", entry.dateCreatedYear, entry.dateCreatedMonth, entry.dateCreatedDay, entry.dateCreatedHour, entry.dateCreatedMin, entry.dateCreatedSec);
         jsonEntry["dateCreated"] = createdDT;
@@ -971,12 +983,16 @@ void NukiNetworkOpener::publishKeypad(const std::list<NukiLock::KeypadEntry>& en
         jsonEntry["allowedUntilTime"] = allowedUntilTimeT;
 
         if(topicPerEntry)
+        {
+            jsonEntry["name_ha"] = entry.name;
+            jsonEntry["index"] = index;
+        }
+
+        if(topicPerEntry && diff.changed[index])
         {
             basePath = mqtt_topic_keypad;
             basePath.concat("/codes/");
             basePath.concat(std::to_string(index).c_str());
-            jsonEntry["name_ha"] = entry.name;
-            jsonEntry["index"] = index;
             serializeJson(jsonEntry, _buffer, _bufferSize);
             _nukiPublisher->publishString(basePath.c_str(), _buffer, true);
 
@@ -1020,12 +1036,14 @@ void NukiNetworkOpener::publishKeypad(const std::list<NukiLock::KeypadEntry>& en
         ++index;
     }
 
-    serializeJson(json, _buffer, _bufferSize);
-    _nukiPublisher->publishString(mqtt_topic_keypad_json, _buffer, true);
+    _nukiPublisher->publishJson(mqtt_topic_keypad_json, std::move(json), true);
+
+    // positions no longer used since the last publish, all unused ones on a full publish
+    const uint unusedUntil = diff.full ? maxKeypadCodeCount : diff.previousSize;
 
     if(!_disableNonJSON)
     {
-        while(index < maxKeypadCodeCount)
+        while(index < unusedUntil)
         {
             NukiLock::KeypadEntry entry;
             memset(&entry, 0, sizeof(entry));
@@ -1037,7 +1055,7 @@ void NukiNetworkOpener::publishKeypad(const std::list<NukiLock::KeypadEntry>& en
             ++index;
         }
 
-        if(!publishCode)
+        if(!publishCode && diff.full)
         {
             for(int i=0; i<maxKeypadCodeCount; i++)
             {
@@ -1076,7 +1094,7 @@ void NukiNetworkOpener::publishKeypad(const std::list<NukiLock::KeypadEntry>& en
             }
         }
 
-        for(int j=entries.size(); j<maxKeypadCodeCount; j++)
+        for(int j=entries.size(); j<unusedUntil; j++)
         {
             String codesTopic = _mqttPath;
             codesTopic.concat(mqtt_topic_keypad_codes);
@@ -1206,8 +1224,7 @@ void NukiNetworkOpener::publishTimeControl(const std::list<NukiOpener::TimeContr
         ++index;
     }
 
-    serializeJson(json, _buffer, _bufferSize);
-    _nukiPublisher->publishString(mqtt_topic_timecontrol_json, _buffer, true);
+    _nukiPublisher->publishJson(mqtt_topic_timecontrol_json, std::move(json), true);
 
     for(int j=timeControlEntries.size(); j<maxTimeControlEntryCount; j++)
     {
@@ -1357,8 +1374,7 @@ void NukiNetworkOpener::publishAuth(const std::list<NukiOpener::AuthorizationEnt
         ++index;
     }
 
-    serializeJson(json, _buffer, _bufferSize);
-    _nukiPublisher->publishString(mqtt_topic_auth_json, _buffer, true);
+    _nukiPublisher->publishJson(mqtt_topic_auth_json, std::move(json), true);
 
     for(int j=authEntries.size(); j<maxAuthEntryCount; j++)
     {
@@ -1405,6 +1421,12 @@ void NukiNetworkOpener::publishStatusUpdated(const bool statusUpdated)
     _nukiPublisher->publishBool(mqtt_topic_lock_status_updated, statusUpdated, true);
 }
 
+void NukiNetworkOpener::publishLockstateQueries(const uint32_t performed, const uint32_t avoided)
+{
+    _nukiPublisher->publishUInt(mqtt_topic_query_lockstate_performed, performed, true);
+    _nukiPublisher->publishUInt(mqtt_topic_query_lockstate_avoided, avoided, true);
+}
+
 void NukiNetworkOpener::setLockActionReceivedCallback(LockActionResult (*lockActionReceivedCallback)(const char *))
 {
     _lockActionReceivedCallback = lockActionReceivedCallback;
@@ -1497,14 +1519,6 @@ void NukiNetworkOpener::subscribe(const char *path)
     _network->subscribe(prefixedPath, MQTT_QOS_LEVEL);
 }
 
-bool NukiNetworkOpener::comparePrefixedPath(const char *fullPath, const char *subPath)
-{
-    char prefixedPath[500];
-    buildMqttPath(subPath, prefixedPath);
-
-    return strcmp(fullPath, prefixedPath) == 0;
-}
-
 String NukiNetworkOpener::concat(String a, String b)
 {
     String c = a;
@@ -1524,6 +1538,21 @@ uint8_t NukiNetworkOpener::queryCommands()
     return qc;
 }
 
+const uint32_t NukiNetworkOpener::getLastRollingLog() const
+{
+    return _lastRollingLog;
+}
+
+void NukiNetworkOpener::setLastRollingLog(const uint32_t index)
+{
+    // the cursor is kept across reboots, only written when it changes
+    if(index != _lastRollingLog)
+    {
+        _lastRollingLog = index;
+        _preferences->putUInt(preference_opener_auth_log_cursor, _lastRollingLog);
+    }
+}
+
 void NukiNetworkOpener::setupHASS(int type, uint32_t nukiId, char* nukiName, const char* firmwareVersion, const char* hardwareVersion, bool hasDoorSensor, bool hasKeypad)
 {
     _network->setupHASS(type, nukiId, nukiName, firmwareVersion, hardwareVersion, hasDoorSensor, hasKeypad);
@@ -7,8 +7,9 @@
 #include "NukiOpenerConstants.h"
 #include "NukiNetworkLock.h"
 #include "EspMillis.h"
+#include "EntrySnapshot.h"
 
-class NukiNetworkOpener : public MqttReceiver
+class NukiNetworkOpener
 {
 public:
     explicit NukiNetworkOpener(NukiNetwork* network, Preferences* preferences, char* buffer, size_t bufferSize);
@@ -21,8 +22,10 @@ public:
     void publishRing(const bool locked);
     void publishState(NukiOpener::OpenerState lockState);
     void publishAuthorizationInfo(const std::list<NukiOpener::LogEntry>& logEntries, bool latest);
+    void publishRollingLog(const std::list<NukiOpener::LogEntry>& logEntries);
     void clearAuthorizationInfo();
     void publishCommandResult(const char* resultStr);
+    void publishCommandResultJson(uint32_t commandId, const NukiOpener::LockAction action, const char* resultStr, int retryCount);
     void publishLockstateCommandResult(const char* resultStr);
     void publishBatteryReport(const NukiOpener::BatteryReport& batteryReport);
     void publishConfig(const NukiOpener::Config& config);
@@ -34,6 +37,7 @@ public:
     void publishTimeControl(const std::list<NukiOpener::TimeControlEntry>& timeControlEntries, uint maxTimeControlEntryCount);
     void publishAuth(const std::list<NukiLock::AuthorizationEntry>& authEntries, uint maxAuthEntryCount);
     void publishStatusUpdated(const bool statusUpdated);
+    void publishLockstateQueries(const uint32_t performed, const uint32_t avoided);
     void publishConfigCommandResult(const char* result);
     void publishKeypadCommandResult(const char* result);
     void publishKeypadJsonCommandResult(const char* result);
@@ -46,17 +50,23 @@ public:
     void setKeypadJsonCommandReceivedCallback(void (*keypadJsonCommandReceivedReceivedCallback)(const char* value));
     void setTimeControlCommandReceivedCallback(void (*timeControlCommandReceivedReceivedCallback)(const char* value));
     void setAuthCommandReceivedCallback(void (*authCommandReceivedReceivedCallback)(const char* value));
-    void onMqttDataReceived(const char* topic, byte* payload, const unsigned int length) override;
     void setupHASS(int type, uint32_t nukiId, char* nukiName, const char* firmwareVersion, const char* hardwareVersion, bool hasDoorSensor, bool hasKeypad);
 
     int mqttConnectionState();
     uint8_t queryCommands();
+    const uint32_t getLastRollingLog() const;
+    void setLastRollingLog(const uint32_t index);
     char _nukiName[33];
 
 private:
-    bool comparePrefixedPath(const char* fullPath, const char* subPath);
+    void onLockActionReceived(const char* data);
+    void onRollingLogReceived(const char* data);
+    void onKeypadCommandActionReceived(const char* data);
+    void onQueryReceived(const char* topic, const char* data, const uint8_t queryCommand);
+    void onJsonActionReceived(const char* topic, const char* data, void (*callback)(const char* value));
 
     void publishKeypadEntry(const String topic, NukiLock::KeypadEntry entry);
+    void authLogEntryToJson(const NukiOpener::LogEntry& log, JsonObject entry);
 
     void buildMqttPath(const char* path, char* outPath);
     void subscribe(const char* path);
@@ -75,6 +85,7 @@ private:
     NukiPublisher* _nukiPublisher = nullptr;
 
     std::map<uint32_t, String> _authEntries;
+    EntrySnapshot<NukiLock::KeypadEntry> _keypadSnapshot;
     char _mqttPath[181] = {0};
     bool _firstTunerStatePublish = true;
     bool _haEnabled = false;
@@ -23,9 +23,6 @@ public:
     const bool hasAuthId() const;
     void clearAuthId();
 
-    void buildMqttPath(const char* path, char* outPath);
-    bool comparePrefixedPath(const char *fullPath, const char *subPath);
-
     void onOfficialUpdateReceived(const char* topic, const char* value);
 
     const bool getOffConnected() const;
@@ -10,18 +10,21 @@
 #include "hal/wdt_hal.h"
 #include <time.h>
 #include "esp_sntp.h"
+#include "NukiTaskWakeup.h"
 
 NukiOpenerWrapper* nukiOpenerInst;
 Preferences* nukiOpenerPreferences = nullptr;
 
-NukiOpenerWrapper::NukiOpenerWrapper(const std::string& deviceName, NukiDeviceId* deviceId, BleScanner::Scanner* scanner, NukiNetworkOpener* network, Gpio* gpio, Preferences* preferences, char* buffer, size_t bufferSize)
+NukiOpenerWrapper::NukiOpenerWrapper(const std::string& deviceName, NukiDeviceId* deviceId, BleScanner::Scanner* scanner, NukiNetworkOpener* network, Gpio* gpio, JobScheduler* scheduler, Preferences* preferences, char* buffer, size_t bufferSize)
     : _deviceName(deviceName),
       _deviceId(deviceId),
       _nukiOpener(deviceName, _deviceId->get()),
       _bleScanner(scanner),
       _network(network),
       _gpio(gpio),
+      _scheduler(scheduler),
       _preferences(preferences),
+      _beaconTracker(NUKI_BEACON_SAFETY_TIMEOUT, NUKI_BEACON_TIMEOUT, NUKI_BEACON_SETTLE_TIME),
       _buffer(buffer),
       _bufferSize(bufferSize)
 {
@@ -43,7 +46,92 @@ NukiOpenerWrapper::NukiOpenerWrapper(const std::string& deviceName, NukiDeviceId
     network->setTimeControlCommandReceivedCallback(nukiOpenerInst->onTimeControlCommandReceivedCallback);
     network->setAuthCommandReceivedCallback(nukiOpenerInst->onAuthCommandReceivedCallback);
 
+    _gpioActionQueue = xQueueCreate(NUKI_GPIO_ACTION_QUEUE_LENGTH, sizeof(GpioAction));
     _gpio->addCallback(NukiOpenerWrapper::gpioActionCallback);
+
+    _lockActionExecutor.onSuperseded([this](const LockActionExecutor<NukiOpener::LockAction>::Command& command)
+    {
+        _network->publishCommandResultJson(command.id, command.action, "superseded", command.retryCount);
+    });
+
+    // lower value runs first: the opener state, then battery and config, informational queries last
+    addJob(JobLockState, "opener state", 0, [this](int64_t ts)
+    {
+        scheduleJob(JobLockState, ts + _intervalLockstate * 1000, true);
+        if(!_lockStateRequested && _keyTurnerState.lockState != NukiOpener::LockState::Undefined && _beaconTracker.skipPeriodicQuery(ts))
+        {
+            Log->println("Opener state unchanged according to beacon, skipping query");
+            _network->publishLockstateQueries(_beaconTracker.performed(), _beaconTracker.avoided());
+            return;
+        }
+        _lockStateRequested = false;
+        _statusUpdated = updateKeyTurnerState();
+        _network->publishLockstateQueries(_beaconTracker.performed(), _beaconTracker.avoided());
+        _network->publishStatusUpdated(_statusUpdated);
+        memcpy(&_lastKeyTurnerState, &_keyTurnerState, sizeof(NukiOpener::OpenerState));
+    });
+    addJob(JobBattery, "opener battery", 1, [this](int64_t ts)
+    {
+        scheduleJob(JobBattery, ts + _intervalBattery * 1000, true);
+        updateBatteryState();
+    });
+    addJob(JobConfig, "opener config", 1, [this](int64_t ts)
+    {
+        scheduleJob(JobConfig, ts + _intervalConfig * 1000, true);
+        updateConfig();
+    });
+    addJob(JobAuthLogRetrieved, "opener auth log", 2, [this](int64_t ts)
+    {
+        updateAuthData(true);
+    });
+    addJob(JobKeypadRetrieved, "opener keypad codes", 2, [this](int64_t ts)
+    {
+        updateKeypad(true);
+    });
+    addJob(JobTimeControlRetrieved, "opener time control", 2, [this](int64_t ts)
+    {
+        updateTimeControl(true);
+    });
+    addJob(JobAuthRetrieved, "opener authorizations", 2, [this](int64_t ts)
+    {
+        updateAuth(true);
+    });
+    addJob(JobKeypad, "opener keypad", 2, [this](int64_t ts)
+    {
+        if(!hasKeypad() || !_keypadEnabled)
+        {
+            scheduleJob(JobKeypad, ts + NUKI_JOB_DEFER_DELAY);
+            return;
+        }
+        scheduleJob(JobKeypad, ts + _intervalKeypad * 1000, true);
+        updateKeypad(false);
+    });
+    addJob(JobRssi, "opener rssi", 3, [this](int64_t ts)
+    {
+        if(_rssiPublishInterval <= 0)
+        {
+            scheduleJob(JobRssi, ts + NUKI_JOB_DEFER_DELAY);
+            return;
+        }
+        scheduleJob(JobRssi, ts + _rssiPublishInterval);
+
+        int rssi = _nukiOpener.getRssi();
+        if(rssi != _lastRssi)
+        {
+            _network->publishRssi(rssi);
+            _lastRssi = rssi;
+        }
+    });
+    addJob(JobTime, "opener time", 3, [this](int64_t ts)
+    {
+        if(!_preferences->getBool(preference_update_time, false))
+        {
+            scheduleJob(JobTime, ts + NUKI_JOB_DEFER_DELAY);
+            return;
+        }
+        scheduleJob(JobTime, ts + (12 * 60 * 60 * 1000), true);
+        updateTime();
+    });
 }
 
 
@@ -170,6 +258,7 @@ void NukiOpenerWrapper::readSettings()
         _retryDelay = 100;
         _preferences->putInt(preference_command_retry_delay, _retryDelay);
     }
+    _lockActionExecutor.setRetries(_nrOfRetries, _retryDelay);
     if(_intervalLockstate == 0)
     {
         Log->println("Invalid intervalLockstate, revert to default (1800)");
@@ -261,127 +350,97 @@ void NukiOpenerWrapper::update()
 
     _nukiOpener.updateConnectionState();
 
-    if(_nextLockAction != (NukiOpener::LockAction)0xff)
+    GpioAction gpioAction;
+    while(xQueueReceive(_gpioActionQueue, &gpioAction, 0) == pdTRUE)
     {
-        int retryCount = 0;
-        Nuki::CmdResult cmdResult = (Nuki::CmdResult)-1;
-
-        while(retryCount < _nrOfRetries + 1 && cmdResult != Nuki::CmdResult::Success)
-        {
-            cmdResult = _nukiOpener.lockAction(_nextLockAction, 0, 0);
-            char resultStr[15] = {0};
-            NukiOpener::cmdResultToString(cmdResult, resultStr);
-
-            _network->publishCommandResult(resultStr);
+        onGpioActionReceived(gpioAction);
+    }
 
-            Log->print("Opener action result: ");
-            Log->println(resultStr);
+    LockActionExecutor<NukiOpener::LockAction>::Command command;
+    if(_lockActionExecutor.next(ts, command))
+    {
+        _bleScanner->boostScanning();
+        Nuki::CmdResult cmdResult = _nukiOpener.lockAction(command.action, 0, 0);
+        char resultStr[15] = {0};
+        NukiOpener::cmdResultToString(cmdResult, resultStr);
 
-            if(cmdResult != Nuki::CmdResult::Success)
-            {
-                Log->print("Opener: Last command failed, retrying after ");
-                Log->print(_retryDelay);
-                Log->print(" milliseconds. Retry ");
-                Log->print(retryCount + 1);
-                Log->print(" of ");
-                Log->println(_nrOfRetries);
+        _network->publishCommandResult(resultStr);
 
-                _network->publishRetry(std::to_string(retryCount + 1));
+        Log->print("Opener action result: ");
+        Log->println(resultStr);
+        postponeBleWatchdog();
 
-                delay(_retryDelay);
+        LockActionExecutor<NukiOpener::LockAction>::Step step = _lockActionExecutor.complete(cmdResult == Nuki::CmdResult::Success, espMillis(), command);
+        _network->publishCommandResultJson(command.id, command.action, resultStr, command.retryCount);
 
-                ++retryCount;
-            }
-            postponeBleWatchdog();
-        }
-
-        if(cmdResult == Nuki::CmdResult::Success)
+        switch(step)
         {
-            _nextLockAction = (NukiOpener::LockAction) 0xff;
+        case LockActionExecutor<NukiOpener::LockAction>::Step::Success:
             _network->publishRetry("--");
-            retryCount = 0;
             _statusUpdated = true;
             Log->println("Opener: updating status after action");
             _statusUpdatedTs = ts;
             if(_intervalLockstate > 10)
             {
-                _nextLockStateUpdateTs = ts + 10 * 1000;
+                scheduleJob(JobLockState, ts + 10 * 1000);
             }
-        }
-        else
-        {
+            break;
+        case LockActionExecutor<NukiOpener::LockAction>::Step::Retry:
+            Log->print("Opener: Last command failed, retrying after ");
+            Log->print(_retryDelay);
+            Log->print(" milliseconds. Retry ");
+            Log->print(command.retryCount);
+            Log->print(" of ");
+            Log->println(_nrOfRetries);
+            _network->publishRetry(std::to_string(command.retryCount));
+            break;
+        case LockActionExecutor<NukiOpener::LockAction>::Step::Failed:
             Log->println("Opener: Maximum number of retries exceeded, aborting.");
             _network->publishRetry("failed");
-            retryCount = 0;
-            _nextLockAction = (NukiOpener::LockAction) 0xff;
+            break;
+        case LockActionExecutor<NukiOpener::LockAction>::Step::Superseded:
+            Log->println("Opener: Last command failed and was superseded by a new action.");
+            _network->publishRetry("--");
+            break;
+        default:
+            break;
         }
     }
-    if(_statusUpdated || _nextLockStateUpdateTs == 0 || ts >= _nextLockStateUpdateTs || (queryCommands & QUERY_COMMAND_LOCKSTATE) > 0)
+    if(!_jobsArmed)
     {
-        _statusUpdated = updateKeyTurnerState();
-        _nextLockStateUpdateTs = ts + _intervalLockstate * 1000;
-        _network->publishStatusUpdated(_statusUpdated);
+        // once paired, only the advertisements of the device are dispatched
+        BLEAddress address = _nukiOpener.getBleAddress();
+        _bleScanner->clearFilters(&_nukiOpener);
+        _bleScanner->addAddressFilter(&_nukiOpener, address);
+        _beaconTracker.setAddress(address);
+        _bleScanner->clearFilters(&_beaconTracker);
+        _bleScanner->addAddressFilter(&_beaconTracker, address);
+        _bleScanner->subscribe(&_beaconTracker);
+        armJobs(ts);
+    }
+    if(_statusUpdated || (queryCommands & QUERY_COMMAND_LOCKSTATE) > 0)
+    {
+        _lockStateRequested = true;
+        scheduleJob(JobLockState, ts);
+    }
+    if((queryCommands & QUERY_COMMAND_BATTERY) > 0)
+    {
+        scheduleJob(JobBattery, ts);
+    }
+    if((queryCommands & QUERY_COMMAND_CONFIG) > 0)
+    {
+        scheduleJob(JobConfig, ts);
+    }
+    if((queryCommands & QUERY_COMMAND_KEYPAD) > 0)
+    {
+        scheduleJob(JobKeypad, ts);
     }
     if(_network->mqttConnectionState() == 2)
     {
-        if(!_statusUpdated)
+        if(!_statusUpdated && _hassEnabled && _nukiConfigValid && _nukiAdvancedConfigValid && !_hassSetupCompleted)
         {
-            if(_nextBatteryReportTs == 0 || ts > _nextBatteryReportTs || (queryCommands & QUERY_COMMAND_BATTERY) > 0)
-            {
-                _nextBatteryReportTs = ts + _intervalBattery * 1000;
-                updateBatteryState();
-            }
-            if(_nextConfigUpdateTs == 0 || ts > _nextConfigUpdateTs || (queryCommands & QUERY_COMMAND_CONFIG) > 0)
-            {
-                _nextConfigUpdateTs = ts + _intervalConfig * 1000;
-                updateConfig();
-            }
-            if(_waitAuthLogUpdateTs != 0 && ts > _waitAuthLogUpdateTs)
-            {
-                _waitAuthLogUpdateTs = 0;
-                updateAuthData(true);
-            }
-            if(_waitKeypadUpdateTs != 0 && ts > _waitKeypadUpdateTs)
-            {
-                _waitKeypadUpdateTs = 0;
-                updateKeypad(true);
-            }
-            if(_preferences->getBool(preference_update_time, false) && ts > (120 * 1000) && ts > _nextTimeUpdateTs)
-            {
-                _nextTimeUpdateTs = ts + (12 * 60 * 60 * 1000);
-                updateTime();
-            }
-            if(_waitTimeControlUpdateTs != 0 && ts > _waitTimeControlUpdateTs)
-            {
-                _waitTimeControlUpdateTs = 0;
-                updateTimeControl(true);
-            }
-            if(_waitAuthUpdateTs != 0 && ts > _waitAuthUpdateTs)
-            {
-                _waitAuthUpdateTs = 0;
-                updateAuth(true);
-            }
-            if(_hassEnabled && _nukiConfigValid && _nukiAdvancedConfigValid && !_hassSetupCompleted)
-            {
-                _network->setupHASS(2, _nukiConfig.nukiId, (char*)_nukiConfig.name, _firmwareVersion.c_str(), _hardwareVersion.c_str(), false, hasKeypad());
-                _hassSetupCompleted = true;
-            }
-            if(_rssiPublishInterval > 0 && (_nextRssiTs == 0 || ts > _nextRssiTs))
-            {
-                _nextRssiTs = ts + _rssiPublishInterval;
-
-                int rssi = _nukiOpener.getRssi();
-                if(rssi != _lastRssi)
-                {
-                    _network->publishRssi(rssi);
-                    _lastRssi = rssi;
-                }
-            }
-            if(hasKeypad() && _keypadEnabled && (_nextKeypadUpdateTs == 0 || ts > _nextKeypadUpdateTs || (queryCommands & QUERY_COMMAND_KEYPAD) > 0))
-            {
-                _nextKeypadUpdateTs = ts + _intervalKeypad * 1000;
-                updateKeypad(false);
-            }
+            _network->setupHASS(2, _nukiConfig.nukiId, (char*)_nukiConfig.name, _firmwareVersion.c_str(), _hardwareVersion.c_str(), false, hasKeypad());
+            _hassSetupCompleted = true;
         }
 
         if(_clearAuthData)
@@ -394,46 +453,109 @@ void NukiOpenerWrapper::update()
             _invalidCount--;
         }
     }
+}
+
 
-    memcpy(&_lastKeyTurnerState, &_keyTurnerState, sizeof(NukiOpener::OpenerState));
+int64_t NukiOpenerWrapper::nextWakeupTs()
+{
+    // periodic queries are covered by the scheduler's next deadline
+    if(!_paired || _statusUpdated)
+    {
+        return 0;
+    }
+    return _lockActionExecutor.nextAttemptTs();
 }
 
+void NukiOpenerWrapper::addJob(NukiJob job, const char* name, uint8_t priority, std::function<void(int64_t)> run)
+{
+    _jobs[job] = _scheduler->add(name, NUKI_JOB_OWNER_OPENER, priority, [this, job, run](int64_t ts)
+    {
+        if(!_paired)
+        {
+            // armed again after pairing
+            return;
+        }
+        // everything but the opener state waits for MQTT and a settled opener state
+        if(job != JobLockState && (_network->mqttConnectionState() != 2 || _statusUpdated))
+        {
+            scheduleJob(job, ts + NUKI_JOB_DEFER_DELAY);
+            return;
+        }
+        run(ts);
+    });
+}
+
+void NukiOpenerWrapper::armJobs(int64_t ts)
+{
+    scheduleJob(JobLockState, ts, true);
+    scheduleJob(JobBattery, ts, true);
+    scheduleJob(JobConfig, ts, true);
+    scheduleJob(JobKeypad, ts, true);
+    scheduleJob(JobRssi, ts);
+    scheduleJob(JobTime, std::max(ts, (int64_t)120 * 1000), true);
+    _jobsArmed = true;
+}
+
+void NukiOpenerWrapper::scheduleJob(NukiJob job, int64_t ts, bool spread)
+{
+    _scheduler->schedule(_jobs[job], ts, spread);
+}
+
+bool NukiOpenerWrapper::queueLockAction(NukiOpener::LockAction action)
+{
+    uint32_t commandId = _lockActionExecutor.submit(action);
+    if(commandId == 0)
+    {
+        Log->println("Opener: Action queue full, action rejected");
+        return false;
+    }
+    _network->publishCommandResultJson(commandId, action, "queued", 0);
+    NukiTaskWakeup::notify(NukiTaskWakeupReason::Command);
+    return true;
+}
+
+bool NukiOpenerWrapper::coalescableLockAction(NukiOpener::LockAction action)
+{
+    // only the resulting mode matters, electric strike and fob actions always run
+    return action == NukiOpener::LockAction::ActivateRTO || action == NukiOpener::LockAction::DeactivateRTO ||
+           action == NukiOpener::LockAction::ActivateCM || action == NukiOpener::LockAction::DeactivateCM;
+}
 
 void NukiOpenerWrapper::electricStrikeActuation()
 {
-    _nextLockAction = NukiOpener::LockAction::ElectricStrikeActuation;
+    queueLockAction(NukiOpener::LockAction::ElectricStrikeActuation);
 }
 
 void NukiOpenerWrapper::activateRTO()
 {
-    _nextLockAction = NukiOpener::LockAction::ActivateRTO;
+    queueLockAction(NukiOpener::LockAction::ActivateRTO);
 }
 
 void NukiOpenerWrapper::activateCM()
 {
-    _nextLockAction = NukiOpener::LockAction::ActivateCM;
+    queueLockAction(NukiOpener::LockAction::ActivateCM);
 }
 
 void NukiOpenerWrapper::deactivateRtoCm()
 {
     if(_keyTurnerState.nukiState == NukiOpener::State::ContinuousMode)
     {
-        _nextLockAction = NukiOpener::LockAction::DeactivateCM;
+        queueLockAction(NukiOpener::LockAction::DeactivateCM);
     }
     else if(_keyTurnerState.lockState == NukiOpener::LockState::RTOactive)
     {
-        _nextLockAction = NukiOpener::LockAction::DeactivateRTO;
+        queueLockAction(NukiOpener::LockAction::DeactivateRTO);
     }
 }
 
 void NukiOpenerWrapper::deactivateRTO()
 {
-    _nextLockAction = NukiOpener::LockAction::DeactivateRTO;
+    queueLockAction(NukiOpener::LockAction::DeactivateRTO);
 }
 
 void NukiOpenerWrapper::deactivateCM()
 {
-    _nextLockAction = NukiOpener::LockAction::DeactivateCM;
+    queueLockAction(NukiOpener::LockAction::DeactivateCM);
 }
 
 bool NukiOpenerWrapper::isPinValid()
@@ -464,6 +586,8 @@ void NukiOpenerWrapper::unpair()
         _preferences->remove(preference_nuki_id_opener);
     }
     _paired = false;
+    _jobsArmed = false;
+    _bleScanner->clearFilters(&_nukiOpener);
 }
 
 bool NukiOpenerWrapper::updateKeyTurnerState()
@@ -486,6 +610,8 @@ bool NukiOpenerWrapper::updateKeyTurnerState()
     NukiOpener::cmdResultToString(result, resultStr);
     _network->publishLockstateCommandResult(resultStr);
 
+    _beaconTracker.queried(result == Nuki::CmdResult::Success, espMillis());
+
     if(result != Nuki::CmdResult::Success)
     {
         Log->println("Query opener state failed");
@@ -496,7 +622,7 @@ bool NukiOpenerWrapper::updateKeyTurnerState()
             Log->print("Query opener state retrying in ");
             Log->print(_retryDelay);
             Log->println("ms");
-            _nextLockStateUpdateTs = espMillis() + _retryDelay;
+            scheduleJob(JobLockState, espMillis() + _retryDelay);
         }
         _network->publishKeyTurnerState(_keyTurnerState, _lastKeyTurnerState);
         return false;
@@ -539,10 +665,7 @@ bool NukiOpenerWrapper::updateKeyTurnerState()
 
         if(_keyTurnerState.lockState == NukiOpener::LockState::Undefined)
         {
-            if (_nextLockStateUpdateTs > espMillis() + 60000)
-            {
-                _nextLockStateUpdateTs = espMillis() + 60000;
-            }
+            _scheduler->scheduleEarlier(_jobs[JobLockState], espMillis() + 60000);
         }
 
         updateGpioOutputs();
@@ -712,8 +835,7 @@ void NukiOpenerWrapper::updateConfig()
     {
         ++_retryConfigCount;
         Log->println("Invalid/Unexpected opener config and/or advanced config received, retrying in 10 seconds");
-        int64_t ts = espMillis();
-        _nextConfigUpdateTs = ts + 10000;
+        scheduleJob(JobConfig, espMillis() + 10000);
     }
 }
 
@@ -727,13 +849,23 @@ void NukiOpenerWrapper::updateAuthData(bool retrieved)
 
     if(!retrieved)
     {
+        // only the entries after the last published index are read, the index is kept across reboots
+        const uint32_t cursor = _authLogResync ? 0 : _network->getLastRollingLog();
+        const int maxEntries = _preferences->getInt(preference_authlog_max_entries, MAX_AUTHLOG);
         Nuki::CmdResult result = (Nuki::CmdResult)-1;
         int retryCount = 0;
 
         while(retryCount < _nrOfRetries + 1)
         {
             Log->print("Retrieve log entries: ");
-            result = _nukiOpener.retrieveLogEntries(0, _preferences->getInt(preference_authlog_max_entries, MAX_AUTHLOG), 1, false);
+            if(cursor > 0)
+            {
+                result = _nukiOpener.retrieveLogEntries(cursor + 1, maxEntries, 0, false);
+            }
+            else
+            {
+                result = _nukiOpener.retrieveLogEntries(0, maxEntries, 1, false);
+            }
 
             if(result != Nuki::CmdResult::Success)
             {
@@ -749,53 +881,90 @@ void NukiOpenerWrapper::updateAuthData(bool retrieved)
         printCommandResult(result);
         if(result == Nuki::CmdResult::Success)
         {
-            _waitAuthLogUpdateTs = espMillis() + 5000;
+            scheduleJob(JobAuthLogRetrieved, espMillis() + 5000);
             delay(100);
 
             std::list<NukiOpener::LogEntry> log;
             _nukiOpener.getLogEntries(&log);
 
-            if(log.size() > _preferences->getInt(preference_authlog_max_entries, 3))
+            if(_authLogResync && !log.empty())
             {
-                log.resize(_preferences->getInt(preference_authlog_max_entries, 3));
+                // the latest entry on the device is older than the cursor: the log was reset, continue from there
+                uint32_t latest = 0;
+                for(const auto& entry : log)
+                {
+                    if(entry.index > latest)
+                    {
+                        latest = entry.index;
+                    }
+                }
+                if(latest < _network->getLastRollingLog())
+                {
+                    _network->setLastRollingLog(latest);
+                }
             }
 
-            log.sort([](const NukiOpener::LogEntry& a, const NukiOpener::LogEntry& b)
-            {
-                return a.index < b.index;
-            });
-
-            if(log.size() > 0)
+            const bool added = updateAuthLog(log);
+            if(added)
             {
-                _network->publishAuthorizationInfo(log, true);
+                _network->publishAuthorizationInfo(_authLog, true);
             }
+            // nothing after the cursor (e.g. the log was reset on the device): read the latest entries once
+            _authLogResync = cursor > 0 && !added;
         }
     }
     else
     {
         std::list<NukiOpener::LogEntry> log;
         _nukiOpener.getLogEntries(&log);
+        updateAuthLog(log);
 
-        if(log.size() > _preferences->getInt(preference_authlog_max_entries, MAX_AUTHLOG))
+        Log->print("Log size: ");
+        Log->println(_authLog.size());
+
+        // the full log is only serialized when entries were added since it was last published
+        if(_authLogChanged && _authLog.size() > 0)
         {
-            log.resize(_preferences->getInt(preference_authlog_max_entries, MAX_AUTHLOG));
+            _network->publishAuthorizationInfo(_authLog, false);
+            _authLogChanged = false;
         }
+    }
 
-        log.sort([](const NukiOpener::LogEntry& a, const NukiOpener::LogEntry& b)
-        {
-            return a.index < b.index;
-        });
+    postponeBleWatchdog();
+}
 
-        Log->print("Log size: ");
-        Log->println(log.size());
+bool NukiOpenerWrapper::updateAuthLog(std::list<NukiOpener::LogEntry>& log)
+{
+    log.sort([](const NukiOpener::LogEntry& a, const NukiOpener::LogEntry& b)
+    {
+        return a.index < b.index;
+    });
+
+    _network->publishRollingLog(log);
 
-        if(log.size() > 0)
+    bool added = false;
+    for(const auto& entry : log)
+    {
+        auto it = _authLog.begin();
+        while(it != _authLog.end() && it->index < entry.index)
+        {
+            ++it;
+        }
+        if(it != _authLog.end() && it->index == entry.index)
         {
-            _network->publishAuthorizationInfo(log, false);
+            continue;
         }
+        _authLog.insert(it, entry);
+        added = true;
     }
 
-    postponeBleWatchdog();
+    while(_authLog.size() > _preferences->getInt(preference_authlog_max_entries, MAX_AUTHLOG))
+    {
+        _authLog.pop_front();
+    }
+
+    _authLogChanged = _authLogChanged || added;
+    return added;
 }
 
 void NukiOpenerWrapper::updateKeypad(bool retrieved)
@@ -834,7 +1003,7 @@ void NukiOpenerWrapper::updateKeypad(bool retrieved)
         printCommandResult(result);
         if(result == Nuki::CmdResult::Success)
         {
-            _waitKeypadUpdateTs = espMillis() + 5000;
+            scheduleJob(JobKeypadRetrieved, espMillis() + 5000);
         }
     }
     else
@@ -914,7 +1083,7 @@ void NukiOpenerWrapper::updateTimeControl(bool retrieved)
         printCommandResult(result);
         if(result == Nuki::CmdResult::Success)
         {
-            _waitTimeControlUpdateTs = espMillis() + 5000;
+            scheduleJob(JobTimeControlRetrieved, espMillis() + 5000);
         }
     }
     else
@@ -991,7 +1160,7 @@ void NukiOpenerWrapper::updateAuth(bool retrieved)
         printCommandResult(result);
         if(result == Nuki::CmdResult::Success)
         {
-            _waitAuthUpdateTs = millis() + 5000;
+            scheduleJob(JobAuthRetrieved, espMillis() + 5000);
         }
     }
     else
@@ -1106,8 +1275,7 @@ LockActionResult NukiOpenerWrapper::onLockActionReceivedCallback(const char *val
     if((action == NukiOpener::LockAction::ActivateRTO && (int)aclPrefs[9] == 1) || (action == NukiOpener::LockAction::DeactivateRTO && (int)aclPrefs[10] == 1) || (action == NukiOpener::LockAction::ElectricStrikeActuation && (int)aclPrefs[11] == 1) || (action == NukiOpener::LockAction::ActivateCM && (int)aclPrefs[12] == 1) || (action == NukiOpener::LockAction::DeactivateCM && (int)aclPrefs[13] == 1) || (action == NukiOpener::LockAction::FobAction1 && (int)aclPrefs[14] == 1) || (action == NukiOpener::LockAction::FobAction2 && (int)aclPrefs[15] == 1) || (action == NukiOpener::LockAction::FobAction3 && (int)aclPrefs[16] == 1))
     {
         nukiOpenerPreferences->end();
-        nukiOpenerInst->_nextLockAction = action;
-        return LockActionResult::Success;
+        return nukiOpenerInst->queueLockAction(action) ? LockActionResult::Success : LockActionResult::Failed;
     }
 
     nukiOpenerPreferences->end();
@@ -2420,7 +2588,7 @@ void NukiOpenerWrapper::onConfigUpdateReceived(const char *value)
         jsonResult["general"] = "noChange";
     }
 
-    _nextConfigUpdateTs = espMillis() + 300;
+    scheduleJob(JobConfig, espMillis() + 300);
 
     serializeJson(jsonResult, _buffer, _bufferSize);
     _network->publishConfigCommandResult(_buffer);
@@ -2449,26 +2617,35 @@ void NukiOpenerWrapper::onAuthCommandReceivedCallback(const char *value)
 }
 
 void NukiOpenerWrapper::gpioActionCallback(const GpioAction &action, const int& pin)
+{
+    // Called from the GPIO timer interrupt, the action is handled by the nuki task
+    if(xQueueSendFromISR(nukiOpenerInst->_gpioActionQueue, &action, nullptr) == pdTRUE)
+    {
+        NukiTaskWakeup::notify(NukiTaskWakeupReason::Command);
+    }
+}
+
+void NukiOpenerWrapper::onGpioActionReceived(const GpioAction &action)
 {
     switch(action)
     {
     case GpioAction::ElectricStrikeActuation:
-        nukiOpenerInst->electricStrikeActuation();
+        electricStrikeActuation();
         break;
     case GpioAction::ActivateRTO:
-        nukiOpenerInst->activateRTO();
+        activateRTO();
         break;
     case GpioAction::ActivateCM:
-        nukiOpenerInst->activateCM();
+        activateCM();
         break;
     case GpioAction::DeactivateRtoCm:
-        nukiOpenerInst->deactivateRtoCm();
+        deactivateRtoCm();
         break;
     case GpioAction::DeactivateRTO:
-        nukiOpenerInst->deactivateRTO();
+        deactivateRTO();
         break;
     case GpioAction::DeactivateCM:
-        nukiOpenerInst->deactivateCM();
+        deactivateCM();
         break;
     }
 }
@@ -3471,7 +3648,7 @@ void NukiOpenerWrapper::onTimeControlCommandReceived(const char *value)
             _network->publishTimeControlCommandResult(resultStr);
         }
 
-        _nextConfigUpdateTs = espMillis() + 300;
+        scheduleJob(JobConfig, espMillis() + 300);
     }
     else
     {
@@ -4052,13 +4229,15 @@ void NukiOpenerWrapper::notify(Nuki::EventType eventType)
     }
     else if(eventType == Nuki::EventType::KeyTurnerStatusUpdated)
     {
-        if(!_statusUpdated && _newSignal < 5)
+        if(!_statusUpdated && _newSignal < 5 && !_beaconTracker.skipFlaggedQuery(espMillis()))
         {
             _newSignal++;
             Log->println("KeyTurnerStatusUpdated");
+            _bleScanner->boostScanning();
             _statusUpdated = true;
             _statusUpdatedTs = espMillis();
             _network->publishStatusUpdated(_statusUpdated);
+            NukiTaskWakeup::notify(NukiTaskWakeupReason::StatusChanged);
         }
     }
     else if(eventType == Nuki::EventType::ERROR_BAD_PIN)
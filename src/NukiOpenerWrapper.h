@@ -7,16 +7,20 @@
 #include "BleScanner.h"
 #include "Gpio.h"
 #include "NukiDeviceId.h"
+#include "LockActionExecutor.h"
+#include "JobScheduler.h"
+#include "NukiBeaconTracker.h"
 
 class NukiOpenerWrapper : public NukiOpener::SmartlockEventHandler
 {
 public:
-    NukiOpenerWrapper(const std::string& deviceName, NukiDeviceId* deviceId, BleScanner::Scanner* scanner, NukiNetworkOpener* network, Gpio* gpio, Preferences* preferences, char* buffer, size_t bufferSize);
+    NukiOpenerWrapper(const std::string& deviceName, NukiDeviceId* deviceId, BleScanner::Scanner* scanner, NukiNetworkOpener* network, Gpio* gpio, JobScheduler* scheduler, Preferences* preferences, char* buffer, size_t bufferSize);
     virtual ~NukiOpenerWrapper();
 
     void initialize();
     void readSettings();
     void update();
+    int64_t nextWakeupTs();
 
     void electricStrikeActuation();
     void activateRTO();
@@ -45,6 +49,21 @@ public:
     void notify(NukiOpener::EventType eventType) override;
 
 private:
+    enum NukiJob
+    {
+        JobLockState,
+        JobBattery,
+        JobConfig,
+        JobAuthLogRetrieved,
+        JobKeypadRetrieved,
+        JobTimeControlRetrieved,
+        JobAuthRetrieved,
+        JobKeypad,
+        JobRssi,
+        JobTime,
+        JobCount
+    };
+
     static LockActionResult onLockActionReceivedCallback(const char* value);
     static void onConfigUpdateReceivedCallback(const char* value);
     static void onKeypadCommandReceivedCallback(const char* command, const uint& id, const String& name, const String& code, const int& enabled);
@@ -52,7 +71,10 @@ private:
     static void onTimeControlCommandReceivedCallback(const char* value);
     static void onAuthCommandReceivedCallback(const char* value);
     static void gpioActionCallback(const GpioAction& action, const int& pin);
+    static bool coalescableLockAction(NukiOpener::LockAction action);
 
+    bool queueLockAction(NukiOpener::LockAction action);
+    void onGpioActionReceived(const GpioAction& action);
     void onKeypadCommandReceived(const char* command, const uint& id, const String& name, const String& code, const int& enabled);
     void onConfigUpdateReceived(const char* value);
     void onKeypadJsonCommandReceived(const char* value);
@@ -63,12 +85,17 @@ private:
     void updateBatteryState();
     void updateConfig();
     void updateAuthData(bool retrieved);
+    bool updateAuthLog(std::list<NukiOpener::LogEntry>& log);
     void updateKeypad(bool retrieved);
     void updateTimeControl(bool retrieved);
     void updateAuth(bool retrieved);
     void postponeBleWatchdog();
     void updateTime();
 
+    void addJob(NukiJob job, const char* name, uint8_t priority, std::function<void(int64_t)> run);
+    void armJobs(int64_t ts);
+    void scheduleJob(NukiJob job, int64_t ts, bool spread = false);
+
     void updateGpioOutputs();
 
     void readConfig();
@@ -92,6 +119,10 @@ private:
     BleScanner::Scanner* _bleScanner = nullptr;
     NukiNetworkOpener* _network = nullptr;
     Gpio* _gpio = nullptr;
+    JobScheduler* _scheduler = nullptr;
+    int _jobs[JobCount];
+    bool _jobsArmed = false;
+    bool _lockStateRequested = false;
     Preferences* _preferences = nullptr;
     int _intervalLockstate = 0; // seconds
     int _intervalBattery = 0; // seconds
@@ -99,6 +130,9 @@ private:
     int _intervalKeypad = 0; // seconds
     int _restartBeaconTimeout = 0; // seconds
     bool _publishAuthData = false;
+    std::list<NukiOpener::LogEntry> _authLog;
+    bool _authLogChanged = false;
+    bool _authLogResync = false;
     bool _clearAuthData = false;
     bool _disableNonJSON = false;
     bool _checkKeypadCodes = false;
@@ -140,24 +174,16 @@ private:
     uint _maxAuthEntryCount = 0;
     int _rssiPublishInterval = 0;
     int64_t _statusUpdatedTs = 0;
-    int64_t _nextLockStateUpdateTs = 0;
-    int64_t _nextBatteryReportTs = 0;
-    int64_t _nextConfigUpdateTs = 0;
-    int64_t _waitAuthLogUpdateTs = 0;
-    int64_t _waitKeypadUpdateTs = 0;
-    int64_t _waitTimeControlUpdateTs = 0;
-    int64_t _waitAuthUpdateTs = 0;
-    int64_t _nextTimeUpdateTs = 0;
-    int64_t _nextKeypadUpdateTs = 0;
     int64_t _nextPairTs = 0;
-    int64_t _nextRssiTs = 0;
     int64_t _lastRssi = 0;
     int64_t _disableBleWatchdogTs = 0;
     uint32_t _basicOpenerConfigAclPrefs[16];
     uint32_t _advancedOpenerConfigAclPrefs[21];
     std::string _firmwareVersion = "";
     std::string _hardwareVersion = "";
-    NukiOpener::LockAction _nextLockAction = (NukiOpener::LockAction)0xff;
+    LockActionExecutor<NukiOpener::LockAction> _lockActionExecutor{coalescableLockAction};
+    QueueHandle_t _gpioActionQueue = nullptr; // filled from the GPIO timer interrupt, drained in update()
+    NukiBeaconTracker _beaconTracker;
     
     char* _buffer;
     const size_t _bufferSize;
@@ -0,0 +1,100 @@
+#include "NukiTaskWakeup.h"
+#include "esp_timer.h"
+#include "EspMillis.h"
+
+void NukiTaskWakeup::initialize(TaskHandle_t task)
+{
+    _task = task;
+    _windowStartTs = espMillis();
+}
+
+void NukiTaskWakeup::notify(NukiTaskWakeupReason reason)
+{
+    if(_task == nullptr)
+    {
+        return;
+    }
+
+    if(reason == NukiTaskWakeupReason::Command)
+    {
+        // latency is measured from the oldest command that has not been picked up
+        int64_t expected = 0;
+        _commandTs.compare_exchange_strong(expected, espMillis());
+    }
+
+    // GPIO actions arrive from the timer interrupt
+    if(xPortInIsrContext())
+    {
+        BaseType_t higherPriorityTaskWoken = pdFALSE;
+        xTaskNotifyFromISR(_task, (uint32_t)reason, eSetBits, &higherPriorityTaskWoken);
+        portYIELD_FROM_ISR(higherPriorityTaskWoken);
+    }
+    else
+    {
+        xTaskNotify(_task, (uint32_t)reason, eSetBits);
+    }
+}
+
+uint32_t NukiTaskWakeup::wait(int64_t deadline)
+{
+    int64_t ts = espMillis();
+    uint32_t reasons = 0;
+
+    if(deadline > ts)
+    {
+        xTaskNotifyWait(0, UINT32_MAX, &reasons, pdMS_TO_TICKS(deadline - ts));
+        ts = espMillis();
+    }
+    else
+    {
+        // deadline already passed, only collect pending notifications
+        xTaskNotifyWait(0, UINT32_MAX, &reasons, 0);
+    }
+
+    if((reasons & (uint32_t)NukiTaskWakeupReason::Command) != 0)
+    {
+        int64_t commandTs = _commandTs.exchange(0);
+        if(commandTs > 0)
+        {
+            int64_t latency = ts - commandTs;
+            _lastPickupLatency = latency;
+            if(latency > _maxPickupLatency)
+            {
+                _maxPickupLatency = latency;
+            }
+        }
+    }
+
+    ++_wakeups;
+    if(ts - _windowStartTs >= 60000)
+    {
+        _wakeupsPerMinute = (uint32_t)((uint64_t)_wakeups * 60000 / (ts - _windowStartTs));
+        _wakeups = 0;
+        _windowStartTs = ts;
+    }
+
+    return reasons;
+}
+
+uint32_t NukiTaskWakeup::wakeupsPerMinute()
+{
+    return _wakeupsPerMinute;
+}
+
+int64_t NukiTaskWakeup::lastPickupLatency()
+{
+    return _lastPickupLatency;
+}
+
+int64_t NukiTaskWakeup::maxPickupLatency()
+{
+    return _maxPickupLatency;
+}
+
+TaskHandle_t NukiTaskWakeup::_task = nullptr;
+std::atomic<int64_t> NukiTaskWakeup::_commandTs {0};
+int64_t NukiTaskWakeup::_windowStartTs = 0;
+uint32_t NukiTaskWakeup::_wakeups = 0;
+std::atomic<uint32_t> NukiTaskWakeup::_wakeupsPerMinute {0};
+std::atomic<int64_t> NukiTaskWakeup::_lastPickupLatency {0};
+std::atomic<int64_t> NukiTaskWakeup::_maxPickupLatency {0};
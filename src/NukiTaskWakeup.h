@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+enum class NukiTaskWakeupReason : uint32_t
+{
+    Command = 1,        // lock action queued
+    StatusChanged = 2,  // beacon signalled a state change on the device
+    Query = 4,          // state, battery or config query requested
+    Scanner = 8         // advertisement queued or scan ended, the scanner needs an update
+};
+
+// Lets the nuki task sleep until there is work instead of polling
+class NukiTaskWakeup
+{
+public:
+    static void initialize(TaskHandle_t task);
+    static void notify(NukiTaskWakeupReason reason);
+
+    // Blocks until notified or until 'deadline' (espMillis), returns the reasons or 0 on timeout
+    static uint32_t wait(int64_t deadline);
+
+    static uint32_t wakeupsPerMinute();
+    static int64_t lastPickupLatency();
+    static int64_t maxPickupLatency();
+
+private:
+    static TaskHandle_t _task;
+    static std::atomic<int64_t> _commandTs;
+    static int64_t _windowStartTs;
+    static uint32_t _wakeups;
+    static std::atomic<uint32_t> _wakeupsPerMinute;
+    static std::atomic<int64_t> _lastPickupLatency;
+    static std::atomic<int64_t> _maxPickupLatency;
+};
@@ -9,10 +9,11 @@
 #include "hal/wdt_hal.h"
 #include <time.h>
 #include "esp_sntp.h"
+#include "NukiTaskWakeup.h"
 
 NukiWrapper* nukiInst = nullptr;
 
-NukiWrapper::NukiWrapper(const std::string& deviceName, NukiDeviceId* deviceId, BleScanner::Scanner* scanner, NukiNetworkLock* network, NukiOfficial* nukiOfficial, Gpio* gpio, Preferences* preferences, char* buffer, size_t bufferSize)
+NukiWrapper::NukiWrapper(const std::string& deviceName, NukiDeviceId* deviceId, BleScanner::Scanner* scanner, NukiNetworkLock* network, NukiOfficial* nukiOfficial, Gpio* gpio, JobScheduler* scheduler, Preferences* preferences, char* buffer, size_t bufferSize)
     : _deviceName(deviceName),
       _deviceId(deviceId),
       _bleScanner(scanner),
@@ -20,7 +21,9 @@ NukiWrapper::NukiWrapper(const std::string& deviceName, NukiDeviceId* deviceId,
       _network(network),
       _nukiOfficial(nukiOfficial),
       _gpio(gpio),
+      _scheduler(scheduler),
       _preferences(preferences),
+      _beaconTracker(NUKI_BEACON_SAFETY_TIMEOUT, NUKI_BEACON_TIMEOUT, NUKI_BEACON_SETTLE_TIME),
       _buffer(buffer),
       _bufferSize(bufferSize)
 {
@@ -44,7 +47,96 @@ NukiWrapper::NukiWrapper(const std::string& deviceName, NukiDeviceId* deviceId,
     network->setTimeControlCommandReceivedCallback(nukiInst->onTimeControlCommandReceivedCallback);
     network->setAuthCommandReceivedCallback(nukiInst->onAuthCommandReceivedCallback);
 
+    _gpioActionQueue = xQueueCreate(NUKI_GPIO_ACTION_QUEUE_LENGTH, sizeof(GpioAction));
     _gpio->addCallback(NukiWrapper::gpioActionCallback);
+
+    _lockActionExecutor.onSuperseded([this](const LockActionExecutor<NukiLock::LockAction>::Command& command)
+    {
+        _network->publishCommandResultJson(command.id, command.action, "superseded", command.retryCount);
+    });
+
+    // lower value runs first: the lock state, then battery and config, informational queries last
+    addJob(JobLockState, "lock state", 0, [this](int64_t ts)
+    {
+        scheduleJob(JobLockState, ts + _intervalLockstate * 1000, true);
+        if(!_lockStateRequested && _keyTurnerState.lockState != NukiLock::LockState::Undefined && _beaconTracker.skipPeriodicQuery(ts))
+        {
+            Log->println("Lock state unchanged according to beacon, skipping query");
+            _network->publishLockstateQueries(_beaconTracker.performed(), _beaconTracker.avoided());
+            return;
+        }
+        _lockStateRequested = false;
+        Log->println("Updating Lock state based on status, timer or query");
+        _statusUpdated = updateKeyTurnerState();
+        _network->publishLockstateQueries(_beaconTracker.performed(), _beaconTracker.avoided());
+        _network->publishStatusUpdated(_statusUpdated);
+        memcpy(&_lastKeyTurnerState, &_keyTurnerState, sizeof(NukiLock::KeyTurnerState));
+    });
+    addJob(JobBattery, "lock battery", 1, [this](int64_t ts)
+    {
+        Log->println("Updating Lock battery state based on timer or query");
+        scheduleJob(JobBattery, ts + _intervalBattery * 1000, true);
+        updateBatteryState();
+    });
+    addJob(JobConfig, "lock config", 1, [this](int64_t ts)
+    {
+        Log->println("Updating Lock config based on timer or query");
+        scheduleJob(JobConfig, ts + _intervalConfig * 1000, true);
+        updateConfig();
+    });
+    addJob(JobAuthLogRetrieved, "lock auth log", 2, [this](int64_t ts)
+    {
+        updateAuthData(true);
+    });
+    addJob(JobKeypadRetrieved, "lock keypad codes", 2, [this](int64_t ts)
+    {
+        updateKeypad(true);
+    });
+    addJob(JobTimeControlRetrieved, "lock time control", 2, [this](int64_t ts)
+    {
+        updateTimeControl(true);
+    });
+    addJob(JobAuthRetrieved, "lock authorizations", 2, [this](int64_t ts)
+    {
+        updateAuth(true);
+    });
+    addJob(JobKeypad, "lock keypad", 2, [this](int64_t ts)
+    {
+        if(!hasKeypad() || !_keypadEnabled)
+        {
+            scheduleJob(JobKeypad, ts + NUKI_JOB_DEFER_DELAY);
+            return;
+        }
+        Log->println("Updating Lock keypad based on timer or query");
+        scheduleJob(JobKeypad, ts + _intervalKeypad * 1000, true);
+        updateKeypad(false);
+    });
+    addJob(JobRssi, "lock rssi", 3, [this](int64_t ts)
+    {
+        if(_rssiPublishInterval <= 0)
+        {
+            scheduleJob(JobRssi, ts + NUKI_JOB_DEFER_DELAY);
+            return;
+        }
+        scheduleJob(JobRssi, ts + _rssiPublishInterval);
+
+        int rssi = _nukiLock.getRssi();
+        if(rssi != _lastRssi)
+        {
+            _network->publishRssi(rssi);
+            _lastRssi = rssi;
+        }
+    });
+    addJob(JobTime, "lock time", 3, [this](int64_t ts)
+    {
+        if(!_preferences->getBool(preference_update_time, false))
+        {
+            scheduleJob(JobTime, ts + NUKI_JOB_DEFER_DELAY);
+            return;
+        }
+        scheduleJob(JobTime, ts + (12 * 60 * 60 * 1000), true);
+        updateTime();
+    });
 }
 
 
@@ -178,6 +270,7 @@ void NukiWrapper::readSettings()
         _retryDelay = 100;
         _preferences->putInt(preference_command_retry_delay, _retryDelay);
     }
+    _lockActionExecutor.setRetries(_nrOfRetries, _retryDelay);
     if(_intervalLockstate == 0)
     {
         Log->println("Invalid intervalLockstate, revert to default (1800)");
@@ -276,49 +369,38 @@ void NukiWrapper::update(bool reboot)
 
     _nukiLock.updateConnectionState();
 
+    GpioAction gpioAction;
+    while(xQueueReceive(_gpioActionQueue, &gpioAction, 0) == pdTRUE)
+    {
+        onGpioActionReceived(gpioAction);
+    }
+
     if(_nukiOfficial->getOffCommandExecutedTs() > 0 && ts >= _nukiOfficial->getOffCommandExecutedTs())
     {
-        _nextLockAction = _offCommand;
+        queueLockAction(_offCommand);
         _nukiOfficial->clearOffCommandExecutedTs();
     }
-    if(_nextLockAction != (NukiLock::LockAction)0xff)
-    {
-        int retryCount = 0;
-        Nuki::CmdResult cmdResult;
 
-        while(retryCount < _nrOfRetries + 1 && cmdResult != Nuki::CmdResult::Success)
-        {
-            cmdResult = _nukiLock.lockAction(_nextLockAction, 0, 0);
-            char resultStr[15] = {0};
-            NukiLock::cmdResultToString(cmdResult, resultStr);
-            _network->publishCommandResult(resultStr);
-
-            Log->print("Lock action result: ");
-            Log->println(resultStr);
-
-            if(cmdResult != Nuki::CmdResult::Success)
-            {
-                Log->print("Lock: Last command failed, retrying after ");
-                Log->print(_retryDelay);
-                Log->print(" milliseconds. Retry ");
-                Log->print(retryCount + 1);
-                Log->print(" of ");
-                Log->println(_nrOfRetries);
+    LockActionExecutor<NukiLock::LockAction>::Command command;
+    if(_lockActionExecutor.next(ts, command))
+    {
+        _bleScanner->boostScanning();
+        Nuki::CmdResult cmdResult = _nukiLock.lockAction(command.action, 0, 0);
+        char resultStr[15] = {0};
+        NukiLock::cmdResultToString(cmdResult, resultStr);
+        _network->publishCommandResult(resultStr);
 
-                _network->publishRetry(std::to_string(retryCount + 1));
+        Log->print("Lock action result: ");
+        Log->println(resultStr);
+        postponeBleWatchdog();
 
-                delay(_retryDelay);
+        LockActionExecutor<NukiLock::LockAction>::Step step = _lockActionExecutor.complete(cmdResult == Nuki::CmdResult::Success, espMillis(), command);
+        _network->publishCommandResultJson(command.id, command.action, resultStr, command.retryCount);
 
-                ++retryCount;
-            }
-            postponeBleWatchdog();
-        }
-
-        if(cmdResult == Nuki::CmdResult::Success)
+        switch(step)
         {
-            _nextLockAction = (NukiLock::LockAction) 0xff;
+        case LockActionExecutor<NukiLock::LockAction>::Step::Success:
             _network->publishRetry("--");
-            retryCount = 0;
             if(!_nukiOfficial->getOffConnected())
             {
                 _statusUpdated = true;
@@ -327,87 +409,65 @@ void NukiWrapper::update(bool reboot)
             _statusUpdatedTs = ts;
             if(_intervalLockstate > 10)
             {
-                _nextLockStateUpdateTs = ts + 10 * 1000;
+                scheduleJob(JobLockState, ts + 10 * 1000);
             }
-        }
-        else
-        {
+            break;
+        case LockActionExecutor<NukiLock::LockAction>::Step::Retry:
+            Log->print("Lock: Last command failed, retrying after ");
+            Log->print(_retryDelay);
+            Log->print(" milliseconds. Retry ");
+            Log->print(command.retryCount);
+            Log->print(" of ");
+            Log->println(_nrOfRetries);
+            _network->publishRetry(std::to_string(command.retryCount));
+            break;
+        case LockActionExecutor<NukiLock::LockAction>::Step::Failed:
             Log->println("Lock: Maximum number of retries exceeded, aborting.");
             _network->publishRetry("failed");
-            retryCount = 0;
-            _nextLockAction = (NukiLock::LockAction) 0xff;
+            break;
+        case LockActionExecutor<NukiLock::LockAction>::Step::Superseded:
+            Log->println("Lock: Last command failed and was superseded by a new action.");
+            _network->publishRetry("--");
+            break;
+        default:
+            break;
         }
     }
-    if(_nukiOfficial->getStatusUpdated() || _statusUpdated || _nextLockStateUpdateTs == 0 || ts >= _nextLockStateUpdateTs || (queryCommands & QUERY_COMMAND_LOCKSTATE) > 0)
+    if(!_jobsArmed)
     {
-        Log->println("Updating Lock state based on status, timer or query");
-        _statusUpdated = updateKeyTurnerState();
-        _nextLockStateUpdateTs = ts + _intervalLockstate * 1000;
-        _network->publishStatusUpdated(_statusUpdated);
+        // once paired, only the advertisements of the device are dispatched
+        BLEAddress address = _nukiLock.getBleAddress();
+        _bleScanner->clearFilters(&_nukiLock);
+        _bleScanner->addAddressFilter(&_nukiLock, address);
+        _beaconTracker.setAddress(address);
+        _bleScanner->clearFilters(&_beaconTracker);
+        _bleScanner->addAddressFilter(&_beaconTracker, address);
+        _bleScanner->subscribe(&_beaconTracker);
+        armJobs(ts);
+    }
+    if(_nukiOfficial->getStatusUpdated() || _statusUpdated || (queryCommands & QUERY_COMMAND_LOCKSTATE) > 0)
+    {
+        _lockStateRequested = true;
+        scheduleJob(JobLockState, ts);
+    }
+    if((queryCommands & QUERY_COMMAND_BATTERY) > 0)
+    {
+        scheduleJob(JobBattery, ts);
+    }
+    if((queryCommands & QUERY_COMMAND_CONFIG) > 0)
+    {
+        scheduleJob(JobConfig, ts);
+    }
+    if((queryCommands & QUERY_COMMAND_KEYPAD) > 0)
+    {
+        scheduleJob(JobKeypad, ts);
     }
     if(_network->mqttConnectionState() == 2)
     {
-        if(!_statusUpdated)
+        if(!_statusUpdated && _hassEnabled && _nukiConfigValid && _nukiAdvancedConfigValid && !_hassSetupCompleted)
         {
-            if(_nextBatteryReportTs == 0 || ts > _nextBatteryReportTs || (queryCommands & QUERY_COMMAND_BATTERY) > 0)
-            {
-                Log->println("Updating Lock battery state based on timer or query");
-                _nextBatteryReportTs = ts + _intervalBattery * 1000;
-                updateBatteryState();
-            }
-            if(_nextConfigUpdateTs == 0 || ts > _nextConfigUpdateTs || (queryCommands & QUERY_COMMAND_CONFIG) > 0)
-            {
-                Log->println("Updating Lock config based on timer or query");
-                _nextConfigUpdateTs = ts + _intervalConfig * 1000;
-                updateConfig();
-            }
-            if(_waitAuthLogUpdateTs != 0 && ts > _waitAuthLogUpdateTs)
-            {
-                _waitAuthLogUpdateTs = 0;
-                updateAuthData(true);
-            }
-            if(_waitKeypadUpdateTs != 0 && ts > _waitKeypadUpdateTs)
-            {
-                _waitKeypadUpdateTs = 0;
-                updateKeypad(true);
-            }
-            if(_waitTimeControlUpdateTs != 0 && ts > _waitTimeControlUpdateTs)
-            {
-                _waitTimeControlUpdateTs = 0;
-                updateTimeControl(true);
-            }
-            if(_waitAuthUpdateTs != 0 && ts > _waitAuthUpdateTs)
-            {
-                _waitAuthUpdateTs = 0;
-                updateAuth(true);
-            }
-            if(_hassEnabled && _nukiConfigValid && _nukiAdvancedConfigValid && !_hassSetupCompleted)
-            {
-                _network->setupHASS(1, _nukiConfig.nukiId, (char*)_nukiConfig.name, _firmwareVersion.c_str(), _hardwareVersion.c_str(), hasDoorSensor(), hasKeypad());
-                _hassSetupCompleted = true;
-            }
-            if(_rssiPublishInterval > 0 && (_nextRssiTs == 0 || ts > _nextRssiTs))
-            {
-                _nextRssiTs = ts + _rssiPublishInterval;
-
-                int rssi = _nukiLock.getRssi();
-                if(rssi != _lastRssi)
-                {
-                    _network->publishRssi(rssi);
-                    _lastRssi = rssi;
-                }
-            }
-            if(hasKeypad() && _keypadEnabled && (_nextKeypadUpdateTs == 0 || ts > _nextKeypadUpdateTs || (queryCommands & QUERY_COMMAND_KEYPAD) > 0))
-            {
-                Log->println("Updating Lock keypad based on timer or query");
-                _nextKeypadUpdateTs = ts + _intervalKeypad * 1000;
-                updateKeypad(false);
-            }
-            if(_preferences->getBool(preference_update_time, false) && ts > (120 * 1000) && ts > _nextTimeUpdateTs)
-            {
-                _nextTimeUpdateTs = ts + (12 * 60 * 60 * 1000);
-                updateTime();
-            }
+            _network->setupHASS(1, _nukiConfig.nukiId, (char*)_nukiConfig.name, _firmwareVersion.c_str(), _hardwareVersion.c_str(), hasDoorSensor(), hasKeypad());
+            _hassSetupCompleted = true;
         }
         if(_clearAuthData)
         {
@@ -424,33 +484,95 @@ void NukiWrapper::update(bool reboot)
             Nuki::CmdResult cmdResult = _nukiLock.requestReboot();
         }
     }
+}
+
+int64_t NukiWrapper::nextWakeupTs()
+{
+    // periodic queries are covered by the scheduler's next deadline
+    if(!_paired || _statusUpdated)
+    {
+        return 0;
+    }
+    return _lockActionExecutor.nextAttemptTs();
+}
+
+void NukiWrapper::addJob(NukiJob job, const char* name, uint8_t priority, std::function<void(int64_t)> run)
+{
+    _jobs[job] = _scheduler->add(name, NUKI_JOB_OWNER_LOCK, priority, [this, job, run](int64_t ts)
+    {
+        if(!_paired)
+        {
+            // armed again after pairing
+            return;
+        }
+        // everything but the lock state waits for MQTT and a settled lock state
+        if(job != JobLockState && (_network->mqttConnectionState() != 2 || _statusUpdated))
+        {
+            scheduleJob(job, ts + NUKI_JOB_DEFER_DELAY);
+            return;
+        }
+        run(ts);
+    });
+}
+
+void NukiWrapper::armJobs(int64_t ts)
+{
+    scheduleJob(JobLockState, ts, true);
+    scheduleJob(JobBattery, ts, true);
+    scheduleJob(JobConfig, ts, true);
+    scheduleJob(JobKeypad, ts, true);
+    scheduleJob(JobRssi, ts);
+    scheduleJob(JobTime, std::max(ts, (int64_t)120 * 1000), true);
+    _jobsArmed = true;
+}
+
+void NukiWrapper::scheduleJob(NukiJob job, int64_t ts, bool spread)
+{
+    _scheduler->schedule(_jobs[job], ts, spread);
+}
+
+bool NukiWrapper::queueLockAction(NukiLock::LockAction action)
+{
+    uint32_t commandId = _lockActionExecutor.submit(action);
+    if(commandId == 0)
+    {
+        Log->println("Lock: Action queue full, action rejected");
+        return false;
+    }
+    _network->publishCommandResultJson(commandId, action, "queued", 0);
+    NukiTaskWakeup::notify(NukiTaskWakeupReason::Command);
+    return true;
+}
 
-    memcpy(&_lastKeyTurnerState, &_keyTurnerState, sizeof(NukiLock::KeyTurnerState));
+bool NukiWrapper::coalescableLockAction(NukiLock::LockAction action)
+{
+    // only the resulting state matters, unlatch and fob actions always run
+    return action == NukiLock::LockAction::Lock || action == NukiLock::LockAction::Unlock || action == NukiLock::LockAction::FullLock;
 }
 
 void NukiWrapper::lock()
 {
-    _nextLockAction = NukiLock::LockAction::Lock;
+    queueLockAction(NukiLock::LockAction::Lock);
 }
 
 void NukiWrapper::unlock()
 {
-    _nextLockAction = NukiLock::LockAction::Unlock;
+    queueLockAction(NukiLock::LockAction::Unlock);
 }
 
 void NukiWrapper::unlatch()
 {
-    _nextLockAction = NukiLock::LockAction::Unlatch;
+    queueLockAction(NukiLock::LockAction::Unlatch);
 }
 
 void NukiWrapper::lockngo()
 {
-    _nextLockAction = NukiLock::LockAction::LockNgo;
+    queueLockAction(NukiLock::LockAction::LockNgo);
 }
 
 void NukiWrapper::lockngounlatch()
 {
-    _nextLockAction = NukiLock::LockAction::LockNgoUnlatch;
+    queueLockAction(NukiLock::LockAction::LockNgoUnlatch);
 }
 
 bool NukiWrapper::isPinValid()
@@ -491,6 +613,8 @@ void NukiWrapper::unpair()
         _preferences->remove(preference_nuki_id_lock);
     }
     _paired = false;
+    _jobsArmed = false;
+    _bleScanner->clearFilters(&_nukiLock);
 }
 
 bool NukiWrapper::updateKeyTurnerState()
@@ -515,6 +639,8 @@ bool NukiWrapper::updateKeyTurnerState()
     NukiLock::cmdResultToString(result, resultStr);
     _network->publishLockstateCommandResult(resultStr);
 
+    _beaconTracker.queried(result == Nuki::CmdResult::Success, espMillis());
+
     if(result != Nuki::CmdResult::Success)
     {
         Log->println("Query lock state failed");
@@ -525,7 +651,7 @@ bool NukiWrapper::updateKeyTurnerState()
             Log->print("Query lock state retrying in ");
             Log->print(_retryDelay);
             Log->println("ms");
-            _nextLockStateUpdateTs = espMillis() + _retryDelay;
+            scheduleJob(JobLockState, espMillis() + _retryDelay);
         }
         _network->publishKeyTurnerState(_keyTurnerState, _lastKeyTurnerState);
         return false;
@@ -562,10 +688,7 @@ bool NukiWrapper::updateKeyTurnerState()
     }
     else if(lockState == NukiLock::LockState::Undefined)
     {
-        if (_nextLockStateUpdateTs > espMillis() + 60000)
-        {
-            _nextLockStateUpdateTs = espMillis() + 60000;
-        }
+        _scheduler->scheduleEarlier(_jobs[JobLockState], espMillis() + 60000);
     }
     _network->publishKeyTurnerState(_keyTurnerState, _lastKeyTurnerState);
 
@@ -723,8 +846,7 @@ void NukiWrapper::updateConfig()
     {
         ++_retryConfigCount;
         Log->println("Invalid/Unexpected lock config and/or advanced config received, retrying in 10 seconds");
-        int64_t ts = espMillis();
-        _nextConfigUpdateTs = ts + 10000;
+        scheduleJob(JobConfig, espMillis() + 10000);
     }
 }
 
@@ -738,13 +860,23 @@ void NukiWrapper::updateAuthData(bool retrieved)
 
     if(!retrieved)
     {
+        // only the entries after the last published index are read, the index is kept across reboots
+        const uint32_t cursor = _authLogResync ? 0 : _network->getLastRollingLog();
+        const int maxEntries = _preferences->getInt(preference_authlog_max_entries, MAX_AUTHLOG);
         Nuki::CmdResult result = (Nuki::CmdResult)-1;
         int retryCount = 0;
 
         while(retryCount < _nrOfRetries + 1)
         {
             Log->print("Retrieve log entries: ");
-            result = _nukiLock.retrieveLogEntries(0, _preferences->getInt(preference_authlog_max_entries, MAX_AUTHLOG), 1, false);
+            if(cursor > 0)
+            {
+                result = _nukiLock.retrieveLogEntries(cursor + 1, maxEntries, 0, false);
+            }
+            else
+            {
+                result = _nukiLock.retrieveLogEntries(0, maxEntries, 1, false);
+            }
             if(result != Nuki::CmdResult::Success)
             {
                 ++retryCount;
@@ -758,53 +890,90 @@ void NukiWrapper::updateAuthData(bool retrieved)
         printCommandResult(result);
         if(result == Nuki::CmdResult::Success)
         {
-            _waitAuthLogUpdateTs = espMillis() + 5000;
+            scheduleJob(JobAuthLogRetrieved, espMillis() + 5000);
             delay(100);
 
             std::list<NukiLock::LogEntry> log;
             _nukiLock.getLogEntries(&log);
 
-            if(log.size() > _preferences->getInt(preference_authlog_max_entries, 3))
+            if(_authLogResync && !log.empty())
             {
-                log.resize(_preferences->getInt(preference_authlog_max_entries, 3));
+                // the latest entry on the device is older than the cursor: the log was reset, continue from there
+                uint32_t latest = 0;
+                for(const auto& entry : log)
+                {
+                    if(entry.index > latest)
+                    {
+                        latest = entry.index;
+                    }
+                }
+                if(latest < _network->getLastRollingLog())
+                {
+                    _network->setLastRollingLog(latest);
+                }
             }
 
-            log.sort([](const NukiLock::LogEntry& a, const NukiLock::LogEntry& b)
-            {
-                return a.index < b.index;
-            });
-
-            if(log.size() > 0)
+            const bool added = updateAuthLog(log);
+            if(added)
             {
-                _network->publishAuthorizationInfo(log, true);
+                _network->publishAuthorizationInfo(_authLog, true);
             }
+            // nothing after the cursor (e.g. the log was reset on the device): read the latest entries once
+            _authLogResync = cursor > 0 && !added;
         }
     }
     else
     {
         std::list<NukiLock::LogEntry> log;
         _nukiLock.getLogEntries(&log);
+        updateAuthLog(log);
 
-        if(log.size() > _preferences->getInt(preference_authlog_max_entries, MAX_AUTHLOG))
+        Log->print("Log size: ");
+        Log->println(_authLog.size());
+
+        // the full log is only serialized when entries were added since it was last published
+        if(_authLogChanged && _authLog.size() > 0)
         {
-            log.resize(_preferences->getInt(preference_authlog_max_entries, MAX_AUTHLOG));
+            _network->publishAuthorizationInfo(_authLog, false);
+            _authLogChanged = false;
         }
+    }
 
-        log.sort([](const NukiLock::LogEntry& a, const NukiLock::LogEntry& b)
-        {
-            return a.index < b.index;
-        });
+    postponeBleWatchdog();
+}
 
-        Log->print("Log size: ");
-        Log->println(log.size());
+bool NukiWrapper::updateAuthLog(std::list<NukiLock::LogEntry>& log)
+{
+    log.sort([](const NukiLock::LogEntry& a, const NukiLock::LogEntry& b)
+    {
+        return a.index < b.index;
+    });
+
+    _network->publishRollingLog(log);
 
-        if(log.size() > 0)
+    bool added = false;
+    for(const auto& entry : log)
+    {
+        auto it = _authLog.begin();
+        while(it != _authLog.end() && it->index < entry.index)
+        {
+            ++it;
+        }
+        if(it != _authLog.end() && it->index == entry.index)
         {
-            _network->publishAuthorizationInfo(log, false);
+            continue;
         }
+        _authLog.insert(it, entry);
+        added = true;
     }
 
-    postponeBleWatchdog();
+    while(_authLog.size() > _preferences->getInt(preference_authlog_max_entries, MAX_AUTHLOG))
+    {
+        _authLog.pop_front();
+    }
+
+    _authLogChanged = _authLogChanged || added;
+    return added;
 }
 
 void NukiWrapper::updateKeypad(bool retrieved)
@@ -842,7 +1011,7 @@ void NukiWrapper::updateKeypad(bool retrieved)
         printCommandResult(result);
         if(result == Nuki::CmdResult::Success)
         {
-            _waitKeypadUpdateTs = espMillis() + 5000;
+            scheduleJob(JobKeypadRetrieved, espMillis() + 5000);
         }
     }
     else
@@ -921,7 +1090,7 @@ void NukiWrapper::updateTimeControl(bool retrieved)
         printCommandResult(result);
         if(result == Nuki::CmdResult::Success)
         {
-            _waitTimeControlUpdateTs = espMillis() + 5000;
+            scheduleJob(JobTimeControlRetrieved, espMillis() + 5000);
         }
     }
     else
@@ -998,7 +1167,7 @@ void NukiWrapper::updateAuth(bool retrieved)
         printCommandResult(result);
         if(result == Nuki::CmdResult::Success)
         {
-            _waitAuthUpdateTs = millis() + 5000;
+            scheduleJob(JobAuthRetrieved, espMillis() + 5000);
         }
     }
     else
@@ -1121,7 +1290,10 @@ LockActionResult NukiWrapper::onLockActionReceived(const char *value)
     {
         if(!_nukiOfficial->getOffConnected())
         {
-            nukiInst->_nextLockAction = action;
+            if(!nukiInst->queueLockAction(action))
+            {
+                return LockActionResult::Failed;
+            }
         }
         else
         {
@@ -1134,9 +1306,9 @@ LockActionResult NukiWrapper::onLockActionReceived(const char *value)
                 }
                 _network->publishOffAction((int)action);
             }
-            else
+            else if(!nukiInst->queueLockAction(action))
             {
-                nukiInst->_nextLockAction = action;
+                return LockActionResult::Failed;
             }
         }
         return LockActionResult::Success;
@@ -2472,7 +2644,7 @@ void NukiWrapper::onConfigUpdateReceived(const char *value)
         jsonResult["general"] = "noChange";
     }
 
-    _nextConfigUpdateTs = espMillis() + 300;
+    scheduleJob(JobConfig, espMillis() + 300);
 
     serializeJson(jsonResult, _buffer, _bufferSize);
     _network->publishConfigCommandResult(_buffer);
@@ -2503,10 +2675,14 @@ void NukiWrapper::onAuthCommandReceivedCallback(const char *value)
 
 void NukiWrapper::gpioActionCallback(const GpioAction &action, const int& pin)
 {
-    nukiInst->onGpioActionReceived(action, pin);
+    // Called from the GPIO timer interrupt, the action is handled by the nuki task
+    if(xQueueSendFromISR(nukiInst->_gpioActionQueue, &action, nullptr) == pdTRUE)
+    {
+        NukiTaskWakeup::notify(NukiTaskWakeupReason::Command);
+    }
 }
 
-void NukiWrapper::onGpioActionReceived(const GpioAction &action, const int &pin)
+void NukiWrapper::onGpioActionReceived(const GpioAction &action)
 {
     switch(action)
     {
@@ -3574,7 +3750,7 @@ void NukiWrapper::onTimeControlCommandReceived(const char *value)
             _network->publishTimeControlCommandResult(resultStr);
         }
 
-        _nextConfigUpdateTs = espMillis() + 300;
+        scheduleJob(JobConfig, espMillis() + 300);
     }
     else
     {
@@ -4147,6 +4323,7 @@ void NukiWrapper::notify(Nuki::EventType eventType)
         {
             Log->println("OffKeyTurnerStatusUpdated");
             _statusUpdated = true;
+            NukiTaskWakeup::notify(NukiTaskWakeupReason::StatusChanged);
         }
         else
         {
@@ -4157,13 +4334,15 @@ void NukiWrapper::notify(Nuki::EventType eventType)
             }
             else if(eventType == Nuki::EventType::KeyTurnerStatusUpdated)
             {
-                if(!_statusUpdated && _newSignal < 5)
+                if(!_statusUpdated && _newSignal < 5 && !_beaconTracker.skipFlaggedQuery(espMillis()))
                 {
                     _newSignal++;
                     Log->println("KeyTurnerStatusUpdated");
+                    _bleScanner->boostScanning();
                     _statusUpdated = true;
                     _statusUpdatedTs = espMillis();
                     _network->publishStatusUpdated(_statusUpdated);
+                    NukiTaskWakeup::notify(NukiTaskWakeupReason::StatusChanged);
                 }
             }
             else if(eventType == Nuki::EventType::ERROR_BAD_PIN)
@@ -10,16 +10,20 @@
 #include "NukiDeviceId.h"
 #include "NukiOfficial.h"
 #include "EspMillis.h"
+#include "LockActionExecutor.h"
+#include "JobScheduler.h"
+#include "NukiBeaconTracker.h"
 
 class NukiWrapper : public Nuki::SmartlockEventHandler
 {
 public:
-    NukiWrapper(const std::string& deviceName, NukiDeviceId* deviceId, BleScanner::Scanner* scanner, NukiNetworkLock* network, NukiOfficial* nukiOfficial, Gpio* gpio, Preferences* preferences, char* buffer, size_t bufferSize);
+    NukiWrapper(const std::string& deviceName, NukiDeviceId* deviceId, BleScanner::Scanner* scanner, NukiNetworkLock* network, NukiOfficial* nukiOfficial, Gpio* gpio, JobScheduler* scheduler, Preferences* preferences, char* buffer, size_t bufferSize);
     virtual ~NukiWrapper();
 
     void initialize();
     void readSettings();
     void update(bool reboot = false);
+    int64_t nextWakeupTs();
 
     void lock();
     void unlock();
@@ -49,6 +53,21 @@ public:
     void notify(Nuki::EventType eventType) override;
 
 private:
+    enum NukiJob
+    {
+        JobLockState,
+        JobBattery,
+        JobConfig,
+        JobAuthLogRetrieved,
+        JobKeypadRetrieved,
+        JobTimeControlRetrieved,
+        JobAuthRetrieved,
+        JobKeypad,
+        JobRssi,
+        JobTime,
+        JobCount
+    };
+
     static LockActionResult onLockActionReceivedCallback(const char* value);
     static void onOfficialUpdateReceivedCallback(const char* topic, const char* value);
     static void onConfigUpdateReceivedCallback(const char* value);
@@ -57,25 +76,32 @@ private:
     static void onTimeControlCommandReceivedCallback(const char* value);
     static void onAuthCommandReceivedCallback(const char* value);
     static void gpioActionCallback(const GpioAction& action, const int& pin);
+    static bool coalescableLockAction(NukiLock::LockAction action);
     LockActionResult onLockActionReceived(const char* value);
+    bool queueLockAction(NukiLock::LockAction action);
     void onKeypadCommandReceived(const char* command, const uint& id, const String& name, const String& code, const int& enabled);
     void onOfficialUpdateReceived(const char* topic, const char* value);
     void onConfigUpdateReceived(const char* value);
     void onKeypadJsonCommandReceived(const char* value);
     void onTimeControlCommandReceived(const char* value);
     void onAuthCommandReceived(const char* value);
-    void onGpioActionReceived(const GpioAction& action, const int& pin);
+    void onGpioActionReceived(const GpioAction& action);
 
     bool updateKeyTurnerState();
     void updateBatteryState();
     void updateConfig();
     void updateAuthData(bool retrieved);
+    bool updateAuthLog(std::list<NukiLock::LogEntry>& log);
     void updateKeypad(bool retrieved);
     void updateTimeControl(bool retrieved);
     void updateAuth(bool retrieved);
     void postponeBleWatchdog();
     void updateTime();
 
+    void addJob(NukiJob job, const char* name, uint8_t priority, std::function<void(int64_t)> run);
+    void armJobs(int64_t ts);
+    void scheduleJob(NukiJob job, int64_t ts, bool spread = false);
+
     void updateGpioOutputs();
 
     void readConfig();
@@ -98,6 +124,10 @@ private:
     NukiNetworkLock* _network = nullptr;
     NukiOfficial* _nukiOfficial = nullptr;
     Gpio* _gpio = nullptr;
+    JobScheduler* _scheduler = nullptr;
+    int _jobs[JobCount];
+    bool _jobsArmed = false;
+    bool _lockStateRequested = false;
     Preferences* _preferences;
     int _intervalLockstate = 0; // seconds
     int _intervalHybridLockstate = 0; // seconds
@@ -106,6 +136,9 @@ private:
     int _intervalKeypad = 0; // seconds
     int _restartBeaconTimeout = 0; // seconds
     bool _publishAuthData = false;
+    std::list<NukiLock::LogEntry> _authLog;
+    bool _authLogChanged = false;
+    bool _authLogResync = false;
     bool _clearAuthData = false;
     bool _checkKeypadCodes = false;
     int _invalidCount = 0;
@@ -150,23 +183,15 @@ private:
     int _rssiPublishInterval = 0;
     int64_t _statusUpdatedTs = 0;
     int64_t _nextRetryTs = 0;
-    int64_t _nextLockStateUpdateTs = 0;
-    int64_t _nextBatteryReportTs = 0;
-    int64_t _nextConfigUpdateTs = 0;
-    int64_t _waitAuthLogUpdateTs = 0;
-    int64_t _waitKeypadUpdateTs = 0;
-    int64_t _waitTimeControlUpdateTs = 0;
-    int64_t _waitAuthUpdateTs = 0;
-    int64_t _nextTimeUpdateTs = 0;
-    int64_t _nextKeypadUpdateTs = 0;
-    int64_t _nextRssiTs = 0;
     int64_t _lastRssi = 0;
     int64_t _disableBleWatchdogTs = 0;
     uint32_t _basicLockConfigaclPrefs[16];
     uint32_t _advancedLockConfigaclPrefs[25];
     std::string _firmwareVersion = "";
     std::string _hardwareVersion = "";
-    volatile NukiLock::LockAction _nextLockAction = (NukiLock::LockAction)0xff;
+    LockActionExecutor<NukiLock::LockAction> _lockActionExecutor{coalescableLockAction};
+    QueueHandle_t _gpioActionQueue = nullptr; // filled from the GPIO timer interrupt, drained in update()
+    NukiBeaconTracker _beaconTracker;
 
     char* _buffer;
     const size_t _bufferSize;
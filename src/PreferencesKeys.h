@@ -22,6 +22,7 @@
 #define preference_mqtt_user (char*)"mqttuser"
 #define preference_mqtt_password (char*)"mqttpass"
 #define preference_mqtt_log_enabled (char*)"mqttlog"
+#define preference_mqtt_journal_enabled (char*)"mqttJournal"
 #define preference_webserial_enabled (char*)"weblog"
 #define preference_lock_enabled (char*)"lockena"
 #define preference_mqtt_lock_path (char*)"mqttpath"
@@ -159,6 +160,8 @@
 #define preference_updater_date (char*)"updDate"
 #define preference_lock_max_auth_entry_count (char*)"maxauth"
 #define preference_opener_max_auth_entry_count (char*)"opmaxauth"
+#define preference_lock_auth_log_cursor (char*)"authLogCur"
+#define preference_opener_auth_log_cursor (char*)"opAuthLogCur"
 #define preference_started_before (char*)"run"
 #define preference_config_version (char*)"confVersion"
 #define preference_device_id_lock (char*)"deviceId"
@@ -293,7 +296,7 @@ inline void initPreferences(Preferences* preferences)
         Log->print("Current config version: ");
         Log->println(NUKI_HUB_VERSION_INT);
 
-        if(lastConfigVer >= NUKI_HUB_VERSION_INT && lastConfigVer < 20000) return;
+        if(lastConfigVer >= (int)NUKI_HUB_VERSION_INT && lastConfigVer < 20000) return;
 
         if (lastConfigVer < 834)
         {
@@ -513,6 +516,7 @@ private:
     {
         preference_started_before, preference_config_version, preference_device_id_lock, preference_device_id_opener, preference_nuki_id_lock, preference_nuki_id_opener,
         preference_mqtt_broker, preference_mqtt_broker_port, preference_mqtt_user, preference_mqtt_password, preference_mqtt_log_enabled, preference_check_updates,
+        preference_mqtt_journal_enabled,
         preference_webserver_enabled, preference_lock_enabled, preference_lock_pin_status, preference_mqtt_lock_path, preference_opener_enabled, preference_opener_pin_status,
         preference_opener_continuous_mode, preference_lock_max_keypad_code_count, preference_opener_max_keypad_code_count, preference_update_time, preference_time_server,
         preference_lock_max_timecontrol_entry_count, preference_opener_max_timecontrol_entry_count, preference_enable_bootloop_reset,
@@ -530,6 +534,7 @@ private:
         preference_network_custom_mdc, preference_network_custom_clk, preference_network_custom_phy, preference_network_custom_addr, preference_network_custom_irq,
         preference_network_custom_rst, preference_network_custom_cs, preference_network_custom_sck, preference_network_custom_miso, preference_network_custom_mosi,
         preference_network_custom_pwr, preference_network_custom_mdio, preference_lock_max_auth_entry_count, preference_opener_max_auth_entry_count,
+        preference_lock_auth_log_cursor, preference_opener_auth_log_cursor,
         preference_auth_control_enabled, preference_auth_topic_per_entry, preference_auth_info_enabled, preference_auth_max_entries, preference_wifi_ssid, preference_wifi_pass,
         preference_keypad_check_code_enabled, preference_disable_network_not_connected, preference_mqtt_hass_enabled, preference_hass_device_discovery, preference_retain_gpio,
         preference_debug_connect, preference_debug_communication, preference_debug_readable_data, preference_debug_hex_data, preference_debug_command, preference_connect_mode,
@@ -549,6 +554,7 @@ private:
     std::vector<char*> _boolPrefs =
     {
         preference_started_before, preference_mqtt_log_enabled, preference_check_updates, preference_lock_enabled, preference_opener_enabled, preference_opener_continuous_mode,
+        preference_mqtt_journal_enabled,
         preference_timecontrol_topic_per_entry, preference_keypad_topic_per_entry, preference_enable_bootloop_reset, preference_webserver_enabled, preference_update_time,
         preference_restart_on_disconnect, preference_keypad_control_enabled, preference_keypad_info_enabled, preference_keypad_publish_code, preference_show_secrets,
         preference_timecontrol_control_enabled, preference_timecontrol_info_enabled, preference_register_as_app, preference_register_opener_as_app, preference_ip_dhcp_enabled,
@@ -582,7 +588,8 @@ private:
     };
     std::vector<char*> _uintPrefs =
     {
-        preference_device_id_lock, preference_device_id_opener, preference_nuki_id_lock, preference_nuki_id_opener
+        preference_device_id_lock, preference_device_id_opener, preference_nuki_id_lock, preference_nuki_id_opener,
+        preference_lock_auth_log_cursor, preference_opener_auth_log_cursor
     };
     std::vector<char*> _uint64Prefs =
     {
@@ -0,0 +1,204 @@
+#include "SessionStore.h"
+#include <cstring>
+
+#define SESSION_STORE_EMPTY 0xFF
+
+static_assert(SESSION_STORE_CAPACITY < SESSION_STORE_EMPTY, "Session index doesn't fit the slots");
+static_assert((SESSION_STORE_SLOTS & (SESSION_STORE_SLOTS - 1)) == 0, "Slot count has to be a power of two");
+static_assert(SESSION_STORE_SLOTS >= SESSION_STORE_CAPACITY * 2, "Slots have to be at most half filled");
+
+SessionStore::SessionStore()
+{
+    memset(_slots, SESSION_STORE_EMPTY, sizeof(_slots));
+}
+
+bool SessionStore::add(const char* id, const int64_t expiry, const int64_t now)
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    return insert(id, hash(id), expiry, now);
+}
+
+bool SessionStore::valid(const char* id, const int64_t now)
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    int index = find(id, hash(id));
+
+    if(index < 0)
+    {
+        return false;
+    }
+    if(_sessions[index].expiry > now)
+    {
+        return true;
+    }
+
+    removeAt(index);
+    return false;
+}
+
+bool SessionStore::remove(const char* id)
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    int index = find(id, hash(id));
+
+    if(index < 0)
+    {
+        return false;
+    }
+
+    removeAt(index);
+    return true;
+}
+
+void SessionStore::clear()
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    _count = 0;
+    memset(_slots, SESSION_STORE_EMPTY, sizeof(_slots));
+    _dirty = true;
+}
+
+size_t SessionStore::count() const
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    return _count;
+}
+
+bool SessionStore::dirty() const
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    return _dirty;
+}
+
+void SessionStore::toJson(JsonDocument& json)
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    json.to<JsonObject>();
+
+    for(size_t i = 0; i < _count; ++i)
+    {
+        json[_sessions[i].id] = _sessions[i].expiry;
+    }
+    _dirty = false;
+}
+
+void SessionStore::fromJson(const JsonDocument& json, const int64_t now)
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+
+    for(JsonPairConst session : json.as<JsonObjectConst>())
+    {
+        const char* id = session.key().c_str();
+        insert(id, hash(id), session.value().as<int64_t>(), now);
+    }
+    _dirty = false;
+}
+
+int SessionStore::find(const char* id, const uint32_t h) const
+{
+    uint32_t slot = h & (SESSION_STORE_SLOTS - 1);
+
+    while(_slots[slot] != SESSION_STORE_EMPTY)
+    {
+        const Session& session = _sessions[_slots[slot]];
+        if(session.hash == h && strcmp(session.id, id) == 0)
+        {
+            return _slots[slot];
+        }
+        slot = (slot + 1) & (SESSION_STORE_SLOTS - 1);
+    }
+
+    return -1;
+}
+
+bool SessionStore::insert(const char* id, const uint32_t h, const int64_t expiry, const int64_t now)
+{
+    if(id == nullptr || strlen(id) == 0 || strlen(id) > SESSION_ID_LENGTH || expiry <= now)
+    {
+        return false;
+    }
+
+    int index = find(id, h);
+    if(index >= 0)
+    {
+        _sessions[index].expiry = expiry;
+        _dirty = true;
+        return true;
+    }
+
+    if(_count == SESSION_STORE_CAPACITY)
+    {
+        // drop the expired sessions, if there are none the one that would expire first
+        size_t oldest = 0;
+        for(size_t i = _count; i-- > 0;)
+        {
+            if(_sessions[i].expiry <= now)
+            {
+                _sessions[i] = _sessions[--_count];
+            }
+        }
+        if(_count == SESSION_STORE_CAPACITY)
+        {
+            for(size_t i = 1; i < _count; ++i)
+            {
+                if(_sessions[i].expiry < _sessions[oldest].expiry)
+                {
+                    oldest = i;
+                }
+            }
+            _sessions[oldest] = _sessions[--_count];
+        }
+        rebuildIndex();
+    }
+
+    Session& session = _sessions[_count];
+    strcpy(session.id, id);
+    session.hash = h;
+    session.expiry = expiry;
+
+    uint32_t slot = h & (SESSION_STORE_SLOTS - 1);
+    while(_slots[slot] != SESSION_STORE_EMPTY)
+    {
+        slot = (slot + 1) & (SESSION_STORE_SLOTS - 1);
+    }
+    _slots[slot] = _count++;
+    _dirty = true;
+    return true;
+}
+
+void SessionStore::removeAt(const size_t index)
+{
+    // removals are rare (logout, expiry), rebuilding the small index is simpler than fixing up the probe sequences
+    _sessions[index] = _sessions[--_count];
+    rebuildIndex();
+    _dirty = true;
+}
+
+void SessionStore::rebuildIndex()
+{
+    memset(_slots, SESSION_STORE_EMPTY, sizeof(_slots));
+
+    for(size_t i = 0; i < _count; ++i)
+    {
+        uint32_t slot = _sessions[i].hash & (SESSION_STORE_SLOTS - 1);
+        while(_slots[slot] != SESSION_STORE_EMPTY)
+        {
+            slot = (slot + 1) & (SESSION_STORE_SLOTS - 1);
+        }
+        _slots[slot] = i;
+    }
+}
+
+uint32_t SessionStore::hash(const char* id)
+{
+    uint32_t h = 2166136261UL;
+
+    while(*id != 0x00)
+    {
+        h ^= (uint8_t)*id;
+        h *= 16777619UL;
+        ++id;
+    }
+
+    return h;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include "ArduinoJson.h"
+
+#define SESSION_STORE_CAPACITY 16
+#define SESSION_STORE_SLOTS 32
+#define SESSION_ID_LENGTH 32
+
+// Login sessions (web, Duo, TOTP, bypass) of the web configuration, keyed by the
+// session id sent as cookie. Sessions are kept in a fixed table, looked up through
+// an open addressing index on the hash of the id, so checking the cookie of a
+// request doesn't allocate. Expired sessions are dropped when they are looked up
+// or when room is needed for a new one; if the table is full the session closest
+// to its expiry is replaced.
+// Changes only mark the store dirty, the owner writes it out with toJson() when
+// convenient, which coalesces several logins / logouts into one write.
+// Expiry and now are wall clock times in microseconds. Thread safe.
+class SessionStore
+{
+public:
+    SessionStore();
+
+    bool add(const char* id, const int64_t expiry, const int64_t now);
+    bool valid(const char* id, const int64_t now);
+    bool remove(const char* id);
+    void clear();
+
+    size_t count() const;
+    bool dirty() const;
+
+    // Serializes the sessions as {"id": expiry, ...} and clears the dirty flag
+    void toJson(JsonDocument& json);
+    void fromJson(const JsonDocument& json, const int64_t now);
+
+private:
+    struct Session
+    {
+        char id[SESSION_ID_LENGTH + 1];
+        uint32_t hash;
+        int64_t expiry;
+    };
+
+    int find(const char* id, const uint32_t h) const;
+    bool insert(const char* id, const uint32_t h, const int64_t expiry, const int64_t now);
+    void removeAt(const size_t index);
+    void rebuildIndex();
+    static uint32_t hash(const char* id);
+
+    mutable std::mutex _mutex;
+    Session _sessions[SESSION_STORE_CAPACITY];
+    size_t _count = 0;
+    uint8_t _slots[SESSION_STORE_SLOTS];
+    bool _dirty = false;
+};
@@ -0,0 +1,123 @@
+#include "WebCfgAsset.h"
+#include <string.h>
+#include <strings.h>
+
+bool webCfgAssetNotModified(const char* ifNoneMatch, const char* etag)
+{
+    if(ifNoneMatch == nullptr || etag == nullptr)
+    {
+        return false;
+    }
+
+    const size_t etagLength = strlen(etag);
+    const char* pos = ifNoneMatch;
+
+    while(*pos != '\0')
+    {
+        while(*pos == ' ' || *pos == '\t' || *pos == ',')
+        {
+            ++pos;
+        }
+        if(*pos == '\0')
+        {
+            break;
+        }
+        if(*pos == '*')
+        {
+            return true;
+        }
+        if(strncmp(pos, "W/", 2) == 0)
+        {
+            pos += 2;
+        }
+        if(*pos != '"')
+        {
+            // malformed list, nothing can be trusted to match
+            return false;
+        }
+
+        const char* end = strchr(pos + 1, '"');
+        if(end == nullptr)
+        {
+            return false;
+        }
+
+        const size_t length = end - pos + 1;
+        if(length == etagLength && strncmp(pos, etag, length) == 0)
+        {
+            return true;
+        }
+        pos = end + 1;
+    }
+
+    return false;
+}
+
+bool webCfgAssetAcceptsGzip(const char* acceptEncoding)
+{
+    if(acceptEncoding == nullptr)
+    {
+        // without the header any coding is acceptable
+        return true;
+    }
+
+    // -1 not listed, 0 refused, 1 accepted
+    int gzip = -1;
+    int any = -1;
+    const char* pos = acceptEncoding;
+
+    while(*pos != '\0')
+    {
+        while(*pos == ' ' || *pos == '\t' || *pos == ',')
+        {
+            ++pos;
+        }
+        if(*pos == '\0')
+        {
+            break;
+        }
+
+        const char* name = pos;
+        while(*pos != '\0' && *pos != ',' && *pos != ';' && *pos != ' ' && *pos != '\t')
+        {
+            ++pos;
+        }
+        const size_t nameLength = pos - name;
+
+        bool accepted = true;
+        while(*pos != '\0' && *pos != ',')
+        {
+            if(*pos != ';')
+            {
+                ++pos;
+                continue;
+            }
+            ++pos;
+            while(*pos == ' ' || *pos == '\t')
+            {
+                ++pos;
+            }
+            if((*pos == 'q' || *pos == 'Q') && pos[1] == '=')
+            {
+                // only a qvalue of zero ("0", "0.", "0.000") refuses the coding
+                pos += 2;
+                while(*pos == '0' || *pos == '.')
+                {
+                    ++pos;
+                }
+                accepted = *pos >= '1' && *pos <= '9';
+            }
+        }
+
+        if((nameLength == 4 && strncasecmp(name, "gzip", 4) == 0) || (nameLength == 6 && strncasecmp(name, "x-gzip", 6) == 0))
+        {
+            gzip = accepted ? 1 : 0;
+        }
+        else if(nameLength == 1 && *name == '*')
+        {
+            any = accepted ? 1 : 0;
+        }
+    }
+
+    return gzip >= 0 ? gzip == 1 : any == 1;
+}
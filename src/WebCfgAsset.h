@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Static file of the web configuration, generated into WebCfgServerConstants.h by resources/web_assets.py
+struct WebCfgAsset
+{
+    const char* contentType;
+    const char* cacheControl;
+    const uint8_t* data;
+    size_t length;
+    const char* etag; // strong entity tag of data, including the quotes
+    bool gzip;        // data is sent with Content-Encoding: gzip
+};
+
+// Evaluates an If-None-Match header against etag (RFC 9110, 13.1.2). Returns true if the
+// header is "*" or lists a matching tag, compared weakly as the RFC requires for this header.
+bool webCfgAssetNotModified(const char* ifNoneMatch, const char* etag);
+
+// Evaluates an Accept-Encoding header (RFC 9110, 12.5.3). Returns true if gzip, or "*" without an
+// entry for gzip, is listed with a non-zero qvalue, or if there is no header at all.
+bool webCfgAssetAcceptsGzip(const char* acceptEncoding);
@@ -93,40 +93,41 @@ WebCfgServer::WebCfgServer(NukiNetwork* network, Preferences* preferences, bool
 
 bool WebCfgServer::isAuthenticated(PsychicRequest *request, int type)
 {
-    String cookieKey = "sessionId";
+    const char* cookieKey = "sessionId";
+    SessionStore* sessions = &_httpSessions;
 
     if (type == 1)
     {
         cookieKey = "duoId";
+        sessions = &_importExport->_duoSessions;
     }
     else if (type == 2)
     {
         cookieKey = "totpId";
+        sessions = &_importExport->_totpSessions;
     }
     else if (type == 3)
     {
         cookieKey = "bypassId";
+        sessions = &_importExport->_bypassSessions;
     }
 
-    if (request->hasCookie(cookieKey.c_str()))
+    // runs for every request, keep it free of allocations
+    char cookie[SESSION_ID_LENGTH + 1];
+    size_t size = sizeof(cookie);
+
+    if (request->getCookie(cookieKey, cookie, &size) == ESP_OK)
     {
-        String cookie = request->getCookie(cookieKey.c_str());
+        struct timeval time;
+        gettimeofday(&time, NULL);
+        int64_t time_us = (int64_t)time.tv_sec * 1000000L + (int64_t)time.tv_usec;
 
-        if ((type == 0 && _httpSessions[cookie].is<JsonVariant>()) || (type == 1 && _importExport->_duoSessions[cookie].is<JsonVariant>()) || (type == 2 && _importExport->_totpSessions[cookie].is<JsonVariant>()) || (type == 3 && _importExport->_bypassSessions[cookie].is<JsonVariant>()))
+        if (sessions->valid(cookie, time_us))
         {
-            struct timeval time;
-            gettimeofday(&time, NULL);
-            int64_t time_us = (int64_t)time.tv_sec * 1000000L + (int64_t)time.tv_usec;
-
-            if ((type == 0 && _httpSessions[cookie].as<signed long long>() > time_us) || (type == 1 && _importExport->_duoSessions[cookie].as<signed long long>() > time_us) || (type == 2 && _importExport->_totpSessions[cookie].as<signed long long>() > time_us) || (type == 3 && _importExport->_bypassSessions[cookie].as<signed long long>() > time_us))
-            {
-                return true;
-            }
-            else
-            {
-                Log->println("Cookie found, but not valid anymore");
-            }
+            return true;
         }
+
+        Log->println("Cookie found, but not valid anymore");
     }
     return false;
 }
@@ -147,8 +148,7 @@ esp_err_t WebCfgServer::logoutSession(PsychicRequest *request, PsychicResponse*
     if (request->hasCookie("sessionId"))
     {
         String cookie = request->getCookie("sessionId");
-        _httpSessions.remove(cookie);
-        saveSessions();
+        _httpSessions.remove(cookie.c_str());
     }
     else
     {
@@ -168,8 +168,7 @@ esp_err_t WebCfgServer::logoutSession(PsychicRequest *request, PsychicResponse*
 
         if (request->hasCookie("duoId")) {
             String cookie2 = request->getCookie("duoId");
-            _importExport->_duoSessions.remove(cookie2);
-            saveSessions(1);
+            _importExport->_duoSessions.remove(cookie2.c_str());
         }
         else
         {
@@ -190,8 +189,7 @@ esp_err_t WebCfgServer::logoutSession(PsychicRequest *request, PsychicResponse*
 
         if (request->hasCookie("totpId")) {
             String cookie2 = request->getCookie("totpId");
-            _importExport->_totpSessions.remove(cookie2);
-            saveSessions(2);
+            _importExport->_totpSessions.remove(cookie2.c_str());
         }
         else
         {
@@ -212,7 +210,7 @@ esp_err_t WebCfgServer::logoutSession(PsychicRequest *request, PsychicResponse*
 
         if (request->hasCookie("bypassId")) {
             String cookie2 = request->getCookie("bypassId");
-            _importExport->_bypassSessions.remove(cookie2);
+            _importExport->_bypassSessions.remove(cookie2.c_str());
         }
     }
 
@@ -229,24 +227,18 @@ void WebCfgServer::saveSessions(int type)
         }
         else
         {
-            File file;
-
             if (type == 0)
             {
-                file = SPIFFS.open("/sessions.json", "w");
-                serializeJson(_httpSessions, file);
+                writeSessionFile("/sessions.json", _httpSessions);
             }
             else if (type == 1)
             {
-                file = SPIFFS.open("/duosessions.json", "w");
-                serializeJson(_importExport->_duoSessions, file);
+                writeSessionFile("/duosessions.json", _importExport->_duoSessions);
             }
             else if (type == 2)
             {
-                file = SPIFFS.open("/totpsessions.json", "w");
-                serializeJson(_importExport->_totpSessions, file);
+                writeSessionFile("/totpsessions.json", _importExport->_totpSessions);
             }
-            file.close();
         }
     }
 }
@@ -261,49 +253,78 @@ void WebCfgServer::loadSessions(int type)
         }
         else
         {
-            File file;
-
             if (type == 0)
             {
-                file = SPIFFS.open("/sessions.json", "r");
-
-                if (!file || file.isDirectory()) {
-                    Log->println("sessions.json not found");
-                }
-                else
-                {
-                    deserializeJson(_httpSessions, file);
-                }
+                readSessionFile("/sessions.json", _httpSessions);
             }
             else if (type == 1)
             {
-                file = SPIFFS.open("/duosessions.json", "r");
-
-                if (!file || file.isDirectory()) {
-                    Log->println("duosessions.json not found");
-                }
-                else
-                {
-                    deserializeJson(_importExport->_duoSessions, file);
-                }
+                readSessionFile("/duosessions.json", _importExport->_duoSessions);
             }
             else if (type == 2)
             {
-                file = SPIFFS.open("/totpsessions.json", "r");
-
-                if (!file || file.isDirectory()) {
-                    Log->println("totpsessions.json not found");
-                }
-                else
-                {
-                    deserializeJson(_importExport->_totpSessions, file);
-                }
+                readSessionFile("/totpsessions.json", _importExport->_totpSessions);
             }
-            file.close();
         }
     }
 }
 
+void WebCfgServer::writeSessionFile(const char* path, SessionStore& sessions)
+{
+    JsonDocument json;
+    sessions.toJson(json);
+
+    // write a complete new file first, so a reset while writing doesn't lose the sessions
+    String tmpPath = String(path) + ".tmp";
+    File file = SPIFFS.open(tmpPath, "w");
+
+    if (!file)
+    {
+        Log->print("Failed to write ");
+        Log->println(path);
+        return;
+    }
+
+    serializeJson(json, file);
+    file.close();
+
+    SPIFFS.remove(path);
+    if (!SPIFFS.rename(tmpPath, path))
+    {
+        Log->print("Failed to rename ");
+        Log->println(tmpPath);
+    }
+}
+
+void WebCfgServer::readSessionFile(const char* path, SessionStore& sessions)
+{
+    String tmpPath = String(path) + ".tmp";
+
+    // a reset between removing the old and renaming the new file leaves only the new one
+    if (!SPIFFS.exists(path) && SPIFFS.exists(tmpPath))
+    {
+        SPIFFS.rename(tmpPath, path);
+    }
+
+    File file = SPIFFS.open(path, "r");
+
+    if (!file || file.isDirectory()) {
+        Log->print(path + 1);
+        Log->println(" not found");
+    }
+    else
+    {
+        JsonDocument json;
+        struct timeval time;
+        gettimeofday(&time, NULL);
+        int64_t time_us = (int64_t)time.tv_sec * 1000000L + (int64_t)time.tv_usec;
+
+        deserializeJson(json, file);
+        sessions.fromJson(json, time_us);
+    }
+    file.close();
+}
+
 void WebCfgServer::clearSessions()
 {
     if (!SPIFFS.begin(true))
@@ -315,17 +336,36 @@ void WebCfgServer::clearSessions()
         _httpSessions.clear();
         _importExport->_duoSessions.clear();
         _importExport->_totpSessions.clear();
-        File file;
-        file = SPIFFS.open("/sessions.json", "w");
-        serializeJson(_httpSessions, file);
-        file.close();
-        file = SPIFFS.open("/duosessions.json", "w");
-        serializeJson(_importExport->_duoSessions, file);
-        file.close();
-        file = SPIFFS.open("/totpsessions.json", "w");
-        serializeJson(_importExport->_totpSessions, file);
-        file.close();
+        writeSessionFile("/sessions.json", _httpSessions);
+        writeSessionFile("/duosessions.json", _importExport->_duoSessions);
+        writeSessionFile("/totpsessions.json", _importExport->_totpSessions);
+    }
+}
+
+void WebCfgServer::update()
+{
+    // logins and logouts only mark the sessions dirty, write them out at most once per interval
+    if(espMillis() - _sessionsPersistTs >= SESSION_PERSIST_INTERVAL)
+    {
+        _sessionsPersistTs = espMillis();
+
+        if(_httpSessions.dirty())
+        {
+            saveSessions();
+        }
+        if(_importExport->_duoSessions.dirty())
+        {
+            saveSessions(1);
+        }
+        if(_importExport->_totpSessions.dirty())
+        {
+            saveSessions(2);
+        }
     }
+
+#ifndef NUKI_HUB_UPDATER
+    sendStatusEvents();
+#endif
 }
 
 int WebCfgServer::doAuthentication(PsychicRequest *request)
@@ -418,12 +458,18 @@ void WebCfgServer::initialize()
 
     _psychicServer->on("/style.css", HTTP_GET, [&](PsychicRequest *request, PsychicResponse* resp)
     {
-        return sendCss(request, resp);
+        return sendAsset(request, resp, stylecss);
     });
     _psychicServer->on("/favicon.ico", HTTP_GET, [&](PsychicRequest *request, PsychicResponse* resp)
     {
-        return sendFavicon(request, resp);
+        return sendAsset(request, resp, favicon);
     });
+#ifndef NUKI_HUB_UPDATER
+    _psychicServer->on("/status.js", HTTP_GET, [&](PsychicRequest *request, PsychicResponse* resp)
+    {
+        return sendAsset(request, resp, statusjs);
+    });
+#endif
 
     if(_network->isApOpen())
     {
@@ -521,6 +567,90 @@ void WebCfgServer::initialize()
     }
     else
     {
+#ifndef NUKI_HUB_UPDATER
+        _statusEvents.onOpen([&](PsychicEventSourceClient* client)
+        {
+            JsonDocument json;
+            String jsonStr;
+            addStatusFields(json, readStatus());
+
+            if(_preferences->getBool(preference_check_updates))
+            {
+                json["latestFirmware"] = _preferences->getString(preference_latest_version);
+            }
+
+            serializeJson(json, jsonStr);
+            client->send(jsonStr.c_str(), "status");
+            ++_statusEventClients;
+        });
+        _statusEvents.onClose([&](PsychicEventSourceClient* client)
+        {
+            --_statusEventClients;
+        });
+        _psychicServer->on("/events", &_statusEvents)->addFilter([&](PsychicRequest *request)
+        {
+            return doAuthentication(request) == 4;
+        });
+        // JSON API, streamed from the same state and settings table as the HTML pages
+        _psychicServer->on("/api/v1/status", HTTP_GET, [&](PsychicRequest *request, PsychicResponse* resp)
+        {
+            int authReq = doAuthentication(request);
+            if(authReq != 4)
+            {
+                return sendApiUnauthorized(request, resp, authReq);
+            }
+            return buildApiStatus(request, resp);
+        });
+        _psychicServer->on("/api/v1/lock", HTTP_GET, [&](PsychicRequest *request, PsychicResponse* resp)
+        {
+            int authReq = doAuthentication(request);
+            if(authReq != 4)
+            {
+                return sendApiUnauthorized(request, resp, authReq);
+            }
+            return buildApiLock(request, resp);
+        });
+        _psychicServer->on("/api/v1/opener", HTTP_GET, [&](PsychicRequest *request, PsychicResponse* resp)
+        {
+            int authReq = doAuthentication(request);
+            if(authReq != 4)
+            {
+                return sendApiUnauthorized(request, resp, authReq);
+            }
+            return buildApiOpener(request, resp);
+        });
+        _psychicServer->on("/api/v1/config", HTTP_GET, [&](PsychicRequest *request, PsychicResponse* resp)
+        {
+            int authReq = doAuthentication(request);
+            if(authReq != 4)
+            {
+                return sendApiUnauthorized(request, resp, authReq);
+            }
+            return buildApiConfig(request, resp);
+        });
+        _psychicServer->on("/api/v1/config", HTTP_PATCH, [&](PsychicRequest *request, PsychicResponse* resp)
+        {
+            int authReq = doAuthentication(request);
+            if(authReq != 4)
+            {
+                return sendApiUnauthorized(request, resp, authReq);
+            }
+            if(!approveApiChange(request))
+            {
+                return sendApiError(resp, 403, "MFA approval required, send a TOTP code as totpkey or approve on the Duo/TOTP page first");
+            }
+            return processApiConfig(request, resp);
+        });
+        _psychicServer->on("/api/v1/gpio", HTTP_GET, [&](PsychicRequest *request, PsychicResponse* resp)
+        {
+            int authReq = doAuthentication(request);
+            if(authReq != 4)
+            {
+                return sendApiUnauthorized(request, resp, authReq);
+            }
+            return buildApiGpio(request, resp);
+        });
+#endif
         _psychicServer->on("/get", HTTP_GET, [&](PsychicRequest *request, PsychicResponse* resp)
         {
             String value = "";
@@ -1915,22 +2045,35 @@ esp_err_t WebCfgServer::buildConfirmHtml(PsychicRequest *request, PsychicRespons
     return response.endSend();
 }
 
-esp_err_t WebCfgServer::sendCss(PsychicRequest* request, PsychicResponse* resp)
+esp_err_t WebCfgServer::sendAsset(PsychicRequest* request, PsychicResponse* resp, const WebCfgAsset& asset)
 {
-    // escaped by https://www.cescaper.com/
-    resp->addHeader("Cache-Control", "public, max-age=3600");
-    resp->setCode(200);
-    resp->setContentType("text/css");
-    resp->setContent(stylecss);
-    return resp->send();
-}
+    resp->addHeader("Cache-Control", asset.cacheControl);
+    resp->addHeader("ETag", asset.etag);
+
+    if(asset.gzip)
+    {
+        // only the compressed copy is in flash, clients that can't decode it get 406
+        resp->addHeader("Vary", "Accept-Encoding");
+        if(!webCfgAssetAcceptsGzip(request->hasHeader("Accept-Encoding") ? request->header("Accept-Encoding").c_str() : nullptr))
+        {
+            resp->setCode(406);
+            return resp->send();
+        }
+    }
+
+    if(request->hasHeader("If-None-Match") && webCfgAssetNotModified(request->header("If-None-Match").c_str(), asset.etag))
+    {
+        resp->setCode(304);
+        return resp->send();
+    }
 
-esp_err_t WebCfgServer::sendFavicon(PsychicRequest* request, PsychicResponse* resp)
-{
-    resp->addHeader("Cache-Control", "public, max-age=604800");
     resp->setCode(200);
-    resp->setContentType("image/png");
-    resp->setContent((const uint8_t *)favicon_32x32, sizeof(favicon_32x32));
+    resp->setContentType(asset.contentType);
+    if(asset.gzip)
+    {
+        resp->addHeader("Content-Encoding", "gzip");
+    }
+    resp->setContent(asset.data, asset.length);
     return resp->send();
 }
 
@@ -2291,8 +2434,7 @@ bool WebCfgServer::processLogin(PsychicRequest *request, PsychicResponse* resp)
                 struct timeval time;
                 gettimeofday(&time, NULL);
                 int64_t time_us = (int64_t)time.tv_sec * 1000000L + (int64_t)time.tv_usec;
-                _httpSessions[buffer] = time_us + (durationLength*1000000L);
-                saveSessions();
+                _httpSessions.add(buffer, time_us + (durationLength*1000000L), time_us);
 
                 _importExport->_sessionsOpts[request->client()->localIP().toString() + "totp"] = request->hasParam("totp");
 
@@ -2331,7 +2473,7 @@ bool WebCfgServer::processBypass(PsychicRequest *request, PsychicResponse* resp)
                 struct timeval time;
                 gettimeofday(&time, NULL);
                 int64_t time_us = (int64_t)time.tv_sec * 1000000L + (int64_t)time.tv_usec;
-                _importExport->_bypassSessions[buffer] = time_us + ((int64_t)3600*1000000L);
+                _importExport->_bypassSessions.add(buffer, time_us + ((int64_t)3600*1000000L), time_us);
 
                 char randomstr2[33];
                 randomSeed(analogRead(0));
@@ -2383,8 +2525,7 @@ bool WebCfgServer::processTOTP(PsychicRequest *request, PsychicResponse* resp)
                 struct timeval time;
                 gettimeofday(&time, NULL);
                 int64_t time_us = (int64_t)time.tv_sec * 1000000L + (int64_t)time.tv_usec;
-                _importExport->_totpSessions[buffer] = time_us + (durationLength*1000000L);
-                saveSessions(2);
+                _importExport->_totpSessions.add(buffer, time_us + (durationLength*1000000L), time_us);
                 return true;
             }
         }
@@ -2478,6 +2619,8 @@ bool WebCfgServer::processArgs(PsychicRequest *request, PsychicResponse* resp, S
     uint32_t basicOpenerConfigAclPrefs[14] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
     uint32_t advancedLockConfigAclPrefs[25] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
     uint32_t advancedOpenerConfigAclPrefs[21] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    // indexed by WebCfgAclGroup
+    uint32_t* aclGroups[] = {aclPrefs, basicLockConfigAclPrefs, advancedLockConfigAclPrefs, basicOpenerConfigAclPrefs, advancedOpenerConfigAclPrefs};
 
     int params = request->params();
 
@@ -2499,24 +2642,22 @@ bool WebCfgServer::processArgs(PsychicRequest *request, PsychicResponse* resp, S
             }
         }
 
-        if(key == "MQTTSERVER")
+        const WebCfgSetting* setting = _settings.find(key.c_str());
+
+        if(setting != nullptr)
         {
-            if(_preferences->getString(preference_mqtt_broker, "") != value)
+            if(setting->type == WebCfgSettingType::Acl)
             {
-                _preferences->putString(preference_mqtt_broker, value);
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
+                aclGroups[(uint8_t)setting->aclGroup][setting->aclIndex] = ((value == "1") ? 1 : 0);
             }
-        }
-        else if(key == "MQTTPORT")
-        {
-            if(_preferences->getInt(preference_mqtt_broker_port, 0) !=  value.toInt())
+            else if(_settings.apply(*setting, _preferences, value))
             {
-                _preferences->putInt(preference_mqtt_broker_port,  value.toInt());
                 Log->print("Setting changed: ");
                 Log->println(key);
-                configChanged = true;
+                configChanged = configChanged || (setting->flags & WEBCFG_CONFIG_CHANGED) != 0;
+                networkReconfigure = networkReconfigure || (setting->flags & WEBCFG_NETWORK_RECONFIGURE) != 0;
+                clearSession = clearSession || (setting->flags & WEBCFG_CLEAR_SESSION) != 0;
+                newMFA = newMFA || (setting->flags & WEBCFG_NEW_MFA) != 0;
             }
         }
         else if(key == "MQTTUSER")
@@ -2536,29 +2677,6 @@ bool WebCfgServer::processArgs(PsychicRequest *request, PsychicResponse* resp, S
                 }
             }
         }
-        else if(key == "MQTTPASS")
-        {
-            if(value != "*")
-            {
-                if(_preferences->getString(preference_mqtt_password, "") != value)
-                {
-                    _preferences->putString(preference_mqtt_password, value);
-                    Log->print("Setting changed: ");
-                    Log->println(key);
-                    configChanged = true;
-                }
-            }
-        }
-        else if(key == "MQTTPATH")
-        {
-            if(_preferences->getString(preference_mqtt_lock_path, "") != value)
-            {
-                _preferences->putString(preference_mqtt_lock_path, value);
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
         else if(key == "MQTTCA")
         {
             if (!SPIFFS.begin(true)) {
@@ -2748,26 +2866,6 @@ bool WebCfgServer::processArgs(PsychicRequest *request, PsychicResponse* resp, S
             configChanged = true;        
         }
         #endif
-        else if(key == "UPTIME")
-        {
-            if(_preferences->getBool(preference_update_time, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_update_time, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "TIMESRV")
-        {
-            if(_preferences->getString(preference_time_server, "pool.ntp.org") != value)
-            {
-                _preferences->putString(preference_time_server, value);
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
         else if(key == "NWHW")
         {
             if(_preferences->getInt(preference_network_hardware, 0) != value.toInt())
@@ -2786,1566 +2884,138 @@ bool WebCfgServer::processArgs(PsychicRequest *request, PsychicResponse* resp, S
                 configChanged = true;
             }
         }
-        else if(key == "NWCUSTPHY")
-        {
-            if(_preferences->getInt(preference_network_custom_phy, 0) != value.toInt())
-            {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_phy, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "NWCUSTADDR")
+        else if(key == "DUOENA")
         {
-            if(_preferences->getInt(preference_network_custom_addr, -1) != value.toInt())
+            if(_preferences->getBool(preference_cred_duo_enabled, false) != (value == "1"))
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_addr, value.toInt());
+                _preferences->putBool(preference_cred_duo_enabled, (value == "1"));
+                if (value == "1") {
+                    _preferences->putBool(preference_update_time, true);
+                }
                 Log->print("Setting changed: ");
                 Log->println(key);
                 configChanged = true;
+                clearSession = true;
+                newMFA = true;
             }
         }
-        else if(key == "NWCUSTIRQ")
+        else if(key == "HADEVDISC")
         {
-            if(_preferences->getInt(preference_network_custom_irq, 0) != value.toInt())
+            if(_preferences->getBool(preference_hass_device_discovery, false) != (value == "1"))
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_irq, value.toInt());
+                _network->disableHASS();
+                _preferences->putBool(preference_hass_device_discovery, (value == "1"));
                 Log->print("Setting changed: ");
                 Log->println(key);
                 configChanged = true;
             }
         }
-        else if(key == "NWCUSTRST")
+        else if(key == "ENHADISC")
         {
-            if(_preferences->getInt(preference_network_custom_rst, 0) != value.toInt())
+            if(_preferences->getBool(preference_mqtt_hass_enabled, false) != (value == "1"))
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_rst, value.toInt());
+                _network->disableHASS();
+                _preferences->putBool(preference_mqtt_hass_enabled, (value == "1"));
                 Log->print("Setting changed: ");
                 Log->println(key);
                 configChanged = true;
             }
         }
-        else if(key == "NWCUSTCS")
+        else if(key == "HASSDISCOVERY")
         {
-            if(_preferences->getInt(preference_network_custom_cs, 0) != value.toInt())
+            if(_preferences->getString(preference_mqtt_hass_discovery, "") != value)
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_cs, value.toInt());
+                _network->disableHASS();
+                _preferences->putString(preference_mqtt_hass_discovery, value);
                 Log->print("Setting changed: ");
                 Log->println(key);
                 configChanged = true;
             }
         }
-        else if(key == "NWCUSTSCK")
+        else if(key == "OFFHYBRID")
         {
-            if(_preferences->getInt(preference_network_custom_sck, 0) != value.toInt())
+            if(_preferences->getBool(preference_official_hybrid_enabled, false) != (value == "1"))
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_sck, value.toInt());
+                _preferences->putBool(preference_official_hybrid_enabled, (value == "1"));
+                if((value == "1"))
+                {
+                    _preferences->putBool(preference_register_as_app, true);
+                }
                 Log->print("Setting changed: ");
                 Log->println(key);
                 configChanged = true;
             }
         }
-        else if(key == "NWCUSTMISO")
+        else if(key == "HYBRIDACT")
         {
-            if(_preferences->getInt(preference_network_custom_miso, 0) != value.toInt())
+            if(_preferences->getBool(preference_official_hybrid_actions, false) != (value == "1"))
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_miso, value.toInt());
+                _preferences->putBool(preference_official_hybrid_actions, (value == "1"));
+                if(value == "1")
+                {
+                    _preferences->putBool(preference_register_as_app, true);
+                }
                 Log->print("Setting changed: ");
                 Log->println(key);
-                configChanged = true;
+                //configChanged = true;
             }
         }
-        else if(key == "NWCUSTMOSI")
+        else if(key == "ACLLVLCHANGED")
         {
-            if(_preferences->getInt(preference_network_custom_mosi, 0) != value.toInt())
-            {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_mosi, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
+            aclLvlChanged = true;
         }
-        else if(key == "NWCUSTPWR")
+        else if(key == "CONFNHPUB")
         {
-            if(_preferences->getInt(preference_network_custom_pwr, 0) != value.toInt())
+            if(_preferences->getBool(preference_publish_config, false) != (value == "1"))
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_pwr, value.toInt());
+                if(_preferences->getBool(preference_config_from_mqtt, false) && _preferences->getInt(preference_buffer_size, CHAR_BUFFER_SIZE) < 8192)
+                {
+                    _preferences->putInt(preference_buffer_size, 8192);
+                }
+                _preferences->putBool(preference_publish_config, (value == "1"));
                 Log->print("Setting changed: ");
                 Log->println(key);
                 configChanged = true;
             }
         }
-        else if(key == "NWCUSTMDIO")
+        else if(key == "CONFNHCTRL")
         {
-            if(_preferences->getInt(preference_network_custom_mdio, 0) != value.toInt())
+            if(_preferences->getBool(preference_config_from_mqtt, false) != (value == "1"))
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_mdio, value.toInt());
+                if(_preferences->getBool(preference_config_from_mqtt, false) && _preferences->getInt(preference_buffer_size, CHAR_BUFFER_SIZE) < 8192)
+                {
+                    _preferences->putInt(preference_buffer_size, 8192);
+                }
+                _preferences->putBool(preference_config_from_mqtt, (value == "1"));
                 Log->print("Setting changed: ");
                 Log->println(key);
                 configChanged = true;
             }
         }
-        else if(key == "NWCUSTMDC")
+        else if(key == "GEMINIENA")
         {
-            if(_preferences->getInt(preference_network_custom_mdc, 0) != value.toInt())
+            if(_preferences->getBool(preference_lock_gemini_enabled, false) != (value == "1"))
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_mdc, value.toInt());
+                _preferences->putBool(preference_lock_gemini_enabled, (value == "1"));
+                if (value == "1")
+                {
+                    _preferences->putBool(preference_register_as_app, true);
+                    _preferences->putBool(preference_lock_enabled, true);
+                    _preferences->putBool(preference_official_hybrid_enabled, true);
+                    _preferences->putBool(preference_official_hybrid_actions, true);
+                }
                 Log->print("Setting changed: ");
                 Log->println(key);
                 configChanged = true;
             }
         }
-        else if(key == "NWCUSTCLK")
+        else if(key == "CREDUSER")
         {
-            if(_preferences->getInt(preference_network_custom_clk, 0) != value.toInt())
+            if(value == "#")
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_clk, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
+                clearCredentials = true;
             }
-        }
-        else if(key == "RSSI")
-        {
-            if(_preferences->getInt(preference_rssi_publish_interval, 60) != value.toInt())
-            {
-                _preferences->putInt(preference_rssi_publish_interval, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "HTTPSFQDN")
-        {
-            if(_preferences->getString(preference_https_fqdn, "") != value)
-            {
-                _preferences->putString(preference_https_fqdn, value);
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "DUOHOST")
-        {
-            if(value != "*")
-            {
-                if(_preferences->getString(preference_cred_duo_host, "") != value)
-                {
-                    _preferences->putString(preference_cred_duo_host, value);
-                    Log->print("Setting changed: ");
-                    Log->println(key);
-                    configChanged = true;
-                    clearSession = true;
-                    newMFA = true;
-                }
-            }
-        }
-        else if(key == "DUOIKEY")
-        {
-            if(value != "*")
-            {
-                if(_preferences->getString(preference_cred_duo_ikey, "") != value)
-                {
-                    _preferences->putString(preference_cred_duo_ikey, value);
-                    Log->print("Setting changed: ");
-                    Log->println(key);
-                    configChanged = true;
-                    clearSession = true;
-                    newMFA = true;
-                }
-            }
-        }
-        else if(key == "DUOSKEY")
-        {
-            if(value != "*")
-            {
-                if(_preferences->getString(preference_cred_duo_skey, "") != value)
-                {
-                    _preferences->putString(preference_cred_duo_skey, value);
-                    Log->print("Setting changed: ");
-                    Log->println(key);
-                    configChanged = true;
-                    clearSession = true;
-                    newMFA = true;
-                }
-            }
-        }
-        else if(key == "DUOUSER")
-        {
-            if(value != "*")
-            {
-                if(_preferences->getString(preference_cred_duo_user, "") != value)
-                {
-                    _preferences->putString(preference_cred_duo_user, value);
-                    Log->print("Setting changed: ");
-                    Log->println(key);
-                    configChanged = true;
-                    clearSession = true;
-                    newMFA = true;
-                }
-            }
-        }
-        else if(key == "DUOENA")
-        {
-            if(_preferences->getBool(preference_cred_duo_enabled, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_cred_duo_enabled, (value == "1"));
-                if (value == "1") {
-                    _preferences->putBool(preference_update_time, true);
-                }
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-                clearSession = true;
-                newMFA = true;
-            }
-        }
-        else if(key == "DUOBYPASS")
-        {
-            if(_preferences->getBool(preference_cred_bypass_boot_btn_enabled, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_cred_bypass_boot_btn_enabled, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "DUOBYPASSHIGH")
-        {
-            if(_preferences->getInt(preference_cred_bypass_gpio_high, -1) != value.toInt())
-            {
-                _preferences->putInt(preference_cred_bypass_gpio_high, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "DUOBYPASSLOW")
-        {
-            if(_preferences->getInt(preference_cred_bypass_gpio_low, -1) != value.toInt())
-            {
-                _preferences->putInt(preference_cred_bypass_gpio_low, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "DUOAPPROVAL")
-        {
-            if(_preferences->getBool(preference_cred_duo_approval, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_cred_duo_approval, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "CREDLFTM")
-        {
-            if(_preferences->getInt(preference_cred_session_lifetime, 3600) != value.toInt())
-            {
-                _preferences->putInt(preference_cred_session_lifetime, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-                clearSession = true;
-            }
-        }
-        else if(key == "CREDLFTMRMBR")
-        {
-            if(_preferences->getInt(preference_cred_session_lifetime_remember, 720) != value.toInt())
-            {
-                _preferences->putInt(preference_cred_session_lifetime_remember, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-                clearSession = true;
-            }
-        }
-        else if(key == "CREDDUOLFTM")
-        {
-            if(_preferences->getInt(preference_cred_session_lifetime_duo, 3600) != value.toInt())
-            {
-                _preferences->putInt(preference_cred_session_lifetime_duo, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-                clearSession = true;
-            }
-        }
-        else if(key == "CREDDUOLFTMRMBR")
-        {
-            if(_preferences->getInt(preference_cred_session_lifetime_duo_remember, 720) != value.toInt())
-            {
-                _preferences->putInt(preference_cred_session_lifetime_duo_remember, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-                clearSession = true;
-            }
-        }
-        else if(key == "CREDTOTPLFTM")
-        {
-            if(_preferences->getInt(preference_cred_session_lifetime_totp, 3600) != value.toInt())
-            {
-                _preferences->putInt(preference_cred_session_lifetime_totp, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-                clearSession = true;
-            }
-        }
-        else if(key == "CREDTOTPLFTMRMBR")
-        {
-            if(_preferences->getInt(preference_cred_session_lifetime_totp_remember, 720) != value.toInt())
-            {
-                _preferences->putInt(preference_cred_session_lifetime_totp_remember, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-                clearSession = true;
-            }
-        }
-        else if(key == "HADEVDISC")
-        {
-            if(_preferences->getBool(preference_hass_device_discovery, false) != (value == "1"))
-            {
-                _network->disableHASS();
-                _preferences->putBool(preference_hass_device_discovery, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "ENHADISC")
-        {
-            if(_preferences->getBool(preference_mqtt_hass_enabled, false) != (value == "1"))
-            {
-                _network->disableHASS();
-                _preferences->putBool(preference_mqtt_hass_enabled, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "HASSDISCOVERY")
-        {
-            if(_preferences->getString(preference_mqtt_hass_discovery, "") != value)
-            {
-                _network->disableHASS();
-                _preferences->putString(preference_mqtt_hass_discovery, value);
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "OPENERCONT")
-        {
-            if(_preferences->getBool(preference_opener_continuous_mode, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_opener_continuous_mode, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "HASSCUURL")
-        {
-            if(_preferences->getString(preference_mqtt_hass_cu_url, "") != value)
-            {
-                _preferences->putString(preference_mqtt_hass_cu_url, value);
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "HOSTNAME")
-        {
-            if(_preferences->getString(preference_hostname, "") != value)
-            {
-                _preferences->putString(preference_hostname, value);
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "NETTIMEOUT")
-        {
-            if(_preferences->getInt(preference_network_timeout, 60) != value.toInt())
-            {
-                _preferences->putInt(preference_network_timeout, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "FINDBESTRSSI")
-        {
-            if(_preferences->getBool(preference_find_best_rssi, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_find_best_rssi, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "RSTDISC")
-        {
-            if(_preferences->getBool(preference_restart_on_disconnect, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_restart_on_disconnect, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "MQTTLOG")
-        {
-            if(_preferences->getBool(preference_mqtt_log_enabled, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_mqtt_log_enabled, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "MQTTSENA")
-        {
-            if(_preferences->getBool(preference_mqtt_ssl_enabled, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_mqtt_ssl_enabled, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "WEBLOG")
-        {
-            if(_preferences->getBool(preference_webserial_enabled, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_webserial_enabled, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "CHECKUPDATE")
-        {
-            if(_preferences->getBool(preference_check_updates, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_check_updates, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "UPDATEMQTT")
-        {
-            if(_preferences->getBool(preference_update_from_mqtt, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_update_from_mqtt, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "OFFHYBRID")
-        {
-            if(_preferences->getBool(preference_official_hybrid_enabled, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_official_hybrid_enabled, (value == "1"));
-                if((value == "1"))
-                {
-                    _preferences->putBool(preference_register_as_app, true);
-                }
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "HYBRIDACT")
-        {
-            if(_preferences->getBool(preference_official_hybrid_actions, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_official_hybrid_actions, (value == "1"));
-                if(value == "1")
-                {
-                    _preferences->putBool(preference_register_as_app, true);
-                }
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "HYBRIDTIMER")
-        {
-            if(_preferences->getInt(preference_query_interval_hybrid_lockstate, 600) != value.toInt())
-            {
-                _preferences->putInt(preference_query_interval_hybrid_lockstate, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "HYBRIDRETRY")
-        {
-            if(_preferences->getBool(preference_official_hybrid_retry, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_official_hybrid_retry, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "HYBRIDREBOOT")
-        {
-            if(_preferences->getBool(preference_hybrid_reboot_on_disconnect, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_hybrid_reboot_on_disconnect, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "DISNONJSON")
-        {
-            if(_preferences->getBool(preference_disable_non_json, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_disable_non_json, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "DHCPENA")
-        {
-            if(_preferences->getBool(preference_ip_dhcp_enabled, true) != (value == "1"))
-            {
-                _preferences->putBool(preference_ip_dhcp_enabled, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "IPADDR")
-        {
-            if(_preferences->getString(preference_ip_address, "") != value)
-            {
-                _preferences->putString(preference_ip_address, value);
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "IPSUB")
-        {
-            if(_preferences->getString(preference_ip_subnet, "") != value)
-            {
-                _preferences->putString(preference_ip_subnet, value);
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "IPGTW")
-        {
-            if(_preferences->getString(preference_ip_gateway, "") != value)
-            {
-                _preferences->putString(preference_ip_gateway, value);
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "DNSSRV")
-        {
-            if(_preferences->getString(preference_ip_dns_server, "") != value)
-            {
-                _preferences->putString(preference_ip_dns_server, value);
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "LSTINT")
-        {
-            if(_preferences->getInt(preference_query_interval_lockstate, 1800) != value.toInt())
-            {
-                _preferences->putInt(preference_query_interval_lockstate, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "CFGINT")
-        {
-            if(_preferences->getInt(preference_query_interval_configuration, 3600) != value.toInt())
-            {
-                _preferences->putInt(preference_query_interval_configuration, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "BATINT")
-        {
-            if(_preferences->getInt(preference_query_interval_battery, 1800) != value.toInt())
-            {
-                _preferences->putInt(preference_query_interval_battery, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "KPINT")
-        {
-            if(_preferences->getInt(preference_query_interval_keypad, 1800) != value.toInt())
-            {
-                _preferences->putInt(preference_query_interval_keypad, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "NRTRY")
-        {
-            if(_preferences->getInt(preference_command_nr_of_retries, 3) != value.toInt())
-            {
-                _preferences->putInt(preference_command_nr_of_retries, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "TRYDLY")
-        {
-            if(_preferences->getInt(preference_command_retry_delay, 100) != value.toInt())
-            {
-                _preferences->putInt(preference_command_retry_delay, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "TXPWR")
-        {
-            #if defined(CONFIG_IDF_TARGET_ESP32)
-            if(value.toInt() >= -12 && value.toInt() <= 9)
-            #else
-            if(value.toInt() >= -12 && value.toInt() <= 20)
-            #endif
-            {
-                if(_preferences->getInt(preference_ble_tx_power, 9) != value.toInt())
-                {
-                    _preferences->putInt(preference_ble_tx_power, value.toInt());
-                    Log->print("Setting changed: ");
-                    Log->println(key);
-                    //configChanged = true;
-                }
-            }
-        }
-        else if(key == "RSBC")
-        {
-            if(_preferences->getInt(preference_restart_ble_beacon_lost, 60) != value.toInt())
-            {
-                _preferences->putInt(preference_restart_ble_beacon_lost, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "TSKNTWK")
-        {
-            if(value.toInt() > 12287 && value.toInt() < 65537)
-            {
-                if(_preferences->getInt(preference_task_size_network, NETWORK_TASK_SIZE) != value.toInt())
-                {
-                    _preferences->putInt(preference_task_size_network, value.toInt());
-                    Log->print("Setting changed: ");
-                    Log->println(key);
-                    configChanged = true;
-                }
-            }
-        }
-        else if(key == "TSKNUKI")
-        {
-            if(value.toInt() > 8191 && value.toInt() < 65537)
-            {
-                if(_preferences->getInt(preference_task_size_nuki, NUKI_TASK_SIZE) != value.toInt())
-                {
-                    _preferences->putInt(preference_task_size_nuki, value.toInt());
-                    Log->print("Setting changed: ");
-                    Log->println(key);
-                    configChanged = true;
-                }
-            }
-        }
-        else if(key == "ALMAX")
-        {
-            if(value.toInt() > 0 && value.toInt() < 101)
-            {
-                if(_preferences->getInt(preference_authlog_max_entries, MAX_AUTHLOG) != value.toInt())
-                {
-                    _preferences->putInt(preference_authlog_max_entries, value.toInt());
-                    Log->print("Setting changed: ");
-                    Log->println(key);
-                    //configChanged = true;
-                }
-            }
-        }
-        else if(key == "KPMAX")
-        {
-            if(value.toInt() > 0 && value.toInt() < 201)
-            {
-                if(_preferences->getInt(preference_keypad_max_entries, MAX_KEYPAD) != value.toInt())
-                {
-                    _preferences->putInt(preference_keypad_max_entries, value.toInt());
-                    Log->print("Setting changed: ");
-                    Log->println(key);
-                    //configChanged = true;
-                }
-            }
-        }
-        else if(key == "TCMAX")
-        {
-            if(value.toInt() > 0 && value.toInt() < 101)
-            {
-                if(_preferences->getInt(preference_timecontrol_max_entries, MAX_TIMECONTROL) != value.toInt())
-                {
-                    _preferences->putInt(preference_timecontrol_max_entries, value.toInt());
-                    Log->print("Setting changed: ");
-                    Log->println(key);
-                    //configChanged = true;
-                }
-            }
-        }
-        else if(key == "AUTHMAX")
-        {
-            if(value.toInt() > 0 && value.toInt() < 101)
-            {
-                if(_preferences->getInt(preference_auth_max_entries, MAX_AUTH) != value.toInt())
-                {
-                    _preferences->putInt(preference_auth_max_entries, value.toInt());
-                    Log->print("Setting changed: ");
-                    Log->println(key);
-                    //configChanged = true;
-                }
-            }
-        }
-        else if(key == "BUFFSIZE")
-        {
-            if(value.toInt() > 4095 && value.toInt() < 65537)
-            {
-                if(_preferences->getInt(preference_buffer_size, CHAR_BUFFER_SIZE) != value.toInt())
-                {
-                    _preferences->putInt(preference_buffer_size, value.toInt());
-                    Log->print("Setting changed: ");
-                    Log->println(key);
-                    configChanged = true;
-                }
-            }
-        }
-        else if(key == "BTLPRST")
-        {
-            if(_preferences->getBool(preference_enable_bootloop_reset, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_enable_bootloop_reset, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "DISNTWNOCON")
-        {
-            if(_preferences->getBool(preference_disable_network_not_connected, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_disable_network_not_connected, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "OTAUPD")
-        {
-            if(_preferences->getString(preference_ota_updater_url, "") != value)
-            {
-                _preferences->putString(preference_ota_updater_url, value);
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "OTAMAIN")
-        {
-            if(_preferences->getString(preference_ota_main_url, "") != value)
-            {
-                _preferences->putString(preference_ota_main_url, value);
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "SHOWSECRETS")
-        {
-            if(_preferences->getBool(preference_show_secrets, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_show_secrets, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "DBGCONN")
-        {
-            if(_preferences->getBool(preference_debug_connect, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_debug_connect, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "DBGCOMMU")
-        {
-            if(_preferences->getBool(preference_debug_communication, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_debug_communication, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "DBGHEAP")
-        {
-            if(_preferences->getBool(preference_publish_debug_info, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_publish_debug_info, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "DBGREAD")
-        {
-            if(_preferences->getBool(preference_debug_readable_data, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_debug_readable_data, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "DBGHEX")
-        {
-            if(_preferences->getBool(preference_debug_hex_data, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_debug_hex_data, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "DBGCOMM")
-        {
-            if(_preferences->getBool(preference_debug_command, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_debug_command, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "LCKFORCEID")
-        {
-            if(_preferences->getBool(preference_lock_force_id, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_lock_force_id, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-            }
-        }
-        else if(key == "LCKFORCEKP")
-        {
-            if(_preferences->getBool(preference_lock_force_keypad, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_lock_force_keypad, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-            }
-        }
-        else if(key == "LCKFORCEDS")
-        {
-            if(_preferences->getBool(preference_lock_force_doorsensor, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_lock_force_doorsensor, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-            }
-        }
-        else if(key == "OPFORCEID")
-        {
-            if(_preferences->getBool(preference_opener_force_id, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_opener_force_id, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-            }
-        }
-        else if(key == "OPFORCEKP")
-        {
-            if(_preferences->getBool(preference_opener_force_keypad, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_opener_force_keypad, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-            }
-        }
-        else if(key == "ACLLVLCHANGED")
-        {
-            aclLvlChanged = true;
-        }
-        else if(key == "CONFPUB")
-        {
-            if(_preferences->getBool(preference_conf_info_enabled, true) != (value == "1"))
-            {
-                _preferences->putBool(preference_conf_info_enabled, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "CONFNHPUB")
-        {
-            if(_preferences->getBool(preference_publish_config, false) != (value == "1"))
-            {
-                if(_preferences->getBool(preference_config_from_mqtt, false) && _preferences->getInt(preference_buffer_size, CHAR_BUFFER_SIZE) < 8192)
-                {
-                    _preferences->putInt(preference_buffer_size, 8192);
-                }
-                _preferences->putBool(preference_publish_config, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "CONFNHCTRL")
-        {
-            if(_preferences->getBool(preference_config_from_mqtt, false) != (value == "1"))
-            {
-                if(_preferences->getBool(preference_config_from_mqtt, false) && _preferences->getInt(preference_buffer_size, CHAR_BUFFER_SIZE) < 8192)
-                {
-                    _preferences->putInt(preference_buffer_size, 8192);
-                }
-                _preferences->putBool(preference_config_from_mqtt, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "KPPUB")
-        {
-            if(_preferences->getBool(preference_keypad_info_enabled, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_keypad_info_enabled, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "KPCODE")
-        {
-            if(_preferences->getBool(preference_keypad_publish_code, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_keypad_publish_code, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "KPCHECK")
-        {
-            if(_preferences->getBool(preference_keypad_check_code_enabled, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_keypad_check_code_enabled, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "KPENA")
-        {
-            if(_preferences->getBool(preference_keypad_control_enabled, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_keypad_control_enabled, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "TCPUB")
-        {
-            if(_preferences->getBool(preference_timecontrol_info_enabled, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_timecontrol_info_enabled, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "AUTHPUB")
-        {
-            if(_preferences->getBool(preference_auth_info_enabled, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_auth_info_enabled, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "KPPER")
-        {
-            if(_preferences->getBool(preference_keypad_topic_per_entry, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_keypad_topic_per_entry, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "TCPER")
-        {
-            if(_preferences->getBool(preference_timecontrol_topic_per_entry, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_timecontrol_topic_per_entry, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "TCENA")
-        {
-            if(_preferences->getBool(preference_timecontrol_control_enabled, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_timecontrol_control_enabled, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "AUTHPER")
-        {
-            if(_preferences->getBool(preference_auth_topic_per_entry, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_auth_topic_per_entry, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "AUTHENA")
-        {
-            if(_preferences->getBool(preference_auth_control_enabled, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_auth_control_enabled, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "PUBAUTH")
-        {
-            if(_preferences->getBool(preference_publish_authdata, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_publish_authdata, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "CREDDIGEST")
-        {
-            if(_preferences->getInt(preference_http_auth_type, 0) != value.toInt())
-            {
-                _preferences->putInt(preference_http_auth_type, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-                clearSession = true;
-            }
-        }
-        else if(key == "CREDTRUSTPROXY")
-        {
-            if(value != "*")
-            {
-                if(_preferences->getString(preference_bypass_proxy, "") != value)
-                {
-                    _preferences->putString(preference_bypass_proxy, value);
-                    Log->print("Setting changed: ");
-                    Log->println(key);
-                    configChanged = true;
-                    clearSession = true;
-                }
-            }
-        }
-        else if(key == "ACLLCKLCK")
-        {
-            aclPrefs[0] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "ACLLCKUNLCK")
-        {
-            aclPrefs[1] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "ACLLCKUNLTCH")
-        {
-            aclPrefs[2] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "ACLLCKLNG")
-        {
-            aclPrefs[3] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "ACLLCKLNGU")
-        {
-            aclPrefs[4] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "ACLLCKFLLCK")
-        {
-            aclPrefs[5] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "ACLLCKFOB1")
-        {
-            aclPrefs[6] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "ACLLCKFOB2")
-        {
-            aclPrefs[7] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "ACLLCKFOB3")
-        {
-            aclPrefs[8] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "ACLOPNUNLCK")
-        {
-            aclPrefs[9] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "ACLOPNLCK")
-        {
-            aclPrefs[10] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "ACLOPNUNLTCH")
-        {
-            aclPrefs[11] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "ACLOPNUNLCKCM")
-        {
-            aclPrefs[12] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "ACLOPNLCKCM")
-        {
-            aclPrefs[13] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "ACLOPNFOB1")
-        {
-            aclPrefs[14] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "ACLOPNFOB2")
-        {
-            aclPrefs[15] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "ACLOPNFOB3")
-        {
-            aclPrefs[16] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKNAME")
-        {
-            basicLockConfigAclPrefs[0] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKLAT")
-        {
-            basicLockConfigAclPrefs[1] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKLONG")
-        {
-            basicLockConfigAclPrefs[2] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKAUNL")
-        {
-            basicLockConfigAclPrefs[3] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKPRENA")
-        {
-            basicLockConfigAclPrefs[4] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKBTENA")
-        {
-            basicLockConfigAclPrefs[5] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKLEDENA")
-        {
-            basicLockConfigAclPrefs[6] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKLEDBR")
-        {
-            basicLockConfigAclPrefs[7] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKTZOFF")
-        {
-            basicLockConfigAclPrefs[8] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKDSTM")
-        {
-            basicLockConfigAclPrefs[9] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKFOB1")
-        {
-            basicLockConfigAclPrefs[10] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKFOB2")
-        {
-            basicLockConfigAclPrefs[11] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKFOB3")
-        {
-            basicLockConfigAclPrefs[12] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKSGLLCK")
-        {
-            basicLockConfigAclPrefs[13] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKADVM")
-        {
-            basicLockConfigAclPrefs[14] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKTZID")
-        {
-            basicLockConfigAclPrefs[15] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKUPOD")
-        {
-            advancedLockConfigAclPrefs[0] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKLPOD")
-        {
-            advancedLockConfigAclPrefs[1] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKSLPOD")
-        {
-            advancedLockConfigAclPrefs[2] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKUTLTOD")
-        {
-            advancedLockConfigAclPrefs[3] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKLNGT")
-        {
-            advancedLockConfigAclPrefs[4] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKSBPA")
-        {
-            advancedLockConfigAclPrefs[5] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKDBPA")
-        {
-            advancedLockConfigAclPrefs[6] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKDC")
-        {
-            advancedLockConfigAclPrefs[7] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKBATT")
-        {
-            advancedLockConfigAclPrefs[8] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKABTD")
-        {
-            advancedLockConfigAclPrefs[9] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKUNLD")
-        {
-            advancedLockConfigAclPrefs[10] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKALT")
-        {
-            advancedLockConfigAclPrefs[11] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKAUNLD")
-        {
-            advancedLockConfigAclPrefs[12] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKNMENA")
-        {
-            advancedLockConfigAclPrefs[13] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKNMST")
-        {
-            advancedLockConfigAclPrefs[14] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKNMET")
-        {
-            advancedLockConfigAclPrefs[15] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKNMALENA")
-        {
-            advancedLockConfigAclPrefs[16] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKNMAULD")
-        {
-            advancedLockConfigAclPrefs[17] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKNMLOS")
-        {
-            advancedLockConfigAclPrefs[18] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKALENA")
-        {
-            advancedLockConfigAclPrefs[19] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKIALENA")
-        {
-            advancedLockConfigAclPrefs[20] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKAUENA")
-        {
-            advancedLockConfigAclPrefs[21] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKRBTNUKI")
-        {
-            advancedLockConfigAclPrefs[22] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKMTRSPD")
-        {
-            advancedLockConfigAclPrefs[23] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFLCKESSDNM")
-        {
-            advancedLockConfigAclPrefs[24] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNNAME")
-        {
-            basicOpenerConfigAclPrefs[0] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNLAT")
-        {
-            basicOpenerConfigAclPrefs[1] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNLONG")
-        {
-            basicOpenerConfigAclPrefs[2] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNPRENA")
-        {
-            basicOpenerConfigAclPrefs[3] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNBTENA")
-        {
-            basicOpenerConfigAclPrefs[4] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNLEDENA")
-        {
-            basicOpenerConfigAclPrefs[5] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNTZOFF")
-        {
-            basicOpenerConfigAclPrefs[6] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNDSTM")
-        {
-            basicOpenerConfigAclPrefs[7] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNFOB1")
-        {
-            basicOpenerConfigAclPrefs[8] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNFOB2")
-        {
-            basicOpenerConfigAclPrefs[9] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNFOB3")
-        {
-            basicOpenerConfigAclPrefs[10] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNOPM")
-        {
-            basicOpenerConfigAclPrefs[11] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNADVM")
-        {
-            basicOpenerConfigAclPrefs[12] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNTZID")
-        {
-            basicOpenerConfigAclPrefs[13] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNICID")
-        {
-            advancedOpenerConfigAclPrefs[0] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNBUSMS")
-        {
-            advancedOpenerConfigAclPrefs[1] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNSCDUR")
-        {
-            advancedOpenerConfigAclPrefs[2] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNESD")
-        {
-            advancedOpenerConfigAclPrefs[3] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNRESD")
-        {
-            advancedOpenerConfigAclPrefs[4] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNESDUR")
-        {
-            advancedOpenerConfigAclPrefs[5] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNDRTOAR")
-        {
-            advancedOpenerConfigAclPrefs[6] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNRTOT")
-        {
-            advancedOpenerConfigAclPrefs[7] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNDRBSUP")
-        {
-            advancedOpenerConfigAclPrefs[8] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNDRBSUPDUR")
-        {
-            advancedOpenerConfigAclPrefs[9] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNSRING")
-        {
-            advancedOpenerConfigAclPrefs[10] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNSOPN")
-        {
-            advancedOpenerConfigAclPrefs[11] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNSRTO")
-        {
-            advancedOpenerConfigAclPrefs[12] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNSCM")
-        {
-            advancedOpenerConfigAclPrefs[13] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNSCFRM")
-        {
-            advancedOpenerConfigAclPrefs[14] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNSLVL")
-        {
-            advancedOpenerConfigAclPrefs[15] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNSBPA")
-        {
-            advancedOpenerConfigAclPrefs[16] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNDBPA")
-        {
-            advancedOpenerConfigAclPrefs[17] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNBATT")
-        {
-            advancedOpenerConfigAclPrefs[18] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNABTD")
-        {
-            advancedOpenerConfigAclPrefs[19] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "CONFOPNRBTNUKI")
-        {
-            advancedOpenerConfigAclPrefs[20] = ((value == "1") ? 1 : 0);
-        }
-        else if(key == "REGAPP")
-        {
-            if(_preferences->getBool(preference_register_as_app, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_register_as_app, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "REGAPPOPN")
-        {
-            if(_preferences->getBool(preference_register_opener_as_app, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_register_opener_as_app, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                //configChanged = true;
-            }
-        }
-        else if(key == "LOCKENA")
-        {
-            if(_preferences->getBool(preference_lock_enabled, true) != (value == "1"))
-            {
-                _preferences->putBool(preference_lock_enabled, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "GEMINIENA")
-        {
-            if(_preferences->getBool(preference_lock_gemini_enabled, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_lock_gemini_enabled, (value == "1"));
-                if (value == "1")
-                {
-                    _preferences->putBool(preference_register_as_app, true);
-                    _preferences->putBool(preference_lock_enabled, true);
-                    _preferences->putBool(preference_official_hybrid_enabled, true);
-                    _preferences->putBool(preference_official_hybrid_actions, true);
-                }
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "OPENA")
-        {
-            if(_preferences->getBool(preference_opener_enabled, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_opener_enabled, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "CONNMODE")
-        {
-            if(_preferences->getBool(preference_connect_mode, true) != (value == "1"))
-            {
-                _preferences->putBool(preference_connect_mode, (value == "1"));
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if(key == "CREDUSER")
-        {
-            if(value == "#")
-            {
-                clearCredentials = true;
-            }
-            else
+            else
             {
                 if(_preferences->getString(preference_cred_user, "") != value)
                 {
@@ -4358,40 +3028,12 @@ bool WebCfgServer::processArgs(PsychicRequest *request, PsychicResponse* resp, S
             }
         }
         else if(key == "CREDPASS")
-        {
-            pass1 = value;
-        }
-        else if(key == "CREDPASSRE")
-        {
-            pass2 = value;
-        }
-        else if(key == "CREDTOTP")
-        {
-            if(value != "*")
-            {
-                if(_preferences->getString(preference_totp_secret, "") != value)
-                {
-                    _preferences->putString(preference_totp_secret, value);
-                    Log->print("Setting changed: ");
-                    Log->println(key);
-                    configChanged = true;
-                    clearSession = true;
-                    newMFA = true;
-                }
-            }
-        }
-        else if(key == "CREDBYPASS")
-        {
-            if(value != "*")
-            {
-                if(_preferences->getString(preference_bypass_secret, "") != value)
-                {
-                    _preferences->putString(preference_bypass_secret, value);
-                    Log->print("Setting changed: ");
-                    Log->println(key);
-                    configChanged = true;
-                }
-            }
+        {
+            pass1 = value;
+        }
+        else if(key == "CREDPASSRE")
+        {
+            pass2 = value;
         }
         else if(key == "CREDADMIN")
         {
@@ -4530,11 +3172,6 @@ bool WebCfgServer::processArgs(PsychicRequest *request, PsychicResponse* resp, S
         }
     }
 
-    if(networkReconfigure)
-    {
-        _preferences->putBool(preference_ntw_reconfigure, true);
-    }
-
     if(manPairLck)
     {
         Log->println("Changing lock pairing");
@@ -4689,6 +3326,26 @@ bool WebCfgServer::processArgs(PsychicRequest *request, PsychicResponse* resp, S
         }
     }
 
+    applySettingChanges(configChanged, networkReconfigure, clearSession, newMFA);
+
+    if(configChanged)
+    {
+        message = "Configuration saved, reboot required to apply";
+    }
+    else
+    {
+        message = "Configuration saved.";
+    }
+
+    return configChanged;
+}
+
+void WebCfgServer::applySettingChanges(bool configChanged, bool networkReconfigure, bool clearSession, bool newMFA)
+{
+    if(networkReconfigure)
+    {
+        _preferences->putBool(preference_ntw_reconfigure, true);
+    }
     if(clearSession)
     {
         clearSessions();
@@ -4700,13 +3357,8 @@ bool WebCfgServer::processArgs(PsychicRequest *request, PsychicResponse* resp, S
     }
     if(configChanged)
     {
-        message = "Configuration saved, reboot required to apply";
         _rebootRequired = true;
     }
-    else
-    {
-        message = "Configuration saved.";
-    }
 
     _network->readSettings();
     if(_nuki != nullptr)
@@ -4717,8 +3369,6 @@ bool WebCfgServer::processArgs(PsychicRequest *request, PsychicResponse* resp, S
     {
         _nukiOpener->readSettings();
     }
-
-    return configChanged;
 }
 
 bool WebCfgServer::processImport(PsychicRequest *request, PsychicResponse* resp, String& message)
@@ -4851,7 +3501,7 @@ esp_err_t WebCfgServer::buildCustomNetworkConfigHtml(PsychicRequest *request, Ps
 
 esp_err_t WebCfgServer::buildHtml(PsychicRequest *request, PsychicResponse* resp)
 {
-    String header = (String)"<script>let intervalId; window.onload = function() { updateInfo(); intervalId = setInterval(updateInfo, 3000); }; function updateInfo() { var request = new XMLHttpRequest(); request.open('GET', '/get?page=status', true); request.onload = () => { const obj = JSON.parse(request.responseText); if (obj.stop == 1) { clearInterval(intervalId); } for (var key of Object.keys(obj)) { if(key=='ota' && document.getElementById(key) !== null) { document.getElementById(key).innerText = \"<a href='/ota'>\" + obj[key] + \"</a>\"; } else if(document.getElementById(key) !== null) { document.getElementById(key).innerText = obj[key]; } } }; request.send(); }</script>";
+    String header = "<script src='/status.js'></script>";
     PsychicStreamResponse response(resp, "text/html");
     response.beginSend();
     buildHtmlHeader(&response, header);
@@ -5167,6 +3817,7 @@ esp_err_t WebCfgServer::buildMqttConfigHtml(PsychicRequest *request, PsychicResp
     response.print("<tr><td>Set MQTT SSL Client Key</td><td><button title=\"Set MQTT SSL Client Key\" onclick=\" window.open('/get?page=mqttkeyconfig', '_self'); return false;\">Change</button></td></tr>");
     printInputField(&response, "NETTIMEOUT", "MQTT Timeout until restart (seconds; -1 to disable)", _preferences->getInt(preference_network_timeout), 5, "");
     printCheckBox(&response, "MQTTLOG", "Enable MQTT logging", _preferences->getBool(preference_mqtt_log_enabled), "");
+    printCheckBox(&response, "MQTTJOURNAL", "Keep rolling log, ring and command result messages on flash while MQTT is disconnected", _preferences->getBool(preference_mqtt_journal_enabled), "");
     printCheckBox(&response, "UPDATEMQTT", "Allow updating using MQTT", _preferences->getBool(preference_update_from_mqtt), "");
     printCheckBox(&response, "DISNONJSON", "Disable some extraneous non-JSON topics", _preferences->getBool(preference_disable_non_json), "");
     printCheckBox(&response, "OFFHYBRID", "Enable hybrid official MQTT and Nuki Hub setup", _preferences->getBool(preference_official_hybrid_enabled), "");
@@ -5473,98 +4124,575 @@ esp_err_t WebCfgServer::buildStatusHtml(PsychicRequest *request, PsychicResponse
 {
     JsonDocument json;
     String jsonStr;
-    bool mqttDone = false;
-    bool lockDone = false;
-    bool openerDone = false;
+    const StatusState status = readStatus();
 
     json["stop"] = 0;
+    addStatusFields(json, status);
 
-    if(_network->mqttConnectionState() > 0)
+    if(_preferences->getBool(preference_check_updates))
     {
-        json["mqttState"] = "Yes";
-        mqttDone = true;
+        json["latestFirmware"] = _preferences->getString(preference_latest_version);
     }
-    else
+
+    bool lockDone = _nuki == nullptr || (status.lockPaired && status.lockState != NukiLock::LockState::Undefined);
+    bool openerDone = _nukiOpener == nullptr || (status.openerPaired && status.openerState != NukiOpener::LockState::Undefined);
+
+    if(status.mqttConnected && lockDone && openerDone)
     {
-        json["mqttState"] = "No";
+        json["stop"] = 1;
     }
 
+    serializeJson(json, jsonStr);
+    resp->setCode(200);
+    resp->setContentType("application/json");
+    resp->setContent(jsonStr.c_str());
+    return resp->send();
+}
+
+WebCfgServer::StatusState WebCfgServer::readStatus()
+{
+    StatusState status;
+    status.mqttConnected = _network->mqttConnectionState() > 0;
+
     if(_nuki != nullptr)
     {
-        char lockStateArr[20];
-        NukiLock::lockstateToString(_nuki->keyTurnerState().lockState, lockStateArr);
-        String lockState = lockStateArr;
-        String LockPaired = (_nuki->isPaired() ? ("Yes (BLE Address " + _nuki->getBleAddress().toString() + ")").c_str() : "No");
-        json["lockPaired"] = LockPaired;
-        json["lockState"] = lockState;
+        status.lockPaired = _nuki->isPaired();
+        status.lockState = _nuki->keyTurnerState().lockState;
 
-        if(_nuki->isPaired())
+        if(status.lockPaired)
+        {
+            status.lockPin = (NukiPinState)_preferences->getInt(preference_lock_pin_status, (int)NukiPinState::NotConfigured);
+            status.lockHybrid = _preferences->getBool(preference_official_hybrid_enabled, false) && _nuki->offConnected();
+        }
+    }
+    if(_nukiOpener != nullptr)
+    {
+        status.openerPaired = _nukiOpener->isPaired();
+        status.openerState = _nukiOpener->keyTurnerState().lockState;
+        status.openerContinuous = _nukiOpener->keyTurnerState().nukiState == NukiOpener::State::ContinuousMode;
+
+        if(status.openerPaired)
+        {
+            status.openerPin = (NukiPinState)_preferences->getInt(preference_opener_pin_status, (int)NukiPinState::NotConfigured);
+        }
+    }
+
+    return status;
+}
+
+void WebCfgServer::addStatusFields(JsonDocument& json, const StatusState& status, const StatusState* previous)
+{
+    if(previous == nullptr || status.mqttConnected != previous->mqttConnected)
+    {
+        json["mqttState"] = status.mqttConnected ? "Yes" : "No";
+    }
+
+    if(_nuki != nullptr)
+    {
+        bool pairedChanged = previous == nullptr || status.lockPaired != previous->lockPaired;
+
+        if(pairedChanged)
+        {
+            String lockPaired = (status.lockPaired ? ("Yes (BLE Address " + _nuki->getBleAddress().toString() + ")").c_str() : "No");
+            json["lockPaired"] = lockPaired;
+        }
+        if(previous == nullptr || status.lockState != previous->lockState)
+        {
+            char lockStateArr[20];
+            NukiLock::lockstateToString(status.lockState, lockStateArr);
+            String lockState = lockStateArr;
+            json["lockState"] = lockState;
+        }
+        if(pairedChanged || status.lockPin != previous->lockPin)
+        {
+            json["lockPin"] = status.lockPaired ? pinStateToString(status.lockPin) : "Not Paired";
+        }
+        if(pairedChanged || status.lockHybrid != previous->lockHybrid)
+        {
+            json["lockHybrid"] = status.lockHybrid ? "Yes" : "No";
+        }
+    }
+
+    if(_nukiOpener != nullptr)
+    {
+        bool pairedChanged = previous == nullptr || status.openerPaired != previous->openerPaired;
+
+        if(pairedChanged)
+        {
+            String openerPaired = (status.openerPaired ? ("Yes (BLE Address " + _nukiOpener->getBleAddress().toString() + ")").c_str() : "No");
+            json["openerPaired"] = openerPaired;
+        }
+        if(previous == nullptr || status.openerState != previous->openerState || status.openerContinuous != previous->openerContinuous)
         {
-            json["lockPin"] = pinStateToString((NukiPinState)_preferences->getInt(preference_lock_pin_status, (int)NukiPinState::NotConfigured));
-            if(strcmp(lockStateArr, "undefined") != 0)
+            if(status.openerContinuous)
             {
-                lockDone = true;
+                json["openerState"] = "Open (Continuous Mode)";
+            }
+            else
+            {
+                char openerStateArr[20];
+                NukiOpener::lockstateToString(status.openerState, openerStateArr);
+                String openerState = openerStateArr;
+                json["openerState"] = openerState;
             }
         }
-        else
+        if(pairedChanged || status.openerPin != previous->openerPin)
         {
-            json["lockPin"] = "Not Paired";
+            json["openerPin"] = status.openerPaired ? pinStateToString(status.openerPin) : "Not Paired";
         }
     }
+}
+
+struct StatusEventWork
+{
+    PsychicEventSource* events;
+    String json;
+};
+
+void WebCfgServer::sendStatusEventWork(void* arg)
+{
+    StatusEventWork* work = (StatusEventWork*)arg;
+    work->events->send(work->json.c_str(), "status");
+    delete work;
+}
+
+void WebCfgServer::sendStatusEvents()
+{
+    if(_statusEventClients <= 0 || espMillis() - _statusEventsTs < WEBCFG_STATUS_EVENT_INTERVAL)
+    {
+        return;
+    }
+    _statusEventsTs = espMillis();
+
+    const StatusState status = readStatus();
+    JsonDocument json;
+    addStatusFields(json, status, &_statusSent);
+    _statusSent = status;
+
+    if(json.size() == 0)
+    {
+        return;
+    }
+
+    StatusEventWork* work = new (std::nothrow) StatusEventWork();
+    if(work == nullptr)
+    {
+        return;
+    }
+    work->events = &_statusEvents;
+    serializeJson(json, work->json);
+
+    // The client list is changed by the httpd task when clients connect or leave, send from there
+    if(httpd_queue_work(_psychicServer->server, sendStatusEventWork, work) != ESP_OK)
+    {
+        delete work;
+    }
+}
+
+esp_err_t WebCfgServer::buildApiStatus(PsychicRequest *request, PsychicResponse* resp)
+{
+    const StatusState status = readStatus();
+    char str[50];
+
+    PsychicStreamResponse response(resp, "application/json");
+    response.setContentType("application/json");
+    response.beginSend();
+    JsonStreamWriter json(response);
+
+    json.beginObject();
+    json.addString("version", NUKI_HUB_VERSION);
+    json.addString("build", NUKI_HUB_BUILD);
+    json.addInt("uptime", espMillis() / 1000);
+    json.addBool("mqttConnected", status.mqttConnected);
+    json.addBool("rebootRequired", _rebootRequired);
+
+    if(_preferences->getBool(preference_check_updates))
+    {
+        json.addString("latestFirmware", _preferences->getString(preference_latest_version).c_str());
+    }
+
+    if(_nuki != nullptr)
+    {
+        json.beginObject("lock");
+        json.addBool("paired", status.lockPaired);
+        memset(&str, 0, sizeof(str));
+        NukiLock::lockstateToString(status.lockState, str);
+        json.addString("lock_state", str);
+        json.addString("pin", status.lockPaired ? pinStateToString(status.lockPin).c_str() : "Not Paired");
+        json.addBool("hybrid", status.lockHybrid);
+        json.endObject();
+    }
     else
     {
-        lockDone = true;
+        json.addNull("lock");
     }
+
     if(_nukiOpener != nullptr)
     {
-        char openerStateArr[20];
-        NukiOpener::lockstateToString(_nukiOpener->keyTurnerState().lockState, openerStateArr);
-        String openerState = openerStateArr;
-        String openerPaired = (_nukiOpener->isPaired() ? ("Yes (BLE Address " + _nukiOpener->getBleAddress().toString() + ")").c_str() : "No");
-        json["openerPaired"] = openerPaired;
+        json.beginObject("opener");
+        json.addBool("paired", status.openerPaired);
+        memset(&str, 0, sizeof(str));
+        NukiOpener::lockstateToString(status.openerState, str);
+        json.addString("lock_state", str);
+        json.addBool("continuous_mode", status.openerContinuous);
+        json.addString("pin", status.openerPaired ? pinStateToString(status.openerPin).c_str() : "Not Paired");
+        json.endObject();
+    }
+    else
+    {
+        json.addNull("opener");
+    }
 
-        if(_nukiOpener->keyTurnerState().nukiState == NukiOpener::State::ContinuousMode)
+    json.endObject();
+    return response.endSend();
+}
+
+esp_err_t WebCfgServer::buildApiLock(PsychicRequest *request, PsychicResponse* resp)
+{
+    if(_nuki == nullptr)
+    {
+        return sendApiError(resp, 404, "Lock not enabled");
+    }
+
+    const NukiLock::KeyTurnerState state = _nuki->keyTurnerState();
+    char str[50];
+
+    PsychicStreamResponse response(resp, "application/json");
+    response.setContentType("application/json");
+    response.beginSend();
+    JsonStreamWriter json(response);
+
+    // Same keys as the JSON state published over MQTT
+    json.beginObject();
+    json.addBool("paired", _nuki->isPaired());
+    json.addString("bleAddress", _nuki->getBleAddress().toString().c_str());
+    memset(&str, 0, sizeof(str));
+    NukiLock::lockstateToString(state.lockState, str);
+    json.addString("lock_state", str);
+    memset(&str, 0, sizeof(str));
+    NukiLock::triggerToString(state.trigger, str);
+    json.addString("trigger", str);
+    json.addInt("nightModeActive", state.nightModeActive != 255 ? state.nightModeActive : 0);
+    memset(&str, 0, sizeof(str));
+    NukiLock::lockactionToString(state.lastLockAction, str);
+    json.addString("last_lock_action", str);
+    memset(&str, 0, sizeof(str));
+    NukiLock::triggerToString(state.lastLockActionTrigger, str);
+    json.addString("last_lock_action_trigger", str);
+    memset(&str, 0, sizeof(str));
+    NukiLock::completionStatusToString(state.lastLockActionCompletionStatus, str);
+    json.addString("lock_completion_status", str);
+    memset(&str, 0, sizeof(str));
+    NukiLock::doorSensorStateToString(state.doorSensorState, str);
+    json.addString("door_sensor_state", str);
+
+    json.beginObject("battery");
+    json.addBool("critical", (state.criticalBatteryState & 1) == 1);
+    json.addBool("charging", (state.criticalBatteryState & 2) == 2);
+    json.addInt("level", (state.criticalBatteryState & 0b11111100) >> 1);
+    json.endObject();
+
+    json.endObject();
+    return response.endSend();
+}
+
+esp_err_t WebCfgServer::buildApiOpener(PsychicRequest *request, PsychicResponse* resp)
+{
+    if(_nukiOpener == nullptr)
+    {
+        return sendApiError(resp, 404, "Opener not enabled");
+    }
+
+    const NukiOpener::OpenerState state = _nukiOpener->keyTurnerState();
+    char str[50];
+
+    PsychicStreamResponse response(resp, "application/json");
+    response.setContentType("application/json");
+    response.beginSend();
+    JsonStreamWriter json(response);
+
+    // Same keys as the JSON state published over MQTT
+    json.beginObject();
+    json.addBool("paired", _nukiOpener->isPaired());
+    json.addString("bleAddress", _nukiOpener->getBleAddress().toString().c_str());
+    memset(&str, 0, sizeof(str));
+    NukiOpener::lockstateToString(state.lockState, str);
+    json.addString("lock_state", str);
+    json.addBool("continuous_mode", state.nukiState == NukiOpener::State::ContinuousMode);
+    memset(&str, 0, sizeof(str));
+    NukiOpener::triggerToString(state.trigger, str);
+    json.addString("trigger", str);
+    json.addInt("ringToOpenTimer", state.ringToOpenTimer != 255 ? state.ringToOpenTimer : 0);
+    memset(&str, 0, sizeof(str));
+    NukiOpener::lockactionToString(state.lastLockAction, str);
+    json.addString("last_lock_action", str);
+    memset(&str, 0, sizeof(str));
+    NukiOpener::triggerToString(state.lastLockActionTrigger, str);
+    json.addString("last_lock_action_trigger", str);
+    memset(&str, 0, sizeof(str));
+    NukiOpener::completionStatusToString(state.lastLockActionCompletionStatus, str);
+    json.addString("lock_completion_status", str);
+
+    json.beginObject("battery");
+    json.addBool("critical", (state.criticalBatteryState & 1) == 1);
+    json.endObject();
+
+    json.endObject();
+    return response.endSend();
+}
+
+void WebCfgServer::readAclPrefs(uint32_t aclPrefs[][WEBCFG_ACL_SIZE])
+{
+    for(uint8_t group = 0; group < WEBCFG_ACL_GROUPS; group++)
+    {
+        memset(aclPrefs[group], 0, WEBCFG_ACL_SIZE * sizeof(uint32_t));
+        _preferences->getBytes(_settings.aclPreference((WebCfgAclGroup)group), aclPrefs[group], _settings.aclSize((WebCfgAclGroup)group) * sizeof(uint32_t));
+    }
+}
+
+esp_err_t WebCfgServer::buildApiConfig(PsychicRequest *request, PsychicResponse* resp)
+{
+    uint32_t aclPrefs[WEBCFG_ACL_GROUPS][WEBCFG_ACL_SIZE];
+    readAclPrefs(aclPrefs);
+
+    PsychicStreamResponse response(resp, "application/json");
+    response.setContentType("application/json");
+    response.beginSend();
+    JsonStreamWriter json(response);
+
+    json.beginObject();
+    json.addBool("rebootRequired", _rebootRequired);
+
+    // Keyed by form field name, the same keys are accepted by PATCH
+    json.beginObject("settings");
+    for(size_t i = 0; i < _settings.count(); i++)
+    {
+        const WebCfgSetting& setting = _settings.at(i);
+
+        switch(setting.type)
         {
-            json["openerState"] = "Open (Continuous Mode)";
-        }
-        else
+        case WebCfgSettingType::String:
         {
-            json["openerState"] = openerState;
+            String value = _preferences->getString(setting.preference, setting.defaultString);
+            if((setting.flags & WEBCFG_MASKED) != 0 && value != "")
+            {
+                value = "*";
+            }
+            json.addString(setting.key, value.c_str());
+            break;
         }
+        case WebCfgSettingType::Int:
+            json.addInt(setting.key, _preferences->getInt(setting.preference, setting.defaultValue));
+            break;
+        case WebCfgSettingType::Bool:
+            json.addBool(setting.key, _preferences->getBool(setting.preference, setting.defaultValue != 0));
+            break;
+        case WebCfgSettingType::Acl:
+            json.addBool(setting.key, aclPrefs[(uint8_t)setting.aclGroup][setting.aclIndex] == 1);
+            break;
+        }
+    }
+    json.endObject();
 
-        if(_nukiOpener->isPaired())
+    json.endObject();
+    return response.endSend();
+}
+
+bool WebCfgServer::approveApiChange(PsychicRequest *request)
+{
+    // same approval as saving the settings through /post when DUOAPPROVAL is set
+    const String approveKey = request->client()->localIP().toString() + "approve";
+    WebCfgApproval approval;
+    approval.totpEnabled = _importExport->getTOTPEnabled();
+    approval.duoEnabled = _duoEnabled;
+    approval.sessionApproved = _importExport->_sessionsOpts[approveKey];
+    approval.totpValid = false;
+    approval.bypassed = !timeSynced && _importExport->getBypassEnabled() && isAuthenticated(request, 3);
+
+    if(timeSynced && approval.totpEnabled && request->hasParam("totpkey"))
+    {
+        String totpkey = request->getParam("totpkey")->value();
+        approval.totpValid = totpkey != "" && _importExport->checkTOTP(&totpkey);
+    }
+
+    if(!webCfgChangeApproved(_preferences, approval))
+    {
+        return false;
+    }
+
+    // an approval on the Duo/TOTP page covers one change
+    _importExport->_sessionsOpts[approveKey] = false;
+    return true;
+}
+
+esp_err_t WebCfgServer::processApiConfig(PsychicRequest *request, PsychicResponse* resp)
+{
+    JsonDocument doc;
+    DeserializationError error = deserializeJson(doc, request->body());
+
+    if(error || !doc.is<JsonObjectConst>())
+    {
+        return sendApiError(resp, 400, "Invalid JSON, expected an object of settings");
+    }
+
+    bool configChanged = false;
+    bool networkReconfigure = false;
+    bool clearSession = false;
+    bool newMFA = false;
+    bool anyChanged = false;
+    bool aclChanged[WEBCFG_ACL_GROUPS] = {false};
+    uint32_t aclPrefs[WEBCFG_ACL_GROUPS][WEBCFG_ACL_SIZE];
+    readAclPrefs(aclPrefs);
+
+    PsychicStreamResponse response(resp, "application/json");
+    response.setContentType("application/json");
+    response.beginSend();
+    JsonStreamWriter json(response);
+
+    json.beginObject();
+    json.beginObject("settings");
+
+    for(JsonPairConst pair : doc.as<JsonObjectConst>())
+    {
+        const char* key = pair.key().c_str();
+        JsonVariantConst jsonValue = pair.value();
+        const WebCfgSetting* setting = _settings.find(key);
+
+        // Converted to the representation of the settings form
+        String value;
+        bool accepted = setting != nullptr;
+
+        if(accepted)
         {
-            json["openerPin"] = pinStateToString((NukiPinState)_preferences->getInt(preference_opener_pin_status, (int)NukiPinState::NotConfigured));
-            if(strcmp(openerStateArr, "undefined") != 0)
+            switch(setting->type)
             {
-                openerDone = true;
+            case WebCfgSettingType::String:
+                accepted = jsonValue.is<const char*>();
+                value = accepted ? jsonValue.as<const char*>() : "";
+                break;
+            case WebCfgSettingType::Int:
+                accepted = jsonValue.is<int32_t>();
+                value = String(jsonValue.as<int32_t>());
+                break;
+            case WebCfgSettingType::Bool:
+            case WebCfgSettingType::Acl:
+                accepted = jsonValue.is<bool>() || (jsonValue.is<int>() && (jsonValue.as<int>() == 0 || jsonValue.as<int>() == 1));
+                value = (jsonValue.is<bool>() ? jsonValue.as<bool>() : jsonValue.as<int>() == 1) ? "1" : "0";
+                break;
             }
+            accepted = accepted && _settings.valid(*setting, value);
         }
-        else
+
+        if(!accepted)
+        {
+            json.addString(key, "rejected");
+            continue;
+        }
+
+        bool changed = false;
+
+        if(setting->type == WebCfgSettingType::Acl)
+        {
+            uint32_t& entry = aclPrefs[(uint8_t)setting->aclGroup][setting->aclIndex];
+            uint32_t aclValue = (value == "1") ? 1 : 0;
+            changed = entry != aclValue;
+            entry = aclValue;
+            aclChanged[(uint8_t)setting->aclGroup] = aclChanged[(uint8_t)setting->aclGroup] || changed;
+        }
+        else if(_settings.apply(*setting, _preferences, value))
         {
-            json["openerPin"] = "Not Paired";
+            changed = true;
+            configChanged = configChanged || (setting->flags & WEBCFG_CONFIG_CHANGED) != 0;
+            networkReconfigure = networkReconfigure || (setting->flags & WEBCFG_NETWORK_RECONFIGURE) != 0;
+            clearSession = clearSession || (setting->flags & WEBCFG_CLEAR_SESSION) != 0;
+            newMFA = newMFA || (setting->flags & WEBCFG_NEW_MFA) != 0;
         }
+
+        if(changed)
+        {
+            Log->print("Setting changed: ");
+            Log->println(key);
+            anyChanged = true;
+        }
+
+        json.addString(key, changed ? "changed" : "unchanged");
     }
-    else
+    json.endObject();
+
+    for(uint8_t group = 0; group < WEBCFG_ACL_GROUPS; group++)
     {
-        openerDone = true;
+        if(aclChanged[group])
+        {
+            _preferences->putBytes(_settings.aclPreference((WebCfgAclGroup)group), (byte*)aclPrefs[group], _settings.aclSize((WebCfgAclGroup)group) * sizeof(uint32_t));
+        }
     }
 
-    if(_preferences->getBool(preference_check_updates))
+    if(anyChanged)
     {
-        json["latestFirmware"] = _preferences->getString(preference_latest_version);
+        applySettingChanges(configChanged, networkReconfigure, clearSession, newMFA);
     }
 
-    if(mqttDone && lockDone && openerDone)
+    json.addBool("rebootRequired", _rebootRequired);
+    json.endObject();
+    return response.endSend();
+}
+
+esp_err_t WebCfgServer::buildApiGpio(PsychicRequest *request, PsychicResponse* resp)
+{
+    PsychicStreamResponse response(resp, "application/json");
+    response.setContentType("application/json");
+    response.beginSend();
+    JsonStreamWriter json(response);
+
+    json.beginObject();
+    json.beginArray("pins");
+    for(const auto& entry : _gpio->pinConfiguration())
     {
-        json["stop"] = 1;
+        json.beginObject();
+        json.addInt("pin", entry.pin);
+        json.addInt("role", (int)entry.role);
+        json.addString("description", _gpio->getRoleDescription(entry.role).c_str());
+        json.endObject();
     }
+    json.endArray();
 
-    serializeJson(json, jsonStr);
-    resp->setCode(200);
-    resp->setContentType("application/json");
-    resp->setContent(jsonStr.c_str());
-    return resp->send();
+    json.beginArray("available");
+    for(const auto& pin : _gpio->availablePins())
+    {
+        json.addInt(nullptr, pin);
+    }
+    json.endArray();
+
+    json.endObject();
+    return response.endSend();
+}
+
+esp_err_t WebCfgServer::sendApiUnauthorized(PsychicRequest *request, PsychicResponse* resp, int authReq)
+{
+    // Basic and digest clients need the challenge, session and MFA logins only happen on the HTML pages
+    switch (authReq)
+    {
+        case 0:
+            return request->requestAuthentication(BASIC_AUTH, "Nuki Hub", "You must log in.");
+        case 1:
+            return request->requestAuthentication(DIGEST_AUTH, "Nuki Hub", "You must log in.");
+        default:
+            return sendApiError(resp, 401, "Unauthorized");
+    }
+}
+
+esp_err_t WebCfgServer::sendApiError(PsychicResponse* resp, int code, const char* message)
+{
+    PsychicStreamResponse response(resp, "application/json");
+    response.setCode(code);
+    response.setContentType("application/json");
+    response.beginSend();
+    JsonStreamWriter json(response);
+
+    json.beginObject();
+    json.addString("error", message);
+    json.endObject();
+    return response.endSend();
 }
 
 const String WebCfgServer::pinStateToString(const NukiPinState& value) const
@@ -5956,6 +5084,12 @@ esp_err_t WebCfgServer::buildInfoHtml(PsychicRequest *request, PsychicResponse*
     response.print(uxTaskGetStackHighWaterMark(networkTaskHandle));
     response.print("\nNuki task stack high watermark: ");
     response.print(uxTaskGetStackHighWaterMark(nukiTaskHandle));
+    response.print("\nNuki task wakeups per minute: ");
+    response.print(NukiTaskWakeup::wakeupsPerMinute());
+    response.print("\nNuki task command pickup latency (ms), last / max: ");
+    response.print(NukiTaskWakeup::lastPickupLatency());
+    response.print(" / ");
+    response.print(NukiTaskWakeup::maxPickupLatency());
     SPIFFS.begin(true);
     response.print("\n\n------------ SPIFFS ------------");
     response.printf("\nSPIFFS Total Bytes: %u", SPIFFS.totalBytes());
@@ -6059,6 +5193,8 @@ esp_err_t WebCfgServer::buildInfoHtml(PsychicRequest *request, PsychicResponse*
     response.print(_preferences->getBool(preference_debug_command, false) ? "Yes" : "No");
     response.print("\nMQTT log enabled: ");
     response.print(_preferences->getBool(preference_mqtt_log_enabled, false) ? "Yes" : "No");
+    response.print("\nMQTT journal enabled: ");
+    response.print(_preferences->getBool(preference_mqtt_journal_enabled, false) ? "Yes" : "No");
     response.print("\nWebserial enabled: ");
     response.print(_preferences->getBool(preference_webserial_enabled, false) ? "Yes" : "No");
     response.print("\nBootloop protection enabled: ");
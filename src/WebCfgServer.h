@@ -2,6 +2,7 @@
 
 #include <Preferences.h>
 #include <PsychicHttp.h>
+#include <atomic>
 #include "enums/NukiPinState.h"
 
 #ifdef CONFIG_ESP_HTTPS_SERVER_ENABLE
@@ -9,6 +10,7 @@
 #endif
 #include "esp_ota_ops.h"
 #include "Config.h"
+#include "WebCfgAsset.h"
 
 #ifndef NUKI_HUB_UPDATER
 #include "NukiWrapper.h"
@@ -16,6 +18,9 @@
 #include "NukiOpenerWrapper.h"
 #include "Gpio.h"
 #include "ImportExport.h"
+#include "NukiTaskWakeup.h"
+#include "WebCfgSettings.h"
+#include "JsonStreamWriter.h"
 
 extern TaskHandle_t nukiTaskHandle;
 
@@ -49,9 +54,24 @@ public:
     ~WebCfgServer() = default;
 
     void initialize();
+    // Writes changed sessions and pushes changed status fields to the clients of /events, called from the network task
+    void update();
 
 private:
     #ifndef NUKI_HUB_UPDATER
+    struct StatusState
+    {
+        bool mqttConnected = false;
+        bool lockPaired = false;
+        NukiLock::LockState lockState = NukiLock::LockState::Undefined;
+        NukiPinState lockPin = NukiPinState::NotConfigured;
+        bool lockHybrid = false;
+        bool openerPaired = false;
+        NukiOpener::LockState openerState = NukiOpener::LockState::Undefined;
+        bool openerContinuous = false;
+        NukiPinState openerPin = NukiPinState::NotConfigured;
+    };
+
     esp_err_t sendSettings(PsychicRequest *request, PsychicResponse* resp, bool adminKey = false);
     bool processArgs(PsychicRequest *request, PsychicResponse* resp, String& message);
     bool processImport(PsychicRequest *request, PsychicResponse* resp, String& message);
@@ -65,6 +85,21 @@ private:
     esp_err_t buildMqttSSLConfigHtml(PsychicRequest *request, PsychicResponse* resp, int type=0);
     esp_err_t buildHttpSSLConfigHtml(PsychicRequest *request, PsychicResponse* resp, int type=0);
     esp_err_t buildStatusHtml(PsychicRequest *request, PsychicResponse* resp);
+    StatusState readStatus();
+    void addStatusFields(JsonDocument& json, const StatusState& status, const StatusState* previous = nullptr);
+    void sendStatusEvents();
+    static void sendStatusEventWork(void* arg);
+    esp_err_t buildApiStatus(PsychicRequest *request, PsychicResponse* resp);
+    esp_err_t buildApiLock(PsychicRequest *request, PsychicResponse* resp);
+    esp_err_t buildApiOpener(PsychicRequest *request, PsychicResponse* resp);
+    esp_err_t buildApiConfig(PsychicRequest *request, PsychicResponse* resp);
+    esp_err_t buildApiGpio(PsychicRequest *request, PsychicResponse* resp);
+    esp_err_t processApiConfig(PsychicRequest *request, PsychicResponse* resp);
+    bool approveApiChange(PsychicRequest *request);
+    esp_err_t sendApiError(PsychicResponse* resp, int code, const char* message);
+    esp_err_t sendApiUnauthorized(PsychicRequest *request, PsychicResponse* resp, int authReq);
+    void readAclPrefs(uint32_t aclPrefs[][WEBCFG_ACL_SIZE]);
+    void applySettingChanges(bool configChanged, bool networkReconfigure, bool clearSession, bool newMFA);
     esp_err_t buildAdvancedConfigHtml(PsychicRequest *request, PsychicResponse* resp);
     esp_err_t buildNukiConfigHtml(PsychicRequest *request, PsychicResponse* resp);
     esp_err_t buildGpioConfigHtml(PsychicRequest *request, PsychicResponse* resp);
@@ -99,6 +134,11 @@ private:
     Gpio* _gpio = nullptr;
     bool _brokerConfigured = false;
     bool _rebootRequired = false;
+    WebCfgSettings _settings;
+    PsychicEventSource _statusEvents;
+    StatusState _statusSent;
+    int64_t _statusEventsTs = 0;
+    std::atomic<int> _statusEventClients {0};
     #endif
 
     std::vector<String> _ssidList;
@@ -109,6 +149,8 @@ private:
     void saveSessions(int type = 0);
     void loadSessions(int type = 0);
     void clearSessions();
+    void writeSessionFile(const char* path, SessionStore& sessions);
+    void readSessionFile(const char* path, SessionStore& sessions);
     esp_err_t logoutSession(PsychicRequest *request, PsychicResponse* resp);
     bool isAuthenticated(PsychicRequest *request, int type = 0);
     bool processLogin(PsychicRequest *request, PsychicResponse* resp);
@@ -124,8 +166,7 @@ private:
     esp_err_t buildSSIDListHtml(PsychicRequest *request, PsychicResponse* resp);
     esp_err_t buildConfirmHtml(PsychicRequest *request, PsychicResponse* resp, const String &message, uint32_t redirectDelay = 5, bool redirect = false, String redirectTo = "/");
     esp_err_t buildOtaHtml(PsychicRequest *request, PsychicResponse* resp, bool debug = false);
-    esp_err_t sendCss(PsychicRequest *request, PsychicResponse* resp);
-    esp_err_t sendFavicon(PsychicRequest *request, PsychicResponse* resp);
+    esp_err_t sendAsset(PsychicRequest *request, PsychicResponse* resp, const WebCfgAsset& asset);
     void createSsidList();
     void buildHtmlHeader(PsychicStreamResponse *response, String additionalHeader = "");
     void waitAndProcess(const bool blocking, const uint32_t duration);
@@ -151,7 +192,8 @@ private:
     uint8_t _partitionType = 0;
     size_t _otaContentLen = 0;
     String _hostname;
-    JsonDocument _httpSessions;
+    SessionStore _httpSessions;
+    int64_t _sessionsPersistTs = 0;
     bool _duoEnabled = false;
     bool _bypassGPIO = false;
     bool _newBypass = false;
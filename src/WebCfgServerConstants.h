@@ -1,62 +1,196 @@
 #pragma once
 
-// escaped by https://www.cescaper.com/
-// source: https://cdn.jsdelivr.net/npm/@exampledev/new.css@1.1.2/new.min.css
+// Generated by resources/web_assets.py, do not edit. Change the files in resources/ and icon/ instead.
 
-const char stylecss[] = ":root{--nc-font-sans:'Inter',-apple-system,BlinkMacSystemFont,'Segoe UI',Roboto,Oxygen,Ubuntu,Cantarell,'Open Sans','Helvetica Neue',sans-serif,'Apple Color Emoji','Segoe UI Emoji','Segoe UI Symbol';--nc-font-mono:Consolas,monaco,'Ubuntu Mono','Liberation Mono','Courier New',Courier,monospace;--nc-tx-1:#000;--nc-tx-2:#1a1a1a;--nc-bg-1:#fff;--nc-bg-2:#f6f8fa;--nc-bg-3:#e5e7eb;--nc-lk-1:#0070f3;--nc-lk-2:#0366d6;--nc-lk-tx:#fff;--nc-ac-1:#79ffe1;--nc-ac-tx:#0c4047}@media(prefers-color-scheme:dark){:root{--nc-tx-1:#fff;--nc-tx-2:#eee;--nc-bg-1:#000;--nc-bg-2:#111;--nc-bg-3:#222;--nc-lk-1:#3291ff;--nc-lk-2:#0070f3;--nc-lk-tx:#fff;--nc-ac-1:#7928ca;--nc-ac-tx:#fff}}*{margin:0;padding:0}img,input,option,p,table,textarea,ul{margin-bottom:1rem}button,html,input,select{font-family:var(--nc-font-sans)}body{margin:0 auto;max-width:750px;padding:2rem;border-radius:6px;overflow-x:hidden;word-break:normal;overflow-wrap:anywhere;background:var(--nc-bg-1);color:var(--nc-tx-2);font-size:1.03rem;line-height:1.5}::selection{background:var(--nc-ac-1);color:var(--nc-ac-tx)}h1,h2,h3,h4,h5,h6{line-height:1;color:var(--nc-tx-1);padding-top:.875rem}h1,h2,h3{color:var(--nc-tx-1);padding-bottom:2px;margin-bottom:8px;border-bottom:1px solid var(--nc-bg-2)}h4,h5,h6{margin-bottom:.3rem}h1{font-size:2.25rem}h2{font-size:1.85rem}h3{font-size:1.55rem}h4{font-size:1.25rem}h5{font-size:1rem}h6{font-size:.875rem}a{color:var(--nc-lk-1)}a:hover{color:var(--nc-lk-2) !important;}abbr{cursor:help}abbr:hover{cursor:help}a button,button,input[type=button],input[type=reset],input[type=submit]{font-size:1rem;display:inline-block;padding:6px 12px;text-align:center;text-decoration:none;white-space:nowrap;background:var(--nc-lk-1);color:var(--nc-lk-tx);border:0;border-radius:4px;box-sizing:border-box;cursor:pointer;color:var(--nc-lk-tx)}a button[disabled],button[disabled],input[type=button][disabled],input[type=reset][disabled],input[type=submit][disabled]{cursor:default;opacity:.5;cursor:not-allowed}.button:focus,.button:hover,button:focus,button:hover,input[type=button]:focus,input[type=button]:hover,input[type=reset]:focus,input[type=reset]:hover,input[type=submit]:focus,input[type=submit]:hover{background:var(--nc-lk-2)}table{border-collapse:collapse;width:100%}td,th{border:1px solid var(--nc-bg-3);text-align:left;padding:.5rem}th{background:var(--nc-bg-2)}tr:nth-child(even){background:var(--nc-bg-2)}textarea{max-width:100%}input,select,textarea{padding:6px 12px;margin-bottom:.5rem;background:var(--nc-bg-2);color:var(--nc-tx-2);border:1px solid var(--nc-bg-3);border-radius:4px;box-shadow:none;box-sizing:border-box}img{max-width:100%}td>input{margin-top:0;margin-bottom:0}td>textarea{margin-top:0;margin-bottom:0}td>select{margin-top:0;margin-bottom:0}.warning{color:red}@media only screen and (max-width:600px){.adapt td{display:block}.adapt input[type=text],.adapt input[type=password],.adapt input[type=submit],.adapt textarea,.adapt select{width:100%}.adapt td:has(input[type=checkbox]){text-align:center}.adapt input[type=checkbox]{width:1.5em;height:1.5em}.adapt table td:first-child{border-bottom:0}.adapt table td:last-child{border-top:0}#tblnav a li>span{max-width:140px}}#tblnav a{border:0;border-bottom:1px solid;display:block;font-size:1rem;font-weight:bold;padding:.6rem 0;line-height:1;color:var(--nc-tx-1);text-decoration:none;background:linear-gradient(to left,transparent 50%,rgba(255,255,255,0.4) 50%) right;background-size:200% 100%;transition:all .2s ease}#tblnav a{background:linear-gradient(to left,var(--nc-bg-2) 50%,rgba(255,255,255,0.4) 50%) right;background-size:200% 100%}#tblnav a:hover{background-position:left;transition:all .45s ease}#tblnav a:active{background:var(--nc-lk-1);transition:all .15s ease}#tblnav a li{list-style:none;padding:.5rem;display:inline-block;width:100%}#tblnav a li>span{float:right;text-align:right;margin-right:10px;color:#f70;font-weight:100;font-style:italic;display:block}.tdbtn{text-align:center;vertical-align:middle}.naventry{float:left;max-width:375px;width:100%}";
+#include "WebCfgAsset.h"
 
-// converted to char array by https://notisrac.github.io/FileToCArray/
-const uint8_t favicon_32x32[]  = {
-  0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52, 
-  0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x20, 0x08, 0x06, 0x00, 0x00, 0x00, 0x73, 0x7a, 0x7a, 
-  0xf4, 0x00, 0x00, 0x02, 0xfb, 0x49, 0x44, 0x41, 0x54, 0x58, 0x47, 0xcd, 0x97, 0x4b, 0x4c, 0x53, 
-  0x41, 0x14, 0x86, 0xff, 0x69, 0xa5, 0x3c, 0x8a, 0x12, 0x14, 0x84, 0xa6, 0x96, 0x60, 0x6d, 0xd0, 
-  0x50, 0x14, 0x51, 0xd1, 0x6a, 0x4c, 0x51, 0x63, 0x88, 0x8a, 0x06, 0x63, 0x42, 0xc0, 0x85, 0x01, 
-  0xc3, 0xae, 0xe8, 0x0a, 0x0d, 0x4a, 0x30, 0x31, 0x18, 0xd1, 0x84, 0x18, 0x83, 0x46, 0x5d, 0xa9, 
-  0x09, 0xb8, 0x01, 0xa2, 0x31, 0x82, 0x31, 0x82, 0x6e, 0x48, 0x78, 0xb6, 0x74, 0xe1, 0x8b, 0x47, 
-  0xb0, 0x3e, 0x0a, 0xb4, 0x05, 0xa1, 0xe1, 0x25, 0x14, 0x68, 0xeb, 0x9d, 0x22, 0xb7, 0x40, 0x1f, 
-  0x1b, 0xef, 0xa5, 0xce, 0xea, 0xde, 0x99, 0xce, 0x39, 0xdf, 0xfc, 0x7f, 0x67, 0xee, 0x1c, 0xe2, 
-  0xbc, 0x0e, 0x81, 0xe3, 0x84, 0xba, 0x58, 0x40, 0x88, 0xc6, 0x09, 0x48, 0xb0, 0x0a, 0x8d, 0x00, 
-  0x26, 0x07, 0x71, 0x3e, 0x14, 0xd4, 0x37, 0x95, 0x11, 0x7b, 0x87, 0xba, 0x84, 0x10, 0x72, 0x63, 
-  0x15, 0xf2, 0x7a, 0xa4, 0x70, 0x12, 0xe7, 0x35, 0xe2, 0xe8, 0x48, 0x33, 0x81, 0x20, 0x36, 0x10, 
-  0x00, 0x4c, 0x4e, 0x33, 0x71, 0x68, 0xd3, 0x18, 0xe5, 0x03, 0xd7, 0xfe, 0x6f, 0x80, 0x86, 0xb6, 
-  0x51, 0xd4, 0xbe, 0x1b, 0x66, 0xe5, 0xd1, 0x64, 0x49, 0x91, 0xb2, 0x35, 0xdc, 0xaf, 0x5c, 0x25, 
-  0x8f, 0xbe, 0xc1, 0x36, 0xeb, 0x60, 0x7f, 0x93, 0x79, 0x28, 0x0a, 0x07, 0x93, 0x23, 0x7c, 0xce, 
-  0xf1, 0xab, 0xc0, 0x9d, 0x67, 0x46, 0x5c, 0xae, 0x30, 0xb0, 0x93, 0x93, 0xb6, 0x88, 0xa1, 0xad, 
-  0xdc, 0x85, 0x60, 0x91, 0xc0, 0x67, 0xc0, 0xc8, 0xc3, 0xcd, 0x18, 0x9b, 0x9c, 0x67, 0xc7, 0x2b, 
-  0x2e, 0x29, 0x70, 0x31, 0x5b, 0xca, 0x0d, 0x00, 0x8d, 0x72, 0xf5, 0x7c, 0x1c, 0x6e, 0x6a, 0x36, 
-  0xfb, 0x0c, 0xb8, 0xe1, 0x48, 0x33, 0xac, 0x13, 0x3c, 0x02, 0xac, 0x11, 0x12, 0xb4, 0x3c, 0x49, 
-  0xc1, 0x9e, 0xc4, 0xb5, 0x5e, 0x21, 0xa2, 0x8f, 0xb6, 0x60, 0x64, 0x6c, 0x8e, 0x3f, 0x05, 0x68, 
-  0x64, 0xa5, 0x5c, 0x0c, 0x5d, 0x95, 0x77, 0x2b, 0x62, 0xd2, 0x5b, 0x30, 0x6c, 0xe5, 0x19, 0xc0, 
-  0x9f, 0x15, 0x92, 0x63, 0xad, 0xb0, 0x8c, 0xcc, 0xf2, 0xab, 0x00, 0x8d, 0x4e, 0xad, 0x68, 0x66, 
-  0xac, 0x48, 0x5d, 0x61, 0xc5, 0xa6, 0xe3, 0xad, 0x18, 0xfc, 0xc5, 0x13, 0xc0, 0x3a, 0xb1, 0x10, 
-  0xe3, 0x53, 0x76, 0x76, 0x75, 0x4a, 0x79, 0x18, 0x63, 0xc5, 0xee, 0x65, 0xbb, 0x22, 0x2e, 0xa3, 
-  0x0d, 0xfd, 0x43, 0x36, 0x7e, 0x14, 0x50, 0xa7, 0x44, 0xb8, 0x92, 0x35, 0xb6, 0x5b, 0xd9, 0x04, 
-  0x57, 0xf2, 0x64, 0x28, 0x2b, 0x90, 0xb3, 0xef, 0xf1, 0xa7, 0xda, 0xf0, 0xd3, 0xcc, 0x13, 0x00, 
-  0x3d, 0x84, 0x6a, 0x6e, 0x27, 0x62, 0x47, 0x8e, 0x0e, 0xd3, 0xb6, 0x85, 0xc3, 0xc6, 0x65, 0xc5, 
-  0x63, 0xc6, 0x0a, 0xe5, 0xc2, 0xae, 0x90, 0x67, 0xb6, 0xe3, 0xfb, 0xe0, 0x0c, 0x3f, 0x0a, 0x50, 
-  0xc9, 0x3f, 0x56, 0xa7, 0xa2, 0xbc, 0xd2, 0x88, 0xa2, 0xfb, 0xee, 0x03, 0x2a, 0xf1, 0xaf, 0x15, 
-  0x21, 0x8c, 0x3a, 0x8a, 0xd3, 0xed, 0x30, 0x0c, 0xf0, 0x04, 0xb0, 0x2d, 0x3e, 0x0c, 0x5f, 0x6a, 
-  0x53, 0x31, 0x6f, 0x77, 0x42, 0x95, 0xab, 0x87, 0xbe, 0x67, 0x92, 0x5d, 0x69, 0x51, 0xae, 0x0c, 
-  0xb7, 0x2e, 0xc8, 0x91, 0x70, 0xa6, 0x03, 0x7d, 0xc6, 0x69, 0x7e, 0x14, 0x48, 0x88, 0x0b, 0x45, 
-  0xf7, 0xf3, 0xbd, 0xae, 0xe0, 0xfa, 0xee, 0x49, 0xa8, 0xf2, 0xf4, 0x2e, 0x18, 0xda, 0x84, 0x02, 
-  0xba, 0x2b, 0x76, 0x22, 0xbf, 0xb4, 0x17, 0x9f, 0x0d, 0x53, 0xfc, 0x00, 0x28, 0x64, 0xa1, 0xe8, 
-  0x7d, 0xb1, 0x00, 0x40, 0x5b, 0xd1, 0x3d, 0x03, 0xca, 0xab, 0x8c, 0xec, 0xfb, 0x76, 0x85, 0x18, 
-  0xa2, 0x20, 0x01, 0x3a, 0xbb, 0x26, 0xf8, 0x01, 0x90, 0x4b, 0x43, 0xd0, 0xf7, 0x72, 0x1f, 0x1b, 
-  0xfc, 0xf7, 0x8c, 0x1d, 0xc9, 0x67, 0x3b, 0xf1, 0xb5, 0xdf, 0x2d, 0x39, 0x23, 0x04, 0x1c, 0x4b, 
-  0x6e, 0x18, 0x9c, 0x7e, 0x8c, 0xe2, 0x25, 0x21, 0x30, 0xbc, 0x72, 0x03, 0x50, 0x92, 0xf7, 0x5a, 
-  0x2b, 0xd2, 0x35, 0x1f, 0xe0, 0xeb, 0x56, 0xc3, 0x29, 0x80, 0x2c, 0x36, 0x18, 0x3f, 0xea, 0x54, 
-  0xac, 0x02, 0x8b, 0x0f, 0xf9, 0xa5, 0x3d, 0x78, 0x5a, 0x67, 0xf6, 0xe8, 0xa7, 0x1d, 0x9c, 0x02, 
-  0x48, 0x37, 0x06, 0xc3, 0xf8, 0xda, 0x13, 0x60, 0x74, 0x7c, 0x0e, 0xca, 0x2c, 0x1d, 0x2c, 0xa3, 
-  0xee, 0x23, 0x78, 0x91, 0x86, 0x53, 0x00, 0x49, 0x94, 0x08, 0x03, 0x6f, 0xf6, 0x7b, 0x5d, 0x69, 
-  0x4d, 0xe3, 0x10, 0x72, 0x8a, 0xbb, 0x3c, 0xc6, 0x38, 0x05, 0x88, 0x59, 0x2f, 0x82, 0xe9, 0xad, 
-  0x77, 0x00, 0x9a, 0x39, 0xb3, 0xf0, 0x13, 0xea, 0x9a, 0x46, 0x96, 0x41, 0x70, 0x0a, 0x10, 0x1d, 
-  0x19, 0x04, 0x4b, 0xc3, 0x01, 0xaf, 0x0a, 0xd0, 0xce, 0x7e, 0x8b, 0x0d, 0x49, 0xd9, 0xda, 0x65, 
-  0x1f, 0xac, 0x7f, 0x02, 0x58, 0x79, 0x29, 0x0d, 0x0f, 0x15, 0xe2, 0x6e, 0xa1, 0xc2, 0x27, 0x00, 
-  0x1d, 0xa8, 0x66, 0xac, 0xa8, 0x5f, 0xa2, 0xc2, 0xb9, 0x8c, 0x58, 0xa4, 0xab, 0x22, 0x7d, 0xce, 
-  0xf9, 0xbf, 0xaf, 0xe5, 0x7e, 0x97, 0xca, 0xd1, 0x20, 0x55, 0xc0, 0xc4, 0xc4, 0x0a, 0x5c, 0x69, 
-  0x66, 0xd7, 0x31, 0xc5, 0xa9, 0x33, 0x30, 0xc5, 0x29, 0xa1, 0xc5, 0xa9, 0xab, 0x3c, 0x3f, 0xa9, 
-  0x2e, 0x66, 0x20, 0x0a, 0x56, 0x51, 0x09, 0x33, 0x93, 0xfc, 0x01, 0xf3, 0x6f, 0x2d, 0xfb, 0x03, 
-  0xed, 0x06, 0xb0, 0xce, 0xb5, 0xc4, 0xb4, 0x59, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 
-  0xae, 0x42, 0x60, 0x82
+// resources/style.css: 4030 bytes, 1480 gzipped
+const uint8_t stylecss_data[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xa5, 0x57, 0x6d, 0x8b, 0xe3, 0x36,
+    0x10, 0xfe, 0x2b, 0x2e, 0xcb, 0x91, 0x4d, 0x91, 0x83, 0xe3, 0xbc, 0xed, 0xd9, 0xb4, 0xb4, 0x3d,
+    0x5a, 0x7a, 0xd0, 0xeb, 0x41, 0x97, 0xfb, 0x74, 0xec, 0x07, 0xd9, 0x96, 0x63, 0x75, 0x65, 0xc9,
+    0xc8, 0xca, 0x26, 0xa9, 0xf1, 0x7f, 0xef, 0xc8, 0x92, 0xdf, 0x62, 0xef, 0x5e, 0xa1, 0x2c, 0x61,
+    0xa3, 0xd1, 0x68, 0xf4, 0xcc, 0xcc, 0x33, 0x33, 0x4a, 0x20, 0x85, 0x50, 0x95, 0xeb, 0xf2, 0xd8,
+    0x4d, 0x05, 0x57, 0x6e, 0x89, 0x79, 0x19, 0x2c, 0x3e, 0x72, 0x45, 0xe4, 0x02, 0xb9, 0xb8, 0x28,
+    0x18, 0x71, 0xcb, 0x6b, 0xa9, 0x48, 0x8e, 0x7e, 0x61, 0x94, 0x3f, 0x7f, 0xc2, 0xf1, 0x63, 0xb3,
+    0xfc, 0x0d, 0xb4, 0xd1, 0xe2, 0x91, 0x1c, 0x05, 0x71, 0xbe, 0x7c, 0x5c, 0xa0, 0xbf, 0x44, 0x24,
+    0x94, 0x40, 0x9f, 0x2f, 0xd7, 0x23, 0xe1, 0xe8, 0x4b, 0x74, 0xe2, 0xea, 0x84, 0x3e, 0x60, 0xae,
+    0xb0, 0x24, 0x8c, 0xa1, 0xc5, 0xe7, 0x82, 0x70, 0xe7, 0x11, 0xac, 0x2f, 0xd0, 0xe2, 0x77, 0xc2,
+    0x5e, 0x88, 0xa2, 0x31, 0x76, 0xfe, 0x24, 0x27, 0xb2, 0x40, 0xfa, 0x52, 0xb7, 0x24, 0x92, 0xa6,
+    0x68, 0xf1, 0xb3, 0xbe, 0xd2, 0xf9, 0x20, 0x98, 0x90, 0xce, 0xaf, 0xb9, 0xf8, 0x9b, 0x2e, 0xfa,
+    0x5b, 0xa6, 0x82, 0xc7, 0x6b, 0x1e, 0x09, 0xb6, 0x08, 0x7b, 0x07, 0x72, 0xc1, 0x45, 0xf0, 0x41,
+    0xf0, 0x52, 0x30, 0x5c, 0x22, 0x58, 0xe1, 0x58, 0xa0, 0x85, 0xc1, 0xe3, 0x7c, 0x82, 0x4d, 0x38,
+    0xfe, 0x07, 0x8d, 0x88, 0xc4, 0x8a, 0x0a, 0xde, 0x4a, 0x3e, 0x88, 0x93, 0xa4, 0x44, 0x02, 0x9e,
+    0xf3, 0x02, 0xd9, 0x85, 0x3e, 0x2c, 0xca, 0x02, 0xc7, 0xc4, 0x98, 0x57, 0x17, 0x77, 0x1d, 0xdc,
+    0x79, 0x9e, 0xd7, 0x2d, 0xfd, 0xe0, 0x6e, 0x8d, 0xf5, 0x9f, 0x91, 0x44, 0x47, 0xad, 0x90, 0xa6,
+    0x69, 0xb7, 0x04, 0x85, 0x74, 0x9f, 0x3e, 0xa4, 0xbd, 0xc2, 0x26, 0xb8, 0x23, 0x3b, 0x72, 0x20,
+    0x91, 0x91, 0xb0, 0x67, 0x63, 0xf3, 0xe0, 0xa5, 0x9b, 0x4e, 0x02, 0xa7, 0xbc, 0xcd, 0x7e, 0x9f,
+    0xec, 0x3b, 0x89, 0xba, 0x0c, 0xec, 0xe2, 0x58, 0x9f, 0x39, 0xbc, 0x4f, 0x53, 0xb2, 0xee, 0x24,
+    0x5a, 0xc3, 0x8b, 0xb7, 0xde, 0xf6, 0x50, 0xff, 0x94, 0x93, 0x84, 0xe2, 0xfb, 0x42, 0x92, 0x94,
+    0xc8, 0xd2, 0x8d, 0x75, 0x28, 0xdd, 0x32, 0xce, 0x48, 0x4e, 0x82, 0x04, 0xcb, 0xe7, 0x65, 0x15,
+    0xf4, 0x49, 0x37, 0x4e, 0x75, 0xb6, 0x8d, 0x53, 0x84, 0x90, 0xa1, 0x47, 0x9d, 0xcb, 0xc6, 0xa3,
+    0xf5, 0x7a, 0x3d, 0x74, 0xc7, 0xf7, 0xfd, 0xa1, 0x2f, 0x1b, 0xff, 0xfd, 0xba, 0xb5, 0x66, 0x7d,
+    0x19, 0x7b, 0x37, 0xeb, 0x8b, 0xff, 0x10, 0xe3, 0x91, 0x2f, 0xa0, 0x51, 0xd7, 0xdf, 0x57, 0x39,
+    0x96, 0x47, 0xca, 0x03, 0x2f, 0x2c, 0x70, 0x92, 0x50, 0x7e, 0x0c, 0xbc, 0x9a, 0xe6, 0x47, 0x44,
+    0x79, 0x71, 0x52, 0x48, 0x14, 0x3a, 0x85, 0xa8, 0x40, 0x0a, 0x47, 0x8c, 0x20, 0x45, 0x2e, 0x9a,
+    0x6c, 0x18, 0x9d, 0x98, 0x3d, 0xe7, 0x02, 0x25, 0x95, 0xc8, 0x83, 0xb5, 0x24, 0x79, 0x1d, 0x9d,
+    0xe0, 0x3b, 0x47, 0x99, 0xca, 0x99, 0x3d, 0x5f, 0x12, 0x46, 0x62, 0x55, 0x35, 0xb4, 0x49, 0x71,
+    0x4e, 0xd9, 0x35, 0x78, 0xc1, 0xf2, 0x7e, 0x5c, 0x0c, 0xcb, 0x3a, 0x12, 0xc9, 0xb5, 0x03, 0xe2,
+    0xe0, 0x93, 0x12, 0x61, 0x8e, 0x2f, 0xee, 0x99, 0x26, 0x2a, 0x0b, 0x0e, 0x3b, 0xaf, 0xb8, 0x74,
+    0xe8, 0x7c, 0xb8, 0x28, 0x8c, 0x84, 0x4c, 0x88, 0x74, 0x25, 0x4e, 0xe8, 0xa9, 0x0c, 0xf6, 0xb0,
+    0x2d, 0x5e, 0x88, 0x4c, 0x99, 0x38, 0xbb, 0x97, 0x20, 0xa3, 0x49, 0x42, 0x78, 0x78, 0x06, 0x1d,
+    0x37, 0x02, 0xb0, 0xcf, 0x01, 0x17, 0x32, 0xc7, 0xac, 0xd7, 0x39, 0x4b, 0x5c, 0x04, 0x98, 0x5f,
+    0xcf, 0x19, 0x91, 0x24, 0x8c, 0x70, 0xfc, 0x7c, 0x94, 0xe2, 0xc4, 0x93, 0x1e, 0x9b, 0xce, 0xca,
+    0x32, 0x6c, 0xf2, 0xda, 0x0b, 0x75, 0xe6, 0x96, 0xa1, 0x81, 0x4d, 0xff, 0x21, 0xc1, 0x7a, 0xe5,
+    0x6d, 0x34, 0x1a, 0x28, 0x5a, 0xe2, 0x66, 0x84, 0x1e, 0x33, 0x05, 0xb2, 0x5d, 0x1d, 0x04, 0xc6,
+    0x6d, 0x88, 0x5c, 0x35, 0x67, 0x5c, 0x67, 0x64, 0x62, 0xbc, 0x49, 0xca, 0xb2, 0xce, 0xd6, 0x28,
+    0xf3, 0x51, 0xb6, 0x41, 0xd9, 0x16, 0x65, 0x3b, 0x94, 0xed, 0xab, 0x91, 0xf5, 0x19, 0x48, 0x60,
+    0xca, 0xc6, 0xc6, 0x55, 0xa2, 0x08, 0x56, 0x0f, 0x87, 0x9d, 0xce, 0x45, 0x6b, 0xa8, 0x7a, 0xf3,
+    0x84, 0xcd, 0x9e, 0x0f, 0x11, 0x1c, 0xe7, 0xf3, 0x01, 0x24, 0x36, 0xca, 0x6d, 0x86, 0x8b, 0x8b,
+    0x03, 0x15, 0x4f, 0x13, 0x67, 0x18, 0x25, 0x1f, 0x20, 0xb7, 0x48, 0xc7, 0x16, 0x56, 0x1b, 0x03,
+    0xa3, 0xea, 0x03, 0xe6, 0xaf, 0x7c, 0x83, 0xcd, 0xaf, 0x86, 0x51, 0x7c, 0x30, 0xc2, 0xcd, 0x48,
+    0xb8, 0x33, 0xc2, 0xed, 0x48, 0x68, 0x8f, 0xef, 0x86, 0xc2, 0x46, 0xb2, 0x1f, 0x48, 0xda, 0x08,
+    0xe0, 0x5b, 0xd7, 0x75, 0xf5, 0x2c, 0x6b, 0x1c, 0x64, 0x9a, 0x08, 0x33, 0x9b, 0xfe, 0xd2, 0xf9,
+    0x8e, 0xe6, 0x85, 0x90, 0x0a, 0x7a, 0x6a, 0x58, 0xe3, 0x28, 0x02, 0xad, 0x93, 0x2c, 0x41, 0x2d,
+    0x23, 0xac, 0x68, 0x04, 0xed, 0xe1, 0xa1, 0xd8, 0xb1, 0xbc, 0xb7, 0xff, 0x1a, 0xe6, 0x7f, 0x55,
+    0xd7, 0x82, 0xfc, 0x60, 0x24, 0x4f, 0x43, 0x91, 0x24, 0x25, 0x51, 0x23, 0x49, 0x79, 0x8a, 0x72,
+    0xaa, 0x9e, 0x6e, 0x7c, 0x0a, 0x13, 0x5a, 0x16, 0x0c, 0x5f, 0x03, 0xca, 0x1b, 0x06, 0x44, 0x4c,
+    0xc4, 0xcf, 0x5d, 0x15, 0x00, 0xe5, 0x9d, 0xb5, 0xce, 0x9a, 0xae, 0x48, 0x17, 0x33, 0x7a, 0xe4,
+    0x41, 0x4c, 0xf4, 0x48, 0x31, 0x92, 0x84, 0xc4, 0xc2, 0xb4, 0x5f, 0x20, 0x3f, 0x27, 0xe1, 0x39,
+    0xa3, 0x0a, 0xa6, 0x8c, 0xee, 0xb4, 0x20, 0xd0, 0xfc, 0x9f, 0xa5, 0x7d, 0x13, 0xa1, 0x70, 0x1a,
+    0x19, 0x60, 0xa6, 0x65, 0x03, 0xf4, 0x89, 0x71, 0xf1, 0x6d, 0x1b, 0xa2, 0x5c, 0x34, 0x70, 0x0d,
+    0xac, 0xe3, 0xcc, 0x25, 0xb4, 0x31, 0x2a, 0x04, 0x6d, 0x70, 0xcd, 0x5a, 0xed, 0x82, 0xf7, 0x15,
+    0xdc, 0xd5, 0x2d, 0x26, 0x79, 0x42, 0x13, 0xc1, 0x34, 0xa0, 0xf3, 0x9b, 0x26, 0xb4, 0xf3, 0x7b,
+    0x36, 0xc8, 0xfd, 0x66, 0x9b, 0xc2, 0x84, 0xa4, 0xf8, 0xc4, 0x54, 0x28, 0x20, 0x36, 0x54, 0x5d,
+    0x83, 0xd5, 0xae, 0x05, 0xce, 0x85, 0x8e, 0x2c, 0xf4, 0x0b, 0x92, 0xd4, 0x2b, 0x73, 0x71, 0x90,
+    0x8a, 0xf8, 0x54, 0xa2, 0x76, 0xd5, 0x70, 0x01, 0x8d, 0xb6, 0x46, 0x3b, 0x53, 0xe0, 0x56, 0x6b,
+    0x66, 0x63, 0x72, 0xc2, 0x78, 0x33, 0x3d, 0x60, 0xe5, 0x13, 0x7d, 0xeb, 0xe1, 0xf4, 0x40, 0xbb,
+    0x61, 0x98, 0xfb, 0x4a, 0xda, 0xa1, 0x8e, 0x9b, 0x16, 0x5f, 0xd9, 0x04, 0x42, 0xb6, 0x18, 0x2e,
+    0x4a, 0x12, 0xb4, 0x5f, 0x42, 0xd3, 0x8c, 0xd7, 0x9e, 0xf7, 0xae, 0x56, 0x09, 0x52, 0x99, 0xd5,
+    0x7c, 0xa5, 0x2f, 0x6c, 0x96, 0x43, 0x6a, 0x32, 0x92, 0xaa, 0x8e, 0xbb, 0xab, 0xa6, 0x3a, 0xb5,
+    0x81, 0xf9, 0xc6, 0xab, 0xa1, 0x40, 0xf4, 0x55, 0xe6, 0xc6, 0x19, 0x65, 0xc9, 0x3d, 0x79, 0x21,
+    0x7c, 0xf9, 0x96, 0xb2, 0x1d, 0x4a, 0x55, 0x3f, 0x32, 0x1a, 0x94, 0xc3, 0x09, 0xd4, 0x4d, 0xae,
+    0x6a, 0x52, 0x41, 0x37, 0x5d, 0x6b, 0xd7, 0xcc, 0x97, 0xd7, 0x2e, 0x9b, 0x1f, 0x09, 0xdf, 0x8a,
+    0xc4, 0x2b, 0x15, 0x93, 0xe1, 0x44, 0x9c, 0x4d, 0x7d, 0xce, 0x56, 0x90, 0x9e, 0xc3, 0xb7, 0x4e,
+    0xa9, 0xe4, 0xc7, 0xc6, 0xaf, 0xb6, 0xd9, 0xea, 0x96, 0xef, 0xdd, 0xf8, 0xe0, 0x69, 0xad, 0x41,
+    0x54, 0xde, 0x56, 0xb4, 0x23, 0xfa, 0x4d, 0xb5, 0xd5, 0x19, 0x4b, 0x0e, 0xe0, 0x6c, 0xd3, 0x94,
+    0x50, 0x11, 0xe6, 0x09, 0xe4, 0x08, 0xce, 0xae, 0x4e, 0x19, 0x4b, 0x02, 0x4f, 0x4f, 0xcc, 0x13,
+    0xe7, 0xbe, 0xc7, 0xbb, 0xf7, 0x60, 0x6e, 0x2f, 0xab, 0x15, 0x4e, 0x70, 0xa1, 0x1c, 0x95, 0x54,
+    0x6d, 0x47, 0x6b, 0x5a, 0x59, 0x6d, 0xe5, 0x03, 0xa2, 0x6a, 0xc8, 0x4f, 0x68, 0x2a, 0x2f, 0x70,
+    0x59, 0xea, 0x69, 0x3e, 0xb7, 0x67, 0xc9, 0xdd, 0xee, 0x74, 0x0f, 0x14, 0xbb, 0xb6, 0xce, 0x0d,
+    0x02, 0xd8, 0xc1, 0x09, 0x32, 0x5c, 0xde, 0x0f, 0x2c, 0xc1, 0xeb, 0x2d, 0x7e, 0x86, 0xa8, 0x3f,
+    0x2d, 0xab, 0x49, 0x53, 0x9d, 0x01, 0xdb, 0xa9, 0xb7, 0xc6, 0x57, 0x3b, 0x20, 0x4e, 0xff, 0x0a,
+    0x00, 0x8a, 0xb7, 0x57, 0xe9, 0xba, 0xd2, 0x17, 0xa6, 0x54, 0x96, 0xca, 0x90, 0xba, 0x1a, 0xcf,
+    0x56, 0x6f, 0xa2, 0x0b, 0x2f, 0xeb, 0x1b, 0xd5, 0x26, 0x33, 0xf5, 0x9d, 0x8a, 0x18, 0xc7, 0x2f,
+    0x0e, 0x76, 0x18, 0xfd, 0x11, 0xfa, 0x39, 0x1f, 0x12, 0x64, 0x0b, 0x01, 0xaf, 0x7b, 0x95, 0xea,
+    0xb6, 0x65, 0xdf, 0x4e, 0xf2, 0x70, 0x94, 0x91, 0xf0, 0x66, 0x00, 0x35, 0xcb, 0xb3, 0x71, 0x08,
+    0x7e, 0x01, 0x24, 0x7d, 0x01, 0xef, 0x61, 0xdb, 0xf1, 0xc2, 0xff, 0xf0, 0x32, 0x99, 0x1d, 0x46,
+    0x83, 0xea, 0xd2, 0x26, 0xb0, 0x74, 0x8f, 0xba, 0x34, 0x20, 0xd2, 0xf7, 0x4a, 0x38, 0xba, 0x57,
+    0x20, 0x25, 0xe1, 0x5d, 0x58, 0x40, 0x26, 0xb9, 0x72, 0x76, 0xde, 0x3b, 0x24, 0x8f, 0x11, 0xbe,
+    0xf7, 0x77, 0x3b, 0xd4, 0x7e, 0xbc, 0xd5, 0x76, 0xa9, 0x77, 0x96, 0x8e, 0xd4, 0xf7, 0x0f, 0x6c,
+    0xda, 0xa7, 0x06, 0xe4, 0xda, 0xd1, 0x09, 0x0f, 0x1b, 0x53, 0xb4, 0xb9, 0x1d, 0xba, 0xb9, 0xb3,
+    0xf2, 0x4b, 0x87, 0xe0, 0x92, 0x0c, 0xc3, 0xf4, 0x6d, 0x3c, 0xe3, 0x2e, 0xf0, 0x3f, 0x21, 0xf5,
+    0x57, 0x4f, 0x7a, 0xb2, 0x5b, 0x08, 0x8b, 0xb5, 0x69, 0x99, 0xb7, 0xd8, 0xb7, 0xbb, 0x5b, 0xf0,
+    0x01, 0x86, 0x77, 0xe6, 0x0b, 0xa9, 0x5e, 0x9f, 0xe6, 0xb7, 0x36, 0xd6, 0x13, 0x1b, 0x40, 0x25,
+    0x78, 0x65, 0x02, 0xdf, 0x4a, 0x75, 0x65, 0xc4, 0xe4, 0x68, 0xd4, 0xac, 0xe7, 0xdf, 0x22, 0x83,
+    0xa2, 0x9a, 0xb2, 0x12, 0xde, 0xd9, 0x58, 0x05, 0x26, 0x10, 0x83, 0x72, 0x32, 0x02, 0xdb, 0x5e,
+    0xa4, 0x61, 0x8e, 0x7e, 0xdd, 0x1b, 0xf2, 0xdc, 0xa5, 0x07, 0x6f, 0x44, 0x3b, 0x30, 0x6e, 0x59,
+    0xd9, 0x20, 0xa3, 0x0a, 0xac, 0xc4, 0xe1, 0x4d, 0x1f, 0x51, 0x49, 0xa4, 0xf8, 0xb4, 0x66, 0x43,
+    0x88, 0xac, 0xfe, 0x01, 0xcc, 0xac, 0x34, 0x87, 0x9f, 0x05, 0x8c, 0xd4, 0x2b, 0xc0, 0x09, 0xfb,
+    0xf2, 0x6a, 0x21, 0x36, 0x71, 0xee, 0x6b, 0x68, 0x73, 0xd8, 0x01, 0x9c, 0x81, 0x6b, 0xff, 0x02,
+    0x49, 0x8f, 0x92, 0x82, 0xbe, 0x0f, 0x00, 0x00,
 };
+const WebCfgAsset stylecss = { "text/css", "public, max-age=3600", stylecss_data, sizeof(stylecss_data), "\"d2ec8b511c54acae\"", true };
+
+// resources/status.js: 997 bytes, 482 gzipped
+const uint8_t statusjs_data[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x53, 0xc1, 0x6e, 0x13, 0x31,
+    0x10, 0xbd, 0xe7, 0x2b, 0xdc, 0x1c, 0x6a, 0x47, 0x54, 0x4e, 0x10, 0xc7, 0x74, 0x83, 0x04, 0x44,
+    0x10, 0x14, 0x08, 0x22, 0x3d, 0x20, 0x55, 0x1c, 0xdc, 0xf5, 0x6c, 0xba, 0xc5, 0xd8, 0x8b, 0x3d,
+    0x9b, 0x10, 0x55, 0xfd, 0x77, 0x66, 0xb6, 0xbb, 0xd9, 0xad, 0x54, 0x38, 0x71, 0x59, 0xd9, 0x9e,
+    0xe7, 0x79, 0x6f, 0x9e, 0xdf, 0x3a, 0x40, 0x51, 0x7a, 0x84, 0xb8, 0x37, 0x6e, 0x65, 0xe7, 0xa3,
+    0x43, 0xe9, 0x6d, 0x38, 0xe8, 0xe0, 0x5d, 0x30, 0x56, 0x64, 0xa2, 0xa8, 0x7d, 0x8e, 0x65, 0xf0,
+    0x6a, 0x22, 0xee, 0x47, 0x65, 0x21, 0x54, 0x0b, 0x58, 0xee, 0xc1, 0xe3, 0x36, 0xd4, 0x31, 0x07,
+    0xae, 0xec, 0x4d, 0x14, 0xa9, 0xd9, 0xd1, 0x1d, 0x0f, 0x07, 0x31, 0xa8, 0x2b, 0x39, 0x05, 0xde,
+    0x25, 0x39, 0x99, 0x8f, 0x1e, 0x41, 0xda, 0x58, 0xdb, 0x20, 0xd6, 0x65, 0x42, 0xf0, 0x10, 0x95,
+    0x4c, 0x68, 0xb0, 0x4e, 0xf2, 0xa2, 0x67, 0x6c, 0x1a, 0xa7, 0xdb, 0x70, 0x58, 0xf9, 0x22, 0xa8,
+    0x8f, 0xdb, 0xcd, 0x67, 0x5d, 0x99, 0x98, 0x40, 0x81, 0xb6, 0x06, 0xcd, 0x84, 0xba, 0x3d, 0xf4,
+    0x1d, 0x03, 0x75, 0x89, 0x21, 0x3e, 0x27, 0xb9, 0x45, 0x44, 0x30, 0xf6, 0xb8, 0x25, 0x1a, 0xd2,
+    0x98, 0x0d, 0x05, 0xea, 0xb7, 0xeb, 0xcd, 0x76, 0xf9, 0x4e, 0x9c, 0x9f, 0x8b, 0xb3, 0xde, 0x8b,
+    0x86, 0x1d, 0x4d, 0xc4, 0x2f, 0xc1, 0xb9, 0xd2, 0xef, 0x14, 0xf3, 0x8d, 0x1e, 0xe8, 0x23, 0xc0,
+    0x25, 0xf8, 0x5b, 0xb5, 0x63, 0x17, 0x4f, 0xab, 0x04, 0xaf, 0x2b, 0x92, 0x0d, 0xcd, 0x30, 0x04,
+    0xee, 0x89, 0x48, 0x72, 0x02, 0x5c, 0xb5, 0x7b, 0xd5, 0xc3, 0x2e, 0xc4, 0xab, 0xd9, 0x6c, 0xd6,
+    0x34, 0xee, 0xbb, 0x76, 0x7e, 0x84, 0x9b, 0x3b, 0x6e, 0x5a, 0xd0, 0xc8, 0x8a, 0xdd, 0xff, 0x01,
+    0x47, 0x11, 0x0a, 0xb1, 0xb9, 0xb9, 0x83, 0x1c, 0x35, 0xed, 0x52, 0x03, 0xe9, 0x3c, 0xe0, 0x32,
+    0x4d, 0x2d, 0x03, 0x1a, 0xc9, 0x83, 0xda, 0x90, 0xd7, 0x3f, 0xc9, 0x01, 0xbd, 0x03, 0x5c, 0x3a,
+    0xe0, 0xe5, 0x9b, 0xe3, 0xca, 0x32, 0x6e, 0x22, 0xce, 0x08, 0xe9, 0x6b, 0xe7, 0xf8, 0xf2, 0xbf,
+    0x80, 0xba, 0xf4, 0xe4, 0xfa, 0x15, 0xfc, 0x46, 0x9a, 0x61, 0x7c, 0x69, 0xc4, 0x6d, 0x84, 0x22,
+    0x93, 0x53, 0x26, 0x59, 0x8c, 0xc5, 0x0b, 0x41, 0x0a, 0xae, 0x09, 0xf8, 0x9d, 0x96, 0xe3, 0xcb,
+    0xa9, 0x59, 0x8c, 0x4f, 0xee, 0xb1, 0xa6, 0xff, 0xaf, 0xa1, 0xe3, 0x6b, 0xde, 0x62, 0x68, 0xdb,
+    0xd0, 0xfb, 0x36, 0xae, 0x11, 0x7e, 0xd5, 0x90, 0xb0, 0xcd, 0xeb, 0xb7, 0x4f, 0xeb, 0x0f, 0x88,
+    0xd5, 0xd7, 0xc7, 0x43, 0x7e, 0xa0, 0xb6, 0xae, 0x43, 0x05, 0x5e, 0xc9, 0xf7, 0xcb, 0x2b, 0xca,
+    0xa6, 0x9c, 0x92, 0x82, 0xd7, 0x95, 0xd9, 0x41, 0x76, 0xca, 0x2b, 0xc6, 0x1a, 0x86, 0xf0, 0xee,
+    0xcf, 0x21, 0xa2, 0x6c, 0x41, 0x5c, 0x79, 0xf0, 0xc4, 0x42, 0xca, 0xe8, 0x6c, 0x10, 0xe2, 0x0e,
+    0x1f, 0x21, 0x55, 0x84, 0x00, 0x9e, 0x80, 0x63, 0x41, 0xbe, 0x10, 0x56, 0x27, 0x0c, 0x15, 0x3f,
+    0xd8, 0x4b, 0x96, 0x9b, 0x3b, 0x30, 0xf1, 0x14, 0x90, 0x41, 0x44, 0x79, 0xce, 0x27, 0x89, 0x98,
+    0x73, 0x04, 0xbb, 0xd6, 0x09, 0xbc, 0x6d, 0x72, 0xf9, 0x07, 0x12, 0x12, 0x01, 0x1b, 0xe5, 0x03,
+    0x00, 0x00,
+};
+const WebCfgAsset statusjs = { "application/javascript", "public, max-age=3600", statusjs_data, sizeof(statusjs_data), "\"8357292a318716c4\"", true };
+
+// icon/favicon-32x32.png: 820 bytes
+const uint8_t favicon_data[] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+    0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x20, 0x08, 0x06, 0x00, 0x00, 0x00, 0x73, 0x7a, 0x7a,
+    0xf4, 0x00, 0x00, 0x02, 0xfb, 0x49, 0x44, 0x41, 0x54, 0x58, 0x47, 0xcd, 0x97, 0x4b, 0x4c, 0x53,
+    0x41, 0x14, 0x86, 0xff, 0x69, 0xa5, 0x3c, 0x8a, 0x12, 0x14, 0x84, 0xa6, 0x96, 0x60, 0x6d, 0xd0,
+    0x50, 0x14, 0x51, 0xd1, 0x6a, 0x4c, 0x51, 0x63, 0x88, 0x8a, 0x06, 0x63, 0x42, 0xc0, 0x85, 0x01,
+    0xc3, 0xae, 0xe8, 0x0a, 0x0d, 0x4a, 0x30, 0x31, 0x18, 0xd1, 0x84, 0x18, 0x83, 0x46, 0x5d, 0xa9,
+    0x09, 0xb8, 0x01, 0xa2, 0x31, 0x82, 0x31, 0x82, 0x6e, 0x48, 0x78, 0xb6, 0x74, 0xe1, 0x8b, 0x47,
+    0xb0, 0x3e, 0x0a, 0xb4, 0x05, 0xa1, 0xe1, 0x25, 0x14, 0x68, 0xeb, 0x9d, 0x22, 0xb7, 0x40, 0x1f,
+    0x1b, 0xef, 0xa5, 0xce, 0xea, 0xde, 0x99, 0xce, 0x39, 0xdf, 0xfc, 0x7f, 0x67, 0xee, 0x1c, 0xe2,
+    0xbc, 0x0e, 0x81, 0xe3, 0x84, 0xba, 0x58, 0x40, 0x88, 0xc6, 0x09, 0x48, 0xb0, 0x0a, 0x8d, 0x00,
+    0x26, 0x07, 0x71, 0x3e, 0x14, 0xd4, 0x37, 0x95, 0x11, 0x7b, 0x87, 0xba, 0x84, 0x10, 0x72, 0x63,
+    0x15, 0xf2, 0x7a, 0xa4, 0x70, 0x12, 0xe7, 0x35, 0xe2, 0xe8, 0x48, 0x33, 0x81, 0x20, 0x36, 0x10,
+    0x00, 0x4c, 0x4e, 0x33, 0x71, 0x68, 0xd3, 0x18, 0xe5, 0x03, 0xd7, 0xfe, 0x6f, 0x80, 0x86, 0xb6,
+    0x51, 0xd4, 0xbe, 0x1b, 0x66, 0xe5, 0xd1, 0x64, 0x49, 0x91, 0xb2, 0x35, 0xdc, 0xaf, 0x5c, 0x25,
+    0x8f, 0xbe, 0xc1, 0x36, 0xeb, 0x60, 0x7f, 0x93, 0x79, 0x28, 0x0a, 0x07, 0x93, 0x23, 0x7c, 0xce,
+    0xf1, 0xab, 0xc0, 0x9d, 0x67, 0x46, 0x5c, 0xae, 0x30, 0xb0, 0x93, 0x93, 0xb6, 0x88, 0xa1, 0xad,
+    0xdc, 0x85, 0x60, 0x91, 0xc0, 0x67, 0xc0, 0xc8, 0xc3, 0xcd, 0x18, 0x9b, 0x9c, 0x67, 0xc7, 0x2b,
+    0x2e, 0x29, 0x70, 0x31, 0x5b, 0xca, 0x0d, 0x00, 0x8d, 0x72, 0xf5, 0x7c, 0x1c, 0x6e, 0x6a, 0x36,
+    0xfb, 0x0c, 0xb8, 0xe1, 0x48, 0x33, 0xac, 0x13, 0x3c, 0x02, 0xac, 0x11, 0x12, 0xb4, 0x3c, 0x49,
+    0xc1, 0x9e, 0xc4, 0xb5, 0x5e, 0x21, 0xa2, 0x8f, 0xb6, 0x60, 0x64, 0x6c, 0x8e, 0x3f, 0x05, 0x68,
+    0x64, 0xa5, 0x5c, 0x0c, 0x5d, 0x95, 0x77, 0x2b, 0x62, 0xd2, 0x5b, 0x30, 0x6c, 0xe5, 0x19, 0xc0,
+    0x9f, 0x15, 0x92, 0x63, 0xad, 0xb0, 0x8c, 0xcc, 0xf2, 0xab, 0x00, 0x8d, 0x4e, 0xad, 0x68, 0x66,
+    0xac, 0x48, 0x5d, 0x61, 0xc5, 0xa6, 0xe3, 0xad, 0x18, 0xfc, 0xc5, 0x13, 0xc0, 0x3a, 0xb1, 0x10,
+    0xe3, 0x53, 0x76, 0x76, 0x75, 0x4a, 0x79, 0x18, 0x63, 0xc5, 0xee, 0x65, 0xbb, 0x22, 0x2e, 0xa3,
+    0x0d, 0xfd, 0x43, 0x36, 0x7e, 0x14, 0x50, 0xa7, 0x44, 0xb8, 0x92, 0x35, 0xb6, 0x5b, 0xd9, 0x04,
+    0x57, 0xf2, 0x64, 0x28, 0x2b, 0x90, 0xb3, 0xef, 0xf1, 0xa7, 0xda, 0xf0, 0xd3, 0xcc, 0x13, 0x00,
+    0x3d, 0x84, 0x6a, 0x6e, 0x27, 0x62, 0x47, 0x8e, 0x0e, 0xd3, 0xb6, 0x85, 0xc3, 0xc6, 0x65, 0xc5,
+    0x63, 0xc6, 0x0a, 0xe5, 0xc2, 0xae, 0x90, 0x67, 0xb6, 0xe3, 0xfb, 0xe0, 0x0c, 0x3f, 0x0a, 0x50,
+    0xc9, 0x3f, 0x56, 0xa7, 0xa2, 0xbc, 0xd2, 0x88, 0xa2, 0xfb, 0xee, 0x03, 0x2a, 0xf1, 0xaf, 0x15,
+    0x21, 0x8c, 0x3a, 0x8a, 0xd3, 0xed, 0x30, 0x0c, 0xf0, 0x04, 0xb0, 0x2d, 0x3e, 0x0c, 0x5f, 0x6a,
+    0x53, 0x31, 0x6f, 0x77, 0x42, 0x95, 0xab, 0x87, 0xbe, 0x67, 0x92, 0x5d, 0x69, 0x51, 0xae, 0x0c,
+    0xb7, 0x2e, 0xc8, 0x91, 0x70, 0xa6, 0x03, 0x7d, 0xc6, 0x69, 0x7e, 0x14, 0x48, 0x88, 0x0b, 0x45,
+    0xf7, 0xf3, 0xbd, 0xae, 0xe0, 0xfa, 0xee, 0x49, 0xa8, 0xf2, 0xf4, 0x2e, 0x18, 0xda, 0x84, 0x02,
+    0xba, 0x2b, 0x76, 0x22, 0xbf, 0xb4, 0x17, 0x9f, 0x0d, 0x53, 0xfc, 0x00, 0x28, 0x64, 0xa1, 0xe8,
+    0x7d, 0xb1, 0x00, 0x40, 0x5b, 0xd1, 0x3d, 0x03, 0xca, 0xab, 0x8c, 0xec, 0xfb, 0x76, 0x85, 0x18,
+    0xa2, 0x20, 0x01, 0x3a, 0xbb, 0x26, 0xf8, 0x01, 0x90, 0x4b, 0x43, 0xd0, 0xf7, 0x72, 0x1f, 0x1b,
+    0xfc, 0xf7, 0x8c, 0x1d, 0xc9, 0x67, 0x3b, 0xf1, 0xb5, 0xdf, 0x2d, 0x39, 0x23, 0x04, 0x1c, 0x4b,
+    0x6e, 0x18, 0x9c, 0x7e, 0x8c, 0xe2, 0x25, 0x21, 0x30, 0xbc, 0x72, 0x03, 0x50, 0x92, 0xf7, 0x5a,
+    0x2b, 0xd2, 0x35, 0x1f, 0xe0, 0xeb, 0x56, 0xc3, 0x29, 0x80, 0x2c, 0x36, 0x18, 0x3f, 0xea, 0x54,
+    0xac, 0x02, 0x8b, 0x0f, 0xf9, 0xa5, 0x3d, 0x78, 0x5a, 0x67, 0xf6, 0xe8, 0xa7, 0x1d, 0x9c, 0x02,
+    0x48, 0x37, 0x06, 0xc3, 0xf8, 0xda, 0x13, 0x60, 0x74, 0x7c, 0x0e, 0xca, 0x2c, 0x1d, 0x2c, 0xa3,
+    0xee, 0x23, 0x78, 0x91, 0x86, 0x53, 0x00, 0x49, 0x94, 0x08, 0x03, 0x6f, 0xf6, 0x7b, 0x5d, 0x69,
+    0x4d, 0xe3, 0x10, 0x72, 0x8a, 0xbb, 0x3c, 0xc6, 0x38, 0x05, 0x88, 0x59, 0x2f, 0x82, 0xe9, 0xad,
+    0x77, 0x00, 0x9a, 0x39, 0xb3, 0xf0, 0x13, 0xea, 0x9a, 0x46, 0x96, 0x41, 0x70, 0x0a, 0x10, 0x1d,
+    0x19, 0x04, 0x4b, 0xc3, 0x01, 0xaf, 0x0a, 0xd0, 0xce, 0x7e, 0x8b, 0x0d, 0x49, 0xd9, 0xda, 0x65,
+    0x1f, 0xac, 0x7f, 0x02, 0x58, 0x79, 0x29, 0x0d, 0x0f, 0x15, 0xe2, 0x6e, 0xa1, 0xc2, 0x27, 0x00,
+    0x1d, 0xa8, 0x66, 0xac, 0xa8, 0x5f, 0xa2, 0xc2, 0xb9, 0x8c, 0x58, 0xa4, 0xab, 0x22, 0x7d, 0xce,
+    0xf9, 0xbf, 0xaf, 0xe5, 0x7e, 0x97, 0xca, 0xd1, 0x20, 0x55, 0xc0, 0xc4, 0xc4, 0x0a, 0x5c, 0x69,
+    0x66, 0xd7, 0x31, 0xc5, 0xa9, 0x33, 0x30, 0xc5, 0x29, 0xa1, 0xc5, 0xa9, 0xab, 0x3c, 0x3f, 0xa9,
+    0x2e, 0x66, 0x20, 0x0a, 0x56, 0x51, 0x09, 0x33, 0x93, 0xfc, 0x01, 0xf3, 0x6f, 0x2d, 0xfb, 0x03,
+    0xed, 0x06, 0xb0, 0xce, 0xb5, 0xc4, 0xb4, 0x59, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44,
+    0xae, 0x42, 0x60, 0x82,
+};
+const WebCfgAsset favicon = { "image/png", "public, max-age=604800", favicon_data, sizeof(favicon_data), "\"3eed9792df2ddba1\"", false };
@@ -0,0 +1,376 @@
+#include "WebCfgSettings.h"
+#include <climits>
+#include <cstring>
+#include "PreferencesKeys.h"
+#include "Config.h"
+
+#define WEBCFG_SETTINGS_EMPTY 0xFF
+
+#define WEBCFG_SETTING_STRING(key, preference, defaultString, flags) { key, WebCfgSettingType::String, flags, preference, defaultString, 0, 0, 0, WebCfgAclGroup::Actions, 0 }
+#define WEBCFG_SETTING_INT(key, preference, defaultValue, flags) { key, WebCfgSettingType::Int, flags, preference, nullptr, defaultValue, INT32_MIN, INT32_MAX, WebCfgAclGroup::Actions, 0 }
+#define WEBCFG_SETTING_INT_RANGE(key, preference, defaultValue, min, max, flags) { key, WebCfgSettingType::Int, flags, preference, nullptr, defaultValue, min, max, WebCfgAclGroup::Actions, 0 }
+#define WEBCFG_SETTING_BOOL(key, preference, defaultValue, flags) { key, WebCfgSettingType::Bool, flags, preference, nullptr, defaultValue, 0, 1, WebCfgAclGroup::Actions, 0 }
+#define WEBCFG_SETTING_ACL(key, group, index) { key, WebCfgSettingType::Acl, 0, nullptr, nullptr, 0, 0, 1, group, index }
+
+// In the order of the settings pages. The preference keys cast away const,
+// so the table can't be constexpr, it is still initialized at compile time.
+static const WebCfgSetting settings[] =
+{
+    WEBCFG_SETTING_STRING("MQTTSERVER", preference_mqtt_broker, "", WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_INT("MQTTPORT", preference_mqtt_broker_port, 0, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_STRING("MQTTPASS", preference_mqtt_password, "", WEBCFG_CONFIG_CHANGED | WEBCFG_MASKED),
+    WEBCFG_SETTING_STRING("MQTTPATH", preference_mqtt_lock_path, "", WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("UPTIME", preference_update_time, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_STRING("TIMESRV", preference_time_server, "pool.ntp.org", WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_INT("NWCUSTPHY", preference_network_custom_phy, 0, WEBCFG_CONFIG_CHANGED | WEBCFG_NETWORK_RECONFIGURE),
+    WEBCFG_SETTING_INT("NWCUSTADDR", preference_network_custom_addr, -1, WEBCFG_CONFIG_CHANGED | WEBCFG_NETWORK_RECONFIGURE),
+    WEBCFG_SETTING_INT("NWCUSTIRQ", preference_network_custom_irq, 0, WEBCFG_CONFIG_CHANGED | WEBCFG_NETWORK_RECONFIGURE),
+    WEBCFG_SETTING_INT("NWCUSTRST", preference_network_custom_rst, 0, WEBCFG_CONFIG_CHANGED | WEBCFG_NETWORK_RECONFIGURE),
+    WEBCFG_SETTING_INT("NWCUSTCS", preference_network_custom_cs, 0, WEBCFG_CONFIG_CHANGED | WEBCFG_NETWORK_RECONFIGURE),
+    WEBCFG_SETTING_INT("NWCUSTSCK", preference_network_custom_sck, 0, WEBCFG_CONFIG_CHANGED | WEBCFG_NETWORK_RECONFIGURE),
+    WEBCFG_SETTING_INT("NWCUSTMISO", preference_network_custom_miso, 0, WEBCFG_CONFIG_CHANGED | WEBCFG_NETWORK_RECONFIGURE),
+    WEBCFG_SETTING_INT("NWCUSTMOSI", preference_network_custom_mosi, 0, WEBCFG_CONFIG_CHANGED | WEBCFG_NETWORK_RECONFIGURE),
+    WEBCFG_SETTING_INT("NWCUSTPWR", preference_network_custom_pwr, 0, WEBCFG_CONFIG_CHANGED | WEBCFG_NETWORK_RECONFIGURE),
+    WEBCFG_SETTING_INT("NWCUSTMDIO", preference_network_custom_mdio, 0, WEBCFG_CONFIG_CHANGED | WEBCFG_NETWORK_RECONFIGURE),
+    WEBCFG_SETTING_INT("NWCUSTMDC", preference_network_custom_mdc, 0, WEBCFG_CONFIG_CHANGED | WEBCFG_NETWORK_RECONFIGURE),
+    WEBCFG_SETTING_INT("NWCUSTCLK", preference_network_custom_clk, 0, WEBCFG_CONFIG_CHANGED | WEBCFG_NETWORK_RECONFIGURE),
+    WEBCFG_SETTING_INT("RSSI", preference_rssi_publish_interval, 60, 0),
+    WEBCFG_SETTING_STRING("HTTPSFQDN", preference_https_fqdn, "", WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_STRING("DUOHOST", preference_cred_duo_host, "", WEBCFG_CONFIG_CHANGED | WEBCFG_CLEAR_SESSION | WEBCFG_NEW_MFA | WEBCFG_MASKED),
+    WEBCFG_SETTING_STRING("DUOIKEY", preference_cred_duo_ikey, "", WEBCFG_CONFIG_CHANGED | WEBCFG_CLEAR_SESSION | WEBCFG_NEW_MFA | WEBCFG_MASKED),
+    WEBCFG_SETTING_STRING("DUOSKEY", preference_cred_duo_skey, "", WEBCFG_CONFIG_CHANGED | WEBCFG_CLEAR_SESSION | WEBCFG_NEW_MFA | WEBCFG_MASKED),
+    WEBCFG_SETTING_STRING("DUOUSER", preference_cred_duo_user, "", WEBCFG_CONFIG_CHANGED | WEBCFG_CLEAR_SESSION | WEBCFG_NEW_MFA | WEBCFG_MASKED),
+    WEBCFG_SETTING_BOOL("DUOBYPASS", preference_cred_bypass_boot_btn_enabled, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_INT("DUOBYPASSHIGH", preference_cred_bypass_gpio_high, -1, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_INT("DUOBYPASSLOW", preference_cred_bypass_gpio_low, -1, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("DUOAPPROVAL", preference_cred_duo_approval, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_INT("CREDLFTM", preference_cred_session_lifetime, 3600, WEBCFG_CONFIG_CHANGED | WEBCFG_CLEAR_SESSION),
+    WEBCFG_SETTING_INT("CREDLFTMRMBR", preference_cred_session_lifetime_remember, 720, WEBCFG_CONFIG_CHANGED | WEBCFG_CLEAR_SESSION),
+    WEBCFG_SETTING_INT("CREDDUOLFTM", preference_cred_session_lifetime_duo, 3600, WEBCFG_CONFIG_CHANGED | WEBCFG_CLEAR_SESSION),
+    WEBCFG_SETTING_INT("CREDDUOLFTMRMBR", preference_cred_session_lifetime_duo_remember, 720, WEBCFG_CONFIG_CHANGED | WEBCFG_CLEAR_SESSION),
+    WEBCFG_SETTING_INT("CREDTOTPLFTM", preference_cred_session_lifetime_totp, 3600, WEBCFG_CONFIG_CHANGED | WEBCFG_CLEAR_SESSION),
+    WEBCFG_SETTING_INT("CREDTOTPLFTMRMBR", preference_cred_session_lifetime_totp_remember, 720, WEBCFG_CONFIG_CHANGED | WEBCFG_CLEAR_SESSION),
+    WEBCFG_SETTING_BOOL("OPENERCONT", preference_opener_continuous_mode, false, 0),
+    WEBCFG_SETTING_STRING("HASSCUURL", preference_mqtt_hass_cu_url, "", 0),
+    WEBCFG_SETTING_STRING("HOSTNAME", preference_hostname, "", WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_INT("NETTIMEOUT", preference_network_timeout, 60, 0),
+    WEBCFG_SETTING_BOOL("FINDBESTRSSI", preference_find_best_rssi, false, 0),
+    WEBCFG_SETTING_BOOL("RSTDISC", preference_restart_on_disconnect, false, 0),
+    WEBCFG_SETTING_BOOL("MQTTLOG", preference_mqtt_log_enabled, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("MQTTJOURNAL", preference_mqtt_journal_enabled, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("MQTTSENA", preference_mqtt_ssl_enabled, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("WEBLOG", preference_webserial_enabled, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("CHECKUPDATE", preference_check_updates, false, 0),
+    WEBCFG_SETTING_BOOL("UPDATEMQTT", preference_update_from_mqtt, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_INT("HYBRIDTIMER", preference_query_interval_hybrid_lockstate, 600, 0),
+    WEBCFG_SETTING_BOOL("HYBRIDRETRY", preference_official_hybrid_retry, false, 0),
+    WEBCFG_SETTING_BOOL("HYBRIDREBOOT", preference_hybrid_reboot_on_disconnect, false, 0),
+    WEBCFG_SETTING_BOOL("DISNONJSON", preference_disable_non_json, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("DHCPENA", preference_ip_dhcp_enabled, true, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_STRING("IPADDR", preference_ip_address, "", WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_STRING("IPSUB", preference_ip_subnet, "", WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_STRING("IPGTW", preference_ip_gateway, "", WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_STRING("DNSSRV", preference_ip_dns_server, "", WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_INT("LSTINT", preference_query_interval_lockstate, 1800, 0),
+    WEBCFG_SETTING_INT("CFGINT", preference_query_interval_configuration, 3600, 0),
+    WEBCFG_SETTING_INT("BATINT", preference_query_interval_battery, 1800, 0),
+    WEBCFG_SETTING_INT("KPINT", preference_query_interval_keypad, 1800, 0),
+    WEBCFG_SETTING_INT("NRTRY", preference_command_nr_of_retries, 3, 0),
+    WEBCFG_SETTING_INT("TRYDLY", preference_command_retry_delay, 100, 0),
+    #if defined(CONFIG_IDF_TARGET_ESP32)
+    WEBCFG_SETTING_INT_RANGE("TXPWR", preference_ble_tx_power, 9, -12, 9, 0),
+    #else
+    WEBCFG_SETTING_INT_RANGE("TXPWR", preference_ble_tx_power, 9, -12, 20, 0),
+    #endif
+    WEBCFG_SETTING_INT("RSBC", preference_restart_ble_beacon_lost, 60, 0),
+    WEBCFG_SETTING_INT_RANGE("TSKNTWK", preference_task_size_network, NETWORK_TASK_SIZE, 12288, 65536, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_INT_RANGE("TSKNUKI", preference_task_size_nuki, NUKI_TASK_SIZE, 8192, 65536, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_INT_RANGE("ALMAX", preference_authlog_max_entries, MAX_AUTHLOG, 1, 100, 0),
+    WEBCFG_SETTING_INT_RANGE("KPMAX", preference_keypad_max_entries, MAX_KEYPAD, 1, 200, 0),
+    WEBCFG_SETTING_INT_RANGE("TCMAX", preference_timecontrol_max_entries, MAX_TIMECONTROL, 1, 100, 0),
+    WEBCFG_SETTING_INT_RANGE("AUTHMAX", preference_auth_max_entries, MAX_AUTH, 1, 100, 0),
+    WEBCFG_SETTING_INT_RANGE("BUFFSIZE", preference_buffer_size, CHAR_BUFFER_SIZE, 4096, 65536, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("BTLPRST", preference_enable_bootloop_reset, false, 0),
+    WEBCFG_SETTING_BOOL("DISNTWNOCON", preference_disable_network_not_connected, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_STRING("OTAUPD", preference_ota_updater_url, "", WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_STRING("OTAMAIN", preference_ota_main_url, "", WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("SHOWSECRETS", preference_show_secrets, false, 0),
+    WEBCFG_SETTING_BOOL("DBGCONN", preference_debug_connect, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("DBGCOMMU", preference_debug_communication, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("DBGHEAP", preference_publish_debug_info, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("DBGREAD", preference_debug_readable_data, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("DBGHEX", preference_debug_hex_data, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("DBGCOMM", preference_debug_command, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("LCKFORCEID", preference_lock_force_id, false, 0),
+    WEBCFG_SETTING_BOOL("LCKFORCEKP", preference_lock_force_keypad, false, 0),
+    WEBCFG_SETTING_BOOL("LCKFORCEDS", preference_lock_force_doorsensor, false, 0),
+    WEBCFG_SETTING_BOOL("OPFORCEID", preference_opener_force_id, false, 0),
+    WEBCFG_SETTING_BOOL("OPFORCEKP", preference_opener_force_keypad, false, 0),
+    WEBCFG_SETTING_BOOL("CONFPUB", preference_conf_info_enabled, true, 0),
+    WEBCFG_SETTING_BOOL("KPPUB", preference_keypad_info_enabled, false, 0),
+    WEBCFG_SETTING_BOOL("KPCODE", preference_keypad_publish_code, false, 0),
+    WEBCFG_SETTING_BOOL("KPCHECK", preference_keypad_check_code_enabled, false, 0),
+    WEBCFG_SETTING_BOOL("KPENA", preference_keypad_control_enabled, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("TCPUB", preference_timecontrol_info_enabled, false, 0),
+    WEBCFG_SETTING_BOOL("AUTHPUB", preference_auth_info_enabled, false, 0),
+    WEBCFG_SETTING_BOOL("KPPER", preference_keypad_topic_per_entry, false, 0),
+    WEBCFG_SETTING_BOOL("TCPER", preference_timecontrol_topic_per_entry, false, 0),
+    WEBCFG_SETTING_BOOL("TCENA", preference_timecontrol_control_enabled, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("AUTHPER", preference_auth_topic_per_entry, false, 0),
+    WEBCFG_SETTING_BOOL("AUTHENA", preference_auth_control_enabled, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("PUBAUTH", preference_publish_authdata, false, 0),
+    WEBCFG_SETTING_INT("CREDDIGEST", preference_http_auth_type, 0, WEBCFG_CONFIG_CHANGED | WEBCFG_CLEAR_SESSION),
+    WEBCFG_SETTING_STRING("CREDTRUSTPROXY", preference_bypass_proxy, "", WEBCFG_CONFIG_CHANGED | WEBCFG_CLEAR_SESSION | WEBCFG_MASKED),
+    WEBCFG_SETTING_ACL("ACLLCKLCK", WebCfgAclGroup::Actions, 0),
+    WEBCFG_SETTING_ACL("ACLLCKUNLCK", WebCfgAclGroup::Actions, 1),
+    WEBCFG_SETTING_ACL("ACLLCKUNLTCH", WebCfgAclGroup::Actions, 2),
+    WEBCFG_SETTING_ACL("ACLLCKLNG", WebCfgAclGroup::Actions, 3),
+    WEBCFG_SETTING_ACL("ACLLCKLNGU", WebCfgAclGroup::Actions, 4),
+    WEBCFG_SETTING_ACL("ACLLCKFLLCK", WebCfgAclGroup::Actions, 5),
+    WEBCFG_SETTING_ACL("ACLLCKFOB1", WebCfgAclGroup::Actions, 6),
+    WEBCFG_SETTING_ACL("ACLLCKFOB2", WebCfgAclGroup::Actions, 7),
+    WEBCFG_SETTING_ACL("ACLLCKFOB3", WebCfgAclGroup::Actions, 8),
+    WEBCFG_SETTING_ACL("ACLOPNUNLCK", WebCfgAclGroup::Actions, 9),
+    WEBCFG_SETTING_ACL("ACLOPNLCK", WebCfgAclGroup::Actions, 10),
+    WEBCFG_SETTING_ACL("ACLOPNUNLTCH", WebCfgAclGroup::Actions, 11),
+    WEBCFG_SETTING_ACL("ACLOPNUNLCKCM", WebCfgAclGroup::Actions, 12),
+    WEBCFG_SETTING_ACL("ACLOPNLCKCM", WebCfgAclGroup::Actions, 13),
+    WEBCFG_SETTING_ACL("ACLOPNFOB1", WebCfgAclGroup::Actions, 14),
+    WEBCFG_SETTING_ACL("ACLOPNFOB2", WebCfgAclGroup::Actions, 15),
+    WEBCFG_SETTING_ACL("ACLOPNFOB3", WebCfgAclGroup::Actions, 16),
+    WEBCFG_SETTING_ACL("CONFLCKNAME", WebCfgAclGroup::BasicLockConfig, 0),
+    WEBCFG_SETTING_ACL("CONFLCKLAT", WebCfgAclGroup::BasicLockConfig, 1),
+    WEBCFG_SETTING_ACL("CONFLCKLONG", WebCfgAclGroup::BasicLockConfig, 2),
+    WEBCFG_SETTING_ACL("CONFLCKAUNL", WebCfgAclGroup::BasicLockConfig, 3),
+    WEBCFG_SETTING_ACL("CONFLCKPRENA", WebCfgAclGroup::BasicLockConfig, 4),
+    WEBCFG_SETTING_ACL("CONFLCKBTENA", WebCfgAclGroup::BasicLockConfig, 5),
+    WEBCFG_SETTING_ACL("CONFLCKLEDENA", WebCfgAclGroup::BasicLockConfig, 6),
+    WEBCFG_SETTING_ACL("CONFLCKLEDBR", WebCfgAclGroup::BasicLockConfig, 7),
+    WEBCFG_SETTING_ACL("CONFLCKTZOFF", WebCfgAclGroup::BasicLockConfig, 8),
+    WEBCFG_SETTING_ACL("CONFLCKDSTM", WebCfgAclGroup::BasicLockConfig, 9),
+    WEBCFG_SETTING_ACL("CONFLCKFOB1", WebCfgAclGroup::BasicLockConfig, 10),
+    WEBCFG_SETTING_ACL("CONFLCKFOB2", WebCfgAclGroup::BasicLockConfig, 11),
+    WEBCFG_SETTING_ACL("CONFLCKFOB3", WebCfgAclGroup::BasicLockConfig, 12),
+    WEBCFG_SETTING_ACL("CONFLCKSGLLCK", WebCfgAclGroup::BasicLockConfig, 13),
+    WEBCFG_SETTING_ACL("CONFLCKADVM", WebCfgAclGroup::BasicLockConfig, 14),
+    WEBCFG_SETTING_ACL("CONFLCKTZID", WebCfgAclGroup::BasicLockConfig, 15),
+    WEBCFG_SETTING_ACL("CONFLCKUPOD", WebCfgAclGroup::AdvancedLockConfig, 0),
+    WEBCFG_SETTING_ACL("CONFLCKLPOD", WebCfgAclGroup::AdvancedLockConfig, 1),
+    WEBCFG_SETTING_ACL("CONFLCKSLPOD", WebCfgAclGroup::AdvancedLockConfig, 2),
+    WEBCFG_SETTING_ACL("CONFLCKUTLTOD", WebCfgAclGroup::AdvancedLockConfig, 3),
+    WEBCFG_SETTING_ACL("CONFLCKLNGT", WebCfgAclGroup::AdvancedLockConfig, 4),
+    WEBCFG_SETTING_ACL("CONFLCKSBPA", WebCfgAclGroup::AdvancedLockConfig, 5),
+    WEBCFG_SETTING_ACL("CONFLCKDBPA", WebCfgAclGroup::AdvancedLockConfig, 6),
+    WEBCFG_SETTING_ACL("CONFLCKDC", WebCfgAclGroup::AdvancedLockConfig, 7),
+    WEBCFG_SETTING_ACL("CONFLCKBATT", WebCfgAclGroup::AdvancedLockConfig, 8),
+    WEBCFG_SETTING_ACL("CONFLCKABTD", WebCfgAclGroup::AdvancedLockConfig, 9),
+    WEBCFG_SETTING_ACL("CONFLCKUNLD", WebCfgAclGroup::AdvancedLockConfig, 10),
+    WEBCFG_SETTING_ACL("CONFLCKALT", WebCfgAclGroup::AdvancedLockConfig, 11),
+    WEBCFG_SETTING_ACL("CONFLCKAUNLD", WebCfgAclGroup::AdvancedLockConfig, 12),
+    WEBCFG_SETTING_ACL("CONFLCKNMENA", WebCfgAclGroup::AdvancedLockConfig, 13),
+    WEBCFG_SETTING_ACL("CONFLCKNMST", WebCfgAclGroup::AdvancedLockConfig, 14),
+    WEBCFG_SETTING_ACL("CONFLCKNMET", WebCfgAclGroup::AdvancedLockConfig, 15),
+    WEBCFG_SETTING_ACL("CONFLCKNMALENA", WebCfgAclGroup::AdvancedLockConfig, 16),
+    WEBCFG_SETTING_ACL("CONFLCKNMAULD", WebCfgAclGroup::AdvancedLockConfig, 17),
+    WEBCFG_SETTING_ACL("CONFLCKNMLOS", WebCfgAclGroup::AdvancedLockConfig, 18),
+    WEBCFG_SETTING_ACL("CONFLCKALENA", WebCfgAclGroup::AdvancedLockConfig, 19),
+    WEBCFG_SETTING_ACL("CONFLCKIALENA", WebCfgAclGroup::AdvancedLockConfig, 20),
+    WEBCFG_SETTING_ACL("CONFLCKAUENA", WebCfgAclGroup::AdvancedLockConfig, 21),
+    WEBCFG_SETTING_ACL("CONFLCKRBTNUKI", WebCfgAclGroup::AdvancedLockConfig, 22),
+    WEBCFG_SETTING_ACL("CONFLCKMTRSPD", WebCfgAclGroup::AdvancedLockConfig, 23),
+    WEBCFG_SETTING_ACL("CONFLCKESSDNM", WebCfgAclGroup::AdvancedLockConfig, 24),
+    WEBCFG_SETTING_ACL("CONFOPNNAME", WebCfgAclGroup::BasicOpenerConfig, 0),
+    WEBCFG_SETTING_ACL("CONFOPNLAT", WebCfgAclGroup::BasicOpenerConfig, 1),
+    WEBCFG_SETTING_ACL("CONFOPNLONG", WebCfgAclGroup::BasicOpenerConfig, 2),
+    WEBCFG_SETTING_ACL("CONFOPNPRENA", WebCfgAclGroup::BasicOpenerConfig, 3),
+    WEBCFG_SETTING_ACL("CONFOPNBTENA", WebCfgAclGroup::BasicOpenerConfig, 4),
+    WEBCFG_SETTING_ACL("CONFOPNLEDENA", WebCfgAclGroup::BasicOpenerConfig, 5),
+    WEBCFG_SETTING_ACL("CONFOPNTZOFF", WebCfgAclGroup::BasicOpenerConfig, 6),
+    WEBCFG_SETTING_ACL("CONFOPNDSTM", WebCfgAclGroup::BasicOpenerConfig, 7),
+    WEBCFG_SETTING_ACL("CONFOPNFOB1", WebCfgAclGroup::BasicOpenerConfig, 8),
+    WEBCFG_SETTING_ACL("CONFOPNFOB2", WebCfgAclGroup::BasicOpenerConfig, 9),
+    WEBCFG_SETTING_ACL("CONFOPNFOB3", WebCfgAclGroup::BasicOpenerConfig, 10),
+    WEBCFG_SETTING_ACL("CONFOPNOPM", WebCfgAclGroup::BasicOpenerConfig, 11),
+    WEBCFG_SETTING_ACL("CONFOPNADVM", WebCfgAclGroup::BasicOpenerConfig, 12),
+    WEBCFG_SETTING_ACL("CONFOPNTZID", WebCfgAclGroup::BasicOpenerConfig, 13),
+    WEBCFG_SETTING_ACL("CONFOPNICID", WebCfgAclGroup::AdvancedOpenerConfig, 0),
+    WEBCFG_SETTING_ACL("CONFOPNBUSMS", WebCfgAclGroup::AdvancedOpenerConfig, 1),
+    WEBCFG_SETTING_ACL("CONFOPNSCDUR", WebCfgAclGroup::AdvancedOpenerConfig, 2),
+    WEBCFG_SETTING_ACL("CONFOPNESD", WebCfgAclGroup::AdvancedOpenerConfig, 3),
+    WEBCFG_SETTING_ACL("CONFOPNRESD", WebCfgAclGroup::AdvancedOpenerConfig, 4),
+    WEBCFG_SETTING_ACL("CONFOPNESDUR", WebCfgAclGroup::AdvancedOpenerConfig, 5),
+    WEBCFG_SETTING_ACL("CONFOPNDRTOAR", WebCfgAclGroup::AdvancedOpenerConfig, 6),
+    WEBCFG_SETTING_ACL("CONFOPNRTOT", WebCfgAclGroup::AdvancedOpenerConfig, 7),
+    WEBCFG_SETTING_ACL("CONFOPNDRBSUP", WebCfgAclGroup::AdvancedOpenerConfig, 8),
+    WEBCFG_SETTING_ACL("CONFOPNDRBSUPDUR", WebCfgAclGroup::AdvancedOpenerConfig, 9),
+    WEBCFG_SETTING_ACL("CONFOPNSRING", WebCfgAclGroup::AdvancedOpenerConfig, 10),
+    WEBCFG_SETTING_ACL("CONFOPNSOPN", WebCfgAclGroup::AdvancedOpenerConfig, 11),
+    WEBCFG_SETTING_ACL("CONFOPNSRTO", WebCfgAclGroup::AdvancedOpenerConfig, 12),
+    WEBCFG_SETTING_ACL("CONFOPNSCM", WebCfgAclGroup::AdvancedOpenerConfig, 13),
+    WEBCFG_SETTING_ACL("CONFOPNSCFRM", WebCfgAclGroup::AdvancedOpenerConfig, 14),
+    WEBCFG_SETTING_ACL("CONFOPNSLVL", WebCfgAclGroup::AdvancedOpenerConfig, 15),
+    WEBCFG_SETTING_ACL("CONFOPNSBPA", WebCfgAclGroup::AdvancedOpenerConfig, 16),
+    WEBCFG_SETTING_ACL("CONFOPNDBPA", WebCfgAclGroup::AdvancedOpenerConfig, 17),
+    WEBCFG_SETTING_ACL("CONFOPNBATT", WebCfgAclGroup::AdvancedOpenerConfig, 18),
+    WEBCFG_SETTING_ACL("CONFOPNABTD", WebCfgAclGroup::AdvancedOpenerConfig, 19),
+    WEBCFG_SETTING_ACL("CONFOPNRBTNUKI", WebCfgAclGroup::AdvancedOpenerConfig, 20),
+    WEBCFG_SETTING_BOOL("REGAPP", preference_register_as_app, false, 0),
+    WEBCFG_SETTING_BOOL("REGAPPOPN", preference_register_opener_as_app, false, 0),
+    WEBCFG_SETTING_BOOL("LOCKENA", preference_lock_enabled, true, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("OPENA", preference_opener_enabled, false, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_BOOL("CONNMODE", preference_connect_mode, true, WEBCFG_CONFIG_CHANGED),
+    WEBCFG_SETTING_STRING("CREDTOTP", preference_totp_secret, "", WEBCFG_CONFIG_CHANGED | WEBCFG_CLEAR_SESSION | WEBCFG_NEW_MFA | WEBCFG_MASKED),
+    WEBCFG_SETTING_STRING("CREDBYPASS", preference_bypass_secret, "", WEBCFG_CONFIG_CHANGED | WEBCFG_MASKED),
+};
+
+static const size_t settingsCount = sizeof(settings) / sizeof(settings[0]);
+
+// Indexed by WebCfgAclGroup
+static const char* const aclPreferences[WEBCFG_ACL_GROUPS] =
+{
+    preference_acl,
+    preference_conf_lock_basic_acl,
+    preference_conf_lock_advanced_acl,
+    preference_conf_opener_basic_acl,
+    preference_conf_opener_advanced_acl
+};
+static const uint8_t aclSizes[WEBCFG_ACL_GROUPS] = { 17, 16, 25, 14, 21 };
+
+static_assert(settingsCount < WEBCFG_SETTINGS_EMPTY, "Slot indices are 8 bit");
+static_assert(settingsCount <= WEBCFG_SETTINGS_SLOTS / 2, "Keep the slot table at most half full");
+
+WebCfgSettings::WebCfgSettings()
+{
+    memset(_slots, WEBCFG_SETTINGS_EMPTY, sizeof(_slots));
+    _hashes.reserve(settingsCount);
+
+    for(size_t i = 0; i < settingsCount; i++)
+    {
+        uint32_t h = hash(settings[i].key);
+        uint32_t slot = h & (WEBCFG_SETTINGS_SLOTS - 1);
+        while(_slots[slot] != WEBCFG_SETTINGS_EMPTY)
+        {
+            slot = (slot + 1) & (WEBCFG_SETTINGS_SLOTS - 1);
+        }
+
+        _slots[slot] = i;
+        _hashes.push_back(h);
+    }
+}
+
+const WebCfgSetting* WebCfgSettings::find(const char* key) const
+{
+    uint32_t h = hash(key);
+    uint32_t slot = h & (WEBCFG_SETTINGS_SLOTS - 1);
+
+    while(_slots[slot] != WEBCFG_SETTINGS_EMPTY)
+    {
+        uint8_t index = _slots[slot];
+        if(_hashes[index] == h && strcmp(settings[index].key, key) == 0)
+        {
+            return &settings[index];
+        }
+        slot = (slot + 1) & (WEBCFG_SETTINGS_SLOTS - 1);
+    }
+
+    return nullptr;
+}
+
+bool WebCfgSettings::apply(const WebCfgSetting& setting, Preferences* preferences, const String& value) const
+{
+    if((setting.flags & WEBCFG_MASKED) != 0 && value == "*")
+    {
+        return false;
+    }
+
+    switch(setting.type)
+    {
+    case WebCfgSettingType::String:
+        if(preferences->getString(setting.preference, setting.defaultString) != value)
+        {
+            preferences->putString(setting.preference, value);
+            return true;
+        }
+        break;
+    case WebCfgSettingType::Int:
+    {
+        if(!valid(setting, value))
+        {
+            break;
+        }
+        long intValue = value.toInt();
+        if(preferences->getInt(setting.preference, setting.defaultValue) != intValue)
+        {
+            preferences->putInt(setting.preference, intValue);
+            return true;
+        }
+        break;
+    }
+    case WebCfgSettingType::Bool:
+        if(preferences->getBool(setting.preference, setting.defaultValue != 0) != (value == "1"))
+        {
+            preferences->putBool(setting.preference, (value == "1"));
+            return true;
+        }
+        break;
+    case WebCfgSettingType::Acl:
+        break;
+    }
+
+    return false;
+}
+
+const WebCfgSetting& WebCfgSettings::at(size_t index) const
+{
+    return settings[index];
+}
+
+bool WebCfgSettings::valid(const WebCfgSetting& setting, const String& value) const
+{
+    if(setting.type != WebCfgSettingType::Int)
+    {
+        return true;
+    }
+
+    long intValue = value.toInt();
+    return intValue >= setting.min && intValue <= setting.max;
+}
+
+size_t WebCfgSettings::count() const
+{
+    return settingsCount;
+}
+
+const char* WebCfgSettings::aclPreference(WebCfgAclGroup group) const
+{
+    return aclPreferences[(uint8_t)group];
+}
+
+uint8_t WebCfgSettings::aclSize(WebCfgAclGroup group) const
+{
+    return aclSizes[(uint8_t)group];
+}
+
+uint32_t WebCfgSettings::hash(const char* key)
+{
+    uint32_t h = 2166136261UL;
+
+    while(*key != 0x00)
+    {
+        h ^= (uint8_t)*key;
+        h *= 16777619UL;
+        ++key;
+    }
+
+    return h;
+}
+
+bool webCfgChangeApproved(Preferences* preferences, const WebCfgApproval& approval)
+{
+    if(!preferences->getBool(preference_cred_duo_approval, false) || (!approval.totpEnabled && !approval.duoEnabled))
+    {
+        return true;
+    }
+
+    return approval.sessionApproved || approval.totpValid || approval.bypassed;
+}
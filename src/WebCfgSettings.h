@@ -0,0 +1,94 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <vector>
+
+#define WEBCFG_SETTINGS_SLOTS 512
+
+// Side effects of a changed setting, evaluated by WebCfgServer::processArgs
+#define WEBCFG_CONFIG_CHANGED 0x01
+#define WEBCFG_NETWORK_RECONFIGURE 0x02
+#define WEBCFG_CLEAR_SESSION 0x04
+#define WEBCFG_NEW_MFA 0x08
+// "*" is sent for a stored secret that wasn't edited, keep the stored value
+#define WEBCFG_MASKED 0x10
+
+enum class WebCfgSettingType : uint8_t
+{
+    String,
+    Int,
+    Bool,
+    Acl
+};
+
+// Number of ACL arrays and entries of the longest one (advanced lock config)
+#define WEBCFG_ACL_GROUPS 5
+#define WEBCFG_ACL_SIZE 25
+
+// Order of the ACL arrays collected by processArgs
+enum class WebCfgAclGroup : uint8_t
+{
+    Actions,
+    BasicLockConfig,
+    AdvancedLockConfig,
+    BasicOpenerConfig,
+    AdvancedOpenerConfig
+};
+
+struct WebCfgSetting
+{
+    const char* key;
+    WebCfgSettingType type;
+    uint8_t flags;
+    const char* preference;
+    const char* defaultString;
+    int32_t defaultValue;
+    int32_t min;
+    int32_t max;
+    WebCfgAclGroup aclGroup;
+    uint8_t aclIndex;
+};
+
+// Sources of the MFA approval a change of the settings needs when DUOAPPROVAL is set
+struct WebCfgApproval
+{
+    bool totpEnabled;
+    bool duoEnabled;
+    bool sessionApproved; // confirmed on the Duo or TOTP page of the session
+    bool totpValid;       // valid TOTP code sent with the request
+    bool bypassed;        // one-time bypass session while the time isn't synced
+};
+
+// True if settings may be changed: DUOAPPROVAL is off, no MFA method is set up or one of the sources approved
+bool webCfgChangeApproved(Preferences* preferences, const WebCfgApproval& approval);
+
+// Settings form fields that map one to one to a preference. Looking up a
+// field costs one hash and usually a single strcmp instead of walking the
+// whole chain of comparisons in processArgs. Fields with additional side
+// effects (files, pairing data, PINs, ...) are still handled there.
+class WebCfgSettings
+{
+public:
+    WebCfgSettings();
+
+    const WebCfgSetting* find(const char* key) const;
+    // Settings in table order, index < count()
+    const WebCfgSetting& at(size_t index) const;
+    // False if the value is out of the range of the setting
+    bool valid(const WebCfgSetting& setting, const String& value) const;
+    // Validates the value and stores it if it differs, returns true if the preference was changed
+    bool apply(const WebCfgSetting& setting, Preferences* preferences, const String& value) const;
+
+    size_t count() const;
+
+    // Preference and number of uint32_t entries of an ACL array
+    const char* aclPreference(WebCfgAclGroup group) const;
+    uint8_t aclSize(WebCfgAclGroup group) const;
+
+private:
+    static uint32_t hash(const char* key);
+
+    std::vector<uint32_t> _hashes;
+    uint8_t _slots[WEBCFG_SETTINGS_SLOTS];
+};
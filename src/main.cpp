@@ -33,6 +33,8 @@
 #include "EspMillis.h"
 #include "NimBLEDevice.h"
 #include "ImportExport.h"
+#include "NukiTaskWakeup.h"
+#include "JobScheduler.h"
 
 /*
 #ifdef DEBUG_NUKIHUB
@@ -44,12 +46,14 @@
 NukiNetworkLock* networkLock = nullptr;
 NukiNetworkOpener* networkOpener = nullptr;
 BleScanner::Scanner* bleScanner = nullptr;
+BleScanner::ScanPolicy* scanPolicy = nullptr;
 NukiWrapper* nuki = nullptr;
 NukiOfficial* nukiOfficial = nullptr;
 NukiOpenerWrapper* nukiOpener = nullptr;
 NukiDeviceId* deviceIdLock = nullptr;
 NukiDeviceId* deviceIdOpener = nullptr;
 Gpio* gpio = nullptr;
+JobScheduler* scheduler = nullptr;
 
 bool lockEnabled = false;
 bool openerEnabled = false;
@@ -275,6 +279,15 @@ void networkTask(void *pvParameters)
         }
 #endif
 
+        if(webCfgServer != nullptr)
+        {
+            webCfgServer->update();
+        }
+        if(webCfgServerSSL != nullptr)
+        {
+            webCfgServerSSL->update();
+        }
+
         if(espMillis() - networkLoopTs > 120000)
         {
             Log->println("networkTask is running");
@@ -319,7 +332,18 @@ void nukiTask(void *pvParameters)
         if(disableNetwork || wifiConnected)
         {
             bleScanner->update();
-            delay(20);
+
+            int64_t ts = espMillis();
+            int64_t deadline = std::min(ts + NUKI_TASK_MAX_SLEEP, scheduler->nextDeadline());
+            if(lockEnabled)
+            {
+                deadline = std::min(deadline, nuki->nextWakeupTs());
+            }
+            if(openerEnabled)
+            {
+                deadline = std::min(deadline, nukiOpener->nextWakeupTs());
+            }
+            NukiTaskWakeup::wait(std::max(deadline, ts + NUKI_TASK_MIN_SLEEP));
 
             bool needsPairing = (lockEnabled && !nuki->isPaired()) || (openerEnabled && !nukiOpener->isPaired());
 
@@ -333,10 +357,12 @@ void nukiTask(void *pvParameters)
                 if(lockEnabled)
                 {
                     bleScanner->whitelist(nuki->getBleAddress());
+                    scanPolicy->track(nuki->getBleAddress());
                 }
                 if(openerEnabled)
                 {
                     bleScanner->whitelist(nukiOpener->getBleAddress());
+                    scanPolicy->track(nukiOpener->getBleAddress());
                 }
             }
 
@@ -349,6 +375,9 @@ void nukiTask(void *pvParameters)
             {
                 nukiOpener->update();
             }
+
+            // one query per pass, pending lock actions are picked up in between
+            scheduler->runNext(espMillis());
         }
 
         if(espMillis() - nukiLoopTs > 120000)
@@ -547,6 +576,7 @@ void setupTasks(bool ota)
         {
             xTaskCreatePinnedToCore(nukiTask, "nuki", preferences->getInt(preference_task_size_nuki, NUKI_TASK_SIZE), NULL, 2, &nukiTaskHandle, 0);
             esp_task_wdt_add(nukiTaskHandle);
+            NukiTaskWakeup::initialize(nukiTaskHandle);
         }
 #endif
     }
@@ -871,8 +901,15 @@ void setup()
         bleScanner = new BleScanner::Scanner();
         // Scan interval and window according to Nuki recommendations:
         // https://developer.nuki.io/t/bluetooth-specification-questions/1109/27
-        bleScanner->initialize("NukiHub", true, 40, 40);
+        bleScanner->initialize("NukiHub", true, BLE_SCAN_WINDOW, BLE_SCAN_WINDOW);
         bleScanner->setScanDuration(0);
+        // continuous while pairing and after commands or beacon changes, lower duty cycle when idle
+        scanPolicy = new BleScanner::ScanPolicy(BLE_SCAN_WINDOW, BLE_SCAN_MAX_INTERVAL, BLE_SCAN_BOOST_DURATION, BLE_SCAN_MAX_LATENCY);
+        bleScanner->setScanPolicy(scanPolicy);
+        // the nuki task sleeps up to NUKI_TASK_MAX_SLEEP, wake it to dispatch advertisements and restart the scan
+        bleScanner->setUpdateNotifier([]() { NukiTaskWakeup::notify(NukiTaskWakeupReason::Scanner); });
+        network->setBleScanner(bleScanner);
+        scheduler = new JobScheduler(NUKI_JOB_TICK, NUKI_JOB_SPREAD);
     }
 
     Log->println(lockEnabled ? F("Nuki Lock enabled") : F("Nuki Lock disabled"));
@@ -886,7 +923,7 @@ void setup()
             networkLock->initialize();
         }
 
-        nuki = new NukiWrapper("NukiHub", deviceIdLock, bleScanner, networkLock, nukiOfficial, gpio, preferences, CharBuffer::get(), buffer_size);
+        nuki = new NukiWrapper("NukiHub", deviceIdLock, bleScanner, networkLock, nukiOfficial, gpio, scheduler, preferences, CharBuffer::get(), buffer_size);
         nuki->initialize();
     }
 
@@ -900,7 +937,7 @@ void setup()
             networkOpener->initialize();
         }
 
-        nukiOpener = new NukiOpenerWrapper("NukiHub", deviceIdOpener, bleScanner, networkOpener, gpio, preferences, CharBuffer::get(), buffer_size);
+        nukiOpener = new NukiOpenerWrapper("NukiHub", deviceIdOpener, bleScanner, networkOpener, gpio, scheduler, preferences, CharBuffer::get(), buffer_size);
         nukiOpener->initialize();
     }
 
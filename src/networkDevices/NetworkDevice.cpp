@@ -143,14 +143,29 @@ void NetworkDevice::mqttSetKeepAlive(uint16_t keepAlive)
     }
 }
 
-uint16_t NetworkDevice::mqttPublish(const char *topic, uint8_t qos, bool retain, const char *payload)
+uint16_t NetworkDevice::mqttPublish(const char *topic, uint8_t qos, bool retain, const char *payload, espMqttClientTypes::Priority priority)
 {
-    return getMqttClient()->publish(topic, qos, retain, payload);
+    return getMqttClient()->publish(topic, qos, retain, payload, priority);
 }
 
-uint16_t NetworkDevice::mqttPublish(const char *topic, uint8_t qos, bool retain, const uint8_t *payload, size_t length)
+uint16_t NetworkDevice::mqttPublish(const char *topic, uint8_t qos, bool retain, const uint8_t *payload, size_t length, espMqttClientTypes::Priority priority)
 {
-    return getMqttClient()->publish(topic, qos, retain, payload, length);
+    return getMqttClient()->publish(topic, qos, retain, payload, length, priority);
+}
+
+uint16_t NetworkDevice::mqttPublish(const char *topic, uint8_t qos, bool retain, espMqttClientTypes::PayloadCallback callback, size_t length, espMqttClientTypes::Priority priority)
+{
+    return getMqttClient()->publish(topic, qos, retain, callback, length, priority);
+}
+
+size_t NetworkDevice::mqttQueueSize(espMqttClientTypes::Priority priority)
+{
+    return getMqttClient()->queueSize(priority);
+}
+
+uint32_t NetworkDevice::mqttDroppedPackets(espMqttClientTypes::Priority priority)
+{
+    return getMqttClient()->droppedPackets(priority);
 }
 
 bool NetworkDevice::mqttConnected() const
@@ -240,11 +255,28 @@ void NetworkDevice::mqttOnDisconnect(espMqttClientTypes::OnDisconnectCallback ca
     }
 }
 
+void NetworkDevice::mqttOnSubscribe(espMqttClientTypes::OnSubscribeCallback callback)
+{
+    if (_useEncryption)
+    {
+        _mqttClientSecure->onSubscribe(callback);
+    }
+    else
+    {
+        _mqttClient->onSubscribe(callback);
+    }
+}
+
 uint16_t NetworkDevice::mqttSubscribe(const char *topic, uint8_t qos)
 {
     return getMqttClient()->subscribe(topic, qos);
 }
 
+uint16_t NetworkDevice::mqttSubscribe(const char* const* topics, size_t numberTopics, uint8_t qos)
+{
+    return getMqttClient()->subscribe(topics, numberTopics, qos);
+}
+
 void NetworkDevice::mqttDisable()
 {
     getMqttClient()->disconnect();
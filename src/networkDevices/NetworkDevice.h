@@ -35,9 +35,16 @@ public:
     virtual void mqttDisable();
     virtual bool mqttConnected() const;
 
-    virtual uint16_t mqttPublish(const char* topic, uint8_t qos, bool retain, const char* payload);
-    virtual uint16_t mqttPublish(const char* topic, uint8_t qos, bool retain, const uint8_t* payload, size_t length);
+    virtual uint16_t mqttPublish(const char* topic, uint8_t qos, bool retain, const char* payload,
+                                 espMqttClientTypes::Priority priority = espMqttClientTypes::Priority::STATE);
+    virtual uint16_t mqttPublish(const char* topic, uint8_t qos, bool retain, const uint8_t* payload, size_t length,
+                                 espMqttClientTypes::Priority priority = espMqttClientTypes::Priority::STATE);
+    virtual uint16_t mqttPublish(const char* topic, uint8_t qos, bool retain, espMqttClientTypes::PayloadCallback callback, size_t length,
+                                 espMqttClientTypes::Priority priority = espMqttClientTypes::Priority::STATE);
+    virtual size_t mqttQueueSize(espMqttClientTypes::Priority priority);
+    virtual uint32_t mqttDroppedPackets(espMqttClientTypes::Priority priority);
     virtual uint16_t mqttSubscribe(const char* topic, uint8_t qos);
+    virtual uint16_t mqttSubscribe(const char* const* topics, size_t numberTopics, uint8_t qos);
     
     virtual void mqttSetServer(const char* host, uint16_t port);
     virtual void mqttSetClientId(const char* clientId);
@@ -49,6 +56,7 @@ public:
     virtual void mqttOnMessage(espMqttClientTypes::OnMessageCallback callback);
     virtual void mqttOnConnect(espMqttClientTypes::OnConnectCallback callback);
     virtual void mqttOnDisconnect(espMqttClientTypes::OnDisconnectCallback callback);
+    virtual void mqttOnSubscribe(espMqttClientTypes::OnSubscribeCallback callback);
     #endif
 
 protected:
@@ -0,0 +1,76 @@
+#pragma once
+
+// Minimal Arduino core for the host tests, only what the tested modules use
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+typedef uint8_t byte;
+
+class String
+{
+public:
+    String() {}
+    String(const char* value) : _value(value != nullptr ? value : "") {}
+    String(const std::string& value) : _value(value) {}
+
+    const char* c_str() const { return _value.c_str(); }
+    size_t length() const { return _value.size(); }
+    long toInt() const { return atol(_value.c_str()); }
+
+    bool operator==(const String& other) const { return _value == other._value; }
+    bool operator!=(const String& other) const { return _value != other._value; }
+    bool operator==(const char* other) const { return _value == other; }
+    bool operator!=(const char* other) const { return _value != other; }
+
+private:
+    std::string _value;
+};
+
+// Discards everything, the tests check state and not log output
+class Print
+{
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t) { return 1; }
+    virtual size_t write(const uint8_t*, size_t size) { return size; }
+
+    template<typename T> size_t print(const T&) { return 0; }
+    template<typename T> size_t println(const T&) { return 0; }
+    size_t println() { return 0; }
+};
+
+extern Print Serial;
+
+inline void delay(uint32_t) {}
+
+class EspClass
+{
+public:
+    void restart() { abort(); }
+};
+
+extern EspClass ESP;
+
+enum esp_reset_reason_t
+{
+    ESP_RST_UNKNOWN,
+    ESP_RST_POWERON,
+    ESP_RST_EXT,
+    ESP_RST_SW,
+    ESP_RST_PANIC,
+    ESP_RST_INT_WDT,
+    ESP_RST_TASK_WDT,
+    ESP_RST_WDT,
+    ESP_RST_DEEPSLEEP,
+    ESP_RST_BROWNOUT,
+    ESP_RST_SDIO
+};
+
+inline esp_reset_reason_t esp_reset_reason()
+{
+    return ESP_RST_UNKNOWN;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <Arduino.h>
+
+#define FILE_WRITE "w"
+
+class File : public Print
+{
+public:
+    explicit operator bool() const { return false; }
+    void close() {}
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+// In memory Preferences for the host tests, counts the writes
+
+#include <Arduino.h>
+#include <map>
+#include <vector>
+
+class Preferences
+{
+public:
+    String getString(const char* key, const String& defaultValue = String())
+    {
+        auto it = strings.find(key);
+        return it == strings.end() ? defaultValue : String(it->second);
+    }
+
+    size_t getString(const char* key, char* value, size_t maxLength)
+    {
+        auto it = strings.find(key);
+        if(it == strings.end() || maxLength == 0)
+        {
+            return 0;
+        }
+        size_t length = std::min(it->second.size(), maxLength - 1);
+        memcpy(value, it->second.c_str(), length);
+        value[length] = 0;
+        return length + 1;
+    }
+
+    size_t putString(const char* key, const String& value)
+    {
+        strings[key] = value.c_str();
+        ++writes;
+        return value.length();
+    }
+
+    int32_t getInt(const char* key, int32_t defaultValue = 0)
+    {
+        auto it = ints.find(key);
+        return it == ints.end() ? defaultValue : it->second;
+    }
+
+    size_t putInt(const char* key, int32_t value)
+    {
+        ints[key] = value;
+        ++writes;
+        return sizeof(value);
+    }
+
+    bool getBool(const char* key, bool defaultValue = false)
+    {
+        auto it = bools.find(key);
+        return it == bools.end() ? defaultValue : it->second;
+    }
+
+    size_t putBool(const char* key, bool value)
+    {
+        bools[key] = value;
+        ++writes;
+        return 1;
+    }
+
+    size_t putBytes(const char* key, const void* value, size_t length)
+    {
+        bytes[key].assign((const uint8_t*)value, (const uint8_t*)value + length);
+        ++writes;
+        return length;
+    }
+
+    bool operator==(const Preferences& other) const
+    {
+        return strings == other.strings && ints == other.ints && bools == other.bools && bytes == other.bytes;
+    }
+
+    std::map<std::string, std::string> strings;
+    std::map<std::string, int32_t> ints;
+    std::map<std::string, bool> bools;
+    std::map<std::string, std::vector<uint8_t>> bytes;
+    int writes = 0;
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <FS.h>
+
+class SPIFFSFS
+{
+public:
+    bool begin(bool) { return false; }
+    File open(const char*, const char*) { return File(); }
+};
+
+extern SPIFFSFS SPIFFS;
@@ -0,0 +1,10 @@
+#pragma once
+
+class WiFiClass
+{
+public:
+    void begin() {}
+    bool disconnect(bool, bool) { return true; }
+};
+
+extern WiFiClass WiFi;
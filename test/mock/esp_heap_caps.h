@@ -0,0 +1,3 @@
+#pragma once
+
+// The SPIRAM allocation of the topic registry is compiled out on the host
@@ -0,0 +1,3 @@
+#pragma once
+
+// No ESP-IDF target is defined on the host, Config.h falls back to the ESP32 defaults
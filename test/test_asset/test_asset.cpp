@@ -0,0 +1,101 @@
+#include <unity.h>
+
+#include <cstring>
+#include <string>
+
+#include <WebCfgServerConstants.h>
+
+void setUp() {}
+void tearDown() {}
+
+/*
+- the generated tags are quoted, strong and differ per asset
+*/
+void test_generatedTags() {
+  const WebCfgAsset* assets[] = {&stylecss, &statusjs, &favicon};
+  for (const WebCfgAsset* asset : assets) {
+    size_t length = strlen(asset->etag);
+    TEST_ASSERT_EQUAL_UINT32(18, length);
+    TEST_ASSERT_EQUAL_CHAR('"', asset->etag[0]);
+    TEST_ASSERT_EQUAL_CHAR('"', asset->etag[length - 1]);
+  }
+  TEST_ASSERT_TRUE(strcmp(stylecss.etag, statusjs.etag) != 0);
+  TEST_ASSERT_TRUE(strcmp(stylecss.etag, favicon.etag) != 0);
+  TEST_ASSERT_TRUE(strcmp(statusjs.etag, favicon.etag) != 0);
+}
+
+/*
+- the tag itself, "*", a weak variant and a tag anywhere in a list match
+*/
+void test_matches() {
+  const char* etag = stylecss.etag;
+  std::string tag = etag;
+
+  TEST_ASSERT_TRUE(webCfgAssetNotModified(etag, etag));
+  TEST_ASSERT_TRUE(webCfgAssetNotModified("*", etag));
+  TEST_ASSERT_TRUE(webCfgAssetNotModified(("W/" + tag).c_str(), etag));
+  TEST_ASSERT_TRUE(webCfgAssetNotModified(("\"abc\", " + tag).c_str(), etag));
+  TEST_ASSERT_TRUE(webCfgAssetNotModified(("\"abc\",W/" + tag + " ,\"x\"").c_str(), etag));
+  TEST_ASSERT_TRUE(webCfgAssetNotModified((" \t" + tag + ",").c_str(), etag));
+}
+
+/*
+- other tags, empty or missing headers and malformed lists don't match
+- a prefix or an unterminated tag is not mistaken for the tag
+*/
+void test_noMatch() {
+  const char* etag = stylecss.etag;
+  std::string tag = etag;
+
+  TEST_ASSERT_FALSE(webCfgAssetNotModified("\"abc\"", etag));
+  TEST_ASSERT_FALSE(webCfgAssetNotModified(statusjs.etag, etag));
+  TEST_ASSERT_FALSE(webCfgAssetNotModified("", etag));
+  TEST_ASSERT_FALSE(webCfgAssetNotModified(" , ", etag));
+  TEST_ASSERT_FALSE(webCfgAssetNotModified(nullptr, etag));
+  TEST_ASSERT_FALSE(webCfgAssetNotModified(etag, nullptr));
+  TEST_ASSERT_FALSE(webCfgAssetNotModified(tag.substr(1, tag.size() - 2).c_str(), etag));
+  TEST_ASSERT_FALSE(webCfgAssetNotModified((tag.substr(0, tag.size() - 2) + "\"").c_str(), etag));
+  TEST_ASSERT_FALSE(webCfgAssetNotModified(tag.substr(0, tag.size() - 1).c_str(), etag));
+  TEST_ASSERT_FALSE(webCfgAssetNotModified("garbage, *", etag));
+}
+
+/*
+- gzip, x-gzip and "*" with a non-zero qvalue are accepted, in any case and position
+- without the header any coding is acceptable
+*/
+void test_acceptsGzip() {
+  TEST_ASSERT_TRUE(webCfgAssetAcceptsGzip(nullptr));
+  TEST_ASSERT_TRUE(webCfgAssetAcceptsGzip("gzip"));
+  TEST_ASSERT_TRUE(webCfgAssetAcceptsGzip("gzip, deflate, br, zstd"));
+  TEST_ASSERT_TRUE(webCfgAssetAcceptsGzip("br;q=1.0, GZIP;q=0.5"));
+  TEST_ASSERT_TRUE(webCfgAssetAcceptsGzip("deflate, x-gzip"));
+  TEST_ASSERT_TRUE(webCfgAssetAcceptsGzip("gzip; q=0.001"));
+  TEST_ASSERT_TRUE(webCfgAssetAcceptsGzip("identity, *"));
+  TEST_ASSERT_TRUE(webCfgAssetAcceptsGzip("*;q=0, gzip;q=1"));
+}
+
+/*
+- an empty header, only other codings or a qvalue of zero refuse gzip
+- an entry for gzip takes precedence over "*"
+- codings that only start or end with gzip are not gzip
+*/
+void test_refusesGzip() {
+  TEST_ASSERT_FALSE(webCfgAssetAcceptsGzip(""));
+  TEST_ASSERT_FALSE(webCfgAssetAcceptsGzip("identity"));
+  TEST_ASSERT_FALSE(webCfgAssetAcceptsGzip("deflate, br"));
+  TEST_ASSERT_FALSE(webCfgAssetAcceptsGzip("gzip;q=0"));
+  TEST_ASSERT_FALSE(webCfgAssetAcceptsGzip("br, gzip; q=0.000"));
+  TEST_ASSERT_FALSE(webCfgAssetAcceptsGzip("gzip;q=0, *"));
+  TEST_ASSERT_FALSE(webCfgAssetAcceptsGzip("*;q=0"));
+  TEST_ASSERT_FALSE(webCfgAssetAcceptsGzip("gzipx, xgzip"));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_generatedTags);
+  RUN_TEST(test_matches);
+  RUN_TEST(test_noMatch);
+  RUN_TEST(test_acceptsGzip);
+  RUN_TEST(test_refusesGzip);
+  return UNITY_END();
+}
@@ -0,0 +1,273 @@
+#include <unity.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <LockActionExecutor.h>
+
+void setUp() {}
+void tearDown() {}
+
+enum class Action { Lock, Unlock, Unlatch };
+
+static bool coalescable(Action action) {
+  return action != Action::Unlatch;
+}
+
+typedef LockActionExecutor<Action> Executor;
+
+// a lock that fails the first 'failures' attempts
+struct FakeLock {
+  int failures;
+  std::vector<Action> attempts;
+
+  bool execute(Action action) {
+    attempts.push_back(action);
+    return failures-- <= 0;
+  }
+};
+
+/*
+- a failing action is retried after the retry delay, the owner is polled in between and not blocked
+*/
+void test_retryWithoutBlocking() {
+  Executor executor(coalescable);
+  executor.setRetries(3, 100);
+  FakeLock lock{2, {}};
+  executor.submit(Action::Lock);
+
+  Executor::Command command;
+  int64_t doneTs = -1;
+  int polls = 0;
+  for (int64_t now = 0; now < 1000 && doneTs < 0; now += 20) {
+    ++polls;
+    if (executor.next(now, command)) {
+      if (executor.complete(lock.execute(command.action), now, command) == Executor::Step::Success) {
+        doneTs = now;
+      }
+    }
+  }
+  TEST_ASSERT_EQUAL_INT(200, doneTs);
+  TEST_ASSERT_EQUAL_INT(2, command.retryCount);
+  TEST_ASSERT_EQUAL_UINT32(3, lock.attempts.size());
+  TEST_ASSERT_EQUAL_INT(11, polls);
+  TEST_ASSERT_EQUAL_UINT32(0, executor.size());
+}
+
+/*
+- after the last retry the command fails and is dropped
+*/
+void test_retriesExhausted() {
+  Executor executor(coalescable);
+  executor.setRetries(2, 100);
+  FakeLock lock{10, {}};
+  executor.submit(Action::Lock);
+
+  Executor::Command command;
+  int failed = 0;
+  for (int64_t now = 0; now < 1000; now += 20) {
+    if (executor.next(now, command) &&
+        executor.complete(lock.execute(command.action), now, command) == Executor::Step::Failed) {
+      ++failed;
+    }
+  }
+  TEST_ASSERT_EQUAL_INT(1, failed);
+  TEST_ASSERT_EQUAL_UINT32(3, lock.attempts.size());
+  TEST_ASSERT_EQUAL_UINT32(0, executor.size());
+  TEST_ASSERT_TRUE(executor.nextAttemptTs() == INT64_MAX);
+}
+
+/*
+- a duplicate of the last queued action is merged into it
+- a state changing action replaces the ones queued after the last momentary action
+- momentary actions are always kept, the queue rejects what doesn't fit
+- commands run in submission order
+*/
+void test_coalescing() {
+  Executor executor(coalescable);
+  executor.setRetries(2, 100);
+  std::vector<uint32_t> superseded;
+  executor.onSuperseded([&](const Executor::Command& command) { superseded.push_back(command.id); });
+
+  uint32_t unlock = executor.submit(Action::Unlock);
+  TEST_ASSERT_EQUAL_UINT32(unlock, executor.submit(Action::Unlock));
+  TEST_ASSERT_EQUAL_UINT32(1, executor.coalesced());
+
+  uint32_t lock = executor.submit(Action::Lock);
+  TEST_ASSERT_EQUAL_UINT32(1, superseded.size());
+  TEST_ASSERT_EQUAL_UINT32(unlock, superseded[0]);
+  TEST_ASSERT_EQUAL_UINT32(1, executor.size());
+
+  uint32_t unlatch = executor.submit(Action::Unlatch);
+  uint32_t unlatch2 = executor.submit(Action::Unlatch);
+  TEST_ASSERT_TRUE(unlatch != unlatch2);
+  uint32_t lock2 = executor.submit(Action::Lock);
+  TEST_ASSERT_EQUAL_UINT32(4, executor.size());
+  TEST_ASSERT_EQUAL_UINT32(0, executor.submit(Action::Unlatch));
+  TEST_ASSERT_EQUAL_UINT32(1, executor.rejected());
+
+  std::vector<uint32_t> order;
+  Executor::Command command;
+  for (int64_t now = 0; now < 1000; now += 10) {
+    if (executor.next(now, command)) {
+      order.push_back(command.id);
+      executor.complete(true, now, command);
+    }
+  }
+  TEST_ASSERT_TRUE((order == std::vector<uint32_t>{lock, unlatch, unlatch2, lock2}));
+}
+
+/*
+- a failing command delays the ones behind it, they run after it failed for good
+*/
+void test_failingHeadKeepsOrder() {
+  Executor executor(coalescable);
+  executor.setRetries(1, 50);
+  executor.submit(Action::Unlatch);
+  executor.submit(Action::Lock);
+
+  Executor::Command command;
+  TEST_ASSERT_TRUE(executor.next(0, command));
+  TEST_ASSERT_TRUE(command.action == Action::Unlatch);
+  TEST_ASSERT_TRUE(executor.complete(false, 0, command) == Executor::Step::Retry);
+  TEST_ASSERT_EQUAL_INT(50, executor.nextAttemptTs());
+  TEST_ASSERT_FALSE(executor.next(10, command));
+
+  TEST_ASSERT_TRUE(executor.next(50, command));
+  TEST_ASSERT_TRUE(command.action == Action::Unlatch);
+  TEST_ASSERT_EQUAL_INT(1, command.retryCount);
+  TEST_ASSERT_TRUE(executor.complete(false, 50, command) == Executor::Step::Failed);
+
+  TEST_ASSERT_TRUE(executor.next(50, command));
+  TEST_ASSERT_TRUE(command.action == Action::Lock);
+}
+
+/*
+- a state change submitted while the previous one waits for its retry cancels the remaining retries
+- one submitted while an attempt is running decides when the attempt completes
+*/
+void test_supersededRetries() {
+  Executor executor(coalescable);
+  executor.setRetries(3, 100);
+  FakeLock lock{1, {}};
+  executor.submit(Action::Unlock);
+
+  Executor::Command command;
+  TEST_ASSERT_TRUE(executor.next(0, command));
+  TEST_ASSERT_TRUE(executor.complete(lock.execute(command.action), 0, command) == Executor::Step::Retry);
+  executor.submit(Action::Lock);
+  TEST_ASSERT_TRUE(executor.next(20, command));
+  TEST_ASSERT_TRUE(command.action == Action::Lock);
+  TEST_ASSERT_TRUE(executor.complete(lock.execute(command.action), 20, command) == Executor::Step::Success);
+  TEST_ASSERT_FALSE(executor.next(500, command));
+  TEST_ASSERT_EQUAL_UINT32(2, lock.attempts.size());
+  TEST_ASSERT_EQUAL_UINT32(1, executor.superseded());
+
+  executor.submit(Action::Unlock);
+  TEST_ASSERT_TRUE(executor.next(600, command));
+  executor.submit(Action::Lock);
+  TEST_ASSERT_TRUE(executor.complete(false, 600, command) == Executor::Step::Superseded);
+  TEST_ASSERT_TRUE(executor.next(600, command));
+  TEST_ASSERT_TRUE(command.action == Action::Lock);
+  TEST_ASSERT_TRUE(executor.complete(true, 600, command) == Executor::Step::Success);
+}
+
+/*
+- four tasks submit while the owner drains the queue
+- every accepted command runs exactly once, in submission order
+*/
+void test_concurrentSubmit() {
+  typedef std::chrono::steady_clock Clock;
+  typedef LockActionExecutor<Action, 8> SmallExecutor;
+  const int nrOfTasks = 4;
+  const int submitsPerTask = 50000;
+  SmallExecutor executor(coalescable);
+  executor.setRetries(0, 0);
+
+  std::atomic<uint32_t> superseded{0};
+  executor.onSuperseded([&](const SmallExecutor::Command&) { ++superseded; });
+
+  // submit time per command id, ids are handed out in sequence starting at 1
+  std::vector<std::atomic<int64_t>> submittedTs(nrOfTasks * submitsPerTask + 1);
+  std::atomic<uint32_t> accepted{0};
+  std::atomic<uint32_t> rejected{0};
+  std::atomic<bool> stop{false};
+  uint32_t executed = 0;
+  uint32_t lastId = 0;
+  bool inOrder = true;
+  std::vector<double> latencies;
+
+  std::thread owner([&] {
+    SmallExecutor::Command command;
+    while (!stop || executor.size() > 0) {
+      if (!executor.next(0, command)) {
+        std::this_thread::yield();
+        continue;
+      }
+      int64_t now = Clock::now().time_since_epoch().count();
+      inOrder &= command.id > lastId;
+      lastId = command.id;
+      // the submitting task stores the time right after submit() returned
+      int64_t ts;
+      while ((ts = submittedTs[command.id].load()) == 0) {
+        std::this_thread::yield();
+      }
+      latencies.push_back(std::chrono::duration<double, std::micro>(Clock::duration(now - ts)).count());
+      executor.complete(true, 0, command);
+      ++executed;
+    }
+  });
+
+  std::vector<std::thread> tasks;
+  for (int task = 0; task < nrOfTasks; ++task) {
+    tasks.emplace_back([&, task] {
+      for (int i = 0; i < submitsPerTask; ++i) {
+        Action action = (Action)((i + task) % 3);
+        int64_t ts = Clock::now().time_since_epoch().count();
+        uint32_t id = executor.submit(action);
+        if (id == 0) {
+          ++rejected;
+        } else {
+          int64_t expected = 0;
+          if (submittedTs[id].compare_exchange_strong(expected, ts)) {
+            ++accepted;
+          }
+        }
+        std::this_thread::yield();
+      }
+    });
+  }
+  for (std::thread& task : tasks) {
+    task.join();
+  }
+  stop = true;
+  owner.join();
+
+  TEST_ASSERT_TRUE(inOrder);
+  TEST_ASSERT_EQUAL_UINT32(0, executor.size());
+  // accepted commands either ran or were superseded, coalesced submits return an existing id
+  TEST_ASSERT_EQUAL_UINT32(accepted.load(), executed + superseded.load());
+  TEST_ASSERT_TRUE(executed > 0);
+
+  std::sort(latencies.begin(), latencies.end());
+  char message[160];
+  snprintf(message, sizeof(message), "executed %u, superseded %u, coalesced %u, rejected %u, latency p50 %.1f us, p99 %.1f us",
+           executed, superseded.load(), executor.coalesced(), rejected.load(),
+           latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100]);
+  TEST_MESSAGE(message);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_retryWithoutBlocking);
+  RUN_TEST(test_retriesExhausted);
+  RUN_TEST(test_coalescing);
+  RUN_TEST(test_failingHeadKeepsOrder);
+  RUN_TEST(test_supersededRetries);
+  RUN_TEST(test_concurrentSubmit);
+  return UNITY_END();
+}
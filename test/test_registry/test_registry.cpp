@@ -0,0 +1,143 @@
+#include <unity.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include <MqttTopicRegistry.h>
+#include <MqttTopics.h>
+
+void setUp() {}
+void tearDown() {}
+
+static const char lockPrefix[] = "nuki";
+static const char openerPrefix[] = "nukiopener";
+
+// NukiNetwork::buildMqttPath, which every publish ran before the registry
+static void buildPath(char* outPath, std::initializer_list<const char*> paths) {
+  int offset = 0;
+  int pathCount = 0;
+
+  for (const char* path : paths) {
+    if (pathCount > 0 && path[0] != '/') {
+      outPath[offset] = '/';
+      ++offset;
+    }
+
+    int i = 0;
+    while (path[i] != 0) {
+      outPath[offset] = path[i];
+      ++offset;
+      ++i;
+    }
+    ++pathCount;
+  }
+
+  outPath[offset] = 0x00;
+}
+
+/*
+- topics are found by content, copies of prefix and path resolve to the same id
+*/
+void test_findByContent() {
+  MqttTopicRegistry registry;
+  const uint16_t id = registry.add(lockPrefix, mqtt_topic_lock_state);
+  TEST_ASSERT_TRUE(id != MqttTopicRegistry::InvalidId);
+  TEST_ASSERT_EQUAL_STRING("nuki/state", registry.topic(id));
+
+  std::string prefix = lockPrefix;
+  std::string path = "/state";
+  TEST_ASSERT_EQUAL_UINT16(id, registry.find(prefix.c_str(), path.c_str()));
+  TEST_ASSERT_EQUAL_UINT16(id, registry.add(prefix.c_str(), path.c_str()));
+  TEST_ASSERT_EQUAL_UINT32(1, registry.count());
+
+  TEST_ASSERT_EQUAL_UINT16(MqttTopicRegistry::InvalidId, registry.find(openerPrefix, "/state"));
+  TEST_ASSERT_EQUAL_UINT16(MqttTopicRegistry::InvalidId, registry.find(lockPrefix, "/stat"));
+  TEST_ASSERT_EQUAL_UINT16(MqttTopicRegistry::InvalidId, registry.find("nuk", "i/state"));
+}
+
+/*
+- a path without leading slash is joined with one, like buildMqttPath
+- equals compares registered and unregistered topics in place
+*/
+void test_separator() {
+  MqttTopicRegistry registry;
+  const uint16_t id = registry.add(lockPrefix, "state");
+  TEST_ASSERT_EQUAL_STRING("nuki/state", registry.topic(id));
+  TEST_ASSERT_EQUAL_UINT16(id, registry.find(lockPrefix, "/state"));
+
+  TEST_ASSERT_TRUE(registry.equals(lockPrefix, "/state", "nuki/state"));
+  TEST_ASSERT_TRUE(registry.equals(lockPrefix, "/action", "nuki/action"));
+  TEST_ASSERT_TRUE(registry.equals(lockPrefix, "action", "nuki/action"));
+  TEST_ASSERT_FALSE(registry.equals(lockPrefix, "/action", "nukiaction"));
+  TEST_ASSERT_FALSE(registry.equals(lockPrefix, "/action", "nuki/actions"));
+  TEST_ASSERT_FALSE(registry.equals(openerPrefix, "/action", "nuki/action"));
+}
+
+/*
+- all topics of both devices are registered once and resolve to their full path
+*/
+void test_allTopics() {
+  MqttTopics mqttTopics;
+  MqttTopicRegistry registry;
+  registry.add(lockPrefix, mqttTopics.getMqttTopics());
+  registry.add(openerPrefix, mqttTopics.getMqttTopics());
+  TEST_ASSERT_EQUAL_UINT32(2 * mqttTopics.getMqttTopics().size(), registry.count());
+
+  char path[200];
+  for (const char* topic : mqttTopics.getMqttTopics()) {
+    for (const char* prefix : {lockPrefix, openerPrefix}) {
+      const uint16_t id = registry.find(prefix, topic);
+      TEST_ASSERT_TRUE(id != MqttTopicRegistry::InvalidId);
+      buildPath(path, {prefix, topic});
+      TEST_ASSERT_EQUAL_STRING(path, registry.topic(id));
+    }
+  }
+}
+
+/*
+- resolving a topic for a publish: building the path as before against a registry lookup
+*/
+void test_publishBenchmark() {
+  MqttTopics mqttTopics;
+  MqttTopicRegistry registry;
+  registry.add(lockPrefix, mqttTopics.getMqttTopics());
+  registry.add(openerPrefix, mqttTopics.getMqttTopics());
+
+  const std::vector<char*> topics = mqttTopics.getMqttTopics();
+  const int rounds = 500000;
+  size_t checksum = 0;
+  char path[200];
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int round = 0; round < rounds; ++round) {
+    buildPath(path, {round & 1 ? openerPrefix : lockPrefix, topics[round % topics.size()]});
+    checksum += path[round % 8];
+  }
+  std::chrono::steady_clock::time_point middle = std::chrono::steady_clock::now();
+  for (int round = 0; round < rounds; ++round) {
+    const char* resolved = registry.topic(registry.find(round & 1 ? openerPrefix : lockPrefix, topics[round % topics.size()]));
+    checksum -= resolved[round % 8];
+  }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+  TEST_ASSERT_EQUAL_UINT32(0, checksum);
+
+  char message[120];
+  snprintf(message, sizeof(message), "%u topics: build %.1f ns, registry %.1f ns per publish", (unsigned)registry.count(),
+           std::chrono::duration<double, std::nano>(middle - start).count() / rounds,
+           std::chrono::duration<double, std::nano>(end - middle).count() / rounds);
+  TEST_MESSAGE(message);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_findByContent);
+  RUN_TEST(test_separator);
+  RUN_TEST(test_allTopics);
+  RUN_TEST(test_publishBenchmark);
+  return UNITY_END();
+}
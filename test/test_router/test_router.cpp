@@ -0,0 +1,208 @@
+#include <unity.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <MqttTopicRegistry.h>
+#include <MqttTopicRouter.h>
+#include <MqttTopics.h>
+
+void setUp() {}
+void tearDown() {}
+
+static const char lockPrefix[] = "nuki";
+static const char openerPrefix[] = "nukiopener";
+static const char maintenancePrefix[] = "nukihub";
+
+struct Subscription {
+  const char* prefix;
+  const char* path;
+};
+
+// the command topics NukiNetwork, NukiNetworkLock and NukiNetworkOpener subscribe to
+// with keypad, time control and authorization control enabled
+static std::vector<Subscription> subscriptions() {
+  std::vector<Subscription> result = {{maintenancePrefix, mqtt_topic_reset},
+                                      {maintenancePrefix, mqtt_topic_update},
+                                      {maintenancePrefix, mqtt_topic_webserver_action},
+                                      {maintenancePrefix, mqtt_topic_nuki_hub_config_action}};
+  for (const char* prefix : {lockPrefix, openerPrefix}) {
+    for (const char* path : {mqtt_topic_lock_action, mqtt_topic_config_action, mqtt_topic_query_config,
+                             mqtt_topic_query_lockstate, mqtt_topic_query_battery, mqtt_topic_keypad_command_action,
+                             mqtt_topic_keypad_command_id, mqtt_topic_keypad_command_name, mqtt_topic_keypad_command_code,
+                             mqtt_topic_keypad_command_enabled, mqtt_topic_query_keypad, mqtt_topic_keypad_json_action,
+                             mqtt_topic_timecontrol_action, mqtt_topic_auth_action, mqtt_topic_lock_log_rolling_last}) {
+      result.push_back({prefix, path});
+    }
+  }
+  return result;
+}
+
+static std::string fullPath(const char* prefix, const char* path) {
+  return std::string(prefix) + (path[0] == '/' ? "" : "/") + path;
+}
+
+/*
+- a message is dispatched to the handler of its exact topic with topic, payload and length
+*/
+void test_exactMatch() {
+  MqttTopicRegistry registry;
+  MqttTopicRouter router(&registry);
+  std::string received;
+  int calls = 0;
+  TEST_ASSERT_TRUE(router.add(registry.add(lockPrefix, mqtt_topic_lock_action), [&](const char* topic, const char* data, const unsigned int length) {
+    received = std::string(topic) + "=" + std::string(data, length);
+    ++calls;
+  }));
+  TEST_ASSERT_TRUE(router.add(registry.add(openerPrefix, mqtt_topic_lock_action), [&](const char*, const char*, const unsigned int) {
+    TEST_FAIL_MESSAGE("opener handler called for a lock topic");
+  }));
+
+  TEST_ASSERT_TRUE(router.dispatch("nuki/action", "unlock", 6));
+  TEST_ASSERT_EQUAL_INT(1, calls);
+  TEST_ASSERT_EQUAL_STRING("nuki/action=unlock", received.c_str());
+}
+
+/*
+- handlers added for the same topic are all called, in the order they were added
+*/
+void test_multipleHandlers() {
+  MqttTopicRegistry registry;
+  MqttTopicRouter router(&registry);
+  std::string order;
+  router.add(registry.add(lockPrefix, mqtt_topic_query_lockstate), [&](const char*, const char*, const unsigned int) { order += "a"; });
+  router.add(registry.add(lockPrefix, mqtt_topic_query_battery), [&](const char*, const char*, const unsigned int) { order += "x"; });
+  router.add(registry.add(lockPrefix, mqtt_topic_query_lockstate), [&](const char*, const char*, const unsigned int) { order += "b"; });
+
+  TEST_ASSERT_TRUE(router.dispatch("nuki/query/lockstate", "1", 1));
+  TEST_ASSERT_EQUAL_STRING("ab", order.c_str());
+  TEST_ASSERT_EQUAL_UINT32(3, router.count());
+}
+
+/*
+- prefixes, extensions and other devices' topics are not dispatched
+- there are no wildcard routes, the gpio topics are left to NukiNetwork::parseGpioTopics
+*/
+void test_noPartialMatch() {
+  MqttTopicRegistry registry;
+  MqttTopicRouter router(&registry);
+  int calls = 0;
+  router.add(registry.add(lockPrefix, mqtt_topic_keypad_command_action), [&](const char*, const char*, const unsigned int) { ++calls; });
+
+  for (const char* topic : {"nuki/keypad/command", "nuki/keypad/command/actio", "nuki/keypad/command/action/", "nuki/keypad/command/actions",
+                            "nukiopener/keypad/command/action", "nuki/keypad/command/+", "nuki/keypad/#", "nuki/gpio/pin_17/state", ""}) {
+    TEST_ASSERT_FALSE(router.dispatch(topic, "", 0));
+  }
+  TEST_ASSERT_EQUAL_INT(0, calls);
+  TEST_ASSERT_TRUE(router.dispatch("nuki/keypad/command/action", "add", 3));
+  TEST_ASSERT_EQUAL_INT(1, calls);
+}
+
+/*
+- routes that don't fit into the table go to the fallback list and are still dispatched
+- a topic the registry couldn't intern can only be added as fallback
+*/
+void test_fallback() {
+  MqttTopicRegistry registry;
+  MqttTopicRouter router(&registry);
+  std::vector<int> calls(200, 0);
+  std::vector<std::string> topics;
+
+  for (int i = 0; i < 200; ++i) {
+    topics.push_back("/topic" + std::to_string(i));
+    MqttTopicHandler handler = [&calls, i](const char*, const char*, const unsigned int) { ++calls[i]; };
+    if (!router.add(registry.add(lockPrefix, topics[i].c_str()), handler)) {
+      router.addFallback(fullPath(lockPrefix, topics[i].c_str()).c_str(), handler);
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT32(MQTT_TOPIC_ROUTER_SLOTS / 4 * 3, router.count());
+  TEST_ASSERT_EQUAL_UINT32(200 - router.count(), router.fallbackCount());
+
+  for (int i = 0; i < 200; ++i) {
+    TEST_ASSERT_TRUE(router.dispatch(fullPath(lockPrefix, topics[i].c_str()).c_str(), "", 0));
+  }
+  for (int i = 0; i < 200; ++i) {
+    TEST_ASSERT_EQUAL_INT(1, calls[i]);
+  }
+  TEST_ASSERT_FALSE(router.dispatch("nuki/topic200", "", 0));
+
+  TEST_ASSERT_FALSE(router.add(MqttTopicRegistry::InvalidId, [](const char*, const char*, const unsigned int) {}));
+}
+
+/*
+- replay of a message mix against the previous chain that compared every subscribed topic in place
+*/
+void test_replayBenchmark() {
+  MqttTopicRegistry registry;
+  MqttTopicRouter router(&registry);
+  const std::vector<Subscription> subscribed = subscriptions();
+  int routed = 0;
+  for (const Subscription& subscription : subscribed) {
+    router.add(registry.add(subscription.prefix, subscription.path), [&](const char*, const char*, const unsigned int) { ++routed; });
+  }
+
+  // a day of a lock and an opener driven by Home Assistant: mostly lock actions and state queries,
+  // some keypad and configuration commands and the gpio topics that aren't routed
+  std::vector<std::string> replay;
+  const struct {
+    const char* prefix;
+    const char* path;
+    int count;
+  } mix[] = {{lockPrefix, mqtt_topic_lock_action, 40},       {lockPrefix, mqtt_topic_query_lockstate, 20},
+             {openerPrefix, mqtt_topic_lock_action, 15},     {openerPrefix, mqtt_topic_query_lockstate, 8},
+             {lockPrefix, mqtt_topic_query_battery, 4},      {lockPrefix, mqtt_topic_keypad_json_action, 3},
+             {lockPrefix, mqtt_topic_config_action, 2},      {lockPrefix, mqtt_topic_lock_log_rolling_last, 2},
+             {maintenancePrefix, mqtt_topic_webserver_action, 1}, {lockPrefix, "/gpio/pin_17/state", 5}};
+  for (const auto& entry : mix) {
+    for (int i = 0; i < entry.count; ++i) {
+      replay.push_back(fullPath(entry.prefix, entry.path));
+    }
+  }
+  std::vector<std::string> shuffled;
+  for (size_t i = 0; i < replay.size(); ++i) {
+    shuffled.push_back(replay[(i * 37) % replay.size()]);
+  }
+
+  const int rounds = 20000;
+  int chained = 0;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int round = 0; round < rounds; ++round) {
+    for (const std::string& topic : shuffled) {
+      for (const Subscription& subscription : subscribed) {
+        if (registry.equals(subscription.prefix, subscription.path, topic.c_str())) {
+          ++chained;
+        }
+      }
+    }
+  }
+  std::chrono::steady_clock::time_point middle = std::chrono::steady_clock::now();
+  for (int round = 0; round < rounds; ++round) {
+    for (const std::string& topic : shuffled) {
+      router.dispatch(topic.c_str(), "", 0);
+    }
+  }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+  TEST_ASSERT_EQUAL_INT(chained, routed);
+  TEST_ASSERT_EQUAL_INT(rounds * (int)(shuffled.size() - 5), routed);
+
+  const double messages = (double)rounds * shuffled.size();
+  char message[120];
+  snprintf(message, sizeof(message), "%u routes: chain %.1f ns, router %.1f ns per message", (unsigned)router.count(),
+           std::chrono::duration<double, std::nano>(middle - start).count() / messages,
+           std::chrono::duration<double, std::nano>(end - middle).count() / messages);
+  TEST_MESSAGE(message);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_exactMatch);
+  RUN_TEST(test_multipleHandlers);
+  RUN_TEST(test_noPartialMatch);
+  RUN_TEST(test_fallback);
+  RUN_TEST(test_replayBenchmark);
+  return UNITY_END();
+}
@@ -0,0 +1,166 @@
+#include <unity.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <JobScheduler.h>
+
+void setUp() {}
+void tearDown() {}
+
+const uint32_t tickMs = 50;
+const uint32_t spreadMs = 500;
+
+/*
+- jobs due at the same time run by priority, one per runNext()
+- a deadline hours away passes through all wheel levels and the overflow list
+*/
+void test_priorityAndLongDeadlines() {
+  JobScheduler scheduler(tickMs, 0);
+  std::vector<std::string> runs;
+  int a = scheduler.add("a", 0, 1, [&](int64_t now) { runs.push_back("a@" + std::to_string(now)); });
+  int b = scheduler.add("b", 0, 0, [&](int64_t now) { runs.push_back("b@" + std::to_string(now)); });
+  int c = scheduler.add("c", 0, 2, [&](int64_t now) { runs.push_back("c@" + std::to_string(now)); });
+  scheduler.schedule(a, 1000);
+  scheduler.schedule(b, 1000);
+  scheduler.schedule(c, 12LL * 3600 * 1000);
+  TEST_ASSERT_TRUE(scheduler.nextDeadline() == 1000);
+
+  TEST_ASSERT_TRUE(scheduler.runNext(1000));
+  TEST_ASSERT_EQUAL_UINT32(1, runs.size());
+  for (int64_t now = 1000; now <= 13LL * 3600 * 1000; now += 10) {
+    while (scheduler.runNext(now)) {
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT32(3, runs.size());
+  TEST_ASSERT_EQUAL_STRING("b@1000", runs[0].c_str());
+  TEST_ASSERT_EQUAL_STRING("a@1000", runs[1].c_str());
+  TEST_ASSERT_EQUAL_STRING("c@43200000", runs[2].c_str());
+  TEST_ASSERT_TRUE(scheduler.nextDeadline() == INT64_MAX);
+}
+
+/*
+- scheduleEarlier() only moves a deadline forward, cancel() disarms
+*/
+void test_rescheduleAndCancel() {
+  JobScheduler scheduler(tickMs, 0);
+  int runs = 0;
+  int job = scheduler.add("job", 0, 0, [&](int64_t) { ++runs; });
+
+  scheduler.schedule(job, 5000);
+  scheduler.scheduleEarlier(job, 8000);
+  TEST_ASSERT_TRUE(scheduler.dueTs(job) == 5000);
+  scheduler.scheduleEarlier(job, 2000);
+  TEST_ASSERT_TRUE(scheduler.dueTs(job) == 2000);
+  TEST_ASSERT_FALSE(scheduler.runNext(1999));
+  TEST_ASSERT_TRUE(scheduler.runNext(2000));
+  TEST_ASSERT_FALSE(scheduler.scheduled(job));
+
+  scheduler.schedule(job, 3000);
+  scheduler.cancel(job);
+  TEST_ASSERT_FALSE(scheduler.scheduled(job));
+  TEST_ASSERT_FALSE(scheduler.runNext(10000));
+  TEST_ASSERT_EQUAL_INT(1, runs);
+}
+
+/*
+- simulated clock with random steps, random (re)scheduling and cancelling against a reference
+- a job never runs early, runs within a few ticks after its deadline and nextDeadline() is exact
+*/
+void test_simulatedClock() {
+  const int nrOfJobs = 20;
+  std::mt19937 random(1);
+  JobScheduler scheduler(tickMs, 0);
+  std::vector<int64_t> due(nrOfJobs, -1);
+  std::vector<int> ids;
+  int64_t now = 0;
+  int fired = 0;
+  int64_t maxLate = 0;
+  bool valid = true;
+
+  for (int i = 0; i < nrOfJobs; ++i) {
+    ids.push_back(scheduler.add("job", 0, i % 3, [&, i](int64_t ts) {
+      valid &= due[i] >= 0 && ts >= due[i];
+      maxLate = std::max(maxLate, ts - due[i]);
+      due[i] = -1;
+      ++fired;
+    }));
+  }
+
+  for (int step = 0; step < 200000; ++step) {
+    now += random() % 150;
+    if (random() % 10 == 0) {
+      int i = random() % nrOfJobs;
+      int64_t dueTs = now + (random() % 4 == 0 ? random() % 20000000 : random() % 5000);
+      scheduler.schedule(ids[i], dueTs);
+      due[i] = dueTs;
+    }
+    if (random() % 50 == 0) {
+      int i = random() % nrOfJobs;
+      scheduler.cancel(ids[i]);
+      due[i] = -1;
+    }
+    while (scheduler.runNext(now)) {
+    }
+
+    int64_t nextDue = INT64_MAX;
+    for (int i = 0; i < nrOfJobs; ++i) {
+      if (due[i] >= 0 && due[i] < nextDue) {
+        nextDue = due[i];
+      }
+    }
+    valid &= scheduler.nextDeadline() == nextDue;
+    if (!valid) {
+      break;
+    }
+  }
+  TEST_ASSERT_TRUE(valid);
+  TEST_ASSERT_TRUE(maxLate < 200);
+
+  char message[100];
+  snprintf(message, sizeof(message), "%d jobs fired, at most %lld ms late", fired, (long long)maxLate);
+  TEST_MESSAGE(message);
+}
+
+/*
+- periodic lock and opener jobs that ask to be spread don't run back to back
+*/
+void test_spreadOwners() {
+  JobScheduler scheduler(tickMs, spreadMs);
+  std::vector<std::pair<int, int64_t>> runs;
+  int lock = 0;
+  int opener = 0;
+  lock = scheduler.add("lock state", 0, 0, [&](int64_t now) {
+    runs.push_back(std::make_pair(0, now));
+    scheduler.schedule(lock, now + 60000, true);
+  });
+  opener = scheduler.add("opener state", 1, 0, [&](int64_t now) {
+    runs.push_back(std::make_pair(1, now));
+    scheduler.schedule(opener, now + 60000, true);
+  });
+  scheduler.schedule(lock, 1000, true);
+  scheduler.schedule(opener, 1000, true);
+
+  for (int64_t now = 0; now < 600000; now += 20) {
+    scheduler.runNext(now);
+  }
+  TEST_ASSERT_TRUE(runs.size() >= 18);
+  for (size_t i = 1; i < runs.size(); ++i) {
+    if (runs[i].first != runs[i - 1].first) {
+      TEST_ASSERT_TRUE(runs[i].second - runs[i - 1].second >= spreadMs);
+    }
+  }
+  TEST_ASSERT_TRUE(scheduler.spread() > 0);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_priorityAndLongDeadlines);
+  RUN_TEST(test_rescheduleAndCancel);
+  RUN_TEST(test_simulatedClock);
+  RUN_TEST(test_spreadOwners);
+  return UNITY_END();
+}
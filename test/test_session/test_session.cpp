@@ -0,0 +1,199 @@
+#include <unity.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <SessionStore.h>
+
+// counts heap allocations to show that checking a cookie doesn't allocate
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+  ++allocations;
+  return malloc(size);
+}
+
+void operator delete(void* p) noexcept {
+  free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  free(p);
+}
+
+void setUp() {}
+void tearDown() {}
+
+const int64_t now = 1700000000LL * 1000000LL;
+const int64_t second = 1000000LL;
+
+static std::mt19937 generator(1);
+
+static std::string randomId() {
+  char buffer[SESSION_ID_LENGTH + 1];
+  for (int i = 0; i < SESSION_ID_LENGTH / 8; ++i) {
+    snprintf(buffer + i * 8, 9, "%08lx", (unsigned long)generator());
+  }
+  return buffer;
+}
+
+/*
+- sessions are found until they expire, unknown, empty, too long and expired ids are rejected
+- remove() and clear() log out
+*/
+void test_addAndExpire() {
+  SessionStore store;
+  std::string id = randomId();
+  std::string other = randomId();
+
+  TEST_ASSERT_TRUE(store.add(id.c_str(), now + 10 * second, now));
+  TEST_ASSERT_TRUE(store.add(other.c_str(), now + 20 * second, now));
+  TEST_ASSERT_FALSE(store.add("", now + second, now));
+  TEST_ASSERT_FALSE(store.add((id + "x").c_str(), now + second, now));
+  TEST_ASSERT_FALSE(store.add(randomId().c_str(), now, now));
+  TEST_ASSERT_EQUAL_UINT32(2, store.count());
+
+  TEST_ASSERT_TRUE(store.valid(id.c_str(), now));
+  TEST_ASSERT_FALSE(store.valid("deadbeef", now));
+  TEST_ASSERT_FALSE(store.valid(id.c_str(), now + 10 * second));
+  TEST_ASSERT_EQUAL_UINT32(1, store.count());
+
+  TEST_ASSERT_TRUE(store.remove(other.c_str()));
+  TEST_ASSERT_FALSE(store.remove(other.c_str()));
+  TEST_ASSERT_FALSE(store.valid(other.c_str(), now));
+
+  store.add(id.c_str(), now + 10 * second, now);
+  store.clear();
+  TEST_ASSERT_EQUAL_UINT32(0, store.count());
+  TEST_ASSERT_FALSE(store.valid(id.c_str(), now));
+}
+
+/*
+- a full store replaces the session closest to its expiry
+- expired sessions make room before a valid one is replaced
+*/
+void test_full() {
+  SessionStore store;
+  std::vector<std::string> ids;
+  for (int i = 0; i < SESSION_STORE_CAPACITY; ++i) {
+    ids.push_back(randomId());
+    TEST_ASSERT_TRUE(store.add(ids.back().c_str(), now + (i + 1) * second, now));
+  }
+  TEST_ASSERT_EQUAL_UINT32(SESSION_STORE_CAPACITY, store.count());
+
+  std::string extra = randomId();
+  TEST_ASSERT_TRUE(store.add(extra.c_str(), now + 100 * second, now));
+  TEST_ASSERT_FALSE(store.valid(ids[0].c_str(), now));
+  TEST_ASSERT_TRUE(store.valid(ids[1].c_str(), now));
+  TEST_ASSERT_TRUE(store.valid(extra.c_str(), now));
+
+  // ids 1 to 4 have expired by then, all are dropped to add the new one
+  std::string late = randomId();
+  TEST_ASSERT_TRUE(store.add(late.c_str(), now + 200 * second, now + 5500000LL));
+  TEST_ASSERT_EQUAL_UINT32(SESSION_STORE_CAPACITY - 3, store.count());
+  for (int i = 5; i < SESSION_STORE_CAPACITY; ++i) {
+    TEST_ASSERT_TRUE(store.valid(ids[i].c_str(), now + 5500000LL));
+  }
+  TEST_ASSERT_TRUE(store.valid(late.c_str(), now + 5500000LL));
+}
+
+/*
+- changes mark the store dirty until it is written with toJson()
+- the written sessions load again, the previous format {"id": expiry} too, expired ones are skipped
+*/
+void test_persistence() {
+  SessionStore store;
+  std::string id = randomId();
+  std::string other = randomId();
+  TEST_ASSERT_FALSE(store.dirty());
+  store.add(id.c_str(), now + 10 * second, now);
+  store.add(other.c_str(), now + 20 * second, now);
+  TEST_ASSERT_TRUE(store.dirty());
+
+  JsonDocument json;
+  store.toJson(json);
+  TEST_ASSERT_FALSE(store.dirty());
+  std::string text;
+  serializeJson(json, text);
+
+  JsonDocument parsed;
+  deserializeJson(parsed, text);
+  SessionStore loaded;
+  loaded.fromJson(parsed, now + 15 * second);
+  TEST_ASSERT_FALSE(loaded.dirty());
+  TEST_ASSERT_EQUAL_UINT32(1, loaded.count());
+  TEST_ASSERT_TRUE(loaded.valid(other.c_str(), now + 15 * second));
+
+  JsonDocument old;
+  old["0123456789abcdef0123456789abcdef"] = now + 10;
+  old["expired"] = now - 10;
+  SessionStore fromOld;
+  fromOld.fromJson(old, now);
+  TEST_ASSERT_EQUAL_UINT32(1, fromOld.count());
+  TEST_ASSERT_TRUE(fromOld.valid("0123456789abcdef0123456789abcdef", now));
+}
+
+/*
+- lookup of a valid cookie among n sessions, previous JsonDocument lookup against the store
+- the store doesn't allocate
+*/
+void test_lookupBenchmark() {
+  const int rounds = 200000;
+  for (int n : {1, 4, 16}) {
+    JsonDocument doc;
+    SessionStore store;
+    std::vector<std::string> ids;
+    for (int i = 0; i < n; ++i) {
+      ids.push_back(randomId());
+      doc[ids.back()] = now + 3600 * second;
+      store.add(ids.back().c_str(), now + 3600 * second, now);
+    }
+
+    int hits = 0;
+    size_t allocationsBefore = allocations;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+      // the previous code copied the cookie into a String as well
+      std::string cookie = ids[round % n];
+      if (doc[cookie].is<JsonVariant>() && doc[cookie].as<signed long long>() > now) {
+        ++hits;
+      }
+    }
+    std::chrono::steady_clock::time_point middle = std::chrono::steady_clock::now();
+    size_t allocationsJson = allocations - allocationsBefore;
+
+    allocationsBefore = allocations;
+    for (int round = 0; round < rounds; ++round) {
+      char cookie[SESSION_ID_LENGTH + 1];
+      memcpy(cookie, ids[round % n].c_str(), sizeof(cookie));
+      if (store.valid(cookie, now)) {
+        ++hits;
+      }
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    size_t allocationsStore = allocations - allocationsBefore;
+
+    TEST_ASSERT_EQUAL_INT(2 * rounds, hits);
+    TEST_ASSERT_EQUAL_UINT32(0, allocationsStore);
+
+    char message[160];
+    snprintf(message, sizeof(message), "%2d sessions: json %.1f ns (%.1f allocations), store %.1f ns per lookup", n,
+             std::chrono::duration<double, std::nano>(middle - start).count() / rounds, (double)allocationsJson / rounds,
+             std::chrono::duration<double, std::nano>(end - middle).count() / rounds);
+    TEST_MESSAGE(message);
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_addAndExpire);
+  RUN_TEST(test_full);
+  RUN_TEST(test_persistence);
+  RUN_TEST(test_lookupBenchmark);
+  return UNITY_END();
+}
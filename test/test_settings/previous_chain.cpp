@@ -0,0 +1,1551 @@
+#include "previous_chain.h"
+#include "PreferencesKeys.h"
+
+bool applyPreviousChain(Preferences* _preferences, const String& key, const String& value, SettingsFlags& flags, uint32_t** acl)
+{
+    bool& configChanged = flags.configChanged;
+    bool& networkReconfigure = flags.networkReconfigure;
+    bool& clearSession = flags.clearSession;
+    bool& newMFA = flags.newMFA;
+    uint32_t* aclPrefs = acl[0];
+    uint32_t* basicLockConfigAclPrefs = acl[1];
+    uint32_t* advancedLockConfigAclPrefs = acl[2];
+    uint32_t* basicOpenerConfigAclPrefs = acl[3];
+    uint32_t* advancedOpenerConfigAclPrefs = acl[4];
+
+    if(key == "MQTTSERVER")
+    {
+        if(_preferences->getString(preference_mqtt_broker, "") != value)
+        {
+            _preferences->putString(preference_mqtt_broker, value);
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "MQTTPORT")
+    {
+        if(_preferences->getInt(preference_mqtt_broker_port, 0) !=  value.toInt())
+        {
+            _preferences->putInt(preference_mqtt_broker_port,  value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "MQTTPASS")
+    {
+        if(value != "*")
+        {
+            if(_preferences->getString(preference_mqtt_password, "") != value)
+            {
+                _preferences->putString(preference_mqtt_password, value);
+                Log->print("Setting changed: ");
+                Log->println(key);
+                configChanged = true;
+            }
+        }
+    }
+    else if(key == "MQTTPATH")
+    {
+        if(_preferences->getString(preference_mqtt_lock_path, "") != value)
+        {
+            _preferences->putString(preference_mqtt_lock_path, value);
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "UPTIME")
+    {
+        if(_preferences->getBool(preference_update_time, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_update_time, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "TIMESRV")
+    {
+        if(_preferences->getString(preference_time_server, "pool.ntp.org") != value)
+        {
+            _preferences->putString(preference_time_server, value);
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "NWCUSTPHY")
+    {
+        if(_preferences->getInt(preference_network_custom_phy, 0) != value.toInt())
+        {
+            networkReconfigure = true;
+            _preferences->putInt(preference_network_custom_phy, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "NWCUSTADDR")
+    {
+        if(_preferences->getInt(preference_network_custom_addr, -1) != value.toInt())
+        {
+            networkReconfigure = true;
+            _preferences->putInt(preference_network_custom_addr, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "NWCUSTIRQ")
+    {
+        if(_preferences->getInt(preference_network_custom_irq, 0) != value.toInt())
+        {
+            networkReconfigure = true;
+            _preferences->putInt(preference_network_custom_irq, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "NWCUSTRST")
+    {
+        if(_preferences->getInt(preference_network_custom_rst, 0) != value.toInt())
+        {
+            networkReconfigure = true;
+            _preferences->putInt(preference_network_custom_rst, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "NWCUSTCS")
+    {
+        if(_preferences->getInt(preference_network_custom_cs, 0) != value.toInt())
+        {
+            networkReconfigure = true;
+            _preferences->putInt(preference_network_custom_cs, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "NWCUSTSCK")
+    {
+        if(_preferences->getInt(preference_network_custom_sck, 0) != value.toInt())
+        {
+            networkReconfigure = true;
+            _preferences->putInt(preference_network_custom_sck, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "NWCUSTMISO")
+    {
+        if(_preferences->getInt(preference_network_custom_miso, 0) != value.toInt())
+        {
+            networkReconfigure = true;
+            _preferences->putInt(preference_network_custom_miso, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "NWCUSTMOSI")
+    {
+        if(_preferences->getInt(preference_network_custom_mosi, 0) != value.toInt())
+        {
+            networkReconfigure = true;
+            _preferences->putInt(preference_network_custom_mosi, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "NWCUSTPWR")
+    {
+        if(_preferences->getInt(preference_network_custom_pwr, 0) != value.toInt())
+        {
+            networkReconfigure = true;
+            _preferences->putInt(preference_network_custom_pwr, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "NWCUSTMDIO")
+    {
+        if(_preferences->getInt(preference_network_custom_mdio, 0) != value.toInt())
+        {
+            networkReconfigure = true;
+            _preferences->putInt(preference_network_custom_mdio, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "NWCUSTMDC")
+    {
+        if(_preferences->getInt(preference_network_custom_mdc, 0) != value.toInt())
+        {
+            networkReconfigure = true;
+            _preferences->putInt(preference_network_custom_mdc, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "NWCUSTCLK")
+    {
+        if(_preferences->getInt(preference_network_custom_clk, 0) != value.toInt())
+        {
+            networkReconfigure = true;
+            _preferences->putInt(preference_network_custom_clk, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "RSSI")
+    {
+        if(_preferences->getInt(preference_rssi_publish_interval, 60) != value.toInt())
+        {
+            _preferences->putInt(preference_rssi_publish_interval, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "HTTPSFQDN")
+    {
+        if(_preferences->getString(preference_https_fqdn, "") != value)
+        {
+            _preferences->putString(preference_https_fqdn, value);
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "DUOHOST")
+    {
+        if(value != "*")
+        {
+            if(_preferences->getString(preference_cred_duo_host, "") != value)
+            {
+                _preferences->putString(preference_cred_duo_host, value);
+                Log->print("Setting changed: ");
+                Log->println(key);
+                configChanged = true;
+                clearSession = true;
+                newMFA = true;
+            }
+        }
+    }
+    else if(key == "DUOIKEY")
+    {
+        if(value != "*")
+        {
+            if(_preferences->getString(preference_cred_duo_ikey, "") != value)
+            {
+                _preferences->putString(preference_cred_duo_ikey, value);
+                Log->print("Setting changed: ");
+                Log->println(key);
+                configChanged = true;
+                clearSession = true;
+                newMFA = true;
+            }
+        }
+    }
+    else if(key == "DUOSKEY")
+    {
+        if(value != "*")
+        {
+            if(_preferences->getString(preference_cred_duo_skey, "") != value)
+            {
+                _preferences->putString(preference_cred_duo_skey, value);
+                Log->print("Setting changed: ");
+                Log->println(key);
+                configChanged = true;
+                clearSession = true;
+                newMFA = true;
+            }
+        }
+    }
+    else if(key == "DUOUSER")
+    {
+        if(value != "*")
+        {
+            if(_preferences->getString(preference_cred_duo_user, "") != value)
+            {
+                _preferences->putString(preference_cred_duo_user, value);
+                Log->print("Setting changed: ");
+                Log->println(key);
+                configChanged = true;
+                clearSession = true;
+                newMFA = true;
+            }
+        }
+    }
+    else if(key == "DUOBYPASS")
+    {
+        if(_preferences->getBool(preference_cred_bypass_boot_btn_enabled, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_cred_bypass_boot_btn_enabled, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "DUOBYPASSHIGH")
+    {
+        if(_preferences->getInt(preference_cred_bypass_gpio_high, -1) != value.toInt())
+        {
+            _preferences->putInt(preference_cred_bypass_gpio_high, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "DUOBYPASSLOW")
+    {
+        if(_preferences->getInt(preference_cred_bypass_gpio_low, -1) != value.toInt())
+        {
+            _preferences->putInt(preference_cred_bypass_gpio_low, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "DUOAPPROVAL")
+    {
+        if(_preferences->getBool(preference_cred_duo_approval, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_cred_duo_approval, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "CREDLFTM")
+    {
+        if(_preferences->getInt(preference_cred_session_lifetime, 3600) != value.toInt())
+        {
+            _preferences->putInt(preference_cred_session_lifetime, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+            clearSession = true;
+        }
+    }
+    else if(key == "CREDLFTMRMBR")
+    {
+        if(_preferences->getInt(preference_cred_session_lifetime_remember, 720) != value.toInt())
+        {
+            _preferences->putInt(preference_cred_session_lifetime_remember, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+            clearSession = true;
+        }
+    }
+    else if(key == "CREDDUOLFTM")
+    {
+        if(_preferences->getInt(preference_cred_session_lifetime_duo, 3600) != value.toInt())
+        {
+            _preferences->putInt(preference_cred_session_lifetime_duo, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+            clearSession = true;
+        }
+    }
+    else if(key == "CREDDUOLFTMRMBR")
+    {
+        if(_preferences->getInt(preference_cred_session_lifetime_duo_remember, 720) != value.toInt())
+        {
+            _preferences->putInt(preference_cred_session_lifetime_duo_remember, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+            clearSession = true;
+        }
+    }
+    else if(key == "CREDTOTPLFTM")
+    {
+        if(_preferences->getInt(preference_cred_session_lifetime_totp, 3600) != value.toInt())
+        {
+            _preferences->putInt(preference_cred_session_lifetime_totp, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+            clearSession = true;
+        }
+    }
+    else if(key == "CREDTOTPLFTMRMBR")
+    {
+        if(_preferences->getInt(preference_cred_session_lifetime_totp_remember, 720) != value.toInt())
+        {
+            _preferences->putInt(preference_cred_session_lifetime_totp_remember, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+            clearSession = true;
+        }
+    }
+    else if(key == "OPENERCONT")
+    {
+        if(_preferences->getBool(preference_opener_continuous_mode, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_opener_continuous_mode, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "HASSCUURL")
+    {
+        if(_preferences->getString(preference_mqtt_hass_cu_url, "") != value)
+        {
+            _preferences->putString(preference_mqtt_hass_cu_url, value);
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "HOSTNAME")
+    {
+        if(_preferences->getString(preference_hostname, "") != value)
+        {
+            _preferences->putString(preference_hostname, value);
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "NETTIMEOUT")
+    {
+        if(_preferences->getInt(preference_network_timeout, 60) != value.toInt())
+        {
+            _preferences->putInt(preference_network_timeout, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "FINDBESTRSSI")
+    {
+        if(_preferences->getBool(preference_find_best_rssi, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_find_best_rssi, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "RSTDISC")
+    {
+        if(_preferences->getBool(preference_restart_on_disconnect, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_restart_on_disconnect, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "MQTTLOG")
+    {
+        if(_preferences->getBool(preference_mqtt_log_enabled, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_mqtt_log_enabled, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "MQTTJOURNAL")
+    {
+        if(_preferences->getBool(preference_mqtt_journal_enabled, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_mqtt_journal_enabled, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "MQTTSENA")
+    {
+        if(_preferences->getBool(preference_mqtt_ssl_enabled, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_mqtt_ssl_enabled, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "WEBLOG")
+    {
+        if(_preferences->getBool(preference_webserial_enabled, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_webserial_enabled, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "CHECKUPDATE")
+    {
+        if(_preferences->getBool(preference_check_updates, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_check_updates, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "UPDATEMQTT")
+    {
+        if(_preferences->getBool(preference_update_from_mqtt, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_update_from_mqtt, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "HYBRIDTIMER")
+    {
+        if(_preferences->getInt(preference_query_interval_hybrid_lockstate, 600) != value.toInt())
+        {
+            _preferences->putInt(preference_query_interval_hybrid_lockstate, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "HYBRIDRETRY")
+    {
+        if(_preferences->getBool(preference_official_hybrid_retry, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_official_hybrid_retry, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "HYBRIDREBOOT")
+    {
+        if(_preferences->getBool(preference_hybrid_reboot_on_disconnect, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_hybrid_reboot_on_disconnect, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "DISNONJSON")
+    {
+        if(_preferences->getBool(preference_disable_non_json, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_disable_non_json, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "DHCPENA")
+    {
+        if(_preferences->getBool(preference_ip_dhcp_enabled, true) != (value == "1"))
+        {
+            _preferences->putBool(preference_ip_dhcp_enabled, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "IPADDR")
+    {
+        if(_preferences->getString(preference_ip_address, "") != value)
+        {
+            _preferences->putString(preference_ip_address, value);
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "IPSUB")
+    {
+        if(_preferences->getString(preference_ip_subnet, "") != value)
+        {
+            _preferences->putString(preference_ip_subnet, value);
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "IPGTW")
+    {
+        if(_preferences->getString(preference_ip_gateway, "") != value)
+        {
+            _preferences->putString(preference_ip_gateway, value);
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "DNSSRV")
+    {
+        if(_preferences->getString(preference_ip_dns_server, "") != value)
+        {
+            _preferences->putString(preference_ip_dns_server, value);
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "LSTINT")
+    {
+        if(_preferences->getInt(preference_query_interval_lockstate, 1800) != value.toInt())
+        {
+            _preferences->putInt(preference_query_interval_lockstate, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "CFGINT")
+    {
+        if(_preferences->getInt(preference_query_interval_configuration, 3600) != value.toInt())
+        {
+            _preferences->putInt(preference_query_interval_configuration, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "BATINT")
+    {
+        if(_preferences->getInt(preference_query_interval_battery, 1800) != value.toInt())
+        {
+            _preferences->putInt(preference_query_interval_battery, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "KPINT")
+    {
+        if(_preferences->getInt(preference_query_interval_keypad, 1800) != value.toInt())
+        {
+            _preferences->putInt(preference_query_interval_keypad, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "NRTRY")
+    {
+        if(_preferences->getInt(preference_command_nr_of_retries, 3) != value.toInt())
+        {
+            _preferences->putInt(preference_command_nr_of_retries, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "TRYDLY")
+    {
+        if(_preferences->getInt(preference_command_retry_delay, 100) != value.toInt())
+        {
+            _preferences->putInt(preference_command_retry_delay, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "TXPWR")
+    {
+        #if defined(CONFIG_IDF_TARGET_ESP32)
+        if(value.toInt() >= -12 && value.toInt() <= 9)
+        #else
+        if(value.toInt() >= -12 && value.toInt() <= 20)
+        #endif
+        {
+            if(_preferences->getInt(preference_ble_tx_power, 9) != value.toInt())
+            {
+                _preferences->putInt(preference_ble_tx_power, value.toInt());
+                Log->print("Setting changed: ");
+                Log->println(key);
+                //configChanged = true;
+            }
+        }
+    }
+    else if(key == "RSBC")
+    {
+        if(_preferences->getInt(preference_restart_ble_beacon_lost, 60) != value.toInt())
+        {
+            _preferences->putInt(preference_restart_ble_beacon_lost, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "TSKNTWK")
+    {
+        if(value.toInt() > 12287 && value.toInt() < 65537)
+        {
+            if(_preferences->getInt(preference_task_size_network, NETWORK_TASK_SIZE) != value.toInt())
+            {
+                _preferences->putInt(preference_task_size_network, value.toInt());
+                Log->print("Setting changed: ");
+                Log->println(key);
+                configChanged = true;
+            }
+        }
+    }
+    else if(key == "TSKNUKI")
+    {
+        if(value.toInt() > 8191 && value.toInt() < 65537)
+        {
+            if(_preferences->getInt(preference_task_size_nuki, NUKI_TASK_SIZE) != value.toInt())
+            {
+                _preferences->putInt(preference_task_size_nuki, value.toInt());
+                Log->print("Setting changed: ");
+                Log->println(key);
+                configChanged = true;
+            }
+        }
+    }
+    else if(key == "ALMAX")
+    {
+        if(value.toInt() > 0 && value.toInt() < 101)
+        {
+            if(_preferences->getInt(preference_authlog_max_entries, MAX_AUTHLOG) != value.toInt())
+            {
+                _preferences->putInt(preference_authlog_max_entries, value.toInt());
+                Log->print("Setting changed: ");
+                Log->println(key);
+                //configChanged = true;
+            }
+        }
+    }
+    else if(key == "KPMAX")
+    {
+        if(value.toInt() > 0 && value.toInt() < 201)
+        {
+            if(_preferences->getInt(preference_keypad_max_entries, MAX_KEYPAD) != value.toInt())
+            {
+                _preferences->putInt(preference_keypad_max_entries, value.toInt());
+                Log->print("Setting changed: ");
+                Log->println(key);
+                //configChanged = true;
+            }
+        }
+    }
+    else if(key == "TCMAX")
+    {
+        if(value.toInt() > 0 && value.toInt() < 101)
+        {
+            if(_preferences->getInt(preference_timecontrol_max_entries, MAX_TIMECONTROL) != value.toInt())
+            {
+                _preferences->putInt(preference_timecontrol_max_entries, value.toInt());
+                Log->print("Setting changed: ");
+                Log->println(key);
+                //configChanged = true;
+            }
+        }
+    }
+    else if(key == "AUTHMAX")
+    {
+        if(value.toInt() > 0 && value.toInt() < 101)
+        {
+            if(_preferences->getInt(preference_auth_max_entries, MAX_AUTH) != value.toInt())
+            {
+                _preferences->putInt(preference_auth_max_entries, value.toInt());
+                Log->print("Setting changed: ");
+                Log->println(key);
+                //configChanged = true;
+            }
+        }
+    }
+    else if(key == "BUFFSIZE")
+    {
+        if(value.toInt() > 4095 && value.toInt() < 65537)
+        {
+            if(_preferences->getInt(preference_buffer_size, CHAR_BUFFER_SIZE) != value.toInt())
+            {
+                _preferences->putInt(preference_buffer_size, value.toInt());
+                Log->print("Setting changed: ");
+                Log->println(key);
+                configChanged = true;
+            }
+        }
+    }
+    else if(key == "BTLPRST")
+    {
+        if(_preferences->getBool(preference_enable_bootloop_reset, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_enable_bootloop_reset, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "DISNTWNOCON")
+    {
+        if(_preferences->getBool(preference_disable_network_not_connected, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_disable_network_not_connected, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "OTAUPD")
+    {
+        if(_preferences->getString(preference_ota_updater_url, "") != value)
+        {
+            _preferences->putString(preference_ota_updater_url, value);
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "OTAMAIN")
+    {
+        if(_preferences->getString(preference_ota_main_url, "") != value)
+        {
+            _preferences->putString(preference_ota_main_url, value);
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "SHOWSECRETS")
+    {
+        if(_preferences->getBool(preference_show_secrets, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_show_secrets, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "DBGCONN")
+    {
+        if(_preferences->getBool(preference_debug_connect, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_debug_connect, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "DBGCOMMU")
+    {
+        if(_preferences->getBool(preference_debug_communication, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_debug_communication, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "DBGHEAP")
+    {
+        if(_preferences->getBool(preference_publish_debug_info, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_publish_debug_info, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "DBGREAD")
+    {
+        if(_preferences->getBool(preference_debug_readable_data, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_debug_readable_data, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "DBGHEX")
+    {
+        if(_preferences->getBool(preference_debug_hex_data, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_debug_hex_data, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "DBGCOMM")
+    {
+        if(_preferences->getBool(preference_debug_command, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_debug_command, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "LCKFORCEID")
+    {
+        if(_preferences->getBool(preference_lock_force_id, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_lock_force_id, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+        }
+    }
+    else if(key == "LCKFORCEKP")
+    {
+        if(_preferences->getBool(preference_lock_force_keypad, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_lock_force_keypad, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+        }
+    }
+    else if(key == "LCKFORCEDS")
+    {
+        if(_preferences->getBool(preference_lock_force_doorsensor, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_lock_force_doorsensor, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+        }
+    }
+    else if(key == "OPFORCEID")
+    {
+        if(_preferences->getBool(preference_opener_force_id, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_opener_force_id, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+        }
+    }
+    else if(key == "OPFORCEKP")
+    {
+        if(_preferences->getBool(preference_opener_force_keypad, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_opener_force_keypad, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+        }
+    }
+    else if(key == "CONFPUB")
+    {
+        if(_preferences->getBool(preference_conf_info_enabled, true) != (value == "1"))
+        {
+            _preferences->putBool(preference_conf_info_enabled, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "KPPUB")
+    {
+        if(_preferences->getBool(preference_keypad_info_enabled, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_keypad_info_enabled, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "KPCODE")
+    {
+        if(_preferences->getBool(preference_keypad_publish_code, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_keypad_publish_code, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "KPCHECK")
+    {
+        if(_preferences->getBool(preference_keypad_check_code_enabled, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_keypad_check_code_enabled, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "KPENA")
+    {
+        if(_preferences->getBool(preference_keypad_control_enabled, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_keypad_control_enabled, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "TCPUB")
+    {
+        if(_preferences->getBool(preference_timecontrol_info_enabled, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_timecontrol_info_enabled, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "AUTHPUB")
+    {
+        if(_preferences->getBool(preference_auth_info_enabled, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_auth_info_enabled, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "KPPER")
+    {
+        if(_preferences->getBool(preference_keypad_topic_per_entry, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_keypad_topic_per_entry, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "TCPER")
+    {
+        if(_preferences->getBool(preference_timecontrol_topic_per_entry, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_timecontrol_topic_per_entry, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "TCENA")
+    {
+        if(_preferences->getBool(preference_timecontrol_control_enabled, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_timecontrol_control_enabled, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "AUTHPER")
+    {
+        if(_preferences->getBool(preference_auth_topic_per_entry, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_auth_topic_per_entry, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "AUTHENA")
+    {
+        if(_preferences->getBool(preference_auth_control_enabled, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_auth_control_enabled, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "PUBAUTH")
+    {
+        if(_preferences->getBool(preference_publish_authdata, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_publish_authdata, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "CREDDIGEST")
+    {
+        if(_preferences->getInt(preference_http_auth_type, 0) != value.toInt())
+        {
+            _preferences->putInt(preference_http_auth_type, value.toInt());
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+            clearSession = true;
+        }
+    }
+    else if(key == "CREDTRUSTPROXY")
+    {
+        if(value != "*")
+        {
+            if(_preferences->getString(preference_bypass_proxy, "") != value)
+            {
+                _preferences->putString(preference_bypass_proxy, value);
+                Log->print("Setting changed: ");
+                Log->println(key);
+                configChanged = true;
+                clearSession = true;
+            }
+        }
+    }
+    else if(key == "ACLLCKLCK")
+    {
+        aclPrefs[0] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "ACLLCKUNLCK")
+    {
+        aclPrefs[1] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "ACLLCKUNLTCH")
+    {
+        aclPrefs[2] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "ACLLCKLNG")
+    {
+        aclPrefs[3] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "ACLLCKLNGU")
+    {
+        aclPrefs[4] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "ACLLCKFLLCK")
+    {
+        aclPrefs[5] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "ACLLCKFOB1")
+    {
+        aclPrefs[6] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "ACLLCKFOB2")
+    {
+        aclPrefs[7] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "ACLLCKFOB3")
+    {
+        aclPrefs[8] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "ACLOPNUNLCK")
+    {
+        aclPrefs[9] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "ACLOPNLCK")
+    {
+        aclPrefs[10] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "ACLOPNUNLTCH")
+    {
+        aclPrefs[11] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "ACLOPNUNLCKCM")
+    {
+        aclPrefs[12] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "ACLOPNLCKCM")
+    {
+        aclPrefs[13] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "ACLOPNFOB1")
+    {
+        aclPrefs[14] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "ACLOPNFOB2")
+    {
+        aclPrefs[15] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "ACLOPNFOB3")
+    {
+        aclPrefs[16] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKNAME")
+    {
+        basicLockConfigAclPrefs[0] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKLAT")
+    {
+        basicLockConfigAclPrefs[1] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKLONG")
+    {
+        basicLockConfigAclPrefs[2] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKAUNL")
+    {
+        basicLockConfigAclPrefs[3] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKPRENA")
+    {
+        basicLockConfigAclPrefs[4] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKBTENA")
+    {
+        basicLockConfigAclPrefs[5] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKLEDENA")
+    {
+        basicLockConfigAclPrefs[6] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKLEDBR")
+    {
+        basicLockConfigAclPrefs[7] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKTZOFF")
+    {
+        basicLockConfigAclPrefs[8] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKDSTM")
+    {
+        basicLockConfigAclPrefs[9] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKFOB1")
+    {
+        basicLockConfigAclPrefs[10] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKFOB2")
+    {
+        basicLockConfigAclPrefs[11] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKFOB3")
+    {
+        basicLockConfigAclPrefs[12] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKSGLLCK")
+    {
+        basicLockConfigAclPrefs[13] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKADVM")
+    {
+        basicLockConfigAclPrefs[14] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKTZID")
+    {
+        basicLockConfigAclPrefs[15] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKUPOD")
+    {
+        advancedLockConfigAclPrefs[0] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKLPOD")
+    {
+        advancedLockConfigAclPrefs[1] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKSLPOD")
+    {
+        advancedLockConfigAclPrefs[2] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKUTLTOD")
+    {
+        advancedLockConfigAclPrefs[3] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKLNGT")
+    {
+        advancedLockConfigAclPrefs[4] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKSBPA")
+    {
+        advancedLockConfigAclPrefs[5] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKDBPA")
+    {
+        advancedLockConfigAclPrefs[6] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKDC")
+    {
+        advancedLockConfigAclPrefs[7] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKBATT")
+    {
+        advancedLockConfigAclPrefs[8] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKABTD")
+    {
+        advancedLockConfigAclPrefs[9] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKUNLD")
+    {
+        advancedLockConfigAclPrefs[10] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKALT")
+    {
+        advancedLockConfigAclPrefs[11] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKAUNLD")
+    {
+        advancedLockConfigAclPrefs[12] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKNMENA")
+    {
+        advancedLockConfigAclPrefs[13] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKNMST")
+    {
+        advancedLockConfigAclPrefs[14] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKNMET")
+    {
+        advancedLockConfigAclPrefs[15] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKNMALENA")
+    {
+        advancedLockConfigAclPrefs[16] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKNMAULD")
+    {
+        advancedLockConfigAclPrefs[17] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKNMLOS")
+    {
+        advancedLockConfigAclPrefs[18] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKALENA")
+    {
+        advancedLockConfigAclPrefs[19] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKIALENA")
+    {
+        advancedLockConfigAclPrefs[20] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKAUENA")
+    {
+        advancedLockConfigAclPrefs[21] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKRBTNUKI")
+    {
+        advancedLockConfigAclPrefs[22] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKMTRSPD")
+    {
+        advancedLockConfigAclPrefs[23] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFLCKESSDNM")
+    {
+        advancedLockConfigAclPrefs[24] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNNAME")
+    {
+        basicOpenerConfigAclPrefs[0] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNLAT")
+    {
+        basicOpenerConfigAclPrefs[1] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNLONG")
+    {
+        basicOpenerConfigAclPrefs[2] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNPRENA")
+    {
+        basicOpenerConfigAclPrefs[3] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNBTENA")
+    {
+        basicOpenerConfigAclPrefs[4] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNLEDENA")
+    {
+        basicOpenerConfigAclPrefs[5] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNTZOFF")
+    {
+        basicOpenerConfigAclPrefs[6] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNDSTM")
+    {
+        basicOpenerConfigAclPrefs[7] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNFOB1")
+    {
+        basicOpenerConfigAclPrefs[8] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNFOB2")
+    {
+        basicOpenerConfigAclPrefs[9] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNFOB3")
+    {
+        basicOpenerConfigAclPrefs[10] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNOPM")
+    {
+        basicOpenerConfigAclPrefs[11] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNADVM")
+    {
+        basicOpenerConfigAclPrefs[12] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNTZID")
+    {
+        basicOpenerConfigAclPrefs[13] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNICID")
+    {
+        advancedOpenerConfigAclPrefs[0] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNBUSMS")
+    {
+        advancedOpenerConfigAclPrefs[1] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNSCDUR")
+    {
+        advancedOpenerConfigAclPrefs[2] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNESD")
+    {
+        advancedOpenerConfigAclPrefs[3] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNRESD")
+    {
+        advancedOpenerConfigAclPrefs[4] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNESDUR")
+    {
+        advancedOpenerConfigAclPrefs[5] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNDRTOAR")
+    {
+        advancedOpenerConfigAclPrefs[6] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNRTOT")
+    {
+        advancedOpenerConfigAclPrefs[7] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNDRBSUP")
+    {
+        advancedOpenerConfigAclPrefs[8] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNDRBSUPDUR")
+    {
+        advancedOpenerConfigAclPrefs[9] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNSRING")
+    {
+        advancedOpenerConfigAclPrefs[10] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNSOPN")
+    {
+        advancedOpenerConfigAclPrefs[11] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNSRTO")
+    {
+        advancedOpenerConfigAclPrefs[12] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNSCM")
+    {
+        advancedOpenerConfigAclPrefs[13] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNSCFRM")
+    {
+        advancedOpenerConfigAclPrefs[14] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNSLVL")
+    {
+        advancedOpenerConfigAclPrefs[15] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNSBPA")
+    {
+        advancedOpenerConfigAclPrefs[16] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNDBPA")
+    {
+        advancedOpenerConfigAclPrefs[17] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNBATT")
+    {
+        advancedOpenerConfigAclPrefs[18] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNABTD")
+    {
+        advancedOpenerConfigAclPrefs[19] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "CONFOPNRBTNUKI")
+    {
+        advancedOpenerConfigAclPrefs[20] = ((value == "1") ? 1 : 0);
+    }
+    else if(key == "REGAPP")
+    {
+        if(_preferences->getBool(preference_register_as_app, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_register_as_app, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "REGAPPOPN")
+    {
+        if(_preferences->getBool(preference_register_opener_as_app, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_register_opener_as_app, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            //configChanged = true;
+        }
+    }
+    else if(key == "LOCKENA")
+    {
+        if(_preferences->getBool(preference_lock_enabled, true) != (value == "1"))
+        {
+            _preferences->putBool(preference_lock_enabled, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "OPENA")
+    {
+        if(_preferences->getBool(preference_opener_enabled, false) != (value == "1"))
+        {
+            _preferences->putBool(preference_opener_enabled, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "CONNMODE")
+    {
+        if(_preferences->getBool(preference_connect_mode, true) != (value == "1"))
+        {
+            _preferences->putBool(preference_connect_mode, (value == "1"));
+            Log->print("Setting changed: ");
+            Log->println(key);
+            configChanged = true;
+        }
+    }
+    else if(key == "CREDTOTP")
+    {
+        if(value != "*")
+        {
+            if(_preferences->getString(preference_totp_secret, "") != value)
+            {
+                _preferences->putString(preference_totp_secret, value);
+                Log->print("Setting changed: ");
+                Log->println(key);
+                configChanged = true;
+                clearSession = true;
+                newMFA = true;
+            }
+        }
+    }
+    else if(key == "CREDBYPASS")
+    {
+        if(value != "*")
+        {
+            if(_preferences->getString(preference_bypass_secret, "") != value)
+            {
+                _preferences->putString(preference_bypass_secret, value);
+                Log->print("Setting changed: ");
+                Log->println(key);
+                configChanged = true;
+            }
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+
+// Side effects collected while the form is processed
+struct SettingsFlags
+{
+    bool configChanged = false;
+    bool networkReconfigure = false;
+    bool clearSession = false;
+    bool newMFA = false;
+};
+
+// The if / else if chain WebCfgServer::processArgs used for the fields now in WebCfgSettings,
+// kept as reference. acl points to the five ACL arrays in WebCfgAclGroup order.
+// Returns false if the key isn't one of these fields.
+bool applyPreviousChain(Preferences* _preferences, const String& key, const String& value, SettingsFlags& flags, uint32_t** acl);
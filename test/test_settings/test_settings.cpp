@@ -0,0 +1,225 @@
+#include <unity.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include <WebCfgSettings.h>
+#include "previous_chain.h"
+
+static Print nullLog;
+Print* Log = &nullLog;
+
+void setUp() {}
+void tearDown() {}
+
+// fields of the settings pages handled by the previous chain
+static const char* const keys[] = {
+    "MQTTSERVER", "MQTTPORT", "MQTTPASS", "MQTTPATH", "UPTIME", "TIMESRV", "NWCUSTPHY", "NWCUSTADDR", "NWCUSTIRQ", "NWCUSTRST",
+    "NWCUSTCS", "NWCUSTSCK", "NWCUSTMISO", "NWCUSTMOSI", "NWCUSTPWR", "NWCUSTMDIO", "NWCUSTMDC", "NWCUSTCLK", "RSSI", "HTTPSFQDN",
+    "DUOHOST", "DUOIKEY", "DUOSKEY", "DUOUSER", "DUOBYPASS", "DUOBYPASSHIGH", "DUOBYPASSLOW", "DUOAPPROVAL", "CREDLFTM", "CREDLFTMRMBR",
+    "CREDDUOLFTM", "CREDDUOLFTMRMBR", "CREDTOTPLFTM", "CREDTOTPLFTMRMBR", "OPENERCONT", "HASSCUURL", "HOSTNAME", "NETTIMEOUT", "FINDBESTRSSI", "RSTDISC",
+    "MQTTLOG", "MQTTJOURNAL", "MQTTSENA", "WEBLOG", "CHECKUPDATE", "UPDATEMQTT", "HYBRIDTIMER", "HYBRIDRETRY", "HYBRIDREBOOT", "DISNONJSON",
+    "DHCPENA", "IPADDR", "IPSUB", "IPGTW", "DNSSRV", "LSTINT", "CFGINT", "BATINT", "KPINT", "NRTRY",
+    "TRYDLY", "RSBC", "TSKNTWK", "TSKNUKI", "ALMAX", "KPMAX", "TCMAX", "AUTHMAX", "BUFFSIZE", "BTLPRST",
+    "DISNTWNOCON", "OTAUPD", "OTAMAIN", "SHOWSECRETS", "DBGCONN", "DBGCOMMU", "DBGHEAP", "DBGREAD", "DBGHEX", "DBGCOMM",
+    "LCKFORCEID", "LCKFORCEKP", "LCKFORCEDS", "OPFORCEID", "OPFORCEKP", "CONFPUB", "KPPUB", "KPCODE", "KPCHECK", "KPENA",
+    "TCPUB", "AUTHPUB", "KPPER", "TCPER", "TCENA", "AUTHPER", "AUTHENA", "PUBAUTH", "CREDDIGEST", "CREDTRUSTPROXY",
+    "ACLLCKLCK", "ACLLCKUNLCK", "ACLLCKUNLTCH", "ACLLCKLNG", "ACLLCKLNGU", "ACLLCKFLLCK", "ACLLCKFOB1", "ACLLCKFOB2", "ACLLCKFOB3", "ACLOPNUNLCK",
+    "ACLOPNLCK", "ACLOPNUNLTCH", "ACLOPNUNLCKCM", "ACLOPNLCKCM", "ACLOPNFOB1", "ACLOPNFOB2", "ACLOPNFOB3", "CONFLCKNAME", "CONFLCKLAT", "CONFLCKLONG",
+    "CONFLCKAUNL", "CONFLCKPRENA", "CONFLCKBTENA", "CONFLCKLEDENA", "CONFLCKLEDBR", "CONFLCKTZOFF", "CONFLCKDSTM", "CONFLCKFOB1", "CONFLCKFOB2", "CONFLCKFOB3",
+    "CONFLCKSGLLCK", "CONFLCKADVM", "CONFLCKTZID", "CONFLCKUPOD", "CONFLCKLPOD", "CONFLCKSLPOD", "CONFLCKUTLTOD", "CONFLCKLNGT", "CONFLCKSBPA", "CONFLCKDBPA",
+    "CONFLCKDC", "CONFLCKBATT", "CONFLCKABTD", "CONFLCKUNLD", "CONFLCKALT", "CONFLCKAUNLD", "CONFLCKNMENA", "CONFLCKNMST", "CONFLCKNMET", "CONFLCKNMALENA",
+    "CONFLCKNMAULD", "CONFLCKNMLOS", "CONFLCKALENA", "CONFLCKIALENA", "CONFLCKAUENA", "CONFLCKRBTNUKI", "CONFLCKMTRSPD", "CONFLCKESSDNM", "CONFOPNNAME", "CONFOPNLAT",
+    "CONFOPNLONG", "CONFOPNPRENA", "CONFOPNBTENA", "CONFOPNLEDENA", "CONFOPNTZOFF", "CONFOPNDSTM", "CONFOPNFOB1", "CONFOPNFOB2", "CONFOPNFOB3", "CONFOPNOPM",
+    "CONFOPNADVM", "CONFOPNTZID", "CONFOPNICID", "CONFOPNBUSMS", "CONFOPNSCDUR", "CONFOPNESD", "CONFOPNRESD", "CONFOPNESDUR", "CONFOPNDRTOAR", "CONFOPNRTOT",
+    "CONFOPNDRBSUP", "CONFOPNDRBSUPDUR", "CONFOPNSRING", "CONFOPNSOPN", "CONFOPNSRTO", "CONFOPNSCM", "CONFOPNSCFRM", "CONFOPNSLVL", "CONFOPNSBPA", "CONFOPNDBPA",
+    "CONFOPNBATT", "CONFOPNABTD", "CONFOPNRBTNUKI", "REGAPP", "REGAPPOPN", "LOCKENA", "OPENA", "CONNMODE", "CREDTOTP", "CREDBYPASS",
+    "TXPWR"};
+static const size_t nrOfKeys = sizeof(keys) / sizeof(keys[0]);
+
+// empty, masked, booleans, range limits of the int settings and strings
+static const char* const values[] = {"", "0", "1", "2", "*", "#", "-12", "-13", "9", "10", "20", "21", "100", "101",
+                                     "200", "201", "4095", "4096", "8191", "8192", "12287", "12288", "65536", "65537", "abc", "pool.ntp.org", "-1"};
+
+struct AclArrays {
+  uint32_t values[WEBCFG_ACL_GROUPS][32];
+  uint32_t* groups[WEBCFG_ACL_GROUPS];
+
+  AclArrays() {
+    memset(values, 0, sizeof(values));
+    for (int i = 0; i < WEBCFG_ACL_GROUPS; ++i) {
+      groups[i] = values[i];
+    }
+  }
+};
+
+// what processArgs does with a field found in the table
+static bool applyTable(const WebCfgSettings& settings, Preferences* preferences, const String& key, const String& value,
+                       SettingsFlags& flags, uint32_t** acl) {
+  const WebCfgSetting* setting = settings.find(key.c_str());
+  if (setting == nullptr) {
+    return false;
+  }
+  if (setting->type == WebCfgSettingType::Acl) {
+    acl[(uint8_t)setting->aclGroup][setting->aclIndex] = ((value == "1") ? 1 : 0);
+  } else if (settings.apply(*setting, preferences, value)) {
+    flags.configChanged |= (setting->flags & WEBCFG_CONFIG_CHANGED) != 0;
+    flags.networkReconfigure |= (setting->flags & WEBCFG_NETWORK_RECONFIGURE) != 0;
+    flags.clearSession |= (setting->flags & WEBCFG_CLEAR_SESSION) != 0;
+    flags.newMFA |= (setting->flags & WEBCFG_NEW_MFA) != 0;
+  }
+  return true;
+}
+
+static bool sameFlags(const SettingsFlags& a, const SettingsFlags& b) {
+  return a.configChanged == b.configChanged && a.networkReconfigure == b.networkReconfigure &&
+         a.clearSession == b.clearSession && a.newMFA == b.newMFA;
+}
+
+/*
+- the table covers exactly the fields of the previous chain, other keys aren't found
+*/
+void test_keys() {
+  WebCfgSettings settings;
+  TEST_ASSERT_EQUAL_UINT32(nrOfKeys, settings.count());
+  for (size_t i = 0; i < nrOfKeys; ++i) {
+    const WebCfgSetting* setting = settings.find(keys[i]);
+    TEST_ASSERT_NOT_NULL(setting);
+    TEST_ASSERT_EQUAL_STRING(keys[i], setting->key);
+  }
+  TEST_ASSERT_NULL(settings.find(""));
+  TEST_ASSERT_NULL(settings.find("NOPE"));
+  TEST_ASSERT_NULL(settings.find("MQTTUSER"));
+  TEST_ASSERT_NULL(settings.find("MQTTSERVE"));
+  TEST_ASSERT_NULL(settings.find("MQTTSERVERX"));
+}
+
+/*
+- ACL fields point into their array, the arrays fit WEBCFG_ACL_SIZE
+*/
+void test_aclIndices() {
+  WebCfgSettings settings;
+  for (size_t i = 0; i < settings.count(); ++i) {
+    const WebCfgSetting& setting = settings.at(i);
+    if (setting.type == WebCfgSettingType::Acl) {
+      TEST_ASSERT_TRUE(setting.aclIndex < settings.aclSize(setting.aclGroup));
+    }
+  }
+  for (int group = 0; group < WEBCFG_ACL_GROUPS; ++group) {
+    TEST_ASSERT_TRUE(settings.aclSize((WebCfgAclGroup)group) <= WEBCFG_ACL_SIZE);
+    TEST_ASSERT_NOT_NULL(settings.aclPreference((WebCfgAclGroup)group));
+  }
+}
+
+/*
+- with DUOAPPROVAL set and TOTP or Duo enabled a change without approval is refused
+- a session approval, a TOTP code or a bypass session approve it
+- without DUOAPPROVAL or without a MFA method nothing is required
+*/
+void test_changeApproval() {
+  WebCfgSettings settings;
+  Preferences preferences;
+  const WebCfgApproval none = {true, false, false, false, false};
+  TEST_ASSERT_TRUE(webCfgChangeApproved(&preferences, none));
+
+  settings.apply(*settings.find("DUOAPPROVAL"), &preferences, "1");
+  TEST_ASSERT_FALSE(webCfgChangeApproved(&preferences, none));
+  TEST_ASSERT_FALSE(webCfgChangeApproved(&preferences, {false, true, false, false, false}));
+  TEST_ASSERT_TRUE(webCfgChangeApproved(&preferences, {true, false, true, false, false}));
+  TEST_ASSERT_TRUE(webCfgChangeApproved(&preferences, {true, false, false, true, false}));
+  TEST_ASSERT_TRUE(webCfgChangeApproved(&preferences, {false, true, false, false, true}));
+  TEST_ASSERT_TRUE(webCfgChangeApproved(&preferences, {false, false, false, false, false}));
+
+  settings.apply(*settings.find("DUOAPPROVAL"), &preferences, "0");
+  TEST_ASSERT_TRUE(webCfgChangeApproved(&preferences, none));
+}
+
+/*
+- every field with every value, on empty preferences, on the same value and on a different value
+- the preferences, the ACL arrays and the side effects are identical to the previous chain
+*/
+void test_sameAsPreviousChain() {
+  WebCfgSettings settings;
+  int cases = 0;
+  for (size_t k = 0; k < nrOfKeys; ++k) {
+    for (const char* value : values) {
+      for (int before = 0; before < 3; ++before) {
+        Preferences expected;
+        Preferences actual;
+        AclArrays expectedAcl;
+        AclArrays actualAcl;
+        SettingsFlags expectedFlags;
+        SettingsFlags actualFlags;
+
+        if (before > 0) {
+          const char* previous = before == 1 ? value : "7";
+          applyPreviousChain(&expected, keys[k], previous, expectedFlags, expectedAcl.groups);
+          applyPreviousChain(&actual, keys[k], previous, actualFlags, actualAcl.groups);
+          expectedFlags = SettingsFlags();
+          actualFlags = SettingsFlags();
+        }
+
+        bool handled = applyPreviousChain(&expected, keys[k], value, expectedFlags, expectedAcl.groups);
+        bool found = applyTable(settings, &actual, keys[k], value, actualFlags, actualAcl.groups);
+
+        if (handled != found || !(expected == actual) || memcmp(expectedAcl.values, actualAcl.values, sizeof(expectedAcl.values)) != 0 ||
+            !sameFlags(expectedFlags, actualFlags)) {
+          char message[100];
+          snprintf(message, sizeof(message), "%s=\"%s\" differs, preference before: %d", keys[k], value, before);
+          TEST_FAIL_MESSAGE(message);
+        }
+        ++cases;
+      }
+    }
+  }
+
+  char message[60];
+  snprintf(message, sizeof(message), "%d cases identical", cases);
+  TEST_MESSAGE(message);
+}
+
+/*
+- time to apply a complete form submission, previous chain against the table
+*/
+void test_fullFormTiming() {
+  typedef std::chrono::steady_clock Clock;
+  const int rounds = 2000;
+  WebCfgSettings settings;
+  Preferences chainPreferences;
+  Preferences tablePreferences;
+  SettingsFlags flags;
+  AclArrays acl;
+
+  Clock::time_point start = Clock::now();
+  for (int round = 0; round < rounds; ++round) {
+    for (size_t k = 0; k < nrOfKeys; ++k) {
+      applyPreviousChain(&chainPreferences, keys[k], "1", flags, acl.groups);
+    }
+  }
+  Clock::time_point middle = Clock::now();
+  for (int round = 0; round < rounds; ++round) {
+    for (size_t k = 0; k < nrOfKeys; ++k) {
+      applyTable(settings, &tablePreferences, keys[k], "1", flags, acl.groups);
+    }
+  }
+  Clock::time_point end = Clock::now();
+
+  TEST_ASSERT_TRUE(chainPreferences == tablePreferences);
+
+  char message[100];
+  snprintf(message, sizeof(message), "%u fields: chain %.1f us, table %.1f us per form", (unsigned)nrOfKeys,
+           std::chrono::duration<double, std::micro>(middle - start).count() / rounds,
+           std::chrono::duration<double, std::micro>(end - middle).count() / rounds);
+  TEST_MESSAGE(message);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_keys);
+  RUN_TEST(test_aclIndices);
+  RUN_TEST(test_changeApproval);
+  RUN_TEST(test_sameAsPreviousChain);
+  RUN_TEST(test_fullFormTiming);
+  return UNITY_END();
+}
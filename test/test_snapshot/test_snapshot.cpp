@@ -0,0 +1,136 @@
+#include <unity.h>
+
+#include <cstring>
+#include <list>
+#include <thread>
+
+#include <EntrySnapshot.h>
+
+void setUp() {}
+void tearDown() {}
+
+// packed like the keypad entries received from the device
+#pragma pack(push, 1)
+struct Entry {
+  uint16_t codeId;
+  uint32_t code;
+  char name[20];
+  uint8_t enabled;
+  uint16_t lockCount;
+};
+#pragma pack(pop)
+
+static Entry entry(uint16_t codeId, const char* name) {
+  Entry result;
+  memset(&result, 0, sizeof(result));
+  result.codeId = codeId;
+  result.code = 123456;
+  strncpy(result.name, name, sizeof(result.name) - 1);
+  result.enabled = 1;
+  return result;
+}
+
+static std::list<Entry> threeEntries() {
+  return std::list<Entry>{entry(1, "front"), entry(2, "back"), entry(3, "garage")};
+}
+
+/*
+- the first update publishes everything, an identical list publishes nothing
+*/
+void test_firstAndUnchanged() {
+  EntrySnapshot<Entry> snapshot;
+  std::list<Entry> entries = threeEntries();
+
+  EntrySnapshot<Entry>::Diff diff = snapshot.update(entries);
+  TEST_ASSERT_TRUE(diff.full);
+  TEST_ASSERT_TRUE(diff.any());
+  TEST_ASSERT_EQUAL_UINT32(3, diff.changedCount);
+  TEST_ASSERT_EQUAL_UINT32(0, diff.previousSize);
+
+  diff = snapshot.update(entries);
+  TEST_ASSERT_FALSE(diff.full);
+  TEST_ASSERT_FALSE(diff.any());
+  TEST_ASSERT_EQUAL_UINT32(3, diff.changed.size());
+}
+
+/*
+- a change in any field marks only that position
+- an appended entry marks the new position
+*/
+void test_changedAndAdded() {
+  EntrySnapshot<Entry> snapshot;
+  std::list<Entry> entries = threeEntries();
+  snapshot.update(entries);
+
+  entries.back().lockCount = 7;
+  EntrySnapshot<Entry>::Diff diff = snapshot.update(entries);
+  TEST_ASSERT_FALSE(diff.full);
+  TEST_ASSERT_EQUAL_UINT32(1, diff.changedCount);
+  TEST_ASSERT_FALSE(diff.changed[0]);
+  TEST_ASSERT_FALSE(diff.changed[1]);
+  TEST_ASSERT_TRUE(diff.changed[2]);
+
+  entries.push_back(entry(4, "shed"));
+  diff = snapshot.update(entries);
+  TEST_ASSERT_EQUAL_UINT32(1, diff.changedCount);
+  TEST_ASSERT_TRUE(diff.changed[3]);
+  TEST_ASSERT_EQUAL_UINT32(3, diff.previousSize);
+  TEST_ASSERT_FALSE(snapshot.update(entries).any());
+}
+
+/*
+- topics are numbered by position: removing the first entry changes every position after it
+- positions past the new size are reported as removed
+*/
+void test_removed() {
+  EntrySnapshot<Entry> snapshot;
+  std::list<Entry> entries = threeEntries();
+  snapshot.update(entries);
+
+  entries.pop_front();
+  EntrySnapshot<Entry>::Diff diff = snapshot.update(entries);
+  TEST_ASSERT_EQUAL_UINT32(2, diff.changed.size());
+  TEST_ASSERT_EQUAL_UINT32(2, diff.changedCount);
+  TEST_ASSERT_EQUAL_UINT32(3, diff.previousSize);
+  TEST_ASSERT_TRUE(diff.any());
+
+  entries.pop_back();
+  diff = snapshot.update(entries);
+  TEST_ASSERT_EQUAL_UINT32(0, diff.changedCount);
+  TEST_ASSERT_EQUAL_UINT32(2, diff.previousSize);
+  TEST_ASSERT_TRUE(diff.any());
+
+  entries.clear();
+  diff = snapshot.update(entries);
+  TEST_ASSERT_EQUAL_UINT32(0, diff.changed.size());
+  TEST_ASSERT_EQUAL_UINT32(1, diff.previousSize);
+  TEST_ASSERT_TRUE(diff.any());
+  TEST_ASSERT_FALSE(snapshot.update(entries).any());
+}
+
+/*
+- invalidate() from another task forces the next update to publish everything, once
+*/
+void test_invalidate() {
+  EntrySnapshot<Entry> snapshot;
+  std::list<Entry> entries = threeEntries();
+  snapshot.update(entries);
+
+  std::thread network([&] { snapshot.invalidate(); });
+  network.join();
+
+  EntrySnapshot<Entry>::Diff diff = snapshot.update(entries);
+  TEST_ASSERT_TRUE(diff.full);
+  TEST_ASSERT_EQUAL_UINT32(3, diff.changedCount);
+  TEST_ASSERT_EQUAL_UINT32(0, diff.previousSize);
+  TEST_ASSERT_FALSE(snapshot.update(entries).any());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_firstAndUnchanged);
+  RUN_TEST(test_changedAndAdded);
+  RUN_TEST(test_removed);
+  RUN_TEST(test_invalidate);
+  return UNITY_END();
+}
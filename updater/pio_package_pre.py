@@ -38,6 +38,8 @@ else:
 
 recursive_purge("managed_components", ".component_hash")
 
+env.Execute("$PYTHONEXE ../resources/web_assets.py")
+
 board = env.get('BOARD_MCU')
 
 if os.path.exists("sdkconfig.updater_" + board):